@@ -0,0 +1,151 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Benchmarks for AES in various chaining modes.
+//
+//----------------------------------------------------------------------------
+
+#include "tsbench.h"
+#include "tsAES.h"
+#include "tsECB.h"
+#include "tsCBC.h"
+#include "tsCTR.h"
+#include "tsTS.h"
+
+
+//----------------------------------------------------------------------------
+// AES on TS packet payloads, as used by the aes plugin and ATIS-IDSA.
+//----------------------------------------------------------------------------
+
+namespace {
+    const size_t COUNT = 512;  // Number of packets per iteration.
+    const size_t PAYLOAD_SIZE = ts::PKT_SIZE - 4;
+    const size_t BLOCKS_SIZE = PAYLOAD_SIZE - PAYLOAD_SIZE % ts::AES::BLOCK_SIZE;
+
+    class AESBench: public tsbench::Benchmark
+    {
+        TS_NOBUILD_NOCOPY(AESBench);
+    public:
+        AESBench(const ts::UString& name, const ts::UString& description, ts::CipherChaining* algo, bool encrypt, bool residue);
+        virtual ~AESBench() override;
+        virtual void setup() override;
+        virtual uint64_t iterate() override;
+        virtual void cleanup() override;
+    private:
+        ts::CipherChaining*  _algo;
+        bool                 _encrypt;
+        size_t               _size;
+        std::vector<uint8_t> _data;
+    };
+}
+
+AESBench::AESBench(const ts::UString& name, const ts::UString& description, ts::CipherChaining* algo, bool encrypt, bool residue) :
+    tsbench::Benchmark(name, description),
+    _algo(algo),
+    _encrypt(encrypt),
+    _size(residue ? PAYLOAD_SIZE : BLOCKS_SIZE),
+    _data()
+{
+}
+
+AESBench::~AESBench()
+{
+    delete _algo;
+}
+
+void AESBench::setup()
+{
+    static const uint8_t key[16] = {0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C};
+    static const uint8_t iv[16] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F};
+    _algo->setKey(key, sizeof(key));
+    if (_algo->maxIVSize() > 0) {
+        _algo->setIV(iv, sizeof(iv));
+    }
+    _data.resize(COUNT * _size);
+    for (size_t i = 0; i < _data.size(); ++i) {
+        _data[i] = uint8_t(i * 13);
+    }
+}
+
+uint64_t AESBench::iterate()
+{
+    for (size_t i = 0; i < COUNT; ++i) {
+        if (_encrypt) {
+            _algo->encryptInPlace(&_data[i * _size], _size);
+        }
+        else {
+            _algo->decryptInPlace(&_data[i * _size], _size);
+        }
+    }
+    return _data.size();
+}
+
+void AESBench::cleanup()
+{
+    _data.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Registered benchmarks.
+//----------------------------------------------------------------------------
+
+namespace {
+    class AESEncryptECB: public AESBench
+    {
+    public:
+        AESEncryptECB() : AESBench(u"aes.ecb-encrypt", u"AES-128-ECB encryption, 176 bytes per packet", new ts::ECB<ts::AES>, true, false) {}
+    };
+    class AESDecryptECB: public AESBench
+    {
+    public:
+        AESDecryptECB() : AESBench(u"aes.ecb-decrypt", u"AES-128-ECB decryption, 176 bytes per packet", new ts::ECB<ts::AES>, false, false) {}
+    };
+    class AESEncryptCBC: public AESBench
+    {
+    public:
+        AESEncryptCBC() : AESBench(u"aes.cbc-encrypt", u"AES-128-CBC encryption, 176 bytes per packet", new ts::CBC<ts::AES>, true, false) {}
+    };
+    class AESDecryptCBC: public AESBench
+    {
+    public:
+        AESDecryptCBC() : AESBench(u"aes.cbc-decrypt", u"AES-128-CBC decryption, 176 bytes per packet", new ts::CBC<ts::AES>, false, false) {}
+    };
+    class AESCTR: public AESBench
+    {
+    public:
+        AESCTR() : AESBench(u"aes.ctr", u"AES-128-CTR encryption, 184 bytes per packet", new ts::CTR<ts::AES>, true, true) {}
+    };
+}
+
+TSBENCH_REGISTER(AESEncryptECB);
+TSBENCH_REGISTER(AESDecryptECB);
+TSBENCH_REGISTER(AESEncryptCBC);
+TSBENCH_REGISTER(AESDecryptCBC);
+TSBENCH_REGISTER(AESCTR);
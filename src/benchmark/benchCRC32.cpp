@@ -0,0 +1,116 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Benchmarks for CRC32 computation.
+//
+//----------------------------------------------------------------------------
+
+#include "tsbench.h"
+#include "tsCRC32.h"
+#include "tsByteBlock.h"
+
+
+//----------------------------------------------------------------------------
+// CRC32 on data areas of a given size.
+//----------------------------------------------------------------------------
+
+namespace {
+    class CRC32Bench: public tsbench::Benchmark
+    {
+        TS_NOBUILD_NOCOPY(CRC32Bench);
+    public:
+        CRC32Bench(const ts::UString& name, const ts::UString& description, size_t data_size, size_t count);
+        virtual void setup() override;
+        virtual uint64_t iterate() override;
+        virtual void cleanup() override;
+    private:
+        size_t        _data_size;  // Size of each data area.
+        size_t        _count;      // Number of data areas per iteration.
+        ts::ByteBlock _data;
+        uint32_t      _result;     // Prevent the compiler from optimizing out the computation.
+    };
+}
+
+CRC32Bench::CRC32Bench(const ts::UString& name, const ts::UString& description, size_t data_size, size_t count) :
+    tsbench::Benchmark(name, description),
+    _data_size(data_size),
+    _count(count),
+    _data(),
+    _result(0)
+{
+}
+
+void CRC32Bench::setup()
+{
+    _data.resize(_data_size * _count);
+    for (size_t i = 0; i < _data.size(); ++i) {
+        _data[i] = uint8_t(i * 7 + (i >> 8));
+    }
+}
+
+uint64_t CRC32Bench::iterate()
+{
+    for (size_t i = 0; i < _count; ++i) {
+        _result ^= ts::CRC32(&_data[i * _data_size], _data_size).value();
+    }
+    return _data.size();
+}
+
+void CRC32Bench::cleanup()
+{
+    _data.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Registered benchmarks: short sections (typical PAT/PMT), long sections
+// (typical EIT or private sections) and large buffers.
+//----------------------------------------------------------------------------
+
+namespace {
+    class CRC32Short: public CRC32Bench
+    {
+    public:
+        CRC32Short() : CRC32Bench(u"crc32.short", u"CRC32 on 100 sections of 32 bytes", 32, 100) {}
+    };
+    class CRC32Long: public CRC32Bench
+    {
+    public:
+        CRC32Long() : CRC32Bench(u"crc32.long", u"CRC32 on 100 sections of 4096 bytes", 4096, 100) {}
+    };
+    class CRC32Large: public CRC32Bench
+    {
+    public:
+        CRC32Large() : CRC32Bench(u"crc32.large", u"CRC32 on a 4 MB buffer", 4 * 1024 * 1024, 1) {}
+    };
+}
+
+TSBENCH_REGISTER(CRC32Short);
+TSBENCH_REGISTER(CRC32Long);
+TSBENCH_REGISTER(CRC32Large);
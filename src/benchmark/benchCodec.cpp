@@ -0,0 +1,125 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Benchmarks for video codec parsing.
+//
+//----------------------------------------------------------------------------
+
+#include "tsbench.h"
+#include "tsAccessUnitIterator.h"
+#include "tsAVC.h"
+#include "tsByteBlock.h"
+
+
+//----------------------------------------------------------------------------
+// Iteration over all NALunits of large AVC PES payloads.
+//----------------------------------------------------------------------------
+
+namespace {
+    class NALUnitBench: public tsbench::Benchmark
+    {
+        TS_NOBUILD_NOCOPY(NALUnitBench);
+    public:
+        NALUnitBench(const ts::UString& name, const ts::UString& description, size_t nalunit_size);
+        virtual void setup() override;
+        virtual uint64_t iterate() override;
+        virtual void cleanup() override;
+    private:
+        static constexpr size_t PAYLOAD_SIZE = 256 * 1024;  // Size of each PES payload.
+        static constexpr size_t PAYLOAD_COUNT = 4;          // Number of PES payloads per iteration.
+        size_t        _nalunit_size;
+        ts::ByteBlock _data;
+        uint64_t      _result;  // Prevent the compiler from optimizing out the parsing.
+    };
+}
+
+NALUnitBench::NALUnitBench(const ts::UString& name, const ts::UString& description, size_t nalunit_size) :
+    tsbench::Benchmark(name, description),
+    _nalunit_size(nalunit_size),
+    _data(),
+    _result(0)
+{
+}
+
+void NALUnitBench::setup()
+{
+    // Slice NALunits with 4-byte start codes, without 00 00 sequences inside NALunits (emulation prevention).
+    _data.resize(PAYLOAD_SIZE * PAYLOAD_COUNT);
+    for (size_t i = 0; i < _data.size(); ++i) {
+        const size_t offset = i % PAYLOAD_SIZE;
+        const size_t index = offset % _nalunit_size;
+        if (index < 4) {
+            _data[i] = index < 3 ? 0x00 : 0x01;
+        }
+        else if (index == 4) {
+            _data[i] = offset < _nalunit_size ? ts::AVC_AUT_IDR : ts::AVC_AUT_NON_IDR;
+        }
+        else {
+            _data[i] = uint8_t(i * 7 + (i >> 8)) | 0x02;
+        }
+    }
+}
+
+uint64_t NALUnitBench::iterate()
+{
+    for (size_t i = 0; i < PAYLOAD_COUNT; ++i) {
+        ts::AccessUnitIterator iter(&_data[i * PAYLOAD_SIZE], PAYLOAD_SIZE, ts::ST_AVC_VIDEO);
+        while (!iter.atEnd()) {
+            _result += iter.currentAccessUnitType() + iter.currentAccessUnitSize();
+            iter.next();
+        }
+    }
+    return _data.size();
+}
+
+void NALUnitBench::cleanup()
+{
+    _data.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Registered benchmarks: small and large NALunits.
+//----------------------------------------------------------------------------
+
+namespace {
+    class NALUnitSmall: public NALUnitBench
+    {
+    public:
+        NALUnitSmall() : NALUnitBench(u"codec.nalunits.small", u"AVC NALunits of 200 bytes in 256 kB PES payloads", 200) {}
+    };
+    class NALUnitLarge: public NALUnitBench
+    {
+    public:
+        NALUnitLarge() : NALUnitBench(u"codec.nalunits.large", u"AVC NALunits of 16 kB in 256 kB PES payloads", 16 * 1024) {}
+    };
+}
+
+TSBENCH_REGISTER(NALUnitSmall);
+TSBENCH_REGISTER(NALUnitLarge);
@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Benchmarks for DVB-CSA2 scrambling.
+//
+//----------------------------------------------------------------------------
+
+#include "tsbench.h"
+#include "tsDVBCSA2.h"
+#include "tsTS.h"
+
+
+//----------------------------------------------------------------------------
+// DVB-CSA2 on full TS packet payloads, individually or in batch.
+//----------------------------------------------------------------------------
+
+namespace {
+    const size_t COUNT = 512;  // Number of packets per iteration.
+    const size_t PAYLOAD_SIZE = ts::PKT_SIZE - 4;
+
+    class DVBCSA2Bench: public tsbench::Benchmark
+    {
+        TS_NOBUILD_NOCOPY(DVBCSA2Bench);
+    public:
+        DVBCSA2Bench(const ts::UString& name, const ts::UString& description, bool encrypt, bool batch);
+        virtual void setup() override;
+        virtual uint64_t iterate() override;
+        virtual void cleanup() override;
+    private:
+        bool                 _encrypt;
+        bool                 _batch;
+        ts::DVBCSA2          _csa;
+        std::vector<uint8_t> _data;
+        std::vector<void*>   _addr;
+        std::vector<size_t>  _size;
+    };
+}
+
+DVBCSA2Bench::DVBCSA2Bench(const ts::UString& name, const ts::UString& description, bool encrypt, bool batch) :
+    tsbench::Benchmark(name, description),
+    _encrypt(encrypt),
+    _batch(batch),
+    _csa(),
+    _data(),
+    _addr(),
+    _size()
+{
+}
+
+void DVBCSA2Bench::setup()
+{
+    static const uint8_t cw[ts::DVBCSA2::KEY_SIZE] = {0x01, 0x23, 0x45, 0x69, 0x89, 0xAB, 0xCD, 0x01};
+    _csa.setKey(cw, sizeof(cw));
+    _data.resize(COUNT * PAYLOAD_SIZE);
+    _addr.resize(COUNT);
+    _size.resize(COUNT);
+    for (size_t i = 0; i < _data.size(); ++i) {
+        _data[i] = uint8_t(i * 11);
+    }
+    for (size_t i = 0; i < COUNT; ++i) {
+        _addr[i] = &_data[i * PAYLOAD_SIZE];
+        _size[i] = PAYLOAD_SIZE;
+    }
+}
+
+uint64_t DVBCSA2Bench::iterate()
+{
+    if (_batch) {
+        if (_encrypt) {
+            _csa.encryptInPlaceBatch(_addr.data(), _size.data(), COUNT);
+        }
+        else {
+            _csa.decryptInPlaceBatch(_addr.data(), _size.data(), COUNT);
+        }
+    }
+    else {
+        for (size_t i = 0; i < COUNT; ++i) {
+            if (_encrypt) {
+                _csa.encryptInPlace(_addr[i], _size[i]);
+            }
+            else {
+                _csa.decryptInPlace(_addr[i], _size[i]);
+            }
+        }
+    }
+    return _data.size();
+}
+
+void DVBCSA2Bench::cleanup()
+{
+    _data.clear();
+    _addr.clear();
+    _size.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Registered benchmarks.
+//----------------------------------------------------------------------------
+
+namespace {
+    class DVBCSA2Encrypt: public DVBCSA2Bench
+    {
+    public:
+        DVBCSA2Encrypt() : DVBCSA2Bench(u"dvbcsa2.encrypt", u"DVB-CSA2 encryption, packet by packet", true, false) {}
+    };
+    class DVBCSA2Decrypt: public DVBCSA2Bench
+    {
+    public:
+        DVBCSA2Decrypt() : DVBCSA2Bench(u"dvbcsa2.decrypt", u"DVB-CSA2 decryption, packet by packet", false, false) {}
+    };
+    class DVBCSA2EncryptBatch: public DVBCSA2Bench
+    {
+    public:
+        DVBCSA2EncryptBatch() : DVBCSA2Bench(u"dvbcsa2.encrypt-batch", u"DVB-CSA2 encryption, batch of 512 packets", true, true) {}
+    };
+    class DVBCSA2DecryptBatch: public DVBCSA2Bench
+    {
+    public:
+        DVBCSA2DecryptBatch() : DVBCSA2Bench(u"dvbcsa2.decrypt-batch", u"DVB-CSA2 decryption, batch of 512 packets", false, true) {}
+    };
+}
+
+TSBENCH_REGISTER(DVBCSA2Encrypt);
+TSBENCH_REGISTER(DVBCSA2Decrypt);
+TSBENCH_REGISTER(DVBCSA2EncryptBatch);
+TSBENCH_REGISTER(DVBCSA2DecryptBatch);
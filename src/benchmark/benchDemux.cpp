@@ -0,0 +1,165 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Benchmarks for section and PES demultiplexing.
+//
+//----------------------------------------------------------------------------
+
+#include "tsbench.h"
+#include "tsSectionDemux.h"
+#include "tsPESDemux.h"
+#include "tsBinaryTable.h"
+
+
+//----------------------------------------------------------------------------
+// Section demux on all PID's of a multiplex, collecting sections and tables.
+//----------------------------------------------------------------------------
+
+namespace {
+    const size_t COUNT = 10000;  // Number of packets per iteration.
+
+    class SectionDemuxBench: public tsbench::Benchmark, private ts::TableHandlerInterface, private ts::SectionHandlerInterface
+    {
+        TS_NOCOPY(SectionDemuxBench);
+    public:
+        SectionDemuxBench();
+        virtual void setup() override;
+        virtual uint64_t iterate() override;
+        virtual void cleanup() override;
+    private:
+        ts::DuckContext    _duck;
+        ts::SectionDemux   _demux;
+        ts::TSPacketVector _packets;
+        uint64_t           _result;
+
+        virtual void handleTable(ts::SectionDemux& demux, const ts::BinaryTable& table) override;
+        virtual void handleSection(ts::SectionDemux& demux, const ts::Section& section) override;
+    };
+}
+
+SectionDemuxBench::SectionDemuxBench() :
+    tsbench::Benchmark(u"demux.sections", u"Section demux, 10000 packets from a multiplex"),
+    _duck(),
+    _demux(_duck, this, this, ts::AllPIDs),
+    _packets(),
+    _result(0)
+{
+}
+
+void SectionDemuxBench::setup()
+{
+    tsbench::BuildMultiplex(_duck, _packets, COUNT);
+    _demux.reset();
+}
+
+uint64_t SectionDemuxBench::iterate()
+{
+    for (const auto& pkt : _packets) {
+        _demux.feedPacket(pkt);
+    }
+    return _packets.size() * ts::PKT_SIZE;
+}
+
+void SectionDemuxBench::cleanup()
+{
+    _demux.reset();
+    _packets.clear();
+}
+
+void SectionDemuxBench::handleTable(ts::SectionDemux& demux, const ts::BinaryTable& table)
+{
+    _result += table.tableId();
+}
+
+void SectionDemuxBench::handleSection(ts::SectionDemux& demux, const ts::Section& section)
+{
+    _result += section.size();
+}
+
+TSBENCH_REGISTER(SectionDemuxBench);
+
+
+//----------------------------------------------------------------------------
+// PES demux on all PID's of a multiplex, including video and audio analysis.
+//----------------------------------------------------------------------------
+
+namespace {
+    class PESDemuxBench: public tsbench::Benchmark, private ts::PESHandlerInterface
+    {
+        TS_NOCOPY(PESDemuxBench);
+    public:
+        PESDemuxBench();
+        virtual void setup() override;
+        virtual uint64_t iterate() override;
+        virtual void cleanup() override;
+    private:
+        ts::DuckContext    _duck;
+        ts::PESDemux       _demux;
+        ts::TSPacketVector _packets;
+        uint64_t           _result;
+
+        virtual void handlePESPacket(ts::PESDemux& demux, const ts::PESPacket& packet) override;
+    };
+}
+
+PESDemuxBench::PESDemuxBench() :
+    tsbench::Benchmark(u"demux.pes", u"PES demux, 10000 packets from a multiplex"),
+    _duck(),
+    _demux(_duck, this),
+    _packets(),
+    _result(0)
+{
+}
+
+void PESDemuxBench::setup()
+{
+    tsbench::BuildMultiplex(_duck, _packets, COUNT);
+    _demux.reset();
+}
+
+uint64_t PESDemuxBench::iterate()
+{
+    for (const auto& pkt : _packets) {
+        _demux.feedPacket(pkt);
+    }
+    return _packets.size() * ts::PKT_SIZE;
+}
+
+void PESDemuxBench::cleanup()
+{
+    _demux.reset();
+    _packets.clear();
+}
+
+void PESDemuxBench::handlePESPacket(ts::PESDemux& demux, const ts::PESPacket& packet)
+{
+    _result += packet.size();
+}
+
+TSBENCH_REGISTER(PESDemuxBench);
@@ -0,0 +1,275 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Benchmarks for section and PES packetization.
+//
+//----------------------------------------------------------------------------
+
+#include "tsbench.h"
+#include "tsCyclingPacketizer.h"
+#include "tsPESStreamPacketizer.h"
+
+
+//----------------------------------------------------------------------------
+// Cycling packetization of all tables of a multiplex in one PID.
+//----------------------------------------------------------------------------
+
+namespace {
+    const size_t COUNT = 1000;  // Number of packets per iteration.
+
+    class SectionPacketizerBench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(SectionPacketizerBench);
+    public:
+        SectionPacketizerBench();
+        virtual void setup() override;
+        virtual uint64_t iterate() override;
+        virtual void cleanup() override;
+    private:
+        ts::DuckContext       _duck;
+        ts::CyclingPacketizer _packetizer;
+        ts::TSPacket          _packet;
+    };
+}
+
+SectionPacketizerBench::SectionPacketizerBench() :
+    tsbench::Benchmark(u"packetizer.sections", u"Cycling section packetizer, 1000 packets"),
+    _duck(),
+    _packetizer(_duck, 0x0100, ts::CyclingPacketizer::StuffingPolicy::NEVER),
+    _packet()
+{
+}
+
+void SectionPacketizerBench::setup()
+{
+    ts::BinaryTablePtrVector tables;
+    tsbench::BuildTables(_duck, tables);
+    for (const auto& table : tables) {
+        _packetizer.addTable(*table);
+    }
+}
+
+uint64_t SectionPacketizerBench::iterate()
+{
+    for (size_t i = 0; i < COUNT; ++i) {
+        _packetizer.getNextPacket(_packet);
+    }
+    return COUNT * ts::PKT_SIZE;
+}
+
+void SectionPacketizerBench::cleanup()
+{
+    _packetizer.removeAll();
+    _packetizer.reset();
+}
+
+TSBENCH_REGISTER(SectionPacketizerBench);
+
+
+//----------------------------------------------------------------------------
+// Carousel of large EIT schedule sections, repeated cycle after cycle.
+//----------------------------------------------------------------------------
+
+namespace {
+    const size_t CAROUSEL_SECTIONS = 512;       // Number of sections in the carousel.
+    const size_t CAROUSEL_PAYLOAD_SIZE = 4000;  // Payload size of each section.
+
+    class CarouselPacketizerBench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(CarouselPacketizerBench);
+    public:
+        CarouselPacketizerBench();
+        virtual void setup() override;
+        virtual uint64_t iterate() override;
+        virtual void cleanup() override;
+    private:
+        ts::DuckContext       _duck;
+        ts::CyclingPacketizer _packetizer;
+        ts::TSPacket          _packet;
+    };
+}
+
+CarouselPacketizerBench::CarouselPacketizerBench() :
+    tsbench::Benchmark(u"packetizer.carousel", u"Carousel of large sections, 1000 packets"),
+    _duck(),
+    _packetizer(_duck, ts::PID_EIT, ts::CyclingPacketizer::StuffingPolicy::AT_END),
+    _packet()
+{
+}
+
+void CarouselPacketizerBench::setup()
+{
+    ts::ByteBlock payload(CAROUSEL_PAYLOAD_SIZE);
+    for (size_t i = 0; i < CAROUSEL_SECTIONS; ++i) {
+        for (size_t j = 0; j < payload.size(); ++j) {
+            payload[j] = uint8_t(i + j);
+        }
+        const uint8_t secnum = uint8_t(8 * (i % 32));
+        _packetizer.addSection(new ts::Section(ts::TID_EIT_S_ACT_MIN, true, uint16_t(1 + i / 32), 0, true, secnum, 0xF8, payload.data(), payload.size()));
+    }
+}
+
+uint64_t CarouselPacketizerBench::iterate()
+{
+    for (size_t i = 0; i < COUNT; ++i) {
+        _packetizer.getNextPacket(_packet);
+    }
+    return COUNT * ts::PKT_SIZE;
+}
+
+void CarouselPacketizerBench::cleanup()
+{
+    _packetizer.reset();
+}
+
+TSBENCH_REGISTER(CarouselPacketizerBench);
+
+
+//----------------------------------------------------------------------------
+// Large carousel of scheduled sections with individual repetition rates.
+//----------------------------------------------------------------------------
+
+namespace {
+    const size_t SCHEDULE_SECTIONS = 10000;  // Number of scheduled sections.
+
+    class SchedulePacketizerBench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(SchedulePacketizerBench);
+    public:
+        SchedulePacketizerBench();
+        virtual void setup() override;
+        virtual uint64_t iterate() override;
+        virtual void cleanup() override;
+    private:
+        ts::DuckContext       _duck;
+        ts::CyclingPacketizer _packetizer;
+        ts::TSPacket          _packet;
+    };
+}
+
+SchedulePacketizerBench::SchedulePacketizerBench() :
+    tsbench::Benchmark(u"packetizer.schedule", u"Scheduled carousel of 10,000 sections, 1000 packets"),
+    _duck(),
+    _packetizer(_duck, ts::PID_EIT, ts::CyclingPacketizer::StuffingPolicy::NEVER, 10000000),
+    _packet()
+{
+}
+
+void SchedulePacketizerBench::setup()
+{
+    // One-packet sections, repetition rates from 1 to 2 seconds, using the complete bitrate.
+    ts::ByteBlock payload(150);
+    for (size_t i = 0; i < SCHEDULE_SECTIONS; ++i) {
+        for (size_t j = 0; j < payload.size(); ++j) {
+            payload[j] = uint8_t(i + j);
+        }
+        const uint8_t secnum = uint8_t(8 * (i % 32));
+        _packetizer.addSection(new ts::Section(ts::TID_EIT_S_ACT_MIN, true, uint16_t(1 + i / 32), 0, true, secnum, 0xF8, payload.data(), payload.size()),
+                               ts::MilliSecond(1000 + (i * 7) % 1000));
+    }
+}
+
+uint64_t SchedulePacketizerBench::iterate()
+{
+    for (size_t i = 0; i < COUNT; ++i) {
+        _packetizer.getNextPacket(_packet);
+    }
+    return COUNT * ts::PKT_SIZE;
+}
+
+void SchedulePacketizerBench::cleanup()
+{
+    _packetizer.reset();
+}
+
+TSBENCH_REGISTER(SchedulePacketizerBench);
+
+
+//----------------------------------------------------------------------------
+// Packetization of large PES packets.
+//----------------------------------------------------------------------------
+
+namespace {
+    const size_t PES_SIZE = 32 * 1024;  // Typical video frame.
+
+    class PESPacketizerBench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(PESPacketizerBench);
+    public:
+        PESPacketizerBench();
+        virtual void setup() override;
+        virtual uint64_t iterate() override;
+        virtual void cleanup() override;
+    private:
+        ts::DuckContext         _duck;
+        ts::PESStreamPacketizer _packetizer;
+        ts::PESPacketPtr        _pes;
+        ts::TSPacket            _packet;
+    };
+}
+
+PESPacketizerBench::PESPacketizerBench() :
+    tsbench::Benchmark(u"packetizer.pes", u"PES packetizer, 1000 packets"),
+    _duck(),
+    _packetizer(_duck, 0x0100),
+    _pes(),
+    _packet()
+{
+}
+
+void PESPacketizerBench::setup()
+{
+    ts::ByteBlock data(PES_SIZE, 0xA5);
+    data[0] = data[1] = 0x00;
+    data[2] = 0x01;
+    data[3] = 0xE0;
+    ts::PutUInt16(&data[4], uint16_t(PES_SIZE - 6));
+    data[6] = 0x80;
+    data[7] = data[8] = 0x00;
+    _pes = new ts::PESPacket(data, 0x0100);
+}
+
+uint64_t PESPacketizerBench::iterate()
+{
+    for (size_t i = 0; i < COUNT; ++i) {
+        if (_packetizer.empty()) {
+            _packetizer.addPES(_pes);
+        }
+        _packetizer.getNextPacket(_packet);
+    }
+    return COUNT * ts::PKT_SIZE;
+}
+
+void PESPacketizerBench::cleanup()
+{
+    _packetizer.reset();
+    _pes.clear();
+}
+
+TSBENCH_REGISTER(PESPacketizerBench);
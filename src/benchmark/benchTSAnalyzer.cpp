@@ -0,0 +1,102 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Benchmarks for the per-packet processing of the transport stream analyzer.
+//
+//----------------------------------------------------------------------------
+
+#include "tsbench.h"
+#include "tsTSAnalyzer.h"
+#include "tsDuckContext.h"
+
+
+//----------------------------------------------------------------------------
+// Analyze packets from many PID's, as in a typical multiplex.
+//----------------------------------------------------------------------------
+
+namespace {
+    const size_t COUNT = 1024;  // Number of packets per iteration.
+    const size_t PID_COUNT = 60;  // Number of distinct PID's.
+
+    class TSAnalyzerBench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(TSAnalyzerBench);
+    public:
+        TSAnalyzerBench();
+        virtual void setup() override;
+        virtual uint64_t iterate() override;
+        virtual void cleanup() override;
+    private:
+        ts::DuckContext    _duck;
+        ts::TSAnalyzer     _analyzer;
+        ts::TSPacketVector _packets;
+        uint8_t            _cc[PID_COUNT];
+    };
+}
+
+TSAnalyzerBench::TSAnalyzerBench() :
+    tsbench::Benchmark(u"analyzer.packets", u"TS analyzer, 1024 packets on 60 PID's"),
+    _duck(),
+    _analyzer(_duck),
+    _packets(),
+    _cc()
+{
+}
+
+void TSAnalyzerBench::setup()
+{
+    _analyzer.reset();
+    _packets.resize(COUNT);
+    for (size_t i = 0; i < COUNT; ++i) {
+        _packets[i].init(ts::PID(100 + 37 * (i % PID_COUNT)), 0, uint8_t(i));
+    }
+    for (size_t i = 0; i < PID_COUNT; ++i) {
+        _cc[i] = 0;
+    }
+}
+
+uint64_t TSAnalyzerBench::iterate()
+{
+    for (size_t i = 0; i < COUNT; ++i) {
+        // Keep continuity counters consistent over iterations.
+        const size_t index = i % PID_COUNT;
+        _packets[i].setCC(_cc[index]);
+        _cc[index] = (_cc[index] + 1) & ts::CC_MASK;
+        _analyzer.feedPacket(_packets[i]);
+    }
+    return COUNT * ts::PKT_SIZE;
+}
+
+void TSAnalyzerBench::cleanup()
+{
+    _analyzer.reset();
+    _packets.clear();
+}
+
+TSBENCH_REGISTER(TSAnalyzerBench);
@@ -0,0 +1,94 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Benchmarks for TS packet accessors.
+//
+//----------------------------------------------------------------------------
+
+#include "tsbench.h"
+
+
+//----------------------------------------------------------------------------
+// Read the most frequently used header fields of all packets in a multiplex.
+//----------------------------------------------------------------------------
+
+namespace {
+    const size_t COUNT = 10000;  // Number of packets per iteration.
+
+    class TSPacketAccessBench: public tsbench::Benchmark
+    {
+        TS_NOCOPY(TSPacketAccessBench);
+    public:
+        TSPacketAccessBench();
+        virtual void setup() override;
+        virtual uint64_t iterate() override;
+        virtual void cleanup() override;
+    private:
+        ts::DuckContext    _duck;
+        ts::TSPacketVector _packets;
+        uint64_t           _result;  // Prevent the compiler from optimizing out the accesses.
+    };
+}
+
+TSPacketAccessBench::TSPacketAccessBench() :
+    tsbench::Benchmark(u"packet.accessors", u"TS packet header accessors, 10000 packets"),
+    _duck(),
+    _packets(),
+    _result(0)
+{
+}
+
+void TSPacketAccessBench::setup()
+{
+    tsbench::BuildMultiplex(_duck, _packets, COUNT);
+}
+
+uint64_t TSPacketAccessBench::iterate()
+{
+    for (const auto& pkt : _packets) {
+        _result += pkt.getPID() + pkt.getCC() + pkt.getPayloadSize();
+        if (pkt.getPUSI()) {
+            _result++;
+        }
+        if (pkt.hasPCR()) {
+            _result += pkt.getPCR();
+        }
+        if (pkt.hasPTS()) {
+            _result += pkt.getPTS();
+        }
+    }
+    return _packets.size() * ts::PKT_SIZE;
+}
+
+void TSPacketAccessBench::cleanup()
+{
+    _packets.clear();
+}
+
+TSBENCH_REGISTER(TSPacketAccessBench);
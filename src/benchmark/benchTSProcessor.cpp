@@ -0,0 +1,165 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Benchmarks for end-to-end TSProcessor chains, using memory plugins.
+//
+//----------------------------------------------------------------------------
+
+#include "tsbench.h"
+#include "tsTSProcessor.h"
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventContext.h"
+#include "tsPluginEventData.h"
+#include "tsNullReport.h"
+
+#if defined(TS_WINDOWS)
+    #define NULL_DEVICE u"NUL"
+#else
+    #define NULL_DEVICE u"/dev/null"
+#endif
+
+
+//----------------------------------------------------------------------------
+// Run a complete TSProcessor chain on a multiplex, from memory to memory.
+//----------------------------------------------------------------------------
+
+namespace {
+    const size_t COUNT = 20000;  // Number of packets per iteration.
+
+    class TSProcessorBench: public tsbench::Benchmark
+    {
+        TS_NOBUILD_NOCOPY(TSProcessorBench);
+    public:
+        TSProcessorBench(const ts::UString& name, const ts::UString& description, const ts::PluginOptionsVector& plugins);
+        virtual void setup() override;
+        virtual uint64_t iterate() override;
+        virtual void cleanup() override;
+    private:
+        ts::DuckContext     _duck;
+        ts::TSPacketVector  _packets;
+        ts::TSProcessorArgs _args;
+
+        // Memory input: return all packets from the multiplex, then end of input.
+        class InputHandler: public ts::PluginEventHandlerInterface
+        {
+            TS_NOBUILD_NOCOPY(InputHandler);
+        public:
+            InputHandler(const ts::TSPacketVector& packets) : _packets(packets), _next(0) {}
+            virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+        private:
+            const ts::TSPacketVector& _packets;
+            size_t _next;
+        };
+
+        // Memory output: count output packets.
+        class OutputHandler: public ts::PluginEventHandlerInterface
+        {
+            TS_NOCOPY(OutputHandler);
+        public:
+            OutputHandler() : count(0) {}
+            virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+            size_t count;
+        };
+    };
+}
+
+TSProcessorBench::TSProcessorBench(const ts::UString& name, const ts::UString& description, const ts::PluginOptionsVector& plugins) :
+    tsbench::Benchmark(name, description),
+    _duck(),
+    _packets(),
+    _args()
+{
+    _args.app_name = u"benchmark";
+    _args.input = {u"memory", {}};
+    _args.plugins = plugins;
+    _args.output = {u"memory", {}};
+}
+
+void TSProcessorBench::setup()
+{
+    tsbench::BuildMultiplex(_duck, _packets, COUNT);
+}
+
+uint64_t TSProcessorBench::iterate()
+{
+    InputHandler input(_packets);
+    OutputHandler output;
+    ts::TSProcessor tsp(NULLREP);
+    tsp.registerEventHandler(&input, ts::PluginType::INPUT);
+    tsp.registerEventHandler(&output, ts::PluginType::OUTPUT);
+    if (!tsp.start(_args)) {
+        return 0;
+    }
+    tsp.waitForTermination();
+    return output.count * ts::PKT_SIZE;
+}
+
+void TSProcessorBench::cleanup()
+{
+    _packets.clear();
+}
+
+void TSProcessorBench::InputHandler::handlePluginEvent(const ts::PluginEventContext& context)
+{
+    ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+    if (data != nullptr && _next < _packets.size()) {
+        const size_t count = std::min(_packets.size() - _next, data->maxSize() / ts::PKT_SIZE);
+        data->append(&_packets[_next], count * ts::PKT_SIZE);
+        _next += count;
+    }
+}
+
+void TSProcessorBench::OutputHandler::handlePluginEvent(const ts::PluginEventContext& context)
+{
+    const ts::PluginEventData* data = dynamic_cast<const ts::PluginEventData*>(context.pluginData());
+    if (data != nullptr) {
+        count += data->size() / ts::PKT_SIZE;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Registered benchmarks.
+//----------------------------------------------------------------------------
+
+namespace {
+    class TSProcessorPassThrough: public TSProcessorBench
+    {
+    public:
+        TSProcessorPassThrough() : TSProcessorBench(u"tsp.memory", u"tsp chain: memory input, memory output", {}) {}
+    };
+    class TSProcessorPSI: public TSProcessorBench
+    {
+    public:
+        TSProcessorPSI() : TSProcessorBench(u"tsp.psi", u"tsp chain: memory input, psi, memory output", {{u"psi", {u"--output-file", NULL_DEVICE}}}) {}
+    };
+}
+
+TSBENCH_REGISTER(TSProcessorPassThrough);
+TSBENCH_REGISTER(TSProcessorPSI);
@@ -0,0 +1,111 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Benchmarks for the XML and JSON serialization of tables.
+//
+//----------------------------------------------------------------------------
+
+#include "tsbench.h"
+#include "tsSectionFile.h"
+#include "tsBinaryTable.h"
+
+
+//----------------------------------------------------------------------------
+// Serialization of all tables of a multiplex into one XML or JSON document.
+//----------------------------------------------------------------------------
+
+namespace {
+    class TablesBench: public tsbench::Benchmark
+    {
+        TS_NOBUILD_NOCOPY(TablesBench);
+    public:
+        TablesBench(const ts::UString& name, const ts::UString& description, bool json);
+        virtual void setup() override;
+        virtual uint64_t iterate() override;
+        virtual void cleanup() override;
+    private:
+        bool            _json;
+        ts::DuckContext _duck;
+        ts::SectionFile _file;
+        uint64_t        _size;  // Binary size of all tables.
+    };
+}
+
+TablesBench::TablesBench(const ts::UString& name, const ts::UString& description, bool json) :
+    tsbench::Benchmark(name, description),
+    _json(json),
+    _duck(),
+    _file(_duck),
+    _size(0)
+{
+}
+
+void TablesBench::setup()
+{
+    ts::BinaryTablePtrVector tables;
+    tsbench::BuildTables(_duck, tables);
+    _file.clear();
+    _file.add(tables);
+    _size = 0;
+    for (const auto& table : tables) {
+        _size += table->totalSize();
+    }
+}
+
+uint64_t TablesBench::iterate()
+{
+    const ts::UString text(_json ? _file.toJSON() : _file.toXML());
+    return text.empty() ? 0 : _size;
+}
+
+void TablesBench::cleanup()
+{
+    _file.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Registered benchmarks.
+//----------------------------------------------------------------------------
+
+namespace {
+    class TablesXML: public TablesBench
+    {
+    public:
+        TablesXML() : TablesBench(u"tables.xml", u"Tables of a multiplex to XML text", false) {}
+    };
+    class TablesJSON: public TablesBench
+    {
+    public:
+        TablesJSON() : TablesBench(u"tables.json", u"Tables of a multiplex to JSON text", true) {}
+    };
+}
+
+TSBENCH_REGISTER(TablesXML);
+TSBENCH_REGISTER(TablesJSON);
@@ -0,0 +1,210 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Performance benchmarks driver program.
+//
+//  Maintenance note:
+//    There is no need to modify this code when a new benchmark is added
+//    (a new source file in the same directory). Each benchmark is
+//    automatically registered using the macro TSBENCH_REGISTER.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMain.h"
+#include "tsbench.h"
+#include "tsMonotonic.h"
+#include "tsSysInfo.h"
+#include "tsVersionInfo.h"
+#include "tsjsonObject.h"
+#include "tsjsonArray.h"
+TS_MAIN(MainCode);
+
+// Benchmarks always use the static library, enforce a reference to MPEG/DVB structures and plugins.
+#include "tsStaticReferencesDVB.h"
+const ts::StaticReferencesDVB dependenciesForStaticLib;
+
+
+//----------------------------------------------------------------------------
+// Command line options
+//----------------------------------------------------------------------------
+
+namespace {
+    class Options: public ts::Args
+    {
+        TS_NOBUILD_NOCOPY(Options);
+    public:
+        Options(int argc, char *argv[]);
+
+        ts::UStringVector names;     // Benchmark names or prefixes to run.
+        ts::MilliSecond   duration;  // Minimum measurement duration per benchmark.
+        bool              list;      // List benchmarks, do not run them.
+        bool              json;      // Produce a JSON report.
+        ts::UString       json_file; // JSON report file name, standard output if empty.
+    };
+}
+
+Options::Options(int argc, char *argv[]) :
+    ts::Args(u"Run TSDuck performance benchmarks", u"[options] [name-prefix ...]"),
+    names(),
+    duration(0),
+    list(false),
+    json(false),
+    json_file()
+{
+    option(u"", 0, STRING, 0, UNLIMITED_COUNT);
+    help(u"",
+         u"Names or name prefixes of the benchmarks to run. "
+         u"By default, all benchmarks are run.");
+
+    option(u"duration", 'd', POSITIVE);
+    help(u"duration", u"milliseconds",
+         u"Minimum measurement duration of each benchmark. The default is 1000 milliseconds.");
+
+    option(u"json", 'j', STRING, 0, 1, 0, UNLIMITED_VALUE, true);
+    help(u"json", u"filename",
+         u"Produce a JSON report of all results in the specified file. "
+         u"If the file name is omitted or '-', the JSON report is written on the standard output "
+         u"and the text report is written on the standard error. "
+         u"The JSON report is designed to be archived and compared between releases.");
+
+    option(u"list", 'l');
+    help(u"list", u"List all benchmarks, do not run them.");
+
+    analyze(argc, argv);
+
+    getValues(names, u"");
+    duration = intValue<ts::MilliSecond>(u"duration", 1000);
+    list = present(u"list");
+    json = present(u"json");
+    getValue(json_file, u"json");
+
+    exitOnError();
+}
+
+
+//----------------------------------------------------------------------------
+// Check if a benchmark is selected on the command line.
+//----------------------------------------------------------------------------
+
+namespace {
+    bool IsSelected(const Options& opt, const tsbench::Benchmark& bench)
+    {
+        if (opt.names.empty()) {
+            return true;
+        }
+        for (const auto& prefix : opt.names) {
+            if (bench.name().startWith(prefix, ts::CASE_INSENSITIVE)) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Program entry point
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    Options opt(argc, argv);
+
+    if (opt.list) {
+        for (const auto bench : tsbench::Repository::All()) {
+            std::cout << ts::UString::Format(u"%-30s %s", {bench->name(), bench->description()}) << std::endl;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    // When the JSON report goes to the standard output, the text report goes to the standard error.
+    std::ostream& out(opt.json && (opt.json_file.empty() || opt.json_file == u"-") ? std::cerr : std::cout);
+
+    const ts::SysInfo* sys = ts::SysInfo::Instance();
+    out << "System: " << sys->systemVersion() << ", CPU: " << sys->cpuName()
+        << ", CRC acceleration: " << ts::UString::YesNo(sys->crcInstructions())
+        << ", AES acceleration: " << ts::UString::YesNo(sys->aesInstructions()) << std::endl;
+
+    // Global description of the JSON report.
+    ts::json::Object report;
+    ts::json::ValuePtr results(new ts::json::Array);
+    report.add(u"version", ts::VersionInfo::GetVersion());
+    report.add(u"system", sys->systemVersion());
+    report.add(u"cpu", sys->cpuName());
+    report.add(u"crc-acceleration", ts::json::Bool(sys->crcInstructions()));
+    report.add(u"aes-acceleration", ts::json::Bool(sys->aesInstructions()));
+    report.add(u"duration-ms", opt.duration);
+    report.add(u"benchmarks", results);
+
+    for (const auto bench : tsbench::Repository::All()) {
+        if (!IsSelected(opt, *bench)) {
+            continue;
+        }
+
+        // Setup and one warm-up iteration, outside measurement.
+        bench->setup();
+        bench->iterate();
+
+        // Run iterations for the minimum duration.
+        const ts::NanoSecond min_ns = opt.duration * ts::NanoSecPerMilliSec;
+        uint64_t iterations = 0;
+        uint64_t bytes = 0;
+        ts::NanoSecond elapsed = 0;
+        const ts::Monotonic start(true);
+        do {
+            bytes += bench->iterate();
+            iterations++;
+            elapsed = ts::Monotonic(true) - start;
+        } while (elapsed < min_ns);
+
+        bench->cleanup();
+
+        // Report results.
+        const double ns_per_iter = double(elapsed) / double(iterations);
+        ts::UString line(ts::UString::Format(u"%-30s %12'd iterations %12.3f ns/iter", {bench->name(), iterations, ns_per_iter}));
+        if (bytes > 0) {
+            line.append(ts::UString::Format(u" %10.1f MB/s", {(double(bytes) * 1000.0) / double(elapsed)}));
+        }
+        out << line << std::endl;
+
+        // Add results in JSON report. JSON numbers are integers, use nanoseconds and bytes per second.
+        ts::json::ValuePtr res(new ts::json::Object);
+        res->add(u"name", bench->name());
+        res->add(u"description", bench->description());
+        res->add(u"iterations", int64_t(iterations));
+        res->add(u"elapsed-ns", elapsed);
+        res->add(u"ns-per-iteration", int64_t(ns_per_iter + 0.5));
+        res->add(u"bytes", int64_t(bytes));
+        res->add(u"bytes-per-second", int64_t((double(bytes) * 1000000000.0) / double(elapsed)));
+        results->set(res);
+    }
+
+    // The JSON report is saved after all benchmarks. Errors are reported by save().
+    return !opt.json || report.save(opt.json_file, 2, true, opt) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
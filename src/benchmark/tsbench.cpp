@@ -0,0 +1,265 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Minimal framework for TSDuck performance benchmarks.
+//
+//----------------------------------------------------------------------------
+
+#include "tsbench.h"
+#include "tsCyclingPacketizer.h"
+#include "tsPESStreamPacketizer.h"
+#include "tsBinaryTable.h"
+#include "tsPAT.h"
+#include "tsPMT.h"
+#include "tsSDT.h"
+#include "tsEIT.h"
+#include "tsShortEventDescriptor.h"
+#include "tsISO639LanguageDescriptor.h"
+
+
+//----------------------------------------------------------------------------
+// Base class for all benchmarks.
+//----------------------------------------------------------------------------
+
+tsbench::Benchmark::Benchmark(const ts::UString& name, const ts::UString& description) :
+    _name(name),
+    _description(description)
+{
+}
+
+tsbench::Benchmark::~Benchmark()
+{
+}
+
+void tsbench::Benchmark::setup()
+{
+}
+
+void tsbench::Benchmark::cleanup()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Repository of all registered benchmarks.
+//----------------------------------------------------------------------------
+
+std::vector<tsbench::Benchmark*>& tsbench::Repository::Instances()
+{
+    // Function-local static: safe against static initialization order.
+    static std::vector<Benchmark*> instances;
+    return instances;
+}
+
+const std::vector<tsbench::Benchmark*>& tsbench::Repository::All()
+{
+    return Instances();
+}
+
+tsbench::Repository::Register::Register(Benchmark* bench)
+{
+    std::vector<Benchmark*>& list(Instances());
+    std::vector<Benchmark*>::iterator it(list.begin());
+    while (it != list.end() && (*it)->name() < bench->name()) {
+        ++it;
+    }
+    list.insert(it, bench);
+}
+
+
+//----------------------------------------------------------------------------
+// Synthetic DVB multiplex.
+//----------------------------------------------------------------------------
+
+namespace {
+    const uint16_t TS_ID = 1;
+    const uint16_t NETWORK_ID = 0x20FA;
+    const size_t   SERVICE_COUNT = 4;
+    const ts::PID  PMT_PID_BASE = 0x0100;
+    const ts::PID  VIDEO_PID_BASE = 0x0200;
+    const ts::PID  AUDIO_PID_BASE = 0x0300;
+    const size_t   VIDEO_PES_SIZE = 32 * 1024;  // Typical AVC frame at 8 Mb/s.
+    const size_t   AUDIO_PES_SIZE = 1152;       // Typical MPEG-1 layer II frame at 384 kb/s.
+    const uint64_t PTS_PER_FRAME = 3600;        // 25 frames per second.
+    const uint64_t PTS_START = 90000;           // First PTS, one second.
+    const uint64_t PCR_DELAY = 45000;           // PCR is 500 ms ahead of PTS.
+
+    // Serialize a table and add it in a list of binary tables.
+    void AddTable(ts::DuckContext& duck, ts::BinaryTablePtrVector& tables, const ts::AbstractTable& table)
+    {
+        ts::BinaryTablePtr bin(new ts::BinaryTable);
+        table.serialize(duck, *bin);
+        tables.push_back(bin);
+    }
+
+    // Build the binary content of a PES packet. The payload does not contain unexpected start codes.
+    void BuildPES(ts::ByteBlock& pes, uint8_t stream_id, size_t size, uint64_t pts, const ts::ByteBlock& es_header)
+    {
+        pes.resize(size);
+        pes[0] = 0x00;
+        pes[1] = 0x00;
+        pes[2] = 0x01;
+        pes[3] = stream_id;
+        ts::PutUInt16(&pes[4], uint16_t(size - 6));
+        pes[6] = 0x80;
+        pes[7] = 0x80;  // PTS only
+        pes[8] = 0x05;  // PES header data length
+        pes[9] = uint8_t(0x21 | ((pts >> 29) & 0x0E));
+        ts::PutUInt16(&pes[10], uint16_t(0x0001 | ((pts >> 14) & 0xFFFE)));
+        ts::PutUInt16(&pes[12], uint16_t(0x0001 | ((pts << 1) & 0xFFFE)));
+        ::memcpy(&pes[14], es_header.data(), es_header.size());
+        for (size_t i = 14 + es_header.size(); i < size; ++i) {
+            pes[i] = uint8_t(i * 13 + 7) | 0x01;
+        }
+    }
+}
+
+void tsbench::BuildTables(ts::DuckContext& duck, ts::BinaryTablePtrVector& tables)
+{
+    tables.clear();
+
+    ts::PAT pat(0, true, TS_ID);
+    ts::SDT sdt(true, 0, true, TS_ID, NETWORK_ID);
+    const ts::Time start(2021, 6, 1, 20, 0);
+
+    for (size_t i = 0; i < SERVICE_COUNT; ++i) {
+        const uint16_t service_id = uint16_t(i + 1);
+        const ts::PID video_pid = ts::PID(VIDEO_PID_BASE + i);
+        const ts::PID audio_pid = ts::PID(AUDIO_PID_BASE + i);
+        const ts::UString name(ts::UString::Format(u"Service %d", {service_id}));
+
+        pat.pmts[service_id] = ts::PID(PMT_PID_BASE + i);
+
+        ts::PMT pmt(0, true, service_id, video_pid);
+        pmt.streams[video_pid].stream_type = ts::ST_AVC_VIDEO;
+        pmt.streams[audio_pid].stream_type = ts::ST_MPEG1_AUDIO;
+        pmt.streams[audio_pid].descs.add(duck, ts::ISO639LanguageDescriptor(u"eng", 0));
+        AddTable(duck, tables, pmt);
+
+        sdt.services[service_id].setName(duck, name);
+        sdt.services[service_id].setProvider(duck, u"TSDuck");
+        sdt.services[service_id].running_status = 4;
+
+        ts::EIT eit(true, true, 0, 0, true, service_id, TS_ID, NETWORK_ID);
+        for (uint16_t ev = 0; ev < 2; ++ev) {
+            ts::EIT::Event& event(eit.events.newEntry());
+            event.event_id = uint16_t(service_id * 100 + ev);
+            event.start_time = start + ev * ts::MilliSecPerHour;
+            event.duration = 3600;
+            event.running_status = ev == 0 ? 4 : 1;
+            event.descs.add(duck, ts::ShortEventDescriptor(u"eng", ts::UString::Format(u"Event %d on %s", {ev, name}), u"Synthetic event for benchmarks"));
+        }
+        AddTable(duck, tables, eit);
+    }
+
+    AddTable(duck, tables, pat);
+    AddTable(duck, tables, sdt);
+}
+
+void tsbench::BuildMultiplex(ts::DuckContext& duck, ts::TSPacketVector& packets, size_t count)
+{
+    packets.resize(count);
+
+    // One cycling packetizer per PSI/SI PID.
+    ts::BinaryTablePtrVector tables;
+    BuildTables(duck, tables);
+    ts::CyclingPacketizer pat(duck, ts::PID_PAT, ts::CyclingPacketizer::StuffingPolicy::NEVER);
+    ts::CyclingPacketizer sdt(duck, ts::PID_SDT, ts::CyclingPacketizer::StuffingPolicy::NEVER);
+    ts::CyclingPacketizer eit(duck, ts::PID_EIT, ts::CyclingPacketizer::StuffingPolicy::NEVER);
+    std::vector<ts::CyclingPacketizer*> pmt;
+    for (size_t i = 0; i < SERVICE_COUNT; ++i) {
+        pmt.push_back(new ts::CyclingPacketizer(duck, ts::PID(PMT_PID_BASE + i), ts::CyclingPacketizer::StuffingPolicy::NEVER));
+    }
+    for (const auto& table : tables) {
+        switch (table->tableId()) {
+            case ts::TID_PAT: pat.addTable(*table); break;
+            case ts::TID_SDT_ACT: sdt.addTable(*table); break;
+            case ts::TID_EIT_PF_ACT: eit.addTable(*table); break;
+            case ts::TID_PMT: pmt[table->tableIdExtension() - 1]->addTable(*table); break;
+            default: break;
+        }
+    }
+
+    // One PES packetizer per video and audio PID.
+    std::vector<ts::PESStreamPacketizer*> video;
+    std::vector<ts::PESStreamPacketizer*> audio;
+    for (size_t i = 0; i < SERVICE_COUNT; ++i) {
+        video.push_back(new ts::PESStreamPacketizer(duck, ts::PID(VIDEO_PID_BASE + i)));
+        audio.push_back(new ts::PESStreamPacketizer(duck, ts::PID(AUDIO_PID_BASE + i)));
+    }
+
+    // Elementary stream headers: AVC access unit delimiter and non-IDR slice, MPEG audio frame header.
+    const ts::ByteBlock avc_header({0x00, 0x00, 0x00, 0x01, 0x09, 0xF0, 0x00, 0x00, 0x01, 0x41});
+    const ts::ByteBlock mpa_header({0xFF, 0xFD, 0xC4, 0x00});
+    std::vector<uint64_t> video_pts(SERVICE_COUNT, PTS_START);
+    std::vector<uint64_t> audio_pts(SERVICE_COUNT, PTS_START);
+    ts::ByteBlock pes;
+
+    // Repeated pattern of 100 packets: 8 PSI/SI packets, 9 audio packets, 83 video packets.
+    for (size_t n = 0; n < count; ++n) {
+        const size_t slot = n % 100;
+        const size_t srv = n % SERVICE_COUNT;
+        if (slot == 0) {
+            pat.getNextPacket(packets[n]);
+        }
+        else if (slot <= SERVICE_COUNT) {
+            pmt[slot - 1]->getNextPacket(packets[n]);
+        }
+        else if (slot == SERVICE_COUNT + 1) {
+            sdt.getNextPacket(packets[n]);
+        }
+        else if (slot < 8) {
+            eit.getNextPacket(packets[n]);
+        }
+        else if (slot % 10 == 9) {
+            if (audio[srv]->empty()) {
+                BuildPES(pes, 0xC0, AUDIO_PES_SIZE, audio_pts[srv], mpa_header);
+                audio[srv]->addPES(ts::PESPacketPtr(new ts::PESPacket(pes, audio[srv]->getPID())));
+                audio_pts[srv] += PTS_PER_FRAME;
+            }
+            audio[srv]->getNextPacket(packets[n]);
+        }
+        else {
+            if (video[srv]->empty()) {
+                BuildPES(pes, 0xE0, VIDEO_PES_SIZE, video_pts[srv], avc_header);
+                ts::PESPacketPtr pp(new ts::PESPacket(pes, video[srv]->getPID()));
+                pp->setPCR((video_pts[srv] - PCR_DELAY) * ts::SYSTEM_CLOCK_SUBFACTOR);
+                video[srv]->addPES(pp);
+                video_pts[srv] += PTS_PER_FRAME;
+            }
+            video[srv]->getNextPacket(packets[n]);
+        }
+    }
+
+    for (size_t i = 0; i < SERVICE_COUNT; ++i) {
+        delete pmt[i];
+        delete video[i];
+        delete audio[i];
+    }
+}
@@ -0,0 +1,157 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Minimal framework for TSDuck performance benchmarks.
+//!
+//!  Each benchmark is a subclass of tsbench::Benchmark which is registered
+//!  using the macro TSBENCH_REGISTER. The benchmark driver program repeatedly
+//!  executes the method iterate() during a minimum duration and reports the
+//!  average execution time of one iteration and the corresponding throughput.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsUString.h"
+#include "tsTSPacket.h"
+#include "tsTablesPtr.h"
+#include "tsDuckContext.h"
+
+namespace tsbench {
+    //!
+    //! Base class for all benchmarks.
+    //!
+    class Benchmark
+    {
+        TS_NOBUILD_NOCOPY(Benchmark);
+    public:
+        //!
+        //! Constructor.
+        //! @param [in] name Benchmark name, typically "module.operation".
+        //! @param [in] description One-line description.
+        //!
+        Benchmark(const ts::UString& name, const ts::UString& description);
+
+        //!
+        //! Virtual destructor.
+        //!
+        virtual ~Benchmark();
+
+        //!
+        //! Get the benchmark name.
+        //! @return The benchmark name.
+        //!
+        const ts::UString& name() const { return _name; }
+
+        //!
+        //! Get the benchmark description.
+        //! @return The benchmark description.
+        //!
+        const ts::UString& description() const { return _description; }
+
+        //!
+        //! Prepare the data before the measurement. Not included in the measured time.
+        //!
+        virtual void setup();
+
+        //!
+        //! Execute one iteration of the benchmark.
+        //! @return Number of processed bytes in this iteration, zero if not applicable.
+        //!
+        virtual uint64_t iterate() = 0;
+
+        //!
+        //! Release the data after the measurement. Not included in the measured time.
+        //!
+        virtual void cleanup();
+
+    private:
+        ts::UString _name;
+        ts::UString _description;
+    };
+
+    //!
+    //! Repository of all registered benchmarks.
+    //!
+    class Repository
+    {
+        TS_NOCOPY(Repository);
+    public:
+        //!
+        //! Get the list of registered benchmarks, sorted by name.
+        //! @return A constant reference to the list of registered benchmarks.
+        //!
+        static const std::vector<Benchmark*>& All();
+
+        //!
+        //! Register a benchmark. Used by the macro TSBENCH_REGISTER.
+        //!
+        class Register
+        {
+            TS_NOBUILD_NOCOPY(Register);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] bench A benchmark instance. Never deleted.
+            //!
+            Register(Benchmark* bench);
+        };
+
+    private:
+        Repository() = delete;
+        static std::vector<Benchmark*>& Instances();
+    };
+
+    //!
+    //! Build the signalization tables of a synthetic DVB multiplex.
+    //! The multiplex contains 4 services. The tables are a PAT, one PMT per service,
+    //! an SDT Actual and one EIT present/following Actual per service.
+    //! @param [in,out] duck TSDuck execution context.
+    //! @param [out] tables Returned binary tables.
+    //!
+    void BuildTables(ts::DuckContext& duck, ts::BinaryTablePtrVector& tables);
+
+    //!
+    //! Build a synthetic DVB multiplex.
+    //! The multiplex contains the tables from BuildTables() and, for each service,
+    //! one AVC video and one MPEG audio PES stream. PCR's are carried in the video PID's.
+    //! The content of the transport stream is always identical for a given packet count.
+    //! @param [in,out] duck TSDuck execution context.
+    //! @param [out] packets Returned TS packets.
+    //! @param [in] count Number of TS packets to generate.
+    //!
+    void BuildMultiplex(ts::DuckContext& duck, ts::TSPacketVector& packets, size_t count);
+}
+
+//!
+//! Register a benchmark class.
+//! @param classname Benchmark class name, with a default constructor.
+//!
+#define TSBENCH_REGISTER(classname) \
+    static const tsbench::Repository::Register TS_UNIQUE_NAME(_Registrar)(new classname)
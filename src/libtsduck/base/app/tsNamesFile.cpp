@@ -34,6 +34,31 @@
 #include "tsMutex.h"
 #include "tsGuardMutex.h"
 #include "tsSingletonManager.h"
+#include "tsMemory.h"
+#include "tsTime.h"
+
+const ts::UString ts::NamesFile::INDEX_SUFFIX(u".bin");
+
+
+//----------------------------------------------------------------------------
+// Layout of a precompiled binary index (all integers in big endian).
+//
+// - Header: magic (8 bytes), version, number of sections, number of entries,
+//   size of string pool (all 32 bits), size of source ".names" file (64 bits).
+// - Sections, sorted by lower-case name (UTF-8 binary order): name offset,
+//   name size, bits, index of first entry, number of entries (all 32 bits).
+// - Entries, sorted by first value inside each section: first value, last
+//   value (64 bits), name offset, name size (32 bits).
+// - String pool: UTF-8 names, without terminating nul.
+//----------------------------------------------------------------------------
+
+namespace {
+    const char   INDEX_MAGIC[8] = {'T', 'S', 'N', 'A', 'M', 'I', 'D', 'X'};
+    const uint32_t INDEX_VERSION = 1;
+    const size_t INDEX_HEADER_SIZE = 32;
+    const size_t INDEX_SECTION_SIZE = 20;
+    const size_t INDEX_ENTRY_SIZE = 24;
+}
 
 
 //----------------------------------------------------------------------------
@@ -227,18 +252,24 @@ void ts::NamesFile::UnregisterExtensionFile(const UString& filename)
 // Constructor (load the configuration file).
 //----------------------------------------------------------------------------
 
-ts::NamesFile::NamesFile(const UString& fileName, bool mergeExtensions) :
+ts::NamesFile::NamesFile(const UString& fileName, bool mergeExtensions, bool useIndex) :
     _log(CERR),
     _configFile(SearchConfigurationFile(fileName)),
     _configErrors(0),
-    _sections()
+    _sections(),
+    _index_data(nullptr),
+    _index_size(0)
+#if defined(TS_WINDOWS)
+    , _index_buffer()
+#endif
 {
     // Locate the configuration file.
     if (_configFile.empty()) {
         // Cannot load configuration, names will not be available.
         _log.error(u"configuration file '%s' not found", {fileName});
     }
-    else {
+    else if (!useIndex || !loadIndex(_configFile + INDEX_SUFFIX, _configFile)) {
+        // No usable precompiled index, parse the text file.
         loadFile(_configFile);
     }
 
@@ -386,6 +417,230 @@ ts::NamesFile::~NamesFile()
         delete it->second;
     }
     _sections.clear();
+    unloadIndex();
+}
+
+
+//----------------------------------------------------------------------------
+// Map a precompiled binary index of a configuration file.
+//----------------------------------------------------------------------------
+
+bool ts::NamesFile::loadIndex(const UString& indexName, const UString& configName)
+{
+    // The index must exist and must not be older than its source file.
+    if (!FileExists(indexName) || GetFileModificationTimeUTC(indexName) < GetFileModificationTimeUTC(configName)) {
+        return false;
+    }
+    const int64_t fileSize = GetFileSize(indexName);
+    if (fileSize < int64_t(INDEX_HEADER_SIZE)) {
+        _log.debug(u"invalid names index %s", {indexName});
+        return false;
+    }
+
+#if defined(TS_WINDOWS)
+    // No memory mapping on Windows, load the index in memory.
+    if (!_index_buffer.loadFromFile(indexName, size_t(fileSize), &_log)) {
+        return false;
+    }
+    _index_data = _index_buffer.data();
+    _index_size = _index_buffer.size();
+#else
+    // Map the complete index in memory.
+    const int fd = ::open(indexName.toUTF8().c_str(), O_RDONLY);
+    if (fd < 0) {
+        _log.debug(u"cannot open names index %s", {indexName});
+        return false;
+    }
+    void* addr = ::mmap(nullptr, size_t(fileSize), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        _log.debug(u"cannot map names index %s", {indexName});
+        return false;
+    }
+    _index_data = reinterpret_cast<const uint8_t*>(addr);
+    _index_size = size_t(fileSize);
+#endif
+
+    // Check the consistency of the index.
+    const size_t sectionCount = GetUInt32(_index_data + 12);
+    const size_t entryCount = GetUInt32(_index_data + 16);
+    const size_t stringSize = GetUInt32(_index_data + 20);
+    const bool valid =
+        ::memcmp(_index_data, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0 &&
+        GetUInt32(_index_data + 8) == INDEX_VERSION &&
+        _index_size == INDEX_HEADER_SIZE + sectionCount * INDEX_SECTION_SIZE + entryCount * INDEX_ENTRY_SIZE + stringSize &&
+        int64_t(GetUInt64(_index_data + 24)) == GetFileSize(configName);
+
+    if (!valid) {
+        _log.debug(u"invalid or obsolete names index %s", {indexName});
+        unloadIndex();
+        return false;
+    }
+    _log.debug(u"using names index %s", {indexName});
+    return true;
+}
+
+void ts::NamesFile::unloadIndex()
+{
+#if defined(TS_WINDOWS)
+    _index_buffer.clear();
+#else
+    if (_index_data != nullptr) {
+        ::munmap(const_cast<uint8_t*>(_index_data), _index_size);
+    }
+#endif
+    _index_data = nullptr;
+    _index_size = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Save the names which were loaded from text files into a binary index.
+//----------------------------------------------------------------------------
+
+bool ts::NamesFile::saveIndex(const UString& fileName, Report& report) const
+{
+    if (_configFile.empty()) {
+        report.error(u"no names file loaded, cannot create %s", {fileName});
+        return false;
+    }
+    if (_index_data != nullptr) {
+        report.error(u"names were loaded from an index, cannot create %s", {fileName});
+        return false;
+    }
+
+    // Sort sections by UTF-8 name, the order which is used by the binary search.
+    std::vector<std::pair<std::string, const ConfigSection*>> sections;
+    sections.reserve(_sections.size());
+    for (auto it = _sections.begin(); it != _sections.end(); ++it) {
+        sections.push_back(std::make_pair(it->first.toUTF8(), it->second));
+    }
+    std::sort(sections.begin(), sections.end(),
+              [](const std::pair<std::string, const ConfigSection*>& a, const std::pair<std::string, const ConfigSection*>& b) { return a.first < b.first; });
+
+    // Build the three parts of the index.
+    ByteBlock sectionTable;
+    ByteBlock entryTable;
+    ByteBlock strings;
+    size_t entryCount = 0;
+    for (auto sec = sections.begin(); sec != sections.end(); ++sec) {
+        sectionTable.appendUInt32(uint32_t(strings.size()));
+        sectionTable.appendUInt32(uint32_t(sec->first.size()));
+        sectionTable.appendUInt32(uint32_t(sec->second->bits));
+        sectionTable.appendUInt32(uint32_t(entryCount));
+        sectionTable.appendUInt32(uint32_t(sec->second->entries.size()));
+        strings.append(sec->first);
+        for (auto ent = sec->second->entries.begin(); ent != sec->second->entries.end(); ++ent) {
+            const std::string name(ent->second->name.toUTF8());
+            entryTable.appendUInt64(ent->first);
+            entryTable.appendUInt64(ent->second->last);
+            entryTable.appendUInt32(uint32_t(strings.size()));
+            entryTable.appendUInt32(uint32_t(name.size()));
+            strings.append(name);
+            entryCount++;
+        }
+    }
+
+    // Build the complete index.
+    ByteBlock index;
+    index.reserve(INDEX_HEADER_SIZE + sectionTable.size() + entryTable.size() + strings.size());
+    index.append(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    index.appendUInt32(INDEX_VERSION);
+    index.appendUInt32(uint32_t(sections.size()));
+    index.appendUInt32(uint32_t(entryCount));
+    index.appendUInt32(uint32_t(strings.size()));
+    index.appendUInt64(uint64_t(GetFileSize(_configFile)));
+    assert(index.size() == INDEX_HEADER_SIZE);
+    index.append(sectionTable);
+    index.append(entryTable);
+    index.append(strings);
+
+    return index.saveToFile(fileName, &report);
+}
+
+
+//----------------------------------------------------------------------------
+// Locate a section in the binary index.
+//----------------------------------------------------------------------------
+
+bool ts::NamesFile::findIndexSection(const UString& sectionName, size_t& first_entry, size_t& entry_count, size_t& bits) const
+{
+    if (_index_data == nullptr) {
+        return false;
+    }
+
+    const std::string name(sectionName.toUTF8());
+    const size_t sectionCount = GetUInt32(_index_data + 12);
+    const size_t entryCount = GetUInt32(_index_data + 16);
+    const size_t stringSize = GetUInt32(_index_data + 20);
+    const uint8_t* const sections = _index_data + INDEX_HEADER_SIZE;
+    const char* const strings = reinterpret_cast<const char*>(_index_data + INDEX_HEADER_SIZE + sectionCount * INDEX_SECTION_SIZE + entryCount * INDEX_ENTRY_SIZE);
+
+    // Binary search on section names.
+    size_t low = 0;
+    size_t high = sectionCount;
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        const uint8_t* const sec = sections + mid * INDEX_SECTION_SIZE;
+        const size_t offset = GetUInt32(sec);
+        const size_t size = GetUInt32(sec + 4);
+        if (offset + size > stringSize) {
+            return false; // corrupted index
+        }
+        const int cmp = name.compare(0, std::string::npos, strings + offset, size);
+        if (cmp < 0) {
+            high = mid;
+        }
+        else if (cmp > 0) {
+            low = mid + 1;
+        }
+        else {
+            bits = GetUInt32(sec + 8);
+            first_entry = GetUInt32(sec + 12);
+            entry_count = GetUInt32(sec + 16);
+            return first_entry + entry_count <= entryCount;
+        }
+    }
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Get a name from the binary index, empty if not found.
+//----------------------------------------------------------------------------
+
+ts::UString ts::NamesFile::getIndexName(size_t first_entry, size_t entry_count, Value val) const
+{
+    const size_t sectionCount = GetUInt32(_index_data + 12);
+    const size_t entryCount = GetUInt32(_index_data + 16);
+    const size_t stringSize = GetUInt32(_index_data + 20);
+    const uint8_t* const entries = _index_data + INDEX_HEADER_SIZE + sectionCount * INDEX_SECTION_SIZE + first_entry * INDEX_ENTRY_SIZE;
+    const char* const strings = reinterpret_cast<const char*>(_index_data + INDEX_HEADER_SIZE + sectionCount * INDEX_SECTION_SIZE + entryCount * INDEX_ENTRY_SIZE);
+
+    // Find the last entry with a first value lower than or equal to 'val'.
+    size_t low = 0;
+    size_t high = entry_count;
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        if (GetUInt64(entries + mid * INDEX_ENTRY_SIZE) <= val) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    if (low == 0) {
+        return UString();
+    }
+
+    // Now 'val' is possibly in the range of entry low-1.
+    const uint8_t* const ent = entries + (low - 1) * INDEX_ENTRY_SIZE;
+    const size_t offset = GetUInt32(ent + 16);
+    const size_t size = GetUInt32(ent + 20);
+    if (val > GetUInt64(ent + 8) || offset + size > stringSize) {
+        return UString();
+    }
+    return UString::FromUTF8(strings + offset, size);
 }
 
 
@@ -586,9 +841,40 @@ ts::UString ts::NamesFile::Formatted(Value value, const UString& name, NamesFlag
 
 bool ts::NamesFile::nameExists(const UString& sectionName, Value value) const
 {
-    // Get the section, normalize the section name.
-    ConfigSectionMap::const_iterator it = _sections.find(sectionName.toTrimmed().toLower());
-    return it != _sections.end() && !it->second->getName(value).empty();
+    size_t bits = 0;
+    return !getName(sectionName.toTrimmed().toLower(), value, bits).empty();
+}
+
+
+//----------------------------------------------------------------------------
+// Get a name from the text section or the binary index, empty if not found.
+//----------------------------------------------------------------------------
+
+ts::UString ts::NamesFile::getName(const UString& sectionName, Value value, size_t& bits) const
+{
+    UString name;
+    bits = 0;
+
+    // Extension files are always loaded as text, look there first.
+    const ConfigSectionMap::const_iterator it = _sections.find(sectionName);
+    if (it != _sections.end()) {
+        name = it->second->getName(value);
+        bits = it->second->bits;
+    }
+
+    // Then look into the binary index, if any.
+    size_t first_entry = 0;
+    size_t entry_count = 0;
+    size_t index_bits = 0;
+    if (findIndexSection(sectionName, first_entry, entry_count, index_bits)) {
+        if (bits == 0) {
+            bits = index_bits;
+        }
+        if (name.empty()) {
+            name = getIndexName(first_entry, entry_count, value);
+        }
+    }
+    return name;
 }
 
 
@@ -598,17 +884,9 @@ bool ts::NamesFile::nameExists(const UString& sectionName, Value value) const
 
 ts::UString ts::NamesFile::nameFromSection(const UString& sectionName, Value value, NamesFlags flags, size_t bits, Value alternateValue) const
 {
-    // Get the section, normalize the section name.
-    ConfigSectionMap::const_iterator it = _sections.find(sectionName.toTrimmed().toLower());
-    const ConfigSection* section = it == _sections.end() ? nullptr : it->second;
-
-    if (section == nullptr) {
-        // Non-existent section, no name.
-        return Formatted(value, UString(), flags, bits, alternateValue);
-    }
-    else {
-        return Formatted(value, section->getName(value), flags, bits != 0 ? bits : section->bits, alternateValue);
-    }
+    size_t sectionBits = 0;
+    const UString name(getName(sectionName.toTrimmed().toLower(), value, sectionBits));
+    return Formatted(value, name, flags, bits != 0 ? bits : sectionBits, alternateValue);
 }
 
 
@@ -618,23 +896,15 @@ ts::UString ts::NamesFile::nameFromSection(const UString& sectionName, Value val
 
 ts::UString ts::NamesFile::nameFromSectionWithFallback(const UString& sectionName, Value value1, Value value2, NamesFlags flags, size_t bits, Value alternateValue) const
 {
-    // Get the section, normalize the section name.
-    ConfigSectionMap::const_iterator it = _sections.find(sectionName.toTrimmed().toLower());
-    const ConfigSection* section = it == _sections.end() ? nullptr : it->second;
-
-    if (section == nullptr) {
-        // Non-existent section, no name.
-        return Formatted(value1, UString(), flags, bits, alternateValue);
+    const UString section(sectionName.toTrimmed().toLower());
+    size_t sectionBits = 0;
+    const UString name(getName(section, value1, sectionBits));
+    if (!name.empty()) {
+        // value1 has a name
+        return Formatted(value1, name, flags, bits != 0 ? bits : sectionBits, alternateValue);
     }
     else {
-        const UString name(section->getName(value1));
-        if (!name.empty()) {
-            // value1 has a name
-            return Formatted(value1, name, flags, bits != 0 ? bits : section->bits, alternateValue);
-        }
-        else {
-            // value1 has no name, use value2.
-            return Formatted(value2, section->getName(value2), flags, bits != 0 ? bits : section->bits, alternateValue);
-        }
+        // value1 has no name, use value2.
+        return Formatted(value2, getName(section, value2, sectionBits), flags, bits != 0 ? bits : sectionBits, alternateValue);
     }
 }
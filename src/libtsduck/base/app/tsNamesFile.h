@@ -34,6 +34,7 @@
 
 #pragma once
 #include "tsUString.h"
+#include "tsByteBlock.h"
 #include "tsEnumUtils.h"
 #include "tsReport.h"
 #include "tsVersionInfo.h"
@@ -76,10 +77,14 @@ namespace ts {
         //! @param [in] fileName Configuration file name. Typically without directory name.
         //! Without directory, the file is automatically searched in the TSDuck configuration directory.
         //! @param [in] mergeExtensions If true, merge the content of names files from TSDuck extensions.
+        //! @param [in] useIndex If true and a valid precompiled binary index (same file name with
+        //! an additional INDEX_SUFFIX) is found next to the configuration file, the index is mapped
+        //! in memory and used instead of parsing the text file. The extensions are always loaded
+        //! from their text files.
         //! @see Instance(const UString&, bool);
         //! @see Instance(Predefined, bool);
         //!
-        NamesFile(const UString& fileName, bool mergeExtensions = false);
+        NamesFile(const UString& fileName, bool mergeExtensions = false, bool useIndex = true);
 
         //!
         //! Virtual destructor.
@@ -149,6 +154,27 @@ namespace ts {
         //!
         size_t errorCount() const { return _configErrors; }
 
+        //!
+        //! Suffix which is added to a ".names" file name to get the name of its precompiled binary index.
+        //!
+        static const UString INDEX_SUFFIX;
+
+        //!
+        //! Check if the names were loaded from a precompiled binary index.
+        //! @return True if the names of the main configuration file were loaded from a binary index.
+        //!
+        bool indexLoaded() const { return _index_data != nullptr; }
+
+        //!
+        //! Save the names which were loaded from text files into a precompiled binary index.
+        //! The index is a compact sorted representation of all sections and entries. It is
+        //! designed to be mapped in memory and binary-searched, without parsing at startup.
+        //! @param [in] fileName Name of the binary index file to create.
+        //! @param [in] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool saveIndex(const UString& fileName, Report& report) const;
+
         //!
         //! Check if a name exists in a specified section.
         //! @param [in] sectionName Name of section to search. Not case-sensitive.
@@ -269,11 +295,30 @@ namespace ts {
         // Load a configuration file and merge its content into this instance.
         void loadFile(const UString& fileName);
 
+        // Map a precompiled binary index of a configuration file. Return false if not found or invalid.
+        bool loadIndex(const UString& indexName, const UString& configName);
+        void unloadIndex();
+
+        // Locate a section in the binary index. Return false if not found.
+        bool findIndexSection(const UString& sectionName, size_t& first_entry, size_t& entry_count, size_t& bits) const;
+
+        // Get a name from the binary index, empty if not found.
+        UString getIndexName(size_t first_entry, size_t entry_count, Value val) const;
+
+        // Get a name from the text section or the binary index, empty if not found.
+        // The section name must be normalized.
+        UString getName(const UString& sectionName, Value value, size_t& bits) const;
+
         // Names private fields.
         Report&          _log;           // Error logger.
         const UString    _configFile;    // Configuration file path.
         size_t           _configErrors;  // Number of errors in configuration file.
-        ConfigSectionMap _sections;      // Configuration sections.
+        ConfigSectionMap _sections;      // Configuration sections, loaded from text files.
+        const uint8_t*   _index_data;    // Address of binary index, null if not loaded.
+        size_t           _index_size;    // Size in bytes of binary index.
+#if defined(TS_WINDOWS)
+        ByteBlock        _index_buffer;  // Binary index content, loaded in memory.
+#endif
     };
 }
 
@@ -86,6 +86,17 @@ namespace ts {
             //!
             void add(const Value& value);
 
+            //!
+            //! Start one JSON value in the open array of the running document.
+            //! The caller directly prints the value, without building a JSON object.
+            //! This is typically used with large values which are converted from another
+            //! format, see xml::JSONConverter::printJSON().
+            //! @return Address of the text formatter where the caller shall print exactly
+            //! one JSON value, without end of line. A null pointer is returned when the
+            //! document is not open, in which case nothing shall be printed.
+            //!
+            TextFormatter* startValue();
+
             //!
             //! Close the running document.
             //! If the JSON structure is still open, it is closed.
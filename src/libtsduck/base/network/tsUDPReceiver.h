@@ -91,6 +91,11 @@ namespace ts {
                              const AbortInterface* abort = nullptr,
                              Report& report = CERR,
                              MicroSecond* timestamp = nullptr) override;
+        virtual bool receiveBatch(ReceivedMessage* msgs,
+                                  size_t max_count,
+                                  size_t& ret_count,
+                                  const AbortInterface* abort = nullptr,
+                                  Report& report = CERR) override;
 
     private:
         bool             _with_short_options;
@@ -108,5 +113,8 @@ namespace ts {
         IPv4SocketAddress    _use_source;         // Filter on this socket address of sender (can be a simple filter of an SSM source).
         IPv4SocketAddress    _first_source;       // Socket address of first received packet.
         IPv4SocketAddressSet _sources;            // Set of all detected packet sources.
+
+        // Check if a received message matches all filtering criteria.
+        bool checkReceivedMessage(const IPv4SocketAddress& sender, const IPv4SocketAddress& destination, MicroSecond timestamp, Report& report);
     };
 }
@@ -30,9 +30,16 @@
 #include "tsUDPSocket.h"
 #include "tsNullReport.h"
 
-// Network timestampting feature in Linux.
+// Network timestampting and UDP offload features in Linux.
 #if defined(TS_LINUX)
 #include <linux/net_tstamp.h>
+#include <netinet/udp.h>
+#if !defined(UDP_SEGMENT)
+#define UDP_SEGMENT 103 // Older system headers, defined since kernel 4.18
+#endif
+#if !defined(UDP_GRO)
+#define UDP_GRO 104     // Older system headers, defined since kernel 5.0
+#endif
 #endif
 
 // Furiously idiotic Windows feature, see comment in receiveOne()
@@ -50,7 +57,8 @@ ts::UDPSocket::UDPSocket(bool auto_open, Report& report) :
     _local_address(),
     _default_destination(),
     _mcast(),
-    _ssmcast()
+    _ssmcast(),
+    _send_gso(false)
 {
     if (auto_open) {
         // Returned value ignored on purpose, the socket is marked as closed in the object on error.
@@ -243,6 +251,47 @@ bool ts::UDPSocket::setReceiveTimestamps(bool on, Report& report)
 }
 
 
+//----------------------------------------------------------------------------
+// Enable or disable UDP segmentation offload on send.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::setSendSegmentation(bool on, Report& report)
+{
+    // The option exists only on Linux and is silently ignored on other systems.
+#if defined(TS_LINUX)
+    // The segment size is specified in each message. Just check that the option is supported by the kernel.
+    int size = 0;
+    ::socklen_t length = sizeof(size);
+    if (on && ::getsockopt(getSocket(), IPPROTO_UDP, UDP_SEGMENT, &size, &length) != 0) {
+        report.error(u"socket option UDP_SEGMENT: " + SysSocketErrorCodeMessage());
+        return false;
+    }
+    _send_gso = on;
+#endif
+
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Enable or disable UDP receive offload.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::setReceiveCoalescing(bool on, Report& report)
+{
+    // The option exists only on Linux and is silently ignored on other systems.
+#if defined(TS_LINUX)
+    int enable = int(on);
+    if (::setsockopt(getSocket(), IPPROTO_UDP, UDP_GRO, &enable, sizeof(enable)) != 0) {
+        report.error(u"socket option UDP_GRO: " + SysSocketErrorCodeMessage());
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Enable or disable the broadcast option.
 //----------------------------------------------------------------------------
@@ -423,6 +472,119 @@ bool ts::UDPSocket::send(const void* data, size_t size, const IPv4SocketAddress&
 }
 
 
+//----------------------------------------------------------------------------
+// Send several messages to a destination address and port.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::sendBatch(const void* const* data, const size_t* sizes, size_t count, const IPv4SocketAddress& dest, Report& report)
+{
+#if defined(TS_LINUX)
+
+    // Linux implementation, use sendmmsg().
+    ::sockaddr addr;
+    dest.copy(addr);
+
+    // Maximum number of messages and datagrams per system call, all structures are on the stack.
+    // With segmentation offload, one message contains several datagrams of identical size
+    // (the last one can be shorter), up to 64 segments and the maximum size of an UDP payload.
+    constexpr size_t MAX_MESSAGES = 64;
+    constexpr size_t MAX_DATAGRAMS = 256;
+    constexpr size_t MAX_SEGMENTS = 64;
+    constexpr size_t MAX_GSO_SIZE = 65507;
+
+    ::mmsghdr hdr[MAX_MESSAGES];
+    ::iovec vec[MAX_DATAGRAMS];
+    size_t dg_count[MAX_MESSAGES]; // number of datagrams per message
+    union {
+        uint8_t data[CMSG_SPACE(sizeof(uint16_t))];
+        ::cmsghdr align;
+    } control[MAX_MESSAGES];
+
+    while (count > 0) {
+        TS_ZERO(hdr);
+        TS_ZERO(control);
+        size_t msg_count = 0;
+        size_t vec_count = 0;
+        bool use_gso = false;
+
+        // Build as many messages as possible.
+        while (msg_count < MAX_MESSAGES && vec_count < count && vec_count < MAX_DATAGRAMS) {
+            const size_t first = vec_count;
+            const size_t segment = sizes[first];
+            size_t total = 0;
+            do {
+                vec[vec_count].iov_base = const_cast<void*>(data[vec_count]);
+                vec[vec_count].iov_len = sizes[vec_count];
+                total += sizes[vec_count++];
+            } while (_send_gso &&
+                     segment > 0 &&
+                     sizes[vec_count - 1] == segment &&
+                     vec_count < count &&
+                     vec_count < MAX_DATAGRAMS &&
+                     vec_count - first < MAX_SEGMENTS &&
+                     sizes[vec_count] > 0 &&
+                     sizes[vec_count] <= segment &&
+                     total + sizes[vec_count] <= MAX_GSO_SIZE);
+
+            ::msghdr& mh(hdr[msg_count].msg_hdr);
+            mh.msg_name = &addr;
+            mh.msg_namelen = sizeof(addr);
+            mh.msg_iov = &vec[first];
+            mh.msg_iovlen = vec_count - first;
+            if (vec_count - first > 1) {
+                // Several datagrams in one message, the kernel will split them.
+                use_gso = true;
+                mh.msg_control = control[msg_count].data;
+                mh.msg_controllen = sizeof(control[msg_count].data);
+                ::cmsghdr* cmsg = CMSG_FIRSTHDR(&mh);
+                cmsg->cmsg_level = IPPROTO_UDP;
+                cmsg->cmsg_type = UDP_SEGMENT;
+                cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+                const uint16_t segment16 = uint16_t(segment);
+                ::memcpy(CMSG_DATA(cmsg), &segment16, sizeof(segment16));
+            }
+            dg_count[msg_count++] = vec_count - first;
+        }
+
+        // The system may send less messages than requested.
+        const int res = ::sendmmsg(getSocket(), hdr, (unsigned int)(msg_count), 0);
+        if (res <= 0) {
+            const SysSocketErrorCode err = LastSysSocketErrorCode();
+            if (use_gso && (err == EIO || err == EINVAL)) {
+                // The output device does not support segmentation offload, retry without it.
+                report.verbose(u"UDP segmentation offload not supported on output device, disabled");
+                _send_gso = false;
+                continue;
+            }
+            report.error(u"error sending UDP message: " + SysSocketErrorCodeMessage(err));
+            return false;
+        }
+
+        // Skip all datagrams from the sent messages.
+        size_t sent = 0;
+        for (size_t i = 0; i < size_t(res); ++i) {
+            sent += dg_count[i];
+        }
+        data += sent;
+        sizes += sent;
+        count -= sent;
+    }
+    return true;
+
+#else
+
+    // Without sendmmsg(), send messages one by one.
+    for (size_t i = 0; i < count; ++i) {
+        if (!send(data[i], sizes[i], dest, report)) {
+            return false;
+        }
+    }
+    return true;
+
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Receive a message.
 // If abort interface is non-zero, invoke it when I/O is interrupted
@@ -460,19 +622,7 @@ bool ts::UDPSocket::receive(void* data,
                 return true;
             }
         }
-        else if (abort != nullptr && abort->aborting()) {
-            // User-interrupt, end of processing but no error message
-            return false;
-        }
-#if !defined(TS_WINDOWS)
-        else if (err == EINTR) {
-            // Got a signal, not a user interrupt, will ignore it
-            report.debug(u"signal, not user interrupt");
-        }
-#endif
-        else {
-            // Abort on non-interrupt errors.
-            report.error(u"error receiving from UDP socket: %s", {SysSocketErrorCodeMessage(err)});
+        else if (!retryReceive(err, abort, report)) {
             return false;
         }
     }
@@ -594,11 +744,31 @@ ts::SysSocketErrorCode ts::UDPSocket::receiveOne(void* data,
         return LastSysSocketErrorCode();
     }
 
+    // Browse returned ancillary data.
+    getAncillaryData(hdr, destination, timestamp, nullptr);
+
+#endif // Windows vs. UNIX
+
+    // Successfully received a message
+    ret_size = size_t(insize);
+    sender = IPv4SocketAddress(sender_sock);
+
+    return SYS_SUCCESS;
+}
+
+
+//----------------------------------------------------------------------------
+// Analyze the ancillary data of a received message (UNIX only).
+//----------------------------------------------------------------------------
+
+#if !defined(TS_WINDOWS)
+
+void ts::UDPSocket::getAncillaryData(::msghdr& hdr, IPv4SocketAddress& destination, MicroSecond* timestamp, size_t* segment_size) const
+{
     // Because of invalid definition of CMSG_NXTHDR in musl libc (Alpine Linux)
     TS_PUSH_WARNING()
     TS_GCC_NOWARNING(zero-as-null-pointer-constant)
 
-    // Browse returned ancillary data.
     for (::cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
 
         // Look for destination IP address.
@@ -618,16 +788,152 @@ ts::SysSocketErrorCode ts::UDPSocket::receiveOne(void* data,
                 *timestamp = nano / NanoSecPerMicroSec;
             }
         }
+
+        // On Linux, look for the size of coalesced datagrams (UDP receive offload).
+        else if (segment_size != nullptr && cmsg->cmsg_level == IPPROTO_UDP && cmsg->cmsg_type == UDP_GRO && cmsg->cmsg_len >= CMSG_LEN(sizeof(int))) {
+            *segment_size = size_t(std::max(0, *reinterpret_cast<const int*>(CMSG_DATA(cmsg))));
+        }
 #endif
     }
 
     TS_POP_WARNING()
+}
 
-#endif // Windows vs. UNIX
+#endif
 
-    // Successfully received a message
-    ret_size = size_t(insize);
-    sender = IPv4SocketAddress(sender_sock);
 
+//----------------------------------------------------------------------------
+// Process an error code from a receive operation.
+// Return true to retry, false to stop.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::retryReceive(SysSocketErrorCode err, const AbortInterface* abort, Report& report) const
+{
+    if (abort != nullptr && abort->aborting()) {
+        // User-interrupt, end of processing but no error message
+        return false;
+    }
+#if !defined(TS_WINDOWS)
+    else if (err == EINTR) {
+        // Got a signal, not a user interrupt, will ignore it
+        report.debug(u"signal, not user interrupt");
+        return true;
+    }
+#endif
+    else {
+        // Abort on non-interrupt errors.
+        report.error(u"error receiving from UDP socket: %s", {SysSocketErrorCodeMessage(err)});
+        return false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Receive several messages at once.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::receiveBatch(ReceivedMessage* msgs, size_t max_count, size_t& ret_count, const AbortInterface* abort, Report& report)
+{
+    ret_count = 0;
+    if (msgs == nullptr || max_count == 0) {
+        report.error(u"no buffer to receive UDP messages");
+        return false;
+    }
+
+    // Loop on unsollicited interrupts
+    for (;;) {
+
+        // Wait for messages.
+        const SysSocketErrorCode err = receiveMany(msgs, max_count, ret_count, report);
+
+        if (abort != nullptr && abort->aborting()) {
+            // Aborting, no error message.
+            ret_count = 0;
+            return false;
+        }
+        else if (err == SYS_SUCCESS) {
+            // Sometimes, we get "successful" empty message coming from nowhere. Remove them.
+            size_t count = 0;
+            for (size_t i = 0; i < ret_count; ++i) {
+                if (msgs[i].size > 0 || msgs[i].sender.hasAddress()) {
+                    if (count < i) {
+                        std::swap(msgs[count], msgs[i]);
+                    }
+                    count++;
+                }
+            }
+            ret_count = count;
+            if (ret_count > 0) {
+                return true;
+            }
+        }
+        else if (!retryReceive(err, abort, report)) {
+            return false;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Perform one batch receive operation.
+//----------------------------------------------------------------------------
+
+ts::SysSocketErrorCode ts::UDPSocket::receiveMany(ReceivedMessage* msgs, size_t max_count, size_t& ret_count, Report& report)
+{
+    ret_count = 0;
+
+#if defined(TS_LINUX)
+
+    // Linux implementation, use recvmmsg().
+    // Maximum number of messages per system call, all structures are on the stack.
+    constexpr size_t MAX_MESSAGES = 64;
+    const size_t count = std::min(max_count, MAX_MESSAGES);
+
+    ::mmsghdr hdr[MAX_MESSAGES];
+    ::iovec vec[MAX_MESSAGES];
+    ::sockaddr sender_sock[MAX_MESSAGES];
+    uint8_t ancil_data[MAX_MESSAGES][256];
+    TS_ZERO(hdr);
+    TS_ZERO(sender_sock);
+
+    for (size_t i = 0; i < count; ++i) {
+        vec[i].iov_base = msgs[i].data;
+        vec[i].iov_len = msgs[i].max_size;
+        hdr[i].msg_hdr.msg_name = &sender_sock[i];
+        hdr[i].msg_hdr.msg_namelen = sizeof(sender_sock[i]);
+        hdr[i].msg_hdr.msg_iov = &vec[i];
+        hdr[i].msg_hdr.msg_iovlen = 1; // number of iovec structures
+        hdr[i].msg_hdr.msg_control = ancil_data[i];
+        hdr[i].msg_hdr.msg_controllen = sizeof(ancil_data[i]);
+    }
+
+    // Wait for at least one message, then get all messages which are immediately available.
+    const int res = ::recvmmsg(getSocket(), hdr, (unsigned int)(count), MSG_WAITFORONE, nullptr);
+    if (res < 0) {
+        return LastSysSocketErrorCode();
+    }
+
+    for (size_t i = 0; i < size_t(res); ++i) {
+        msgs[i].size = size_t(hdr[i].msg_len);
+        msgs[i].sender = IPv4SocketAddress(sender_sock[i]);
+        msgs[i].destination.clear();
+        msgs[i].timestamp = -1;
+        msgs[i].segment_size = 0;
+        getAncillaryData(hdr[i].msg_hdr, msgs[i].destination, &msgs[i].timestamp, &msgs[i].segment_size);
+    }
+    ret_count = size_t(res);
     return SYS_SUCCESS;
+
+#else
+
+    // Without recvmmsg(), receive one message at a time.
+    msgs[0].timestamp = -1;
+    msgs[0].segment_size = 0;
+    const SysSocketErrorCode err = receiveOne(msgs[0].data, msgs[0].max_size, msgs[0].size, msgs[0].sender, msgs[0].destination, report, &msgs[0].timestamp);
+    if (err == SYS_SUCCESS) {
+        ret_count = 1;
+    }
+    return err;
+
+#endif
 }
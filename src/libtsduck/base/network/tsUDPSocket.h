@@ -203,6 +203,40 @@ namespace ts {
         //!
         bool setReceiveTimestamps(bool on, Report& report = CERR);
 
+        //!
+        //! Enable or disable UDP Generic Segmentation Offload (GSO) on send.
+        //!
+        //! When enabled, sendBatch() passes consecutive datagrams of identical size to the
+        //! kernel as one single large message (option UDP_SEGMENT). The kernel, or the NIC,
+        //! splits this message into individual datagrams. If the output device does not
+        //! support it, the option is automatically disabled at the first send operation.
+        //!
+        //! Currently, this option is supported on Linux only (kernel 4.18 or higher).
+        //! It is ignored on other systems.
+        //!
+        //! @param [in] on If true, segmentation offload is activated on the socket. Otherwise, it is disabled.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        bool setSendSegmentation(bool on, Report& report = CERR);
+
+        //!
+        //! Enable or disable UDP Generic Receive Offload (GRO).
+        //!
+        //! When enabled, the kernel may coalesce several consecutive datagrams of identical size
+        //! from the same sender into one large message (option UDP_GRO). Only receiveBatch()
+        //! reports the size of the original datagrams (see ReceivedMessage::segment_size).
+        //! Therefore, this option should not be used with receive().
+        //!
+        //! Currently, this option is supported on Linux only (kernel 5.0 or higher).
+        //! It is ignored on other systems.
+        //!
+        //! @param [in] on If true, receive offload is activated on the socket. Otherwise, it is disabled.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        bool setReceiveCoalescing(bool on, Report& report = CERR);
+
         //!
         //! Enable or disable the broadcast option.
         //!
@@ -330,6 +364,84 @@ namespace ts {
                              Report& report = CERR,
                              MicroSecond* timestamp = nullptr);
 
+        //!
+        //! Send several messages to a destination address and port.
+        //!
+        //! On Linux, all messages are sent using one single system call (sendmmsg()).
+        //! On other systems, the messages are sent one by one.
+        //!
+        //! @param [in] data Array of @a count addresses of messages to send.
+        //! @param [in] sizes Array of @a count sizes in bytes of messages to send.
+        //! @param [in] count Number of messages to send.
+        //! @param [in] destination Socket address of the destination.
+        //! Both address and port are mandatory in the socket address, they cannot
+        //! be set to IPv4Address::AnyAddress or IPv4SocketAddress::AnyPort.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        virtual bool sendBatch(const void* const* data, const size_t* sizes, size_t count, const IPv4SocketAddress& destination, Report& report = CERR);
+
+        //!
+        //! Send several messages to the default destination address and port.
+        //!
+        //! @param [in] data Array of @a count addresses of messages to send.
+        //! @param [in] sizes Array of @a count sizes in bytes of messages to send.
+        //! @param [in] count Number of messages to send.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        bool sendBatch(const void* const* data, const size_t* sizes, size_t count, Report& report = CERR)
+        {
+            return sendBatch(data, sizes, count, _default_destination, report);
+        }
+
+        //!
+        //! Description of one message in a batch of received messages.
+        //! @see receiveBatch()
+        //!
+        struct TSDUCKDLL ReceivedMessage
+        {
+            void*             data;         //!< Address of the buffer for the received message (input).
+            size_t            max_size;     //!< Size in bytes of the reception buffer (input).
+            size_t            size;         //!< Size in bytes of the received message.
+            IPv4SocketAddress sender;       //!< Socket address of the sender.
+            IPv4SocketAddress destination;  //!< Socket address of the packet destination.
+            MicroSecond       timestamp;    //!< Receive timestamp in micro-seconds, negative if not available.
+            size_t            segment_size; //!< Size of each original datagram in a coalesced message, zero if not coalesced.
+            //!
+            //! Default constructor.
+            //!
+            ReceivedMessage() : data(nullptr), max_size(0), size(0), sender(), destination(), timestamp(-1), segment_size(0) {}
+            //! @cond nodoxygen
+            ReceivedMessage(const ReceivedMessage&) = default;
+            ReceivedMessage& operator=(const ReceivedMessage&) = default;
+            //! @endcond
+        };
+
+        //!
+        //! Receive several messages at once.
+        //!
+        //! The method waits for at least one message and returns all messages which are
+        //! immediately available, up to @a max_count. On Linux, all messages are received
+        //! using one single system call (recvmmsg()). On other systems, one message is
+        //! returned at a time.
+        //!
+        //! @param [in,out] msgs Array of @a max_count message descriptions. On input, the fields
+        //! @a data and @a max_size must be set in each element. On output, the @a ret_count first
+        //! elements describe the received messages.
+        //! @param [in] max_count Maximum number of messages to receive.
+        //! @param [out] ret_count Number of received messages. Never zero on success.
+        //! @param [in] abort If non-zero, invoked when I/O is interrupted
+        //! (in case of user-interrupt, return, otherwise retry).
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        virtual bool receiveBatch(ReceivedMessage* msgs,
+                                  size_t max_count,
+                                  size_t& ret_count,
+                                  const AbortInterface* abort = nullptr,
+                                  Report& report = CERR);
+
         // Implementation of Socket interface.
         virtual bool open(Report& report = CERR) override;
         virtual bool close(Report& report = CERR) override;
@@ -389,10 +501,22 @@ namespace ts {
         IPv4SocketAddress _default_destination;
         MReqSet       _mcast;    // Current set of multicast memberships
         SSMReqSet     _ssmcast;  // Current set of source-specific multicast memberships
+        bool          _send_gso; // Use UDP segmentation offload in sendBatch()
 
         // Perform one receive operation. Hide the system mud.
         SysSocketErrorCode receiveOne(void* data, size_t max_size, size_t& ret_size, IPv4SocketAddress& sender, IPv4SocketAddress& destination, Report& report, MicroSecond* timestamp);
 
+        // Perform one batch receive operation, using recvmmsg() on Linux.
+        SysSocketErrorCode receiveMany(ReceivedMessage* msgs, size_t max_count, size_t& ret_count, Report& report);
+
+        // Process an error code from a receive operation. Return true to retry, false to stop.
+        bool retryReceive(SysSocketErrorCode err, const AbortInterface* abort, Report& report) const;
+
+#if !defined(TS_WINDOWS)
+        // Analyze the ancillary data of a received message.
+        void getAncillaryData(::msghdr& hdr, IPv4SocketAddress& destination, MicroSecond* timestamp, size_t* segment_size) const;
+#endif
+
         // Furiously idiotic Windows feature, see comment in receiveOne()
 #if defined(TS_WINDOWS)
         static volatile ::LPFN_WSARECVMSG _wsaRevcMsg;
@@ -51,8 +51,10 @@ namespace ts {
         //! Abort application if memory allocation fails.
         //! Do not abort if memory locking fails.
         //! @param [in] elem_count Number of @a T elements.
+        //! @param [in] numa_node If not NPOS, allocate the physical memory on this NUMA node.
+        //! Do not abort if the allocation on the NUMA node fails, see isNUMABound().
         //!
-        ResidentBuffer(size_t elem_count);
+        ResidentBuffer(size_t elem_count, size_t numa_node = NPOS);
 
         //!
         //! Destructor.
@@ -77,6 +79,25 @@ namespace ts {
             return _error_code;
         }
 
+        //!
+        //! Check if the buffer is actually allocated on the requested NUMA node.
+        //! @return True if the buffer is allocated on the NUMA node which was
+        //! specified in the constructor, false if none was specified or on error.
+        //!
+        bool isNUMABound() const
+        {
+            return _is_numa_bound;
+        }
+
+        //!
+        //! Get error code when not allocated on the requested NUMA node.
+        //! @return The system error code when binding to the NUMA node failed.
+        //!
+        SysErrorCode numaErrorCode() const
+        {
+            return _numa_error_code;
+        }
+
         //!
         //! Return base address of the buffer.
         //! @return The address of the first @a T element in the buffer.
@@ -103,7 +124,9 @@ namespace ts {
         size_t    _locked_size;      // Locked size (mlock, multiple of page size)
         size_t    _elem_count;       // Element count in locked region
         bool      _is_locked;        // False if mlock failed.
+        bool      _is_numa_bound;    // True if allocated on the requested NUMA node.
         SysErrorCode _error_code;       // Lock error code
+        SysErrorCode _numa_error_code;  // NUMA binding error code
     };
 }
 
@@ -45,7 +45,7 @@
 //----------------------------------------------------------------------------
 
 template <typename T>
-ts::ResidentBuffer<T>::ResidentBuffer(size_t elem_count) :
+ts::ResidentBuffer<T>::ResidentBuffer(size_t elem_count, size_t numa_node) :
     _allocated_base(nullptr),
     _locked_base(nullptr),
     _base(nullptr),
@@ -53,7 +53,9 @@ ts::ResidentBuffer<T>::ResidentBuffer(size_t elem_count) :
     _locked_size(0),
     _elem_count(elem_count),
     _is_locked(false),
-    _error_code(SYS_SUCCESS)
+    _is_numa_bound(false),
+    _error_code(SYS_SUCCESS),
+    _numa_error_code(SYS_SUCCESS)
 {
     const size_t requested_size = elem_count * sizeof(T);
     const size_t page_size = SysInfo::Instance()->memoryPageSize();
@@ -72,6 +74,12 @@ ts::ResidentBuffer<T>::ResidentBuffer(size_t elem_count) :
     _locked_base = char_ptr(round_up(size_t(_allocated_base), page_size));
     _locked_size = round_up(requested_size, page_size);
 
+    // Bind the memory to the NUMA node before the first access to the pages.
+    if (numa_node != NPOS) {
+        _is_numa_bound = BindMemoryToNUMANode(_locked_base, _locked_size, numa_node);
+        _numa_error_code = _is_numa_bound ? SYS_SUCCESS : LastSysErrorCode();
+    }
+
     _base = new (_locked_base) T[elem_count];
 
     // Integrity checks
@@ -150,4 +158,5 @@ ts::ResidentBuffer<T>::~ResidentBuffer<T>()
     _locked_size = 0;
     _elem_count = 0;
     _is_locked = false;
+    _is_numa_bound = false;
 }
@@ -99,7 +99,10 @@ ts::SysInfo::SysInfo() :
 #else
     _cpuName(u"unknown CPU"),
 #endif
-    _memoryPageSize(0)
+    _memoryPageSize(0),
+    _crcInstructions(false),
+    _aesInstructions(false),
+    _vectorInstructions(false)
 {
     //
     // Get operating system name and version.
@@ -244,4 +247,16 @@ ts::SysInfo::SysInfo() :
     }
 
 #endif
+
+    //
+    // Get CPU features for hardware acceleration.
+    //
+    if (GetEnvironment(u"TS_NO_HARDWARE_ACCELERATION").empty()) {
+#if defined(TS_X86_64) && defined(TS_GCC)
+        __builtin_cpu_init();
+        _crcInstructions = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+        _aesInstructions = __builtin_cpu_supports("aes");
+        _vectorInstructions = __builtin_cpu_supports("avx2");
+#endif
+    }
 }
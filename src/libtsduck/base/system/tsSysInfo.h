@@ -122,6 +122,30 @@ namespace ts {
         //! @return The system memory page size in bytes.
         //!
         size_t memoryPageSize() const { return _memoryPageSize; }
+        //!
+        //! Check if the CPU supports accelerated instructions for CRC computation.
+        //! On Intel x86-64, this is the carry-less multiplication (PCLMULQDQ) with SSSE3.
+        //! Hardware acceleration can be disabled at run time by defining the environment
+        //! variable TS_NO_HARDWARE_ACCELERATION.
+        //! @return True if accelerated CRC instructions are available.
+        //!
+        bool crcInstructions() const { return _crcInstructions; }
+        //!
+        //! Check if the CPU supports accelerated instructions for AES.
+        //! On Intel x86-64, this is the AES-NI instruction set.
+        //! Hardware acceleration can be disabled at run time by defining the environment
+        //! variable TS_NO_HARDWARE_ACCELERATION.
+        //! @return True if accelerated AES instructions are available.
+        //!
+        bool aesInstructions() const { return _aesInstructions; }
+        //!
+        //! Check if the CPU supports 256-bit vector instructions on integers.
+        //! On Intel x86-64, this is the AVX2 instruction set.
+        //! Hardware acceleration can be disabled at run time by defining the environment
+        //! variable TS_NO_HARDWARE_ACCELERATION.
+        //! @return True if 256-bit vector instructions are available.
+        //!
+        bool vectorInstructions() const { return _vectorInstructions; }
 
     private:
         bool    _isLinux;
@@ -139,5 +163,8 @@ namespace ts {
         UString _hostName;
         UString _cpuName;
         size_t  _memoryPageSize;
+        bool    _crcInstructions;
+        bool    _aesInstructions;
+        bool    _vectorInstructions;
     };
 }
@@ -41,6 +41,8 @@
 
 #if defined(TS_LINUX)
 #include "tsFileUtils.h"
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
 #endif
 
 #if defined(TS_MAC)
@@ -408,6 +410,101 @@ void ts::GetProcessMetrics(ProcessMetrics& metrics)
 }
 
 
+//----------------------------------------------------------------------------
+// Restrict the execution of the current thread to a set of CPU's.
+//----------------------------------------------------------------------------
+
+bool ts::SetCurrentThreadAffinity(const std::set<size_t>& cpus)
+{
+    if (cpus.empty()) {
+        return true;
+    }
+
+#if defined(TS_LINUX)
+
+    ::cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto it = cpus.begin(); it != cpus.end(); ++it) {
+        if (*it < CPU_SETSIZE) {
+            CPU_SET(*it, &set);
+        }
+    }
+    return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+
+#elif defined(TS_WINDOWS)
+
+    ::DWORD_PTR mask = 0;
+    for (auto it = cpus.begin(); it != cpus.end(); ++it) {
+        if (*it < 8 * sizeof(mask)) {
+            mask |= ::DWORD_PTR(1) << *it;
+        }
+    }
+    return mask != 0 && ::SetThreadAffinityMask(::GetCurrentThread(), mask) != 0;
+
+#else
+    return false;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Get the set of CPU's in a NUMA node.
+//----------------------------------------------------------------------------
+
+bool ts::GetNUMANodeCPUs(size_t node, std::set<size_t>& cpus)
+{
+    cpus.clear();
+
+#if defined(TS_LINUX)
+
+    // The file contains a list of CPU ranges, eg. "0-3,8-11".
+    UStringList lines;
+    if (!UString::Load(lines, UString::Format(u"/sys/devices/system/node/node%d/cpulist", {node})) || lines.empty()) {
+        return false;
+    }
+    UStringVector ranges;
+    lines.front().split(ranges, u',', true, true);
+    for (auto it = ranges.begin(); it != ranges.end(); ++it) {
+        size_t first = 0;
+        size_t last = 0;
+        if (it->scan(u"%d-%d", {&first, &last})) {
+            for (size_t cpu = first; cpu <= last; ++cpu) {
+                cpus.insert(cpu);
+            }
+        }
+        else if (it->toInteger(first)) {
+            cpus.insert(first);
+        }
+    }
+    return !cpus.empty();
+
+#else
+    return false;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Allocate the physical memory of an address range on a NUMA node.
+//----------------------------------------------------------------------------
+
+bool ts::BindMemoryToNUMANode(void* address, size_t size, size_t node)
+{
+#if defined(TS_LINUX)
+
+    // Use the system call directly, without dependency on libnuma.
+    // The node mask is an array of unsigned long, one bit per node.
+    constexpr size_t bits_per_mask = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask(node / bits_per_mask + 1, 0);
+    mask[node / bits_per_mask] = 1UL << (node % bits_per_mask);
+    return ::syscall(SYS_mbind, address, (unsigned long)(size), MPOL_BIND, mask.data(), (unsigned long)(mask.size() * bits_per_mask + 1), MPOL_MF_MOVE) == 0;
+
+#else
+    return false;
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Ignore SIGPIPE. On UNIX systems: writing to a broken pipe returns an
 // error instead of killing the process. On Windows systems: does nothing.
@@ -320,6 +320,34 @@ namespace ts {
     //!
     TSDUCKDLL void GetProcessMetrics(ProcessMetrics& metrics);
 
+    //!
+    //! Restrict the execution of the current thread to a set of CPU's.
+    //! Implemented on Linux and Windows (first 64 CPU's) only.
+    //! @param [in] cpus Set of CPU indexes, starting at zero. When empty, do nothing.
+    //! @return True on success, false on error or when not implemented.
+    //!
+    TSDUCKDLL bool SetCurrentThreadAffinity(const std::set<size_t>& cpus);
+
+    //!
+    //! Get the set of CPU's in a NUMA node.
+    //! Implemented on Linux only.
+    //! @param [in] node NUMA node index, starting at zero.
+    //! @param [out] cpus Set of CPU indexes in the NUMA node.
+    //! @return True on success, false if the NUMA node does not exist or when not implemented.
+    //!
+    TSDUCKDLL bool GetNUMANodeCPUs(size_t node, std::set<size_t>& cpus);
+
+    //!
+    //! Allocate the physical memory of an address range on a NUMA node.
+    //! This must be called before the first access to the memory. The pages which are
+    //! already allocated elsewhere are moved, when possible. Implemented on Linux only.
+    //! @param [in] address Starting address, must be aligned on a page boundary.
+    //! @param [in] size Size in bytes of the memory range.
+    //! @param [in] node NUMA node index, starting at zero.
+    //! @return True on success, false on error or when not implemented.
+    //!
+    TSDUCKDLL bool BindMemoryToNUMANode(void* address, size_t size, size_t node);
+
     //!
     //! Ensure that writing to a broken pipe does not kill the current process.
     //!
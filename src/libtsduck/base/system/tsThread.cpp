@@ -338,6 +338,9 @@ bool ts::Thread::waitForTermination()
 
 void ts::Thread::mainWrapper()
 {
+    // Set CPU affinity from the new thread, errors are ignored.
+    SetCurrentThreadAffinity(_attributes._cpus);
+
     try {
         main();
     }
@@ -184,6 +184,34 @@ namespace ts {
             return _priority;
         }
 
+        //!
+        //! Set the CPU affinity of the thread.
+        //!
+        //! The thread is restricted to run on the specified CPU's. This is typically used to keep
+        //! a thread on the same NUMA node as its data. CPU affinity is implemented on Linux and
+        //! Windows only. It is ignored on other systems or when the CPU set is invalid.
+        //!
+        //! @param [in] cpus Set of CPU indexes, starting at zero. When empty (the default),
+        //! the thread can run on any CPU.
+        //! @return A reference to this object.
+        //!
+        ThreadAttributes& setAffinity(const std::set<size_t>& cpus)
+        {
+            _cpus = cpus;
+            return *this;
+        }
+
+        //!
+        //! Get the CPU affinity of the thread.
+        //!
+        //! @return A constant reference to the set of CPU indexes. When empty, the thread can run on any CPU.
+        //! @see setAffinity()
+        //!
+        const std::set<size_t>& getAffinity() const
+        {
+            return _cpus;
+        }
+
         //!
         //! Get the minimum priority for a thread in this context of the operating system.
         //! @return The minimum priority for a thread.
@@ -241,6 +269,7 @@ namespace ts {
         size_t _stackSize;
         bool _deleteWhenTerminated;
         int _priority;
+        std::set<size_t> _cpus;
 
         //
         // These fields describe the operating system priority range.
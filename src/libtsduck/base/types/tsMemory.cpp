@@ -87,6 +87,31 @@ bool ts::IdenticalBytes(const void * area, size_t area_size)
 }
 
 
+//----------------------------------------------------------------------------
+// Perform an exclusive OR over memory areas.
+//----------------------------------------------------------------------------
+
+void ts::MemXor(void* dest, const void* src1, const void* src2, size_t size)
+{
+    uint8_t* d = reinterpret_cast<uint8_t*>(dest);
+    const uint8_t* s1 = reinterpret_cast<const uint8_t*>(src1);
+    const uint8_t* s2 = reinterpret_cast<const uint8_t*>(src2);
+
+    // Process 64-bit words first, then remaining bytes. The areas may be unaligned:
+    // use memcpy() to access the words, compilers turn it into plain loads and stores.
+    for (; size >= 8; size -= 8, d += 8, s1 += 8, s2 += 8) {
+        uint64_t w1, w2;
+        ::memcpy(&w1, s1, 8);
+        ::memcpy(&w2, s2, 8);
+        w1 ^= w2;
+        ::memcpy(d, &w1, 8);
+    }
+    for (; size > 0; size--) {
+        *d++ = *s1++ ^ *s2++;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Memory accesses with non-natural sizes
 //----------------------------------------------------------------------------
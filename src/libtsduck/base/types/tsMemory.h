@@ -86,6 +86,16 @@ namespace ts {
     //!
     TSDUCKDLL bool IdenticalBytes(const void* area, size_t area_size);
 
+    //!
+    //! Perform an exclusive OR over memory areas.
+    //! The memory areas can be identical (e.g. @a dest and @a src1) but shall not partially overlap.
+    //! @param [out] dest Destination start address.
+    //! @param [in] src1 Address of first source area.
+    //! @param [in] src2 Address of second source area.
+    //! @param [in] size Size in bytes of the memory areas.
+    //!
+    TSDUCKDLL void MemXor(void* dest, const void* src1, const void* src2, size_t size);
+
 
     //----------------------------------------------------------------------------
     // Cross-platforms portable definitions for memory barrier.
@@ -69,6 +69,7 @@ namespace ts {
         class Document;
         class ModelDocument;
         class PatchDocument;
+        class Writer;
 
         //!
         //! Vector of constant elements.
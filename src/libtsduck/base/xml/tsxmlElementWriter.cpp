@@ -0,0 +1,94 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsxmlElementWriter.h"
+#include "tsxmlText.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::xml::ElementWriter::ElementWriter(Element* element) :
+    Writer(element == nullptr ? 0 : element->depth()),
+    _current(element)
+{
+    assert(_current != nullptr);
+}
+
+ts::xml::ElementWriter::~ElementWriter()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Implementation of Writer.
+//----------------------------------------------------------------------------
+
+void ts::xml::ElementWriter::writeStartElement(const UString& name)
+{
+    _current = _current->addElement(name);
+}
+
+void ts::xml::ElementWriter::writeEndElement()
+{
+    Element* parent = dynamic_cast<Element*>(_current->parent());
+    assert(parent != nullptr);
+    _current = parent;
+}
+
+void ts::xml::ElementWriter::writeAttribute(const UString& name, const UString& value)
+{
+    _current->setAttribute(name, value);
+}
+
+void ts::xml::ElementWriter::writeText(const UString& text, bool cdata, bool trimmable)
+{
+    Text* node = new Text(_current, text, cdata, trimmable);
+    CheckNonNull(node);
+}
+
+void ts::xml::ElementWriter::writeFirstChild(const Element* element)
+{
+    // Children may have been directly built using startDOM(), insert a copy in first position.
+    Element* copy = new Element(*element);
+    CheckNonNull(copy);
+    copy->reparent(_current, false);
+}
+
+ts::xml::Element* ts::xml::ElementWriter::openDOM()
+{
+    // No need for a temporary element, directly build the tree.
+    return _current;
+}
+
+void ts::xml::ElementWriter::closeDOM(Element*)
+{
+    // The tree was directly built, nothing to write.
+}
@@ -0,0 +1,84 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  XML writer which builds an XML tree.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsxmlWriter.h"
+
+namespace ts {
+    namespace xml {
+        //!
+        //! XML writer which builds an XML tree.
+        //! @ingroup xml
+        //!
+        //! This is the adapter between code which writes XML structures on the fly
+        //! and the XML tree classes. Everything which is written is added in an
+        //! existing xml::Element.
+        //!
+        class TSDUCKDLL ElementWriter : public Writer
+        {
+            TS_NOBUILD_NOCOPY(ElementWriter);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in,out] element The initial current element. Attributes which are set at
+            //! top level are set in this element. Top-level elements are added as children of it.
+            //!
+            explicit ElementWriter(Element* element);
+
+            //!
+            //! Destructor.
+            //!
+            virtual ~ElementWriter() override;
+
+            //!
+            //! Get the current element.
+            //! @return The current element in the XML tree.
+            //!
+            Element* currentElement() const { return _current; }
+
+        protected:
+            // Implementation of Writer.
+            virtual void writeStartElement(const UString& name) override;
+            virtual void writeEndElement() override;
+            virtual void writeAttribute(const UString& name, const UString& value) override;
+            virtual void writeText(const UString& text, bool cdata, bool trimmable) override;
+            virtual void writeFirstChild(const Element* element) override;
+            virtual Element* openDOM() override;
+            virtual void closeDOM(Element* element) override;
+
+        private:
+            Element* _current;
+        };
+    }
+}
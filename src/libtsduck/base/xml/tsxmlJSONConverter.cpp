@@ -54,6 +54,18 @@ ts::xml::JSONConverter::~JSONConverter()
 }
 
 
+//----------------------------------------------------------------------------
+// Get the model root for a document root, null if they do not match.
+//----------------------------------------------------------------------------
+
+const ts::xml::Element* ts::xml::JSONConverter::modelRootFor(const Element* docRoot) const
+{
+    // Ignore the model if the model root has a different name from the source root.
+    const Element* modelRoot = rootElement();
+    return modelRoot != nullptr && docRoot != nullptr && modelRoot->name().similar(docRoot->name()) ? modelRoot : nullptr;
+}
+
+
 //----------------------------------------------------------------------------
 // Convert an XML document into a JSON object.
 //----------------------------------------------------------------------------
@@ -66,23 +78,164 @@ ts::json::ValuePtr ts::xml::JSONConverter::convertToJSON(const Document& source,
         report().error(u"invalid XML document, no root element");
         return json::ValuePtr(new json::Null());
     }
+    else if (tweaks().x2jIncludeRoot || force_root) {
+        // Return a JSON object containing the root. Use no model if not the same as source.
+        return convertElementToJSON(modelRootFor(docRoot), docRoot, tweaks());
+    }
     else {
-        // Ignore the model if the model root has a different name from the source root.
-        const Element* modelRoot = rootElement();
-        if (modelRoot != nullptr && !modelRoot->name().similar(docRoot->name())) {
-            modelRoot = nullptr;
-        }
+        // Return a JSON array of all top-level elements in the root.
+        return convertChildrenToJSON(modelRootFor(docRoot), docRoot, tweaks());
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Convert an XML document and print it as JSON text.
+//----------------------------------------------------------------------------
+
+void ts::xml::JSONConverter::printJSON(TextFormatter& output, const Document& source, bool force_root) const
+{
+    const xml::Element* docRoot = source.rootElement();
+
+    if (docRoot == nullptr) {
+        report().error(u"invalid XML document, no root element");
+        output << "null";
+    }
+    else if (tweaks().x2jIncludeRoot || force_root) {
+        printElementJSON(output, modelRootFor(docRoot), docRoot, tweaks());
+    }
+    else {
+        printChildrenJSON(output, modelRootFor(docRoot), docRoot, tweaks());
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Convert a top-level XML element and print it as JSON text.
+//----------------------------------------------------------------------------
+
+void ts::xml::JSONConverter::printJSON(TextFormatter& output, const Element* source) const
+{
+    if (source == nullptr) {
+        output << "null";
+    }
+    else {
+        // The model of the element is searched in the model root, if it matches the document root.
+        const Element* docRoot = dynamic_cast<const Element*>(source->parent());
+        printElementJSON(output, findModelElement(modelRootFor(docRoot), source->name()), source, tweaks());
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Convert an XML document and save it as a JSON file.
+//----------------------------------------------------------------------------
 
-        // Convert the source. Use no model if not the same as source.
-        if (tweaks().x2jIncludeRoot || force_root) {
-            // Return a JSON object containing the root.
-            return convertElementToJSON(modelRoot, docRoot, tweaks());
+bool ts::xml::JSONConverter::saveJSON(const Document& source, const UString& fileName, size_t indent, bool stdOutputIfEmpty, bool force_root) const
+{
+    TextFormatter out(report());
+    out.setIndentSize(indent);
+
+    if (stdOutputIfEmpty && (fileName.empty() || fileName == u"-")) {
+        out.setStream(std::cout);
+    }
+    else if (!out.setFile(fileName)) {
+        return false;
+    }
+
+    printJSON(out, source, force_root);
+
+    // The JSON text is printed without end-of-line.
+    out << std::endl;
+    out.close();
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the JSON type of an attribute value.
+//----------------------------------------------------------------------------
+
+ts::json::Type ts::xml::JSONConverter::attributeType(Report& report, const Element* model, const UString& source_name, size_t source_line, const UString& name, const UString& value, const Tweaks& xml_tweaks, int64_t& int_value) const
+{
+    bool bool_value = false;
+    int_value = 0;
+
+    // Get description of this attribute in the model.
+    UString description;
+    bool intModel = false;
+    bool boolModel = false;
+    if (model != nullptr) {
+        // Get description, empty string without error if not found.
+        model->getAttribute(description, name, false);
+        description.trim(true, false, false);
+        intModel = description.startWith(u"uint", CASE_INSENSITIVE) || description.startWith(u"int", CASE_INSENSITIVE);
+        boolModel = description.startWith(u"bool", CASE_INSENSITIVE);
+    }
+
+    // Try to convert as an integer or boolean if defined as such by the model.
+    if (intModel) {
+        // Should be an integer according to the model.
+        if (value.toInteger(int_value, UString::DEFAULT_THOUSANDS_SEPARATOR)) {
+            if (int_value < -TS_CONST64(0xFFFFFFFF)) {
+                // This is a "very negative" value. This is typically a large unsigned hexadecimal value
+                // which will not be handled correctly when reading back the JSON file. We cannot use
+                // hexadecimal literals in JSON (new in JSON 5), so we leave it as a string.
+                return json::Type::String;
+            }
+            else {
+                // Acceptable integer.
+                return json::Type::Number;
+            }
         }
         else {
-            // Return a JSON array of all top-level elements in the root.
-            return convertChildrenToJSON(modelRoot, docRoot, tweaks());
+            report.warning(u"attribute '%s' in <%s> line %d is '%s' but should be an integer", {name, source_name, source_line, value});
         }
     }
+    else if (boolModel) {
+        // Should be a boolean according to the model.
+        if (value.toBool(bool_value)) {
+            return bool_value ? json::Type::True : json::Type::False;
+        }
+        else {
+            report.warning(u"attribute '%s' in <%s> line %d is '%s' but should be a boolean", {name, source_name, source_line, value});
+        }
+    }
+
+    // Try to enforce integer of boolean value if specified on command line.
+    if (xml_tweaks.x2jEnforceInteger && !intModel && value.toInteger(int_value, UString::DEFAULT_THOUSANDS_SEPARATOR)) {
+        return json::Type::Number;
+    }
+    if (xml_tweaks.x2jEnforceBoolean && !boolModel && value.toBool(bool_value)) {
+        return bool_value ? json::Type::True : json::Type::False;
+    }
+
+    // Use a string value by default.
+    return json::Type::String;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the model for text nodes of an element: true if the text is hexadecimal.
+//----------------------------------------------------------------------------
+
+bool ts::xml::JSONConverter::HexaTextModel(const Element* model)
+{
+    UString textModel;
+    if (model != nullptr) {
+        model->getText(textModel, true);
+    }
+    return textModel.startWith(u"hexa", CASE_INSENSITIVE);
+}
+
+
+//----------------------------------------------------------------------------
+// Trim the content of a text node according to the model and tweaks.
+//----------------------------------------------------------------------------
+
+void ts::xml::JSONConverter::TrimText(UString& content, bool hexa_model, const Tweaks& xml_tweaks)
+{
+    content.trim(hexa_model || xml_tweaks.x2jTrimText, hexa_model || xml_tweaks.x2jTrimText, hexa_model || xml_tweaks.x2jCollapseText);
 }
 
 
@@ -107,60 +260,23 @@ ts::json::ValuePtr ts::xml::JSONConverter::convertElementToJSON(const Element* m
         // JSON value of the attribute.
         json::ValuePtr jvalue;
         int64_t intValue = 0;
-        bool boolValue = false;
-
-        // Get description of this attribute in the model.
-        UString description;
-        bool intModel = false;
-        bool boolModel = false;
-        if (model != nullptr) {
-            // Get description, empty string without error if not found.
-            model->getAttribute(description, it->first, false);
-            description.trim(true, false, false);
-            intModel = description.startWith(u"uint", CASE_INSENSITIVE) || description.startWith(u"int", CASE_INSENSITIVE);
-            boolModel = description.startWith(u"bool", CASE_INSENSITIVE);
-        }
-
-        // Try to convert as an integer or boolean if defined as such by the model.
-        if (intModel) {
-            // Should be an integer according to the model.
-            if (it->second.toInteger(intValue, UString::DEFAULT_THOUSANDS_SEPARATOR)) {
-                if (intValue < -TS_CONST64(0xFFFFFFFF)) {
-                    // This is a "very negative" value. This is typically a large unsigned hexadecimal value
-                    // which will not be handled correctly when reading back the JSON file. We cannot use
-                    // hexadecimal literals in JSON (new in JSON 5), so we leave it as a string.
-                    jvalue = new json::String(it->second);
-                }
-                else {
-                    // Acceptable integer.
-                    jvalue = new json::Number(intValue);
-                }
-            }
-            else {
-                source->report().warning(u"attribute '%s' in <%s> line %d is '%s' but should be an integer", {it->first, source->name(), source->lineNumber(), it->second});
-            }
-        }
-        else if (boolModel) {
-            // Should be a boolean according to the model.
-            if (it->second.toBool(boolValue)) {
-                jvalue = json::Bool(boolValue);
-            }
-            else {
-                source->report().warning(u"attribute '%s' in <%s> line %d is '%s' but should be a boolean", {it->first, source->name(), source->lineNumber(), it->second});
-            }
-        }
-
-        // Try to enforce integer of boolean value if specified on command line.
-        if (jvalue.isNull() && xml_tweaks.x2jEnforceInteger && !intModel && it->second.toInteger(intValue, UString::DEFAULT_THOUSANDS_SEPARATOR)) {
-            jvalue = new json::Number(intValue);
-        }
-        if (jvalue.isNull() && xml_tweaks.x2jEnforceBoolean && !boolModel && it->second.toBool(boolValue)) {
-            jvalue = json::Bool(boolValue);
-        }
-
-        // Use a string value by default.
-        if (jvalue.isNull()) {
-            jvalue = new json::String(it->second);
+        switch (attributeType(source->report(), model, source->name(), source->lineNumber(), it->first, it->second, xml_tweaks, intValue)) {
+            case json::Type::Number:
+                jvalue = new json::Number(intValue);
+                break;
+            case json::Type::True:
+                jvalue = json::Bool(true);
+                break;
+            case json::Type::False:
+                jvalue = json::Bool(false);
+                break;
+            case json::Type::String:
+            case json::Type::Null:
+            case json::Type::Object:
+            case json::Type::Array:
+            default:
+                jvalue = new json::String(it->second);
+                break;
         }
 
         // Add the attribute in the JSON object.
@@ -187,7 +303,6 @@ ts::json::ValuePtr ts::xml::JSONConverter::convertChildrenToJSON(const Element*
     CheckNonNull(jchildren.pointer());
 
     // Content of the text children in the model.
-    UString textModel;
     bool getTextModel = model != nullptr;
     bool hexaModel = false;
 
@@ -206,16 +321,14 @@ ts::json::ValuePtr ts::xml::JSONConverter::convertChildrenToJSON(const Element*
             jchildren->set(convertElementToJSON(findModelElement(model, elem->name()), elem, xml_tweaks));
         }
         else if (text != nullptr) {
-            // Convert a text.
+            // Convert a text. Get the model description once only.
             UString content(text->value());
-            // Get the model description once only.
             if (getTextModel) {
                 getTextModel = false;
-                model->getText(textModel, true);
-                hexaModel = textModel.startWith(u"hexa", CASE_INSENSITIVE);
+                hexaModel = HexaTextModel(model);
             }
             // Trim the text content according to model and command line options.
-            content.trim(hexaModel || xml_tweaks.x2jTrimText, hexaModel || xml_tweaks.x2jTrimText, hexaModel || xml_tweaks.x2jCollapseText);
+            TrimText(content, hexaModel, xml_tweaks);
             // Add a JSON string for the text node in the array of JSON children.
             jchildren->set(content);
         }
@@ -224,6 +337,116 @@ ts::json::ValuePtr ts::xml::JSONConverter::convertChildrenToJSON(const Element*
 }
 
 
+//----------------------------------------------------------------------------
+// Print an XML tree of elements as JSON text.
+// The text is identical to the print of the object from convertElementToJSON().
+//----------------------------------------------------------------------------
+
+void ts::xml::JSONConverter::printElementJSON(TextFormatter& output, const Element* model, const Element* source, const Tweaks& xml_tweaks) const
+{
+    // The fields of a JSON object are printed in alphabetical order of names.
+    // The names "#name" and "#nodes" always come before the XML attributes.
+    output << "{" << ts::indent << ts::endl << ts::margin << '"' << HashName << "\": \"" << source->name().toJSON() << '"';
+
+    // Process the list of children, if any.
+    if (source->hasChildren()) {
+        output << "," << ts::endl << ts::margin << '"' << HashNodes << "\": ";
+        printChildrenJSON(output, model, source, xml_tweaks);
+    }
+
+    // Get all attributes of the XML element, in alphabetical order.
+    std::map<UString,UString> attributes;
+    source->getAttributes(attributes);
+
+    // Print all attributes as fields of the JSON object.
+    for (auto it = attributes.begin(); it != attributes.end(); ++it) {
+        output << "," << ts::endl << ts::margin << '"' << it->first.toJSON() << "\": ";
+        printAttributeJSON(output, source->report(), model, source->name(), source->lineNumber(), it->first, it->second, xml_tweaks);
+    }
+
+    // Unindent and closing sequence.
+    output << ts::endl << ts::unindent << ts::margin << "}";
+}
+
+
+//----------------------------------------------------------------------------
+// Print the JSON value of an attribute.
+//----------------------------------------------------------------------------
+
+void ts::xml::JSONConverter::printAttributeJSON(TextFormatter& output, Report& report, const Element* model, const UString& source_name, size_t source_line, const UString& name, const UString& value, const Tweaks& xml_tweaks) const
+{
+    int64_t intValue = 0;
+    switch (attributeType(report, model, source_name, source_line, name, value, xml_tweaks, intValue)) {
+        case json::Type::Number:
+            output << UString::Decimal(intValue, 0, true, UString());
+            break;
+        case json::Type::True:
+            output << "true";
+            break;
+        case json::Type::False:
+            output << "false";
+            break;
+        case json::Type::String:
+        case json::Type::Null:
+        case json::Type::Object:
+        case json::Type::Array:
+        default:
+            output << '"' << value.toJSON() << '"';
+            break;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Print all children of an element as a JSON array.
+// The text is identical to the print of the array from convertChildrenToJSON().
+//----------------------------------------------------------------------------
+
+void ts::xml::JSONConverter::printChildrenJSON(TextFormatter& output, const Element* model, const Element* parent, const Tweaks& xml_tweaks) const
+{
+    output << "[" << ts::indent;
+
+    // Content of the text children in the model.
+    bool getTextModel = model != nullptr;
+    bool hexaModel = false;
+    bool first = true;
+
+    // Loop on all children nodes.
+    bool lastNode = false;
+    for (const Node* child = parent->firstChild(); child != nullptr && !lastNode; child = child->nextSibling()) {
+        lastNode = child == parent->lastChild();
+
+        // Interpret the child either as an Element or a Text node.
+        // Other types of nodes are ignored.
+        const Element* elem = dynamic_cast<const Element*>(child);
+        const Text* text = dynamic_cast<const Text*>(child);
+
+        if (elem != nullptr || text != nullptr) {
+            if (!first) {
+                output << ",";
+            }
+            first = false;
+            output << ts::endl << ts::margin;
+        }
+        if (elem != nullptr) {
+            printElementJSON(output, findModelElement(model, elem->name()), elem, xml_tweaks);
+        }
+        else if (text != nullptr) {
+            UString content(text->value());
+            if (getTextModel) {
+                getTextModel = false;
+                hexaModel = HexaTextModel(model);
+            }
+            TrimText(content, hexaModel, xml_tweaks);
+            output << '"' << content.toJSON() << '"';
+        }
+    }
+
+    // Unindent and closing sequence.
+    output << ts::endl << ts::unindent << ts::margin << "]";
+}
+
+
 //----------------------------------------------------------------------------
 // Build a valid XML element name from a JSON string.
 //----------------------------------------------------------------------------
@@ -74,6 +74,12 @@ namespace ts {
         //!   inside the string.
         //! - XML declarations, comments and "unknown" nodes are dropped.
         //!
+        //! The conversion can produce a JSON tree (convertToJSON()) or directly print the
+        //! JSON text (printJSON()). The second method does not build the intermediate JSON
+        //! tree and is faster on large documents. The produced text is the same.
+        //! Using the same rules, xml::JSONWriter prints JSON text from XML structures which
+        //! are written on the fly, without any XML tree.
+        //!
         class TSDUCKDLL JSONConverter : public ModelDocument
         {
             TS_NOCOPY(JSONConverter);
@@ -97,6 +103,37 @@ namespace ts {
             //!
             json::ValuePtr convertToJSON(const Document& source, bool force_root = false) const;
 
+            //!
+            //! Convert an XML document and print it as JSON text, without building a JSON tree.
+            //! The JSON text is identical to the result of convertToJSON(), followed by json::Value::print().
+            //! @param [in,out] output The text formatter where the JSON text is printed.
+            //! @param [in] source The source XML document to convert.
+            //! @param [in] force_root If true, force the option -\-x2j-include-root.
+            //!
+            void printJSON(TextFormatter& output, const Document& source, bool force_root = false) const;
+
+            //!
+            //! Convert a top-level XML element and print it as JSON text, without building a JSON tree.
+            //! This is typically used to print documents which are built and converted element by element.
+            //! The JSON text is identical to the JSON object of this element in the result of convertToJSON()
+            //! on the complete document, with the root.
+            //! @param [in,out] output The text formatter where the JSON text is printed.
+            //! @param [in] source The source XML element to convert. It must be a direct child of the root
+            //! of its document. If @a source is a null pointer, a JSON null is printed.
+            //!
+            void printJSON(TextFormatter& output, const Element* source) const;
+
+            //!
+            //! Convert an XML document and save it as a JSON file, without building a JSON tree.
+            //! @param [in] source The source XML document to convert.
+            //! @param [in] fileName Name of the JSON file to save.
+            //! @param [in] indent Indentation width of each level.
+            //! @param [in] stdOutputIfEmpty If true and if @a fileName is empty or "-", the standard output is used.
+            //! @param [in] force_root If true, force the option -\-x2j-include-root.
+            //! @return True on success, false on error.
+            //!
+            bool saveJSON(const Document& source, const UString& fileName, size_t indent = 2, bool stdOutputIfEmpty = false, bool force_root = false) const;
+
             //!
             //! Convert a JSON object into an XML document.
             //! Not all JSON values can be converted. Basically, only JSON objects which were previously
@@ -133,6 +170,31 @@ namespace ts {
             // Convert all children of an element as a JSON array. Null pointer on error or if not convertible.
             json::ValuePtr convertChildrenToJSON(const Element* model, const Element* parent, const Tweaks&) const;
 
+            // Get the model root for a document root, null if they do not match.
+            const Element* modelRootFor(const Element* docRoot) const;
+
+            // The JSON writer uses the same conversion rules.
+            friend class JSONWriter;
+
+            // Get the JSON type of an attribute value: String, Number, True or False. Set int_value for a Number.
+            // The source element is described by its name and line number for error messages.
+            json::Type attributeType(Report& report, const Element* model, const UString& source_name, size_t source_line, const UString& name, const UString& value, const Tweaks&, int64_t& int_value) const;
+
+            // Print the JSON value of an attribute.
+            void printAttributeJSON(TextFormatter& output, Report& report, const Element* model, const UString& source_name, size_t source_line, const UString& name, const UString& value, const Tweaks&) const;
+
+            // Get the model for text nodes of an element: true if the text is hexadecimal.
+            static bool HexaTextModel(const Element* model);
+
+            // Trim the content of a text node according to the model and tweaks.
+            static void TrimText(UString& content, bool hexa_model, const Tweaks&);
+
+            // Print an XML tree of elements as JSON text.
+            void printElementJSON(TextFormatter& output, const Element* model, const Element* source, const Tweaks&) const;
+
+            // Print all children of an element as a JSON array.
+            void printChildrenJSON(TextFormatter& output, const Element* model, const Element* parent, const Tweaks&) const;
+
             // Build a valid XML element name from a JSON string.
             static UString ToElementName(const UString& str);
 
@@ -0,0 +1,137 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsxmlJSONWriter.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::xml::JSONWriter::JSONWriter(TextFormatter& output, const JSONConverter& converter, size_t depth) :
+    Writer(depth),
+    _output(output),
+    _converter(converter),
+    _levels()
+{
+}
+
+ts::xml::JSONWriter::~JSONWriter()
+{
+}
+
+ts::xml::JSONWriter::Level::Level(const UString& name_, const Element* model_) :
+    name(name_),
+    model(model_),
+    attributes(),
+    has_children(false),
+    text_model(false),
+    hexa_text(false)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Print the separator before a child in the "#nodes" array.
+// Same layout rules as xml::JSONConverter::printJSON().
+//----------------------------------------------------------------------------
+
+void ts::xml::JSONWriter::openChild()
+{
+    if (!_levels.empty()) {
+        Level& parent(_levels.back());
+        if (parent.has_children) {
+            _output << ",";
+        }
+        else {
+            _output << "," << ts::endl << ts::margin << '"' << JSONConverter::HashNodes << "\": [" << ts::indent;
+            parent.has_children = true;
+        }
+        _output << ts::endl << ts::margin;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Implementation of Writer.
+//----------------------------------------------------------------------------
+
+void ts::xml::JSONWriter::writeStartElement(const UString& name)
+{
+    openChild();
+    const Element* parent_model = _levels.empty() ? _converter.rootElement() : _levels.back().model;
+    _levels.push_back(Level(name, _converter.findModelElement(parent_model, name)));
+    _output << "{" << ts::indent << ts::endl << ts::margin << '"' << JSONConverter::HashName << "\": \"" << name.toJSON() << '"';
+}
+
+void ts::xml::JSONWriter::writeEndElement()
+{
+    assert(!_levels.empty());
+    const Level& level(_levels.back());
+
+    // Close the array of children, if any.
+    if (level.has_children) {
+        _output << ts::endl << ts::unindent << ts::margin << "]";
+    }
+
+    // The attributes come after "#name" and "#nodes", in alphabetical order.
+    for (auto it = level.attributes.begin(); it != level.attributes.end(); ++it) {
+        _output << "," << ts::endl << ts::margin << '"' << it->first.toJSON() << "\": ";
+        _converter.printAttributeJSON(_output, _converter.report(), level.model, level.name, 0, it->first, it->second, _converter.tweaks());
+    }
+
+    _output << ts::endl << ts::unindent << ts::margin << "}";
+    _levels.pop_back();
+}
+
+void ts::xml::JSONWriter::writeAttribute(const UString& name, const UString& value)
+{
+    // Same attribute names as xml::Element::getAttributes() with case-insensitive attributes.
+    assert(!_levels.empty());
+    _levels.back().attributes[name.toLower()] = value;
+}
+
+void ts::xml::JSONWriter::writeText(const UString& text, bool, bool)
+{
+    // CDATA and trimmable texts are converted as any text.
+    assert(!_levels.empty());
+    openChild();
+
+    // Get the model of text nodes once only.
+    Level& parent(_levels.back());
+    if (!parent.text_model) {
+        parent.text_model = true;
+        parent.hexa_text = JSONConverter::HexaTextModel(parent.model);
+    }
+
+    // Trim the text content according to model and tweaks.
+    UString content(text);
+    JSONConverter::TrimText(content, parent.hexa_text, _converter.tweaks());
+    _output << '"' << content.toJSON() << '"';
+}
@@ -0,0 +1,106 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  XML writer which directly prints JSON text.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsxmlWriter.h"
+#include "tsxmlJSONConverter.h"
+#include "tsTextFormatter.h"
+
+namespace ts {
+    namespace xml {
+        //!
+        //! XML writer which directly prints JSON text, without building an XML or JSON tree.
+        //! @ingroup xml
+        //!
+        //! The XML structures are converted using the rules and the model of an xml::JSONConverter.
+        //! The printed text of each top-level element is identical to the output of
+        //! xml::JSONConverter::printJSON() on the same element under the root of an XML document.
+        //! The caller is responsible for the margin and the separators around top-level elements.
+        //!
+        //! In the JSON object of an element, the attributes are printed after the children.
+        //! Therefore, the attributes of each open element are kept until the end of the element.
+        //!
+        class TSDUCKDLL JSONWriter : public Writer
+        {
+            TS_NOBUILD_NOCOPY(JSONWriter);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in,out] output The text formatter where the JSON text is printed.
+            //! It must remain valid as long as this object.
+            //! @param [in] converter The XML-to-JSON converter which provides the model and the tweaks.
+            //! The top-level elements are converted as children of the root of the model.
+            //! It must remain valid as long as this object.
+            //! @param [in] depth Depth of the parent of the top-level elements, see xml::Writer::Writer().
+            //! The default value is appropriate for elements under the root of a document.
+            //!
+            JSONWriter(TextFormatter& output, const JSONConverter& converter, size_t depth = 1);
+
+            //!
+            //! Destructor.
+            //!
+            virtual ~JSONWriter() override;
+
+        protected:
+            // Implementation of Writer.
+            virtual void writeStartElement(const UString& name) override;
+            virtual void writeEndElement() override;
+            virtual void writeAttribute(const UString& name, const UString& value) override;
+            virtual void writeText(const UString& text, bool cdata, bool trimmable) override;
+
+        private:
+            // Description of an element being printed.
+            class Level
+            {
+            public:
+                Level(const UString& name = UString(), const Element* model = nullptr);
+                Level(const Level&) = default;
+                Level& operator=(const Level&) = default;
+                UString                   name;          // Element name.
+                const Element*            model;         // Model of the element, can be null.
+                std::map<UString,UString> attributes;    // Attributes, indexed by lowercase name, printed at end.
+                bool                      has_children;  // The "#nodes" array is open.
+                bool                      text_model;    // The model of text nodes is known.
+                bool                      hexa_text;     // Text nodes are hexadecimal, according to the model.
+            };
+
+            TextFormatter&       _output;
+            const JSONConverter& _converter;
+            std::vector<Level>   _levels;
+
+            // Print the separator before a child in the "#nodes" array of the current element.
+            void openChild();
+        };
+    }
+}
@@ -37,7 +37,8 @@
 ts::xml::RunningDocument::RunningDocument(Report& report) :
     Document(report),
     _text(report),
-    _open_root(false)
+    _open_root(false),
+    _open_element(false)
 {
 }
 
@@ -81,6 +82,12 @@ void ts::xml::RunningDocument::flush()
         return;
     }
 
+    // Terminate the last element which was printed by the caller.
+    if (_open_element) {
+        _text << std::endl;
+        _open_element = false;
+    }
+
     if (!_open_root) {
         // This is the first time we print, print the document and its header with it, leave it open.
         print(_text, true);
@@ -107,6 +114,23 @@ void ts::xml::RunningDocument::flush()
 }
 
 
+//----------------------------------------------------------------------------
+// Start one element under the root, to be printed by the caller.
+//----------------------------------------------------------------------------
+
+ts::TextFormatter* ts::xml::RunningDocument::startElement()
+{
+    // Print the document header or all previous elements.
+    flush();
+    if (!_open_root) {
+        return nullptr;
+    }
+    _text << ts::margin;
+    _open_element = true;
+    return &_text;
+}
+
+
 //----------------------------------------------------------------------------
 // Close the running document.
 //----------------------------------------------------------------------------
@@ -115,6 +139,10 @@ void ts::xml::RunningDocument::close()
 {
     // Close the document structure if currently open.
     if (_open_root) {
+        if (_open_element) {
+            _text << std::endl;
+            _open_element = false;
+        }
         printClose(_text);
         _open_root = false;
     }
@@ -84,6 +84,16 @@ namespace ts {
             //!
             void flush();
 
+            //!
+            //! Start one element under the root of the running document, to be printed by the caller.
+            //! The document is first flushed. This is typically used with large elements which are
+            //! directly printed using an xml::TextWriter, without building an XML tree.
+            //! @return Address of the text formatter where the caller shall print exactly one
+            //! XML element, without end of line. A null pointer is returned when the document
+            //! is not open, in which case nothing shall be printed.
+            //!
+            TextFormatter* startElement();
+
             //!
             //! Close the running document.
             //! If the XML structure is still open, it is closed.
@@ -92,8 +102,9 @@ namespace ts {
             void close();
 
         private:
-            TextFormatter _text;       // The text formatter.
-            bool          _open_root;  // Document root has been printed and is left open.
+            TextFormatter _text;          // The text formatter.
+            bool          _open_root;     // Document root has been printed and is left open.
+            bool          _open_element;  // An element was printed by the caller, without end of line.
         };
     }
 }
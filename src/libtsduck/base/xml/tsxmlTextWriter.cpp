@@ -0,0 +1,134 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsxmlTextWriter.h"
+#include "tsxmlAttribute.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::xml::TextWriter::TextWriter(TextFormatter& output, const Tweaks& tweaks, size_t depth) :
+    Writer(depth),
+    _output(output),
+    _tweaks(tweaks),
+    _levels()
+{
+}
+
+ts::xml::TextWriter::~TextWriter()
+{
+}
+
+ts::xml::TextWriter::Level::Level(const UString& name_) :
+    name(name_),
+    open_tag(true),
+    sticky(false)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Terminate the start tag of the current element before printing a child.
+// Same layout rules as xml::Element::print().
+//----------------------------------------------------------------------------
+
+void ts::xml::TextWriter::openChild(bool sticky)
+{
+    if (!_levels.empty()) {
+        Level& parent(_levels.back());
+        if (parent.open_tag) {
+            _output << ">" << ts::indent;
+            parent.open_tag = false;
+        }
+        if (!parent.sticky && !sticky) {
+            _output << ts::endl << ts::margin;
+        }
+        parent.sticky = sticky;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Implementation of Writer.
+//----------------------------------------------------------------------------
+
+void ts::xml::TextWriter::writeStartElement(const UString& name)
+{
+    openChild(false);
+    _output << "<" << name;
+    _levels.push_back(Level(name));
+}
+
+void ts::xml::TextWriter::writeEndElement()
+{
+    assert(!_levels.empty());
+    const Level& level(_levels.back());
+
+    if (level.open_tag) {
+        // No child, close the tag.
+        _output << "/>";
+    }
+    else {
+        if (!level.sticky) {
+            _output << ts::endl;
+        }
+        _output << ts::unindent;
+        if (!level.sticky) {
+            _output << ts::margin;
+        }
+        _output << "</" << level.name << ">";
+    }
+    _levels.pop_back();
+}
+
+void ts::xml::TextWriter::writeAttribute(const UString& name, const UString& value)
+{
+    // Attributes are printed in the start tag, in order of appearance.
+    assert(!_levels.empty() && _levels.back().open_tag);
+    _output << " " << name << "=" << Attribute(name, value).formattedValue(_tweaks);
+}
+
+void ts::xml::TextWriter::writeText(const UString& text, bool cdata, bool trimmable)
+{
+    // Text nodes are sticky, CDATA are not. Same formatting as xml::Text::print().
+    openChild(!cdata);
+    if (cdata) {
+        _output << "<![CDATA[" << text << "]]>";
+    }
+    else {
+        UString str(text);
+        if (trimmable && !_output.formatting()) {
+            str.trim(true, true, true);
+        }
+        str.convertToHTML(_tweaks.strictTextNodeFormatting ? u"<>&'\"" : u"<>&");
+        _output << str;
+    }
+}
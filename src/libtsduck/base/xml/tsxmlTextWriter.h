@@ -0,0 +1,95 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  XML writer which directly prints XML text.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsxmlWriter.h"
+#include "tsxmlTweaks.h"
+#include "tsTextFormatter.h"
+
+namespace ts {
+    namespace xml {
+        //!
+        //! XML writer which directly prints XML text, without building an XML tree.
+        //! @ingroup xml
+        //!
+        //! The printed text of each top-level element is identical to the output of
+        //! xml::Element::print() on the same element in an XML tree. As with xml::Element::print(),
+        //! the caller is responsible for the margin and the end of line around top-level elements.
+        //!
+        class TSDUCKDLL TextWriter : public Writer
+        {
+            TS_NOBUILD_NOCOPY(TextWriter);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in,out] output The text formatter where the XML text is printed.
+            //! It must remain valid as long as this object.
+            //! @param [in] tweaks XML tweaks to format the XML text.
+            //! @param [in] depth Depth of the parent of the top-level elements, see xml::Writer::Writer().
+            //! The default value is appropriate for elements under the root of a document.
+            //!
+            TextWriter(TextFormatter& output, const Tweaks& tweaks = Tweaks(), size_t depth = 1);
+
+            //!
+            //! Destructor.
+            //!
+            virtual ~TextWriter() override;
+
+        protected:
+            // Implementation of Writer.
+            virtual void writeStartElement(const UString& name) override;
+            virtual void writeEndElement() override;
+            virtual void writeAttribute(const UString& name, const UString& value) override;
+            virtual void writeText(const UString& text, bool cdata, bool trimmable) override;
+
+        private:
+            // Description of an element being printed.
+            class Level
+            {
+            public:
+                Level(const UString& name = UString());
+                UString name;      // Element name.
+                bool    open_tag;  // The start tag is not yet terminated, no child yet.
+                bool    sticky;    // The last child is printed with sticky output.
+            };
+
+            TextFormatter&     _output;
+            const Tweaks       _tweaks;
+            std::vector<Level> _levels;
+
+            // Terminate the start tag of the current element before printing a child.
+            void openChild(bool sticky);
+        };
+    }
+}
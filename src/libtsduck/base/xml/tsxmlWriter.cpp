@@ -0,0 +1,237 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsxmlWriter.h"
+#include "tsxmlText.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::xml::Writer::Writer(size_t depth) :
+    _depth(depth),
+    _next_first(nullptr),
+    _first(nullptr),
+    _dom(nullptr),
+    _temp_doc()
+{
+}
+
+ts::xml::Writer::~Writer()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Start and end elements.
+//----------------------------------------------------------------------------
+
+void ts::xml::Writer::startElement(const UString& name)
+{
+    writePendingFirstChild();
+    writeStartElement(name);
+    _depth++;
+    _first = _next_first;
+    _next_first = nullptr;
+}
+
+void ts::xml::Writer::endElement()
+{
+    assert(_depth > 0);
+    writePendingFirstChild();
+    writeEndElement();
+    _depth--;
+}
+
+
+//----------------------------------------------------------------------------
+// Set an attribute of the current element.
+//----------------------------------------------------------------------------
+
+void ts::xml::Writer::setAttribute(const UString& name, const UString& value, bool onlyIfNotEmpty)
+{
+    if (!onlyIfNotEmpty || !value.empty()) {
+        writeAttribute(name, value);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Add text children.
+//----------------------------------------------------------------------------
+
+void ts::xml::Writer::addText(const UString& text, bool onlyNotEmpty)
+{
+    if (!onlyNotEmpty || !text.empty()) {
+        writePendingFirstChild();
+        writeText(text, false, false);
+    }
+}
+
+void ts::xml::Writer::addHexaText(const void* data, size_t size, bool onlyNotEmpty)
+{
+    // Filter incorrect parameters.
+    if (data == nullptr) {
+        data = "";
+        size = 0;
+    }
+
+    // Do nothing if empty.
+    if (size == 0 && onlyNotEmpty) {
+        return;
+    }
+
+    // Format the data exactly as xml::Element::addHexaText() at the same depth.
+    const UString hex(UString::Dump(data, size, UString::HEXA | UString::BPL, 2 * _depth, 16));
+
+    // Hexa text can be trimmed when necessary.
+    writePendingFirstChild();
+    writeText(u"\n" + hex + UString(_depth == 0 ? 0 : 2 * (_depth - 1), u' '), false, true);
+}
+
+void ts::xml::Writer::addHexaTextChild(const UString& name, const void* data, size_t size, bool onlyNotEmpty)
+{
+    if (data == nullptr) {
+        size = 0;
+    }
+    if (size > 0 || !onlyNotEmpty) {
+        startElement(name);
+        addHexaText(data, size);
+        endElement();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Write copies of XML elements.
+//----------------------------------------------------------------------------
+
+void ts::xml::Writer::addElement(const Element* element)
+{
+    if (element != nullptr) {
+        startElement(element->name());
+        addContent(element);
+        endElement();
+    }
+}
+
+void ts::xml::Writer::addContent(const Element* element)
+{
+    if (element == nullptr) {
+        return;
+    }
+
+    // Write all attributes first, in the same order as they would be printed.
+    UStringList names;
+    element->getAttributesNamesInModificationOrder(names);
+    for (auto it = names.begin(); it != names.end(); ++it) {
+        const Attribute& attr(element->attribute(*it));
+        writeAttribute(attr.name(), attr.value());
+    }
+
+    // Write children elements and texts. Other types of nodes are ignored.
+    for (const Node* node = element->firstChild(); node != nullptr; node = node->nextSibling()) {
+        const Element* elem = dynamic_cast<const Element*>(node);
+        const Text* text = dynamic_cast<const Text*>(node);
+        if (elem != nullptr) {
+            addElement(elem);
+        }
+        else if (text != nullptr) {
+            writePendingFirstChild();
+            writeText(text->value(), text->isCData(), text->isTrimmable());
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Insert an element as first child of the next element.
+//----------------------------------------------------------------------------
+
+void ts::xml::Writer::setNextFirstChild(const Element* element)
+{
+    _next_first = element;
+}
+
+void ts::xml::Writer::writePendingFirstChild()
+{
+    if (_first != nullptr) {
+        // Reset first to avoid recursion.
+        const Element* elem = _first;
+        _first = nullptr;
+        writeFirstChild(elem);
+    }
+}
+
+void ts::xml::Writer::writeFirstChild(const Element* element)
+{
+    addElement(element);
+}
+
+
+//----------------------------------------------------------------------------
+// Build the content of the current element using the xml::Element API.
+//----------------------------------------------------------------------------
+
+ts::xml::Element* ts::xml::Writer::startDOM()
+{
+    assert(_dom == nullptr);
+    _dom = openDOM();
+    return _dom;
+}
+
+void ts::xml::Writer::endDOM()
+{
+    if (_dom != nullptr) {
+        Element* elem = _dom;
+        _dom = nullptr;
+        closeDOM(elem);
+    }
+}
+
+ts::xml::Element* ts::xml::Writer::openDOM()
+{
+    // The temporary element is created at the same depth as the current element so
+    // that hexadecimal texts are formatted the same way. Its ancestors are kept in
+    // the temporary document from one call to another.
+    Node* parent = &_temp_doc;
+    for (size_t level = 1; level < _depth; ++level) {
+        Node* child = parent->firstChild();
+        parent = child != nullptr ? child : new Element(parent, u"_");
+    }
+    return new Element(parent, u"_");
+}
+
+void ts::xml::Writer::closeDOM(Element* element)
+{
+    addContent(element);
+    // Deallocating the element removes it from the temporary document.
+    delete element;
+}
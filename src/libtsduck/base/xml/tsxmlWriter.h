@@ -0,0 +1,332 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Abstract interface to write XML elements on the fly.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsxmlDocument.h"
+#include "tsxmlElement.h"
+
+namespace ts {
+    namespace xml {
+        //!
+        //! Abstract interface to write XML elements on the fly.
+        //! @ingroup xml
+        //!
+        //! A writer receives the content of an XML structure as a sequence of calls
+        //! (start of element, attributes, texts, end of element), in document order.
+        //! Depending on the subclass, this content is printed as XML or JSON text
+        //! without building any XML tree, or used to build an XML tree.
+        //!
+        //! All attributes of an element must be set before its first child element or text.
+        //! Each attribute of an element shall be set only once.
+        //!
+        //! At any time, the writer has a "current element" which receives attributes and
+        //! children. Initially, the current element is the parent of the top-level elements
+        //! which are written.
+        //!
+        //! Code which can only build XML trees can still use a writer through startDOM()
+        //! and endDOM(): the content of the current element is built in an xml::Element
+        //! and then written, at the cost of building this temporary tree.
+        //!
+        class TSDUCKDLL Writer
+        {
+            TS_NOCOPY(Writer);
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] depth Depth of the initial current element in its XML document.
+            //! This is the depth of an xml::Element which would be the parent of the top-level
+            //! elements in an XML tree (see xml::Node::depth()). This is used to format
+            //! hexadecimal texts the same way as in an XML tree.
+            //!
+            explicit Writer(size_t depth);
+
+            //!
+            //! Destructor.
+            //!
+            virtual ~Writer();
+
+            //!
+            //! Get the depth of the current element.
+            //! @return The depth of the current element in its XML document.
+            //!
+            size_t depth() const { return _depth; }
+
+            //!
+            //! Start a new child element in the current element.
+            //! The new element becomes the current element.
+            //! @param [in] name Name of the new element.
+            //!
+            void startElement(const UString& name);
+
+            //!
+            //! End the current element.
+            //! Its parent becomes the current element again.
+            //!
+            void endElement();
+
+            //!
+            //! Set an attribute of the current element.
+            //! @param [in] name Attribute name.
+            //! @param [in] value Attribute value.
+            //! @param [in] onlyIfNotEmpty When true, do not set the attribute if @a value is empty.
+            //!
+            void setAttribute(const UString& name, const UString& value, bool onlyIfNotEmpty = false);
+
+            //!
+            //! Set a bool attribute of the current element.
+            //! @param [in] name Attribute name.
+            //! @param [in] value Attribute value.
+            //!
+            void setBoolAttribute(const UString& name, bool value)
+            {
+                setAttribute(name, UString::TrueFalse(value));
+            }
+
+            //!
+            //! Set an optional bool attribute of the current element.
+            //! @param [in] name Attribute name.
+            //! @param [in] value Attribute value. If the variable is not set, no attribute is set.
+            //!
+            void setOptionalBoolAttribute(const UString& name, const Variable<bool>& value)
+            {
+                if (value.set()) {
+                    setBoolAttribute(name, value.value());
+                }
+            }
+
+            //!
+            //! Set an attribute with an integer value of the current element.
+            //! @tparam INT An integer type.
+            //! @param [in] name Attribute name.
+            //! @param [in] value Attribute value.
+            //! @param [in] hexa If true, use an hexadecimal representation (0x...).
+            //!
+            template <typename INT, typename std::enable_if<std::is_integral<INT>::value>::type* = nullptr>
+            void setIntAttribute(const UString& name, INT value, bool hexa = false)
+            {
+                setAttribute(name, hexa ? UString::Hexa(value) : UString::Decimal(value));
+            }
+
+            //!
+            //! Set an optional attribute with an integer value of the current element.
+            //! @tparam INT An integer type.
+            //! @param [in] name Attribute name.
+            //! @param [in] value Attribute optional value. If the variable is not set, no attribute is set.
+            //! @param [in] hexa If true, use an hexadecimal representation (0x...).
+            //!
+            template <typename INT, typename std::enable_if<std::is_integral<INT>::value>::type* = nullptr>
+            void setOptionalIntAttribute(const UString& name, const Variable<INT>& value, bool hexa = false)
+            {
+                if (value.set()) {
+                    setIntAttribute<INT>(name, value.value(), hexa);
+                }
+            }
+
+            //!
+            //! Set an enumeration attribute of the current element.
+            //! @param [in] definition The definition of enumeration values.
+            //! @param [in] name Attribute name.
+            //! @param [in] value Attribute value.
+            //!
+            void setEnumAttribute(const Enumeration& definition, const UString& name, int value)
+            {
+                setAttribute(name, definition.name(value));
+            }
+
+            //!
+            //! Set an enumeration attribute of the current element.
+            //! @tparam INT An integer type.
+            //! @param [in] definition The definition of enumeration values.
+            //! @param [in] name Attribute name.
+            //! @param [in] value Attribute value.
+            //!
+            template <typename INT, typename std::enable_if<std::is_integral<INT>::value>::type* = nullptr>
+            void setIntEnumAttribute(const Enumeration& definition, const UString& name, INT value)
+            {
+                setAttribute(name, definition.name(int(value), true, 2 * sizeof(INT)));
+            }
+
+            //!
+            //! Set a date/time attribute of the current element.
+            //! @param [in] name Attribute name.
+            //! @param [in] value Attribute value.
+            //!
+            void setDateTimeAttribute(const UString& name, const Time& value)
+            {
+                setAttribute(name, Attribute::DateTimeToString(value));
+            }
+
+            //!
+            //! Set a date (without hours) attribute of the current element.
+            //! @param [in] name Attribute name.
+            //! @param [in] value Attribute value.
+            //!
+            void setDateAttribute(const UString& name, const Time& value)
+            {
+                setAttribute(name, Attribute::DateToString(value));
+            }
+
+            //!
+            //! Set a time attribute of the current element in "hh:mm:ss" format.
+            //! @param [in] name Attribute name.
+            //! @param [in] value Attribute value.
+            //!
+            void setTimeAttribute(const UString& name, Second value)
+            {
+                setAttribute(name, Attribute::TimeToString(value));
+            }
+
+            //!
+            //! Add a text child in the current element.
+            //! @param [in] text Content of the text.
+            //! @param [in] onlyNotEmpty When true, do not add the text if it is empty.
+            //!
+            void addText(const UString& text, bool onlyNotEmpty = false);
+
+            //!
+            //! Add a text child in the current element, containing hexadecimal data.
+            //! The text is formatted as in xml::Element::addHexaText().
+            //! @param [in] data Address of binary data.
+            //! @param [in] size Size in bytes of binary data.
+            //! @param [in] onlyNotEmpty When true, do not add the text if the data are empty.
+            //!
+            void addHexaText(const void* data, size_t size, bool onlyNotEmpty = false);
+
+            //!
+            //! Add a child element in the current element, containing hexadecimal data.
+            //! @param [in] name Name of the child element.
+            //! @param [in] data Address of binary data.
+            //! @param [in] size Size in bytes of binary data.
+            //! @param [in] onlyNotEmpty When true, do not add the child element if the data are empty.
+            //!
+            void addHexaTextChild(const UString& name, const void* data, size_t size, bool onlyNotEmpty = false);
+
+            //!
+            //! Write a copy of an XML tree as a child element of the current element.
+            //! @param [in] element The XML element to copy. Ignored if null.
+            //!
+            void addElement(const Element* element);
+
+            //!
+            //! Write a copy of the attributes and children of an XML element into the current element.
+            //! @param [in] element The XML element to copy. Ignored if null.
+            //!
+            void addContent(const Element* element);
+
+            //!
+            //! Declare an XML element which is written as first child of the next element.
+            //! The XML element is written after all attributes of the next element which is
+            //! started, before its first child. This is typically used to insert metadata
+            //! in structures which are written by some other code.
+            //! @param [in] element The XML element to copy. It must remain valid until the
+            //! next element is completely written.
+            //!
+            void setNextFirstChild(const Element* element);
+
+            //!
+            //! Start to build the content of the current element using the xml::Element API.
+            //! The caller shall populate the returned element with attributes and children
+            //! and then invoke endDOM(). No other method of the writer shall be called between
+            //! startDOM() and endDOM(). Depending on the subclass, the returned element is
+            //! either a temporary one or the actual current element.
+            //! @return An element which is located at the depth of the current element.
+            //!
+            Element* startDOM();
+
+            //!
+            //! Write the content which was built after startDOM().
+            //!
+            void endDOM();
+
+        protected:
+            //!
+            //! Write the start of a new element (subclass implementation).
+            //! @param [in] name Name of the new element.
+            //!
+            virtual void writeStartElement(const UString& name) = 0;
+
+            //!
+            //! Write the end of the current element (subclass implementation).
+            //!
+            virtual void writeEndElement() = 0;
+
+            //!
+            //! Write an attribute of the current element (subclass implementation).
+            //! @param [in] name Attribute name.
+            //! @param [in] value Attribute value.
+            //!
+            virtual void writeAttribute(const UString& name, const UString& value) = 0;
+
+            //!
+            //! Write a text child in the current element (subclass implementation).
+            //! @param [in] text Content of the text.
+            //! @param [in] cdata The text is a CDATA node.
+            //! @param [in] trimmable The text can be trimmed on output, as in xml::Text::setTrimmable().
+            //!
+            virtual void writeText(const UString& text, bool cdata, bool trimmable) = 0;
+
+            //!
+            //! Write the element which was declared by setNextFirstChild().
+            //! The default implementation writes a copy using addElement(). It is called just
+            //! before the first child or the end of the element, when all attributes are set.
+            //! @param [in] element The XML element to write.
+            //!
+            virtual void writeFirstChild(const Element* element);
+
+            //!
+            //! Get the element to build with startDOM().
+            //! The default implementation returns a temporary element.
+            //! @return An element which is located at the depth of the current element.
+            //!
+            virtual Element* openDOM();
+
+            //!
+            //! Write the element which was built after startDOM().
+            //! The default implementation writes the content of the temporary element and deletes it.
+            //! @param [in,out] element The element which was returned by openDOM().
+            //!
+            virtual void closeDOM(Element* element);
+
+        private:
+            size_t         _depth;        // Depth of the current element.
+            const Element* _next_first;   // First child of the next element.
+            const Element* _first;        // First child of the current element, to write.
+            Element*       _dom;          // Element from startDOM(), null if none.
+            Document       _temp_doc;     // Document to build temporary elements.
+
+            // Write the first child of the current element if there is one.
+            void writePendingFirstChild();
+        };
+    }
+}
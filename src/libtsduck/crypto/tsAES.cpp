@@ -14,6 +14,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsAES.h"
+#include "tsSysInfo.h"
 #include "tsRotate.h"
 
 #define BYTE(x,n) (((x) >> (8 * (n))) & 255)
@@ -1012,6 +1013,88 @@ namespace {
 }
 
 
+//----------------------------------------------------------------------------
+// Hardware-accelerated implementation using AES-NI instructions.
+// Independent blocks are interleaved to hide the latency of the instructions.
+// The decryption keys use the "equivalent inverse cipher" schedule, as
+// expected by the AESDEC instruction.
+//----------------------------------------------------------------------------
+
+#if defined(TS_X86_64) && defined(TS_GCC)
+#define TS_AES_NI 1
+
+#include <immintrin.h>
+
+namespace {
+
+    // Check once if the AES instructions shall be used.
+    bool UseAESNI()
+    {
+        static const bool accelerated = ts::SysInfo::Instance()->aesInstructions();
+        return accelerated;
+    }
+
+    // Number of interleaved blocks.
+    constexpr size_t AESNI_INTERLEAVE = 8;
+
+    // One intermediate round and the final round, in encryption or decryption direction.
+    template <bool ENCRYPT>
+    __attribute__((target("aes,sse2")))
+    inline __m128i Round(__m128i block, __m128i key)
+    {
+        return ENCRYPT ? _mm_aesenc_si128(block, key) : _mm_aesdec_si128(block, key);
+    }
+
+    template <bool ENCRYPT>
+    __attribute__((target("aes,sse2")))
+    inline __m128i LastRound(__m128i block, __m128i key)
+    {
+        return ENCRYPT ? _mm_aesenclast_si128(block, key) : _mm_aesdeclast_si128(block, key);
+    }
+
+    // Encrypt or decrypt consecutive blocks. In place processing is allowed.
+    template <bool ENCRYPT>
+    __attribute__((target("aes,sse2")))
+    void ProcessBlocksNI(const uint8_t* keys, int nr, const uint8_t* in, uint8_t* out, size_t count)
+    {
+        __m128i k[ts::AES::MAX_ROUNDS + 1];
+        for (int r = 0; r <= nr; ++r) {
+            k[r] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + 16 * r));
+        }
+
+        while (count >= AESNI_INTERLEAVE) {
+            __m128i b[AESNI_INTERLEAVE];
+            for (size_t i = 0; i < AESNI_INTERLEAVE; ++i) {
+                b[i] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16 * i)), k[0]);
+            }
+            for (int r = 1; r < nr; ++r) {
+                for (size_t i = 0; i < AESNI_INTERLEAVE; ++i) {
+                    b[i] = Round<ENCRYPT>(b[i], k[r]);
+                }
+            }
+            for (size_t i = 0; i < AESNI_INTERLEAVE; ++i) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16 * i), LastRound<ENCRYPT>(b[i], k[nr]));
+            }
+            in += 16 * AESNI_INTERLEAVE;
+            out += 16 * AESNI_INTERLEAVE;
+            count -= AESNI_INTERLEAVE;
+        }
+
+        for (; count > 0; --count) {
+            __m128i b = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), k[0]);
+            for (int r = 1; r < nr; ++r) {
+                b = Round<ENCRYPT>(b, k[r]);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), LastRound<ENCRYPT>(b, k[nr]));
+            in += 16;
+            out += 16;
+        }
+    }
+}
+
+#endif
+
+
 //----------------------------------------------------------------------------
 // Schedule a new key. If rounds is zero, the default is used.
 //----------------------------------------------------------------------------
@@ -1164,24 +1247,24 @@ bool ts::AES::setKeyImpl(const void* key_, size_t key_length, size_t rounds)
     *rk++ = *rrk++;
     *rk   = *rrk;
 
+    // Same keys in byte order, for hardware implementations.
+    for (i = 0; i < 4 * (_Nr + 1); i++) {
+        PutUInt32(_eKb + 4 * i, _eK[i]);
+        PutUInt32(_dKb + 4 * i, _dK[i]);
+    }
+
     return true;
 }
 
 
 //----------------------------------------------------------------------------
-// Encryption in ECB mode.
+// Software encryption of one block.
 //----------------------------------------------------------------------------
 
-bool ts::AES::encryptImpl(const void* plain, size_t plain_length, void* cipher, size_t cipher_maxsize, size_t* cipher_length)
+void ts::AES::encryptBlock(const uint8_t* pt, uint8_t* ct) const
 {
-    if (plain_length != BLOCK_SIZE || cipher_maxsize < BLOCK_SIZE) {
-        return false;
-    }
-
-    const uint8_t* pt = reinterpret_cast<const uint8_t*> (plain);
-    uint8_t* ct = reinterpret_cast<uint8_t*> (cipher);
-
-    uint32_t s0, s1, s2, s3, t0, t1, t2, t3, *rk;
+    uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+    const uint32_t* rk;
     int Nr, r;
 
     Nr = _Nr;
@@ -1284,29 +1367,17 @@ bool ts::AES::encryptImpl(const void* plain, size_t plain_length, void* cipher,
         (Te4_0[BYTE (t2, 0)]) ^
         rk[3];
     PutUInt32 (ct+12, s3);
-
-    if (cipher_length != nullptr) {
-        *cipher_length = BLOCK_SIZE;
-    }
-
-    return true;
 }
 
 
 //----------------------------------------------------------------------------
-// Decryption in ECB mode.
+// Software decryption of one block.
 //----------------------------------------------------------------------------
 
-bool ts::AES::decryptImpl(const void* cipher, size_t cipher_length, void* plain, size_t plain_maxsize, size_t* plain_length)
+void ts::AES::decryptBlock(const uint8_t* ct, uint8_t* pt) const
 {
-    if (cipher_length != BLOCK_SIZE || plain_maxsize < BLOCK_SIZE) {
-        return false;
-    }
-
-    const uint8_t* ct = reinterpret_cast<const uint8_t*> (cipher);
-    uint8_t* pt = reinterpret_cast<uint8_t*> (plain);
-
-    uint32_t s0, s1, s2, s3, t0, t1, t2, t3, *rk;
+    uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+    const uint32_t* rk;
     int Nr, r;
 
     Nr = _Nr;
@@ -1410,11 +1481,77 @@ bool ts::AES::decryptImpl(const void* cipher, size_t cipher_length, void* plain,
         (Td4[BYTE (t0, 0)] & 0x000000ff) ^
         rk[3];
     PutUInt32 (pt+12, s3);
+}
+
+
+//----------------------------------------------------------------------------
+// Encryption in ECB mode.
+//----------------------------------------------------------------------------
+
+bool ts::AES::encryptImpl(const void* plain, size_t plain_length, void* cipher, size_t cipher_maxsize, size_t* cipher_length)
+{
+    if (plain_length != BLOCK_SIZE || cipher_maxsize < BLOCK_SIZE) {
+        return false;
+    }
+    if (cipher_length != nullptr) {
+        *cipher_length = BLOCK_SIZE;
+    }
+    return encryptBlocksImpl(plain, cipher, 1);
+}
+
+bool ts::AES::encryptBlocksImpl(const void* plain, void* cipher, size_t count)
+{
+    const uint8_t* pt = reinterpret_cast<const uint8_t*>(plain);
+    uint8_t* ct = reinterpret_cast<uint8_t*>(cipher);
 
+#if defined(TS_AES_NI)
+    if (UseAESNI()) {
+        ProcessBlocksNI<true>(_eKb, _Nr, pt, ct, count);
+        return true;
+    }
+#endif
+
+    for (size_t i = 0; i < count; ++i) {
+        encryptBlock(pt, ct);
+        pt += BLOCK_SIZE;
+        ct += BLOCK_SIZE;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Decryption in ECB mode.
+//----------------------------------------------------------------------------
+
+bool ts::AES::decryptImpl(const void* cipher, size_t cipher_length, void* plain, size_t plain_maxsize, size_t* plain_length)
+{
+    if (cipher_length != BLOCK_SIZE || plain_maxsize < BLOCK_SIZE) {
+        return false;
+    }
     if (plain_length != nullptr) {
         *plain_length = BLOCK_SIZE;
     }
+    return decryptBlocksImpl(cipher, plain, 1);
+}
+
+bool ts::AES::decryptBlocksImpl(const void* cipher, void* plain, size_t count)
+{
+    const uint8_t* ct = reinterpret_cast<const uint8_t*>(cipher);
+    uint8_t* pt = reinterpret_cast<uint8_t*>(plain);
+
+#if defined(TS_AES_NI)
+    if (UseAESNI()) {
+        ProcessBlocksNI<false>(_dKb, _Nr, ct, pt, count);
+        return true;
+    }
+#endif
 
+    for (size_t i = 0; i < count; ++i) {
+        decryptBlock(ct, pt);
+        ct += BLOCK_SIZE;
+        pt += BLOCK_SIZE;
+    }
     return true;
 }
 
@@ -1426,7 +1563,9 @@ bool ts::AES::decryptImpl(const void* cipher, size_t cipher_length, void* plain,
 ts::AES::AES() :
     _Nr(0),
     _eK(),
-    _dK()
+    _dK(),
+    _eKb(),
+    _dKb()
 {
 }
 
@@ -40,6 +40,10 @@ namespace ts {
     //! AES block cipher
     //! @ingroup crypto
     //!
+    //! On CPU's with AES instructions (AES-NI on Intel x86-64), a hardware-accelerated
+    //! implementation is used. Otherwise, a portable table-based implementation is used.
+    //! @see SysInfo::aesInstructions()
+    //!
     class TSDUCKDLL AES: public BlockCipher
     {
         TS_NOCOPY(AES);
@@ -67,10 +71,18 @@ namespace ts {
         virtual bool setKeyImpl(const void* key, size_t key_length, size_t rounds) override;
         virtual bool encryptImpl(const void* plain, size_t plain_length, void* cipher, size_t cipher_maxsize, size_t* cipher_length) override;
         virtual bool decryptImpl(const void* cipher, size_t cipher_length, void* plain, size_t plain_maxsize, size_t* plain_length) override;
+        virtual bool encryptBlocksImpl(const void* plain, void* cipher, size_t count) override;
+        virtual bool decryptBlocksImpl(const void* cipher, void* plain, size_t count) override;
 
     private:
-        int      _Nr;     //!< Number of rounds
-        uint32_t _eK[60]; //!< Scheduled encryption keys
-        uint32_t _dK[60]; //!< Scheduled decryption keys
+        int      _Nr;        //!< Number of rounds
+        uint32_t _eK[60];    //!< Scheduled encryption keys
+        uint32_t _dK[60];    //!< Scheduled decryption keys
+        uint8_t  _eKb[240];  //!< Scheduled encryption keys, in byte order, for hardware acceleration
+        uint8_t  _dKb[240];  //!< Scheduled decryption keys, in byte order, for hardware acceleration
+
+        // Software implementation of one block encryption and decryption.
+        void encryptBlock(const uint8_t* pt, uint8_t* ct) const;
+        void decryptBlock(const uint8_t* ct, uint8_t* pt) const;
     };
 }
@@ -185,3 +185,66 @@ bool ts::BlockCipher::decryptInPlaceImpl(void* data, size_t data_length, size_t*
     const size_t plain_max_size = max_actual_length != nullptr ? *max_actual_length : data_length;
     return decryptImpl(cipher.data(), cipher.size(), data, plain_max_size, max_actual_length);
 }
+
+
+//----------------------------------------------------------------------------
+// Encrypt or decrypt several consecutive blocks of data.
+//----------------------------------------------------------------------------
+
+bool ts::BlockCipher::encryptBlocks(const void* plain, void* cipher, size_t count)
+{
+    return allowEncrypt() && encryptBlocksImpl(plain, cipher, count);
+}
+
+bool ts::BlockCipher::decryptBlocks(const void* cipher, void* plain, size_t count)
+{
+    return allowDecrypt() && decryptBlocksImpl(cipher, plain, count);
+}
+
+bool ts::BlockCipher::encryptBlocksImpl(const void* plain, void* cipher, size_t count)
+{
+    const size_t bsize = blockSize();
+    const uint8_t* pt = reinterpret_cast<const uint8_t*>(plain);
+    uint8_t* ct = reinterpret_cast<uint8_t*>(cipher);
+
+    // Use an intermediate copy of the input block when processing in place.
+    ByteBlock work(pt == ct ? bsize : 0);
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* in = pt;
+        if (pt == ct) {
+            ::memcpy(work.data(), pt, bsize);
+            in = work.data();
+        }
+        if (!encryptImpl(in, bsize, ct, bsize, nullptr)) {
+            return false;
+        }
+        pt += bsize;
+        ct += bsize;
+    }
+    return true;
+}
+
+bool ts::BlockCipher::decryptBlocksImpl(const void* cipher, void* plain, size_t count)
+{
+    const size_t bsize = blockSize();
+    const uint8_t* ct = reinterpret_cast<const uint8_t*>(cipher);
+    uint8_t* pt = reinterpret_cast<uint8_t*>(plain);
+
+    // Use an intermediate copy of the input block when processing in place.
+    ByteBlock work(pt == ct ? bsize : 0);
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* in = ct;
+        if (pt == ct) {
+            ::memcpy(work.data(), ct, bsize);
+            in = work.data();
+        }
+        if (!decryptImpl(in, bsize, pt, bsize, nullptr)) {
+            return false;
+        }
+        ct += bsize;
+        pt += bsize;
+    }
+    return true;
+}
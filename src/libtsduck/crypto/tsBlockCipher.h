@@ -189,6 +189,36 @@ namespace ts {
         //!
         bool decryptInPlace(void* data, size_t data_length, size_t* max_actual_length = nullptr);
 
+        //!
+        //! Encrypt several consecutive blocks of data, each of them independently (ECB).
+        //!
+        //! This method is used by cipher chainings to process multiple blocks at once.
+        //! Block ciphers which can process several blocks in parallel provide an optimized
+        //! implementation. The usage counter of the key is incremented only once.
+        //!
+        //! @param [in] plain Address of plain text. Its size must be @a count times the block size.
+        //! @param [out] cipher Address of buffer for cipher text. Its size must be @a count times
+        //! the block size. The plain and cipher text buffers can be identical but shall not partially overlap.
+        //! @param [in] count Number of blocks to encrypt.
+        //! @return True on success, false on error.
+        //!
+        bool encryptBlocks(const void* plain, void* cipher, size_t count);
+
+        //!
+        //! Decrypt several consecutive blocks of data, each of them independently (ECB).
+        //!
+        //! This method is used by cipher chainings to process multiple blocks at once.
+        //! Block ciphers which can process several blocks in parallel provide an optimized
+        //! implementation. The usage counter of the key is incremented only once.
+        //!
+        //! @param [in] cipher Address of cipher text. Its size must be @a count times the block size.
+        //! @param [out] plain Address of buffer for plain text. Its size must be @a count times
+        //! the block size. The plain and cipher text buffers can be identical but shall not partially overlap.
+        //! @param [in] count Number of blocks to decrypt.
+        //! @return True on success, false on error.
+        //!
+        bool decryptBlocks(const void* cipher, void* plain, size_t count);
+
         //!
         //! Get the number of times the current key was used for encryption.
         //! @return The number of times the current key was used for encryption.
@@ -314,6 +344,42 @@ namespace ts {
         //!
         virtual bool decryptInPlaceImpl(void* data, size_t data_length, size_t* max_actual_length);
 
+        //!
+        //! Encrypt several consecutive blocks of data (implementation of algorithm-specific part).
+        //! The default implementation is to call encryptImpl() for each block.
+        //! A subclass may provide a more efficient implementation.
+        //! @param [in] plain Address of plain text.
+        //! @param [out] cipher Address of buffer for cipher text.
+        //! @param [in] count Number of blocks to encrypt.
+        //! @return True on success, false on error.
+        //!
+        virtual bool encryptBlocksImpl(const void* plain, void* cipher, size_t count);
+
+        //!
+        //! Decrypt several consecutive blocks of data (implementation of algorithm-specific part).
+        //! The default implementation is to call decryptImpl() for each block.
+        //! A subclass may provide a more efficient implementation.
+        //! @param [in] cipher Address of cipher text.
+        //! @param [out] plain Address of buffer for plain text.
+        //! @param [in] count Number of blocks to decrypt.
+        //! @return True on success, false on error.
+        //!
+        virtual bool decryptBlocksImpl(const void* cipher, void* plain, size_t count);
+
+        //!
+        //! Check if encryption is allowed with the current key, increment the usage counter.
+        //! To be used by subclasses which provide additional encryption methods.
+        //! @return True if encryption is allowed.
+        //!
+        bool allowEncrypt();
+
+        //!
+        //! Check if decryption is allowed with the current key, increment the usage counter.
+        //! To be used by subclasses which provide additional decryption methods.
+        //! @return True if decryption is allowed.
+        //!
+        bool allowDecrypt();
+
     private:
         bool      _key_set;                // Current key successfully set.
         int       _cipher_id;              // Cipher identity (from application).
@@ -323,9 +389,5 @@ namespace ts {
         size_t    _key_decrypt_max;        // Maximum number of times a key should be used for decryption.
         ByteBlock _current_key;            // Current unscheduled key.
         BlockCipherAlertInterface* _alert; // Alert handler.
-
-        // Check if encryption or decryption is allowed. Increment counters.
-        bool allowEncrypt();
-        bool allowDecrypt();
     };
 }
@@ -33,6 +33,7 @@
 //----------------------------------------------------------------------------
 
 #pragma once
+#include "tsMemory.h"
 
 
 //----------------------------------------------------------------------------
@@ -60,9 +61,7 @@ bool ts::CBC<CIPHER>::encryptImpl(const void* plain, size_t plain_length, void*
 
     while (plain_length > 0) {
         // work = previous-cipher XOR plain-text
-        for (size_t i = 0; i < this->block_size; ++i) {
-            this->work[i] = previous[i] ^ pt[i];
-        }
+        MemXor(this->work.data(), previous, pt, this->block_size);
         // cipher-text = encrypt (work)
         if (!this->algo->encrypt(this->work.data(), this->block_size, ct, this->block_size)) {
             return false;
@@ -88,7 +87,7 @@ bool ts::CBC<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, void
 {
     if (this->algo == nullptr ||
         this->iv.size() != this->block_size ||
-        this->work.size() < this->block_size ||
+        this->work.size() < (1 + CipherChaining::PARALLEL_BLOCKS) * this->block_size ||
         cipher_length % this->block_size != 0 ||
         plain_maxsize < cipher_length)
     {
@@ -98,25 +97,32 @@ bool ts::CBC<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, void
         *plain_length = cipher_length;
     }
 
-    const uint8_t* previous = this->iv.data();
+    // Unlike encryption, all blocks can be deciphered independently. We decrypt
+    // up to PARALLEL_BLOCKS blocks at a time. The work buffer contains the previous
+    // cipher block, followed by a copy of the cipher blocks which are processed.
     const uint8_t* ct = reinterpret_cast<const uint8_t*> (cipher);
     uint8_t* pt = reinterpret_cast<uint8_t*> (plain);
+    uint8_t* previous = this->work.data();
+    uint8_t* current = previous + this->block_size;
+    ::memcpy(previous, this->iv.data(), this->block_size);
 
     while (cipher_length > 0) {
-        // work = decrypt (cipher-text)
-        if (!this->algo->decrypt(ct, this->block_size, this->work.data(), this->block_size)) {
+        const size_t count = std::min(cipher_length / this->block_size, CipherChaining::PARALLEL_BLOCKS);
+        const size_t size = count * this->block_size;
+        // Keep a copy of cipher-text, in case of in-place decryption.
+        ::memcpy(current, ct, size);
+        // plain-text = decrypt (cipher-text)
+        if (!this->algo->decryptBlocks(current, pt, count)) {
             return false;
         }
-        // plain-text = previous-cipher XOR work
-        for (size_t i = 0; i < this->block_size; ++i) {
-            pt[i] = previous[i] ^ this->work[i];
-        }
-        // previous-cipher = cipher-text
-        previous = ct;
-        // advance one block
-        ct += this->block_size;
-        pt += this->block_size;
-        cipher_length -= this->block_size;
+        // plain-text = previous-cipher XOR plain-text, for all blocks
+        MemXor(pt, pt, previous, size);
+        // previous-cipher = last cipher-text
+        ::memcpy(previous, previous + size, this->block_size);
+        // advance the processed blocks
+        ct += size;
+        pt += size;
+        cipher_length -= size;
     }
 
     return true;
@@ -144,3 +150,22 @@ ts::UString ts::CBC<CIPHER>::name() const
 {
     return this->algo == nullptr ? UString() : this->algo->name() + u"-CBC";
 }
+
+
+//----------------------------------------------------------------------------
+// Encryption and decryption in place, without intermediate copy.
+// Each plain text block is read before the corresponding cipher text block is written.
+// In decryption, the cipher text is copied in the work buffer before being overwritten.
+//----------------------------------------------------------------------------
+
+template<class CIPHER>
+bool ts::CBC<CIPHER>::encryptInPlaceImpl(void* data, size_t data_length, size_t* max_actual_length)
+{
+    return encryptImpl(data, data_length, data, max_actual_length != nullptr ? *max_actual_length : data_length, max_actual_length);
+}
+
+template<class CIPHER>
+bool ts::CBC<CIPHER>::decryptInPlaceImpl(void* data, size_t data_length, size_t* max_actual_length)
+{
+    return decryptImpl(data, data_length, data, max_actual_length != nullptr ? *max_actual_length : data_length, max_actual_length);
+}
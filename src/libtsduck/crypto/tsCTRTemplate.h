@@ -37,7 +37,7 @@
 
 template<class CIPHER>
 ts::CTR<CIPHER>::CTR(size_t counter_bits) :
-    CipherChainingTemplate<CIPHER>(1, 1, 2),
+    CipherChainingTemplate<CIPHER>(1, 1, 1 + CipherChaining::PARALLEL_BLOCKS),
     _counter_bits(0)
 {
     setCounterBits(counter_bits);
@@ -92,7 +92,7 @@ void ts::CTR<CIPHER>::setCounterBits(size_t counter_bits)
 template<class CIPHER>
 bool ts::CTR<CIPHER>::incrementCounter()
 {
-    // We must have two work blocks.
+    // We must have at least two work blocks.
     if (this->work.size() < 2 * this->block_size) {
         return false;
     }
@@ -121,7 +121,7 @@ bool ts::CTR<CIPHER>::encryptImpl(const void* plain, size_t plain_length, void*
 {
     if (this->algo == nullptr ||
         this->iv.size() != this->block_size ||
-        this->work.size() < 2 * this->block_size ||
+        this->work.size() < (1 + CipherChaining::PARALLEL_BLOCKS) * this->block_size ||
         cipher_maxsize < plain_length)
     {
         return false;
@@ -134,26 +134,30 @@ bool ts::CTR<CIPHER>::encryptImpl(const void* plain, size_t plain_length, void*
     ::memcpy(this->work.data(), this->iv.data(), this->block_size);
 
     // Loop on all blocks, including last truncated one.
+    // The key stream is computed for up to PARALLEL_BLOCKS blocks at a time in work[1..].
 
     const uint8_t* pt = reinterpret_cast<const uint8_t*>(plain);
     uint8_t* ct = reinterpret_cast<uint8_t*>(cipher);
+    uint8_t* stream = this->work.data() + this->block_size;
 
     while (plain_length > 0) {
-        // work[1] = encrypt(work[0])
-        if (!this->algo->encrypt(this->work.data(), this->block_size, this->work.data() + this->block_size, this->block_size)) {
-            return false;
-        }
-        // This block size:
-        const size_t size = std::min(plain_length, this->block_size);
-        // cipher-text = plain-text XOR work[1]
-        for (size_t i = 0; i < size; ++i) {
-            ct[i] = this->work[this->block_size + i] ^ pt[i];
+        const size_t count = std::min((plain_length + this->block_size - 1) / this->block_size, CipherChaining::PARALLEL_BLOCKS);
+        // work[1..count] = work[0], work[0] + 1, ..., work[0] += count
+        for (size_t i = 0; i < count; ++i) {
+            ::memcpy(stream + i * this->block_size, this->work.data(), this->block_size);
+            if (!incrementCounter()) {
+                return false;
+            }
         }
-        // work[0] += 1
-        if (!incrementCounter()) {
+        // work[1..count] = encrypt(work[1..count])
+        if (!this->algo->encryptBlocks(stream, stream, count)) {
             return false;
         }
-        // advance one block
+        // This chunk size:
+        const size_t size = std::min(plain_length, count * this->block_size);
+        // cipher-text = plain-text XOR work[1..count]
+        MemXor(ct, stream, pt, size);
+        // advance the processed blocks
         ct += size;
         pt += size;
         plain_length -= size;
@@ -172,3 +176,21 @@ bool ts::CTR<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, void
     // With CTR, the encryption and decryption are identical operations.
     return this->encryptImpl(cipher, cipher_length, plain, plain_maxsize, plain_length);
 }
+
+
+//----------------------------------------------------------------------------
+// Encryption and decryption in place, without intermediate copy.
+// Each byte of the message is XOR'ed in place with the key stream.
+//----------------------------------------------------------------------------
+
+template<class CIPHER>
+bool ts::CTR<CIPHER>::encryptInPlaceImpl(void* data, size_t data_length, size_t* max_actual_length)
+{
+    return encryptImpl(data, data_length, data, max_actual_length != nullptr ? *max_actual_length : data_length, max_actual_length);
+}
+
+template<class CIPHER>
+bool ts::CTR<CIPHER>::decryptInPlaceImpl(void* data, size_t data_length, size_t* max_actual_length)
+{
+    return decryptImpl(data, data_length, data, max_actual_length != nullptr ? *max_actual_length : data_length, max_actual_length);
+}
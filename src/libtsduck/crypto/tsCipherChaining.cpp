@@ -29,6 +29,10 @@
 
 #include "tsCipherChaining.h"
 
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::CipherChaining::PARALLEL_BLOCKS;
+#endif
+
 
 //----------------------------------------------------------------------------
 // Constructor for subclasses
@@ -92,6 +92,13 @@ namespace ts {
         virtual bool residueAllowed() const = 0;
 
     protected:
+        //!
+        //! Number of blocks which are processed at once by the chaining modes which can
+        //! use independent block operations (ECB, CTR, CBC decryption). This lets block ciphers
+        //! with a pipelined implementation process several blocks in parallel.
+        //!
+        static constexpr size_t PARALLEL_BLOCKS = 8;
+
         // Protected fields, for chaining mode subclass implementation.
         BlockCipher* algo;        //!< An instance of the block cipher.
         const size_t block_size;  //!< Shortcut for algo->blockSize().
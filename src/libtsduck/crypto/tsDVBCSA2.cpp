@@ -565,6 +565,104 @@ void ts::DVBCSA2::BlockCipher::encipher (const uint8_t *bd, uint8_t *ib)
 }
 
 
+//----------------------------------------------------------------------------
+// Block cipher on several independent blocks, used in batch processing.
+// Each block is a little-endian 64-bit value: byte n contains R[n+1].
+// One round is a byte rotation of the value plus a few "xor", using
+// tables which combine the s-box and the permutation. Several blocks are
+// interleaved to hide the latency of the table lookups.
+//----------------------------------------------------------------------------
+
+namespace {
+    class BlockTables
+    {
+    public:
+        uint64_t enc[256];  // R[8] ^= sbox_out, R[6] ^= perm_out
+        uint64_t dec[256];  // R[1], R[3], R[4], R[5] ^= sbox_out, R[7] ^= perm_out
+        BlockTables();
+    };
+
+    BlockTables::BlockTables()
+    {
+        for (size_t i = 0; i < 256; ++i) {
+            const uint64_t sbox_out = block_sbox[i];
+            const uint64_t perm_out = uint64_t(block_perm[sbox_out]);
+            enc[i] = (sbox_out << 56) | (perm_out << 40);
+            dec[i] = (sbox_out * 0x0000000101010001) | (perm_out << 48);
+        }
+    }
+
+    const BlockTables& GetBlockTables()
+    {
+        // Thread-safe one-time initialization.
+        static const BlockTables tables;
+        return tables;
+    }
+
+    template <size_t N>
+    inline void EncipherBlocks(const int* kk, const uint64_t* table, uint64_t* blocks)
+    {
+        uint64_t r[N];
+        for (size_t n = 0; n < N; ++n) {
+            r[n] = blocks[n];
+        }
+        for (int i = 1; i <= 56; i++) {
+            for (size_t n = 0; n < N; ++n) {
+                // R[1]..R[7] = previous R[2]..R[8], R[8] = R[1], R[2..4] ^= R[1]
+                const uint64_t t = table[(uint64_t(kk[i]) ^ (r[n] >> 56)) & 0xFF];
+                r[n] = ((r[n] >> 8) | (r[n] << 56)) ^ t ^ ((r[n] & 0xFF) * 0x0000000001010100);
+            }
+        }
+        for (size_t n = 0; n < N; ++n) {
+            blocks[n] = r[n];
+        }
+    }
+
+    template <size_t N>
+    inline void DecipherBlocks(const int* kk, const uint64_t* table, uint64_t* blocks)
+    {
+        uint64_t r[N];
+        for (size_t n = 0; n < N; ++n) {
+            r[n] = blocks[n];
+        }
+        for (int i = 56; i > 0; i--) {
+            for (size_t n = 0; n < N; ++n) {
+                // R[2]..R[8] = previous R[1]..R[7], R[1] = R[8], R[3..5] ^= R[8]
+                const uint64_t t = table[(uint64_t(kk[i]) ^ (r[n] >> 48)) & 0xFF];
+                r[n] = ((r[n] << 8) | (r[n] >> 56)) ^ t ^ ((r[n] >> 56) * 0x0000000101010000);
+            }
+        }
+        for (size_t n = 0; n < N; ++n) {
+            blocks[n] = r[n];
+        }
+    }
+}
+
+void ts::DVBCSA2::BlockCipher::encipherBatch(uint64_t* blocks, size_t count) const
+{
+    const uint64_t* table = GetBlockTables().enc;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        EncipherBlocks<4>(_kk, table, blocks + i);
+    }
+    for (; i < count; ++i) {
+        EncipherBlocks<1>(_kk, table, blocks + i);
+    }
+}
+
+void ts::DVBCSA2::BlockCipher::decipherBatch(uint64_t* blocks, size_t count) const
+{
+    const uint64_t* table = GetBlockTables().dec;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        DecipherBlocks<4>(_kk, table, blocks + i);
+    }
+    for (; i < count; ++i) {
+        DecipherBlocks<1>(_kk, table, blocks + i);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Set the control word for subsequent encrypt/decrypt operations
 //----------------------------------------------------------------------------
@@ -718,6 +816,410 @@ bool ts::DVBCSA2::decryptInPlaceImpl(void* addr, size_t size, size_t* max_actual
 }
 
 
+//----------------------------------------------------------------------------
+// Bitsliced stream cipher, used in batch processing.
+//
+// In the bitsliced representation, each bit of the stream cipher state is a
+// "slice", a word where bit number k is the state bit for data area number k.
+// All data areas are processed in parallel using logical operations only.
+// All areas use the same control word, so the initial state is the same for
+// all of them. The states diverge during the initialization phase, using the
+// first block of each data area.
+//
+// The s-boxes are evaluated in algebraic normal form (a "xor" of "and" of
+// inputs). The masks were computed from the tables sbox1 to sbox7 above:
+// bit n in a mask means that the monomial with inputs n is present.
+//----------------------------------------------------------------------------
+
+namespace {
+
+#if defined(TS_GCC)
+    // Vector of two 64-bit integers, SSE2 on Intel x86-64, NEON on Arm64.
+    typedef uint64_t Slice __attribute__((vector_size(16)));
+    inline uint64_t GetSliceWord(const Slice& s, size_t i) { return s[i]; }
+    inline void SetSliceWord(Slice& s, size_t i, uint64_t value) { s[i] = value; }
+#else
+    typedef uint64_t Slice;
+    inline uint64_t GetSliceWord(const Slice& s, size_t) { return s; }
+    inline void SetSliceWord(Slice& s, size_t, uint64_t value) { s = value; }
+#endif
+
+    // Number of 64-bit words per slice and number of data areas which are processed in parallel.
+    constexpr size_t SLICE_WORDS = sizeof(Slice) / sizeof(uint64_t);
+    constexpr size_t SLICE_BITS = 64 * SLICE_WORDS;
+
+    // A slice with all bits set to the same value.
+    inline Slice SliceOf(bool bit)
+    {
+        const Slice zero = Slice();
+        return bit ? ~zero : zero;
+    }
+
+    // Index of the lowest bit which is set in a mask.
+    constexpr uint32_t LowBit(uint32_t mask)
+    {
+        return (mask & 1) != 0 ? 0 : 1 + LowBit(mask >> 1);
+    }
+
+    // Monomial (logical "and") of inputs x[i] for all bits i which are set in N.
+    template <uint32_t N>
+    struct Monomial
+    {
+        static inline Slice eval(const Slice* x) { return Monomial<(N & (N - 1))>::eval(x) & x[LowBit(N)]; }
+    };
+    template <>
+    struct Monomial<0>
+    {
+        static inline Slice eval(const Slice*) { return ~Slice(); }
+    };
+
+    // Boolean function in algebraic normal form: "xor" of monomials n for all bits n which are set in MASK.
+    template <uint32_t MASK>
+    struct ANF
+    {
+        static inline Slice eval(const Slice* x) { return ANF<(MASK & (MASK - 1))>::eval(x) ^ Monomial<LowBit(MASK)>::eval(x); }
+    };
+    template <>
+    struct ANF<0>
+    {
+        static inline Slice eval(const Slice*) { return Slice(); }
+    };
+
+    // Stream cipher s-box: 5 input bits (x4 is the most significant one), 2 output bits.
+    template <uint32_t MASK1, uint32_t MASK0>
+    inline void SBox(Slice& out1, Slice& out0, const Slice& x4, const Slice& x3, const Slice& x2, const Slice& x1, const Slice& x0)
+    {
+        const Slice x[5] = {x0, x1, x2, x3, x4};
+        out1 = ANF<MASK1>::eval(x);
+        out0 = ANF<MASK0>::eval(x);
+    }
+
+    // Transpose a 64x64 bit matrix: bit j of a[i] is swapped with bit i of a[j].
+    void Transpose64(uint64_t* a)
+    {
+        uint64_t mask = 0x00000000FFFFFFFF;
+        for (size_t width = 32; width != 0; width >>= 1, mask ^= mask << width) {
+            for (size_t i = 0; i < 64; i = (i + width + 1) & ~width) {
+                const uint64_t t = ((a[i] >> width) ^ a[i + width]) & mask;
+                a[i] ^= t << width;
+                a[i + width] ^= t;
+            }
+        }
+    }
+
+    // Load 8 bytes at a given offset in each data area into 64 slices.
+    // Slice 8*i+b contains bit b of byte i. Missing data areas are zero.
+    void LoadSlices(Slice* slices, uint8_t* const* data, size_t offset, size_t count)
+    {
+        for (size_t w = 0; w < SLICE_WORDS; ++w) {
+            uint64_t rows[64];
+            for (size_t i = 0; i < 64; ++i) {
+                const size_t k = 64 * w + i;
+                rows[i] = k < count ? ts::GetUInt64LE(data[k] + offset) : 0;
+            }
+            Transpose64(rows);
+            for (size_t i = 0; i < 64; ++i) {
+                SetSliceWord(slices[i], w, rows[i]);
+            }
+        }
+    }
+
+    // Bitsliced stream cipher.
+    class StreamSlices
+    {
+    public:
+        // Initialize the state of all data areas from the control word.
+        void init(const uint8_t* key);
+
+        // Initialization phase using the first block of each data area, as 64 slices.
+        void load(const Slice* in);
+
+        // Generate the next 8 bytes of key stream for each data area, as 64 slices.
+        void generate(Slice* out);
+
+    private:
+        Slice  _a[10][4];   // Registers A[1]..A[10], 4 bits each, circular buffer.
+        Slice  _b[10][4];   // Registers B[1]..B[10], 4 bits each, circular buffer.
+        size_t _first;      // Index of A[1] and B[1] in circular buffers.
+        Slice  _x[4];
+        Slice  _y[4];
+        Slice  _z[4];
+        Slice  _d[4];
+        Slice  _e[4];
+        Slice  _f[4];
+        Slice  _p;
+        Slice  _q;
+        Slice  _r;
+
+        // One iteration, 2 bits of output. The inputs are used in the initialization phase only.
+        void step(const Slice* in_a, const Slice* in_b, Slice& out1, Slice& out0);
+    };
+
+    void StreamSlices::init(const uint8_t* key)
+    {
+        // A[1]..A[8] = first 32 bits of key, B[1]..B[8] = last 32 bits of key, all other registers are zero.
+        _first = 0;
+        for (size_t n = 0; n < 10; ++n) {
+            const int nib_a = n >= 8 ? 0 : (key[n / 2] >> (n % 2 == 0 ? 4 : 0)) & 0x0F;
+            const int nib_b = n >= 8 ? 0 : (key[4 + n / 2] >> (n % 2 == 0 ? 4 : 0)) & 0x0F;
+            for (size_t b = 0; b < 4; ++b) {
+                _a[n][b] = SliceOf(((nib_a >> b) & 1) != 0);
+                _b[n][b] = SliceOf(((nib_b >> b) & 1) != 0);
+            }
+        }
+        for (size_t b = 0; b < 4; ++b) {
+            _x[b] = _y[b] = _z[b] = _d[b] = _e[b] = _f[b] = Slice();
+        }
+        _p = _q = _r = Slice();
+    }
+
+    void StreamSlices::load(const Slice* in)
+    {
+        Slice out1, out0;
+        for (size_t i = 0; i < 8; ++i) {
+            // Most significant nibble and least significant nibble of input byte.
+            const Slice* in1 = in + 8 * i + 4;
+            const Slice* in2 = in + 8 * i;
+            step(in1, in2, out1, out0);
+            step(in2, in1, out1, out0);
+            step(in1, in2, out1, out0);
+            step(in2, in1, out1, out0);
+        }
+    }
+
+    void StreamSlices::generate(Slice* out)
+    {
+        for (size_t i = 0; i < 8; ++i) {
+            // 2 bits per iteration, most significant bits first.
+            for (size_t j = 0; j < 4; ++j) {
+                step(nullptr, nullptr, out[8 * i + 7 - 2 * j], out[8 * i + 6 - 2 * j]);
+            }
+        }
+    }
+
+    void StreamSlices::step(const Slice* in_a, const Slice* in_b, Slice& out1, Slice& out0)
+    {
+        // Current registers A[1]..A[10] and B[1]..B[10], index 0 unused.
+        const Slice* A[11];
+        const Slice* B[11];
+        for (size_t n = 1; n <= 10; ++n) {
+            A[n] = _a[(_first + n - 1) % 10];
+            B[n] = _b[(_first + n - 1) % 10];
+        }
+
+        // From A[1]..A[10], 35 bits are selected as inputs to 7 s-boxes.
+        Slice s1_1, s1_0, s2_1, s2_0, s3_1, s3_0, s4_1, s4_0, s5_1, s5_0, s6_1, s6_0, s7_1, s7_0;
+        SBox<0x5D59766F, 0x35020B24>(s1_1, s1_0, A[4][0], A[1][2], A[6][1], A[7][3], A[9][0]);
+        SBox<0x1E4001E7, 0x29182835>(s2_1, s2_0, A[2][1], A[3][2], A[6][3], A[7][0], A[9][1]);
+        SBox<0x52FD5FE7, 0x0001012C>(s3_1, s3_0, A[1][3], A[2][0], A[5][1], A[5][3], A[6][2]);
+        SBox<0x5B87419B, 0x5B861A1D>(s4_1, s4_0, A[3][3], A[1][1], A[2][3], A[4][2], A[8][0]);
+        SBox<0x66D66BEF, 0x0FF226B8>(s5_1, s5_0, A[5][2], A[4][3], A[6][0], A[8][1], A[9][2]);
+        SBox<0x02093824, 0x48C854D2>(s6_1, s6_0, A[3][1], A[4][1], A[5][0], A[7][2], A[9][3]);
+        SBox<0x48DA091E, 0x0C0111DA>(s7_1, s7_0, A[2][2], A[3][0], A[7][1], A[8][2], A[8][3]);
+
+        // Extra nibble for T3, from B[1]..B[10].
+        Slice extra_b[4];
+        extra_b[3] = B[3][0] ^ B[6][1] ^ B[7][2] ^ B[9][3];
+        extra_b[2] = B[6][0] ^ B[8][1] ^ B[3][3] ^ B[4][2];
+        extra_b[1] = B[5][3] ^ B[8][2] ^ B[4][0] ^ B[5][1];
+        extra_b[0] = B[9][2] ^ B[6][3] ^ B[3][1] ^ B[8][0];
+
+        // T1 and T2. The inputs are used during the initialization phase only.
+        Slice next_a1[4];
+        Slice next_b1[4];
+        for (size_t b = 0; b < 4; ++b) {
+            next_a1[b] = A[10][b] ^ _x[b];
+            next_b1[b] = B[7][b] ^ B[10][b] ^ _y[b];
+            if (in_a != nullptr) {
+                next_a1[b] ^= _d[b] ^ in_a[b];
+                next_b1[b] ^= in_b[b];
+            }
+        }
+
+        // If p=1, rotate next B[1] left.
+        Slice rotated[4];
+        for (size_t b = 0; b < 4; ++b) {
+            rotated[b] = next_b1[b] ^ (_p & (next_b1[b] ^ next_b1[(b + 3) % 4]));
+        }
+
+        // T3 and T4. If q=1, F = Z + E + r with carry r, else F = E. Then E = previous F.
+        Slice carry = _r;
+        for (size_t b = 0; b < 4; ++b) {
+            const Slice ze = _z[b] ^ _e[b];
+            const Slice sum = ze ^ carry;
+            carry = (_z[b] & _e[b]) | (carry & ze);
+            _d[b] = ze ^ extra_b[b];
+            const Slice next_f = _e[b] ^ (_q & (sum ^ _e[b]));
+            _e[b] = _f[b];
+            _f[b] = next_f;
+        }
+        _r ^= _q & (carry ^ _r);
+
+        // Shift registers A and B: the previous A[10] and B[10] are replaced by the new A[1] and B[1].
+        _first = (_first + 9) % 10;
+        for (size_t b = 0; b < 4; ++b) {
+            _a[_first][b] = next_a1[b];
+            _b[_first][b] = rotated[b];
+        }
+
+        // New X, Y, Z, p, q from the s-boxes outputs.
+        _x[3] = s4_0; _x[2] = s3_0; _x[1] = s2_1; _x[0] = s1_1;
+        _y[3] = s6_0; _y[2] = s5_0; _y[1] = s4_1; _y[0] = s3_1;
+        _z[3] = s2_0; _z[2] = s1_0; _z[1] = s6_1; _z[0] = s5_1;
+        _p = s7_1;
+        _q = s7_0;
+
+        // 2 output bits are a function of the 4 bits of D, xor 2 by 2.
+        out1 = _d[2] ^ _d[3];
+        out0 = _d[0] ^ _d[1];
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Encrypt or decrypt several data areas with the same control word.
+//----------------------------------------------------------------------------
+
+bool ts::DVBCSA2::encryptInPlaceBatch(void* const* data, const size_t* size, size_t count)
+{
+    return processBatch(true, data, size, count);
+}
+
+bool ts::DVBCSA2::decryptInPlaceBatch(void* const* data, const size_t* size, size_t count)
+{
+    return processBatch(false, data, size, count);
+}
+
+bool ts::DVBCSA2::processBatch(bool encrypt, void* const* data, const size_t* size, size_t count)
+{
+    bool ok = data != nullptr && size != nullptr;
+    uint8_t* group_data[SLICE_BITS];
+    size_t group_size[SLICE_BITS];
+    size_t group_count = 0;
+
+    for (size_t i = 0; ok && i < count; ++i) {
+        // Same checks as individual encryption and decryption.
+        if (data[i] == nullptr || size[i] / 8 > MAX_NBLOCKS || !(encrypt ? allowEncrypt() : allowDecrypt()) || !_init) {
+            ok = false;
+        }
+        else if (size[i] >= 8) {
+            // Data areas smaller than 8 bytes are left unscrambled.
+            group_data[group_count] = reinterpret_cast<uint8_t*>(data[i]);
+            group_size[group_count] = size[i];
+            if (++group_count == SLICE_BITS) {
+                processGroup(encrypt, group_data, group_size, group_count);
+                group_count = 0;
+            }
+        }
+    }
+    if (group_count > 0) {
+        processGroup(encrypt, group_data, group_size, group_count);
+    }
+    return ok;
+}
+
+
+//----------------------------------------------------------------------------
+// Encrypt or decrypt a group of valid data areas, at most SLICE_BITS.
+//----------------------------------------------------------------------------
+
+void ts::DVBCSA2::processGroup(bool encrypt, uint8_t* const* data, const size_t* size, size_t count)
+{
+    assert(count <= SLICE_BITS);
+
+    // Maximum number of blocks and of key stream blocks (all blocks except the first one, plus the residue).
+    size_t max_blocks = 0;
+    size_t max_stream = 0;
+    for (size_t k = 0; k < count; ++k) {
+        max_blocks = std::max(max_blocks, size[k] / 8);
+        max_stream = std::max(max_stream, (size[k] + 7) / 8 - 1);
+    }
+
+    // Encryption: block cipher in reverse CBC mode, in place. The IV after the last block is zero.
+    // The blocks of all data areas are processed together, starting from the last block of each area.
+    if (encrypt) {
+        uint64_t blocks[SLICE_BITS];
+        for (size_t step = 0; step < max_blocks; ++step) {
+            size_t bcount = 0;
+            for (size_t k = 0; k < count; ++k) {
+                const size_t nblocks = size[k] / 8;
+                if (step < nblocks) {
+                    const uint8_t* const block = data[k] + 8 * (nblocks - 1 - step);
+                    blocks[bcount++] = GetUInt64LE(block) ^ (step == 0 ? 0 : GetUInt64LE(block + 8));
+                }
+            }
+            _block.encipherBatch(blocks, bcount);
+            bcount = 0;
+            for (size_t k = 0; k < count; ++k) {
+                const size_t nblocks = size[k] / 8;
+                if (step < nblocks) {
+                    PutUInt64LE(data[k] + 8 * (nblocks - 1 - step), blocks[bcount++]);
+                }
+            }
+        }
+    }
+
+    // Stream cipher, bitsliced. The first block is scrambled using the block cipher only.
+    // Its scrambled value is used to initialize the stream cipher.
+    StreamSlices stream;
+    Slice slices[64];
+    stream.init(_key);
+    LoadSlices(slices, data, 0, count);
+    stream.load(slices);
+
+    // Xor each block (except the first one) and the residue with the key stream.
+    for (size_t index = 1; index <= max_stream; ++index) {
+        stream.generate(slices);
+        for (size_t w = 0; w < SLICE_WORDS; ++w) {
+            uint64_t rows[64];
+            for (size_t i = 0; i < 64; ++i) {
+                rows[i] = GetSliceWord(slices[i], w);
+            }
+            Transpose64(rows);
+            for (size_t i = 0; i < 64 && 64 * w + i < count; ++i) {
+                const size_t k = 64 * w + i;
+                const size_t offset = 8 * index;
+                if (offset + 8 <= size[k]) {
+                    PutUInt64LE(data[k] + offset, GetUInt64LE(data[k] + offset) ^ rows[i]);
+                }
+                else if (offset < size[k]) {
+                    uint8_t ostream[8];
+                    PutUInt64LE(ostream, rows[i]);
+                    for (size_t n = 0; offset + n < size[k]; ++n) {
+                        data[k][offset + n] ^= ostream[n];
+                    }
+                }
+            }
+        }
+    }
+
+    // Decryption: block cipher in reverse CBC mode. At this point, all blocks contain the
+    // intermediate blocks (input of the block cipher). The IV after the last block is zero.
+    // The blocks at the same position in all data areas are deciphered together. Block i
+    // is replaced using the intermediate block i+1 which is not yet overwritten.
+    if (!encrypt) {
+        uint64_t blocks[SLICE_BITS];
+        for (size_t step = 0; step < max_blocks; ++step) {
+            size_t bcount = 0;
+            for (size_t k = 0; k < count; ++k) {
+                if (step < size[k] / 8) {
+                    blocks[bcount++] = GetUInt64LE(data[k] + 8 * step);
+                }
+            }
+            _block.decipherBatch(blocks, bcount);
+            bcount = 0;
+            for (size_t k = 0; k < count; ++k) {
+                const size_t nblocks = size[k] / 8;
+                if (step < nblocks) {
+                    uint8_t* const block = data[k] + 8 * step;
+                    PutUInt64LE(block, blocks[bcount++] ^ (step + 1 < nblocks ? GetUInt64LE(block + 8) : 0));
+                }
+            }
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Wrappers for encrypt and decrypt.
 //----------------------------------------------------------------------------
@@ -88,6 +88,31 @@ namespace ts {
         //!
         static bool IsReducedCW(const uint8_t *cw);
 
+        //!
+        //! Encrypt several data areas in place with the current control word.
+        //! The data areas are typically the payloads of TS packets which are scrambled
+        //! with the same control word. They are processed in parallel using a bitsliced
+        //! implementation of the stream cipher. This is much faster than encrypting each
+        //! data area using encryptInPlace() and the result is identical.
+        //! @param [in,out] data Array of @a count addresses of data areas.
+        //! @param [in] size Array of @a count sizes in bytes of the data areas.
+        //! @param [in] count Number of data areas.
+        //! @return True on success, false on error. On error, the processing stops at the
+        //! first invalid data area. All previous data areas are encrypted.
+        //!
+        bool encryptInPlaceBatch(void* const* data, const size_t* size, size_t count);
+
+        //!
+        //! Decrypt several data areas in place with the current control word.
+        //! This is the reverse operation of encryptInPlaceBatch().
+        //! @param [in,out] data Array of @a count addresses of data areas.
+        //! @param [in] size Array of @a count sizes in bytes of the data areas.
+        //! @param [in] count Number of data areas.
+        //! @return True on success, false on error. On error, the processing stops at the
+        //! first invalid data area. All previous data areas are decrypted.
+        //!
+        bool decryptInPlaceBatch(void* const* data, const size_t* size, size_t count);
+
         // Implementation of CipherChaining interface. Cannot set IV with DVB CSA.
         virtual bool setIV(const void*, size_t) override;
         virtual size_t minIVSize() const override;
@@ -123,6 +148,9 @@ namespace ts {
             void init(const uint8_t *cw);
             void encipher(const uint8_t *bd, uint8_t *ib);
             void decipher(const uint8_t *ib, uint8_t *bd);
+            // Process independent blocks (little-endian 64-bit values), interleaved.
+            void encipherBatch(uint64_t* blocks, size_t count) const;
+            void decipherBatch(uint64_t* blocks, size_t count) const;
         };
 
         // Stream cipher data
@@ -145,6 +173,10 @@ namespace ts {
             void cipher(const uint8_t* sb, uint8_t *cb);
         };
 
+        // Batch processing: filter valid data areas, process them by groups.
+        bool processBatch(bool encrypt, void* const* data, const size_t* size, size_t count);
+        void processGroup(bool encrypt, uint8_t* const* data, const size_t* size, size_t count);
+
         // DVB-CSA scrambling data
         bool         _init;
         EntropyMode  _mode;
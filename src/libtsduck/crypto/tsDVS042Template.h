@@ -45,7 +45,7 @@ TS_MSC_NOWARNING(4505) // warning C4505: 'ts::DVS042<ts::AES>::encrypt': unrefer
 
 template<class CIPHER>
 ts::DVS042<CIPHER>::DVS042() :
-    CipherChainingTemplate<CIPHER>(1, 1, 1),
+    CipherChainingTemplate<CIPHER>(1, 1, 1 + CipherChaining::PARALLEL_BLOCKS),
     shortIV(this->block_size)
 {
 }
@@ -174,7 +174,7 @@ bool ts::DVS042<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, v
     if (this->algo == nullptr ||
         this->iv.size() != this->block_size ||
         this->shortIV.size() != this->block_size ||
-        this->work.size() < this->block_size ||
+        this->work.size() < (1 + CipherChaining::PARALLEL_BLOCKS) * this->block_size ||
         plain_maxsize < cipher_length)
     {
         return false;
@@ -185,39 +185,46 @@ bool ts::DVS042<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, v
         *plain_length = cipher_length;
     }
 
+    // The work buffer contains the previous cipher block, followed by a copy of the cipher blocks which are processed.
+    uint8_t* previous = this->work.data();
+    uint8_t* current = previous + this->block_size;
+
     // Select IV depending on block size.
-    const uint8_t* previous = cipher_length < this->block_size ? this->shortIV.data() : this->iv.data();
+    ::memcpy(previous, cipher_length < this->block_size ? this->shortIV.data() : this->iv.data(), this->block_size);
 
-    // Decrypt all blocks in CBC mode, except the last one if partial
+    // Decrypt all blocks in CBC mode, except the last one if partial.
+    // Up to PARALLEL_BLOCKS blocks are deciphered at a time.
     const uint8_t* ct = reinterpret_cast<const uint8_t*>(cipher);
     uint8_t* pt = reinterpret_cast<uint8_t*>(plain);
 
     while (cipher_length >= this->block_size) {
-        // work = decrypt (cipher-text)
-        if (!this->algo->decrypt(ct, this->block_size, this->work.data(), this->block_size)) {
+        const size_t count = std::min(cipher_length / this->block_size, CipherChaining::PARALLEL_BLOCKS);
+        const size_t size = count * this->block_size;
+        // Keep a copy of cipher-text, in case of in-place decryption.
+        ::memcpy(current, ct, size);
+        // plain-text = decrypt (cipher-text)
+        if (!this->algo->decryptBlocks(current, pt, count)) {
             return false;
         }
-        // plain-text = previous-cipher XOR work
-        for (size_t i = 0; i < this->block_size; ++i) {
-            pt[i] = previous[i] ^ this->work[i];
-        }
-        // previous-cipher = cipher-text
-        previous = ct;
-        // advance one block
-        ct += this->block_size;
-        pt += this->block_size;
-        cipher_length -= this->block_size;
+        // plain-text = previous-cipher XOR plain-text, for all blocks
+        MemXor(pt, pt, previous, size);
+        // previous-cipher = last cipher-text
+        ::memcpy(previous, previous + size, this->block_size);
+        // advance the processed blocks
+        ct += size;
+        pt += size;
+        cipher_length -= size;
     }
 
     // Process final block if incomplete
     if (cipher_length > 0) {
         // work = encrypt (Cn-1), which is encrypt (shortIV) for short packets
-        if (!this->algo->encrypt(previous, this->block_size, this->work.data(), this->block_size)) {
+        if (!this->algo->encrypt(previous, this->block_size, current, this->block_size)) {
             return false;
         }
         // Pn = work XOR Cn, truncated
         for (size_t i = 0; i < cipher_length; ++i) {
-            pt[i] = this->work[i] ^ ct[i];
+            pt[i] = current[i] ^ ct[i];
         }
     }
     return true;
@@ -51,7 +51,10 @@ ts::TSScrambling::TSScrambling(Report& report, uint8_t scrambling) :
     _idsa(),
     _aescbc(),
     _aesctr(),
-    _scrambler{nullptr, nullptr}
+    _scrambler{nullptr, nullptr},
+    _batch_pkts(),
+    _batch_data(),
+    _batch_size()
 {
     setScramblingType(scrambling);
 }
@@ -71,7 +74,10 @@ ts::TSScrambling::TSScrambling(const TSScrambling& other) :
     _idsa(),
     _aescbc(),
     _aesctr(),
-    _scrambler{nullptr, nullptr}
+    _scrambler{nullptr, nullptr},
+    _batch_pkts(),
+    _batch_data(),
+    _batch_size()
 {
     setScramblingType(_scrambling_type);
     _dvbcsa[0].setEntropyMode(other._dvbcsa[0].entropyMode());
@@ -93,7 +99,10 @@ ts::TSScrambling::TSScrambling(TSScrambling&& other) :
     _idsa(),
     _aescbc(),
     _aesctr(),
-    _scrambler{nullptr, nullptr}
+    _scrambler{nullptr, nullptr},
+    _batch_pkts(),
+    _batch_data(),
+    _batch_size()
 {
     setScramblingType(_scrambling_type);
     _dvbcsa[0].setEntropyMode(other._dvbcsa[0].entropyMode());
@@ -581,3 +590,141 @@ bool ts::TSScrambling::decrypt(TSPacket& pkt)
     }
     return ok;
 }
+
+
+//----------------------------------------------------------------------------
+// Encrypt several TS packets with the current parity and corresponding CW.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::encrypt(TSPacket* pkt, size_t count)
+{
+    return encryptBatch(pkt, nullptr, count);
+}
+
+bool ts::TSScrambling::encrypt(TSPacket* const* pkt, size_t count)
+{
+    return encryptBatch(nullptr, pkt, count);
+}
+
+bool ts::TSScrambling::encryptBatch(TSPacket* pkt, TSPacket* const* addr, size_t count)
+{
+    // Only DVB-CSA2 has a batch implementation.
+    if (_scrambling_type != SCRAMBLING_DVB_CSA2) {
+        bool ok = true;
+        for (size_t i = 0; ok && i < count; ++i) {
+            ok = encrypt(addr == nullptr ? pkt[i] : *addr[i]);
+        }
+        return ok;
+    }
+
+    _batch_pkts.clear();
+    for (size_t i = 0; i < count; ++i) {
+        TSPacket* const p = addr == nullptr ? pkt + i : addr[i];
+        // Filter out encrypted packets. Encrypt previous packets first.
+        if (p->isScrambled()) {
+            processBatchCSA2(true, _encrypt_scv);
+            _report.error(u"try to scramble an already scrambled packet");
+            return false;
+        }
+        // Silently pass packets without payload.
+        if (p->hasPayload()) {
+            // If no current parity is set, start with even by default.
+            if (_encrypt_scv == SC_CLEAR && !setEncryptParity(SC_EVEN_KEY)) {
+                return false;
+            }
+            _batch_pkts.push_back(p);
+        }
+    }
+    return processBatchCSA2(true, _encrypt_scv);
+}
+
+
+//----------------------------------------------------------------------------
+// Decrypt several TS packets with the CW corresponding to the parity in the packet.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::decrypt(TSPacket* pkt, size_t count)
+{
+    return decryptBatch(pkt, nullptr, count);
+}
+
+bool ts::TSScrambling::decrypt(TSPacket* const* pkt, size_t count)
+{
+    return decryptBatch(nullptr, pkt, count);
+}
+
+bool ts::TSScrambling::decryptBatch(TSPacket* pkt, TSPacket* const* addr, size_t count)
+{
+    // Only DVB-CSA2 has a batch implementation.
+    if (_scrambling_type != SCRAMBLING_DVB_CSA2) {
+        bool ok = true;
+        for (size_t i = 0; ok && i < count; ++i) {
+            ok = decrypt(addr == nullptr ? pkt[i] : *addr[i]);
+        }
+        return ok;
+    }
+
+    _batch_pkts.clear();
+    for (size_t i = 0; i < count; ++i) {
+        TSPacket* const p = addr == nullptr ? pkt + i : addr[i];
+
+        // Clear or invalid packets are silently accepted.
+        const uint8_t scv = p->getScrambling();
+        if (scv != SC_EVEN_KEY && scv != SC_ODD_KEY) {
+            continue;
+        }
+
+        // On parity change, decrypt previous packets with the previous key.
+        if (scv != _decrypt_scv) {
+            if (!processBatchCSA2(false, _decrypt_scv)) {
+                return false;
+            }
+
+            // Update current parity.
+            const uint8_t previous_scv = _decrypt_scv;
+            _decrypt_scv = scv;
+
+            // In case of fixed control word, use next key when the scrambling control changes.
+            if (hasFixedCW() && previous_scv != _decrypt_scv && !setNextFixedCW(_decrypt_scv)) {
+                return false;
+            }
+        }
+        _batch_pkts.push_back(p);
+    }
+    return processBatchCSA2(false, _decrypt_scv);
+}
+
+
+//----------------------------------------------------------------------------
+// Encrypt or decrypt packets with DVB-CSA2 in one batch.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::processBatchCSA2(bool encrypt, uint8_t scv)
+{
+    if (_batch_pkts.empty()) {
+        return true;
+    }
+
+    // Collect all payloads. The buffers keep their capacity between batches.
+    const size_t count = _batch_pkts.size();
+    _batch_data.resize(count);
+    _batch_size.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        _batch_data[i] = _batch_pkts[i]->getPayload();
+        _batch_size[i] = _batch_pkts[i]->getPayloadSize();
+    }
+
+    // Encrypt or decrypt all payloads.
+    DVBCSA2& algo(_dvbcsa[scv & 1]);
+    const bool ok = encrypt ? algo.encryptInPlaceBatch(_batch_data.data(), _batch_size.data(), count) : algo.decryptInPlaceBatch(_batch_data.data(), _batch_size.data(), count);
+    if (ok) {
+        for (auto it : _batch_pkts) {
+            it->setScrambling(encrypt ? scv : uint8_t(SC_CLEAR));
+        }
+    }
+    else {
+        _report.error(u"packet %s error using %s", {encrypt ? u"encryption" : u"decryption", algo.name()});
+    }
+    _batch_pkts.clear();
+    return ok;
+}
@@ -192,6 +192,46 @@ namespace ts {
         //!
         bool decrypt(TSPacket& pkt);
 
+        //!
+        //! Encrypt several TS packets with the current parity and corresponding CW.
+        //! With DVB-CSA2, all packets are encrypted in parallel, which is much faster
+        //! than encrypting them one by one. With other algorithms, the packets are
+        //! encrypted one by one.
+        //! @param [in,out] pkt Address of an array of TS packets to encrypt.
+        //! @param [in] count Number of packets in the array.
+        //! @return True on success, false on error. An already encrypted packet is an error.
+        //!
+        bool encrypt(TSPacket* pkt, size_t count);
+
+        //!
+        //! Decrypt several TS packets with the CW corresponding to the parity in each packet.
+        //! With DVB-CSA2, consecutive packets using the same CW are decrypted in parallel,
+        //! which is much faster than decrypting them one by one. With other algorithms,
+        //! the packets are decrypted one by one.
+        //! @param [in,out] pkt Address of an array of TS packets to decrypt.
+        //! @param [in] count Number of packets in the array.
+        //! @return True on success, false on error. A clear packet is not an error.
+        //!
+        bool decrypt(TSPacket* pkt, size_t count);
+
+        //!
+        //! Encrypt several TS packets, given by address, with the current parity and corresponding CW.
+        //! This is the same as encrypt(TSPacket*, size_t) for packets which are not contiguous in memory.
+        //! @param [in,out] pkt Address of an array of @a count addresses of TS packets to encrypt.
+        //! @param [in] count Number of packets in the array.
+        //! @return True on success, false on error. An already encrypted packet is an error.
+        //!
+        bool encrypt(TSPacket* const* pkt, size_t count);
+
+        //!
+        //! Decrypt several TS packets, given by address, with the CW corresponding to the parity in each packet.
+        //! This is the same as decrypt(TSPacket*, size_t) for packets which are not contiguous in memory.
+        //! @param [in,out] pkt Address of an array of @a count addresses of TS packets to decrypt.
+        //! @param [in] count Number of packets in the array.
+        //! @return True on success, false on error. A clear packet is not an error.
+        //!
+        bool decrypt(TSPacket* const* pkt, size_t count);
+
     private:
         // List of control words
         typedef std::list<ByteBlock> CWList;
@@ -211,10 +251,20 @@ namespace ts {
         CBC<AES>         _aescbc[2];
         CTR<AES>         _aesctr[2];
         CipherChaining*  _scrambler[2];
+        std::vector<TSPacket*> _batch_pkts;  // Packets to process in one batch (DVB-CSA2), reused between batches.
+        std::vector<void*>     _batch_data;  // Payload addresses of packets in _batch_pkts.
+        std::vector<size_t>    _batch_size;  // Payload sizes of packets in _batch_pkts.
 
         // Set the next fixed control word as scrambling key.
         bool setNextFixedCW(int parity);
 
+        // Encrypt or decrypt several packets, either contiguous (pkt) or by address (addr).
+        bool encryptBatch(TSPacket* pkt, TSPacket* const* addr, size_t count);
+        bool decryptBatch(TSPacket* pkt, TSPacket* const* addr, size_t count);
+
+        // Encrypt or decrypt the packets in _batch_pkts with DVB-CSA2 in one batch. Clear the list of packets.
+        bool processBatchCSA2(bool encrypt, uint8_t scv);
+
         // Implementation of BlockCipherAlertInterface.
         virtual bool handleBlockCipherAlert(BlockCipher& cipher, AlertReason reason) override;
 
@@ -43,6 +43,7 @@ ts::AccessUnitIterator::AccessUnitIterator(const uint8_t* data, size_t size, uin
     _data_size(size),
     _valid(PESPacket::HasCommonVideoHeader(data, size)),
     _format(_valid ? default_format : CodecType::UNDEFINED),
+    _nalunits(),
     _nalunit(nullptr),
     _nalunit_size(0),
     _nalunit_header_size(0),
@@ -69,7 +70,10 @@ ts::AccessUnitIterator::AccessUnitIterator(const uint8_t* data, size_t size, uin
         }
     }
 
-    // Search the first access unit.
+    // Locate all access units and select the first one.
+    if (_valid) {
+        LocateNALUnits(_data, _data_size, _nalunits);
+    }
     reset();
 }
 
@@ -81,12 +85,8 @@ ts::AccessUnitIterator::AccessUnitIterator(const uint8_t* data, size_t size, uin
 void ts::AccessUnitIterator::reset()
 {
     if (_valid) {
-        // Point to the beginning of area, before the first access unit.
-        // Calling next() will find the first one (if any).
-        _nalunit = _data;
-        next();
-        // Reset NALunit index since we point to the first one.
         _nalunit_index = 0;
+        selectAccessUnit();
     }
 }
 
@@ -123,54 +123,35 @@ bool ts::AccessUnitIterator::next()
     if (!_valid || _nalunit == nullptr) {
         return false;
     }
+    _nalunit_index++;
+    return selectAccessUnit();
+}
 
-    // Memory patterns which are used between access units.
-    static const uint8_t Zero3[] = {0x00, 0x00, 0x00};
-    static const uint8_t StartCodePrefix[] = {0x00, 0x00, 0x01};
 
-    // Remaining size in data area.
-    assert(_nalunit >= _data);
-    assert(_nalunit <= _data + _data_size);
-    size_t remain = _data + _data_size - _nalunit;
+//----------------------------------------------------------------------------
+// Set the current access unit from _nalunit_index.
+//----------------------------------------------------------------------------
 
+bool ts::AccessUnitIterator::selectAccessUnit()
+{
     // Preset access unit type to an invalid value.
     // If the video format is undefined, we won't be able to extract a valid one.
     _nalunit_type = AVC_AUT_INVALID;
     _nalunit_size = 0;
     _nalunit_header_size = 0;
 
-    // Locate next access unit: starts with 00 00 01.
-    // The start code prefix 00 00 01 is not part of the NALunit.
-    // The NALunit starts at the NALunit type byte (see H.264, 7.3.1).
-    const uint8_t* const p1 = LocatePattern(_nalunit, remain, StartCodePrefix, sizeof(StartCodePrefix));
-    if (p1 == nullptr) {
-        // No next access unit.
+    if (_nalunit_index >= _nalunits.size()) {
+        // No more access unit.
         _nalunit = nullptr;
-        _nalunit_index++;
         return false;
     }
 
-    // Jump to first byte of NALunit.
-    remain -= p1 - _nalunit + sizeof(StartCodePrefix);
-    _nalunit = p1 + sizeof(StartCodePrefix);
-
-    // Locate end of access unit: ends with 00 00 00, 00 00 01 or end of data.
-    const uint8_t* const p2 = LocatePattern(_nalunit, remain, StartCodePrefix, sizeof(StartCodePrefix));
-    const uint8_t* const p3 = LocatePattern(_nalunit, remain, Zero3, sizeof(Zero3));
-    if (p2 == nullptr && p3 == nullptr) {
-        // No 00 00 01, no 00 00 00, the NALunit extends up to the end of data.
-        _nalunit_size = remain;
-    }
-    else if (p2 == nullptr || (p3 != nullptr && p3 < p2)) {
-        // NALunit ends at 00 00 00.
-        assert(p3 != nullptr);
-        _nalunit_size = p3 - _nalunit;
-    }
-    else {
-        // NALunit ends at 00 00 01.
-        assert(p2 != nullptr);
-        _nalunit_size = p2 - _nalunit;
-    }
+    // The start code prefix 00 00 01 is not part of the NALunit.
+    // The NALunit starts at the NALunit type byte (see H.264, 7.3.1).
+    // It ends before 00 00 00, 00 00 01 or at end of data.
+    assert(_nalunits[_nalunit_index].offset <= _data_size);
+    _nalunit = _data + _nalunits[_nalunit_index].offset;
+    _nalunit_size = _nalunits[_nalunit_index].size;
 
     // Extract NALunit type.
     if (_format == CodecType::AVC && _nalunit_size >= 1) {
@@ -185,8 +166,5 @@ bool ts::AccessUnitIterator::next()
         _nalunit_header_size = 2;
         _nalunit_type = (_nalunit[1] >> 3) & 0x1F;
     }
-
-    // Count NALunits.
-    _nalunit_index++;
     return true;
 }
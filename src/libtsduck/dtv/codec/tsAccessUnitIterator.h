@@ -34,6 +34,7 @@
 
 #pragma once
 #include "tsCodecType.h"
+#include "tsStartCode.h"
 #include "tsEnumeration.h"
 #include "tsPSI.h"
 
@@ -44,7 +45,9 @@ namespace ts {
     //!
     //! Some H.26x video coding formats use a common access unit bitstream
     //! format. This class is an iterator over the payload of a PES packet
-    //! (possibly truncated) to locate each access unit.
+    //! (possibly truncated) to locate each access unit. All access units
+    //! are located in one single pass over the data area when the iterator
+    //! is constructed.
     //!
     //! This class can be used with:
     //!  - AVC, Advanced Video Coding, ISO 14496-10, ITU-T Rec. H.264.
@@ -147,14 +150,18 @@ namespace ts {
         void reset();
 
     private:
-        const uint8_t* const _data;
-        const size_t   _data_size;
-        bool           _valid;
-        CodecType      _format;
-        const uint8_t* _nalunit;
-        size_t         _nalunit_size;
-        size_t         _nalunit_header_size;
-        size_t         _nalunit_index;
-        uint8_t        _nalunit_type;
+        const uint8_t* const  _data;
+        const size_t          _data_size;
+        bool                  _valid;
+        CodecType             _format;
+        NALUnitLocationVector _nalunits;
+        const uint8_t*        _nalunit;
+        size_t                _nalunit_size;
+        size_t                _nalunit_header_size;
+        size_t                _nalunit_index;
+        uint8_t               _nalunit_type;
+
+        // Set the current access unit from _nalunit_index.
+        bool selectAccessUnit();
     };
 }
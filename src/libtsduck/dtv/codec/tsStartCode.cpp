@@ -0,0 +1,203 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "tsStartCode.h"
+#include "tsSysInfo.h"
+
+
+//----------------------------------------------------------------------------
+// Generic scanner. All positions of 00 00 00 and 00 00 01 sequences are
+// reported to a handler, in increasing order. The handler returns false to
+// stop the scan. The scan returns false when it was stopped by the handler.
+//----------------------------------------------------------------------------
+
+namespace {
+
+    // Scalar implementation, from a given index. If the third byte is neither
+    // 00 nor 01, there is no match at this position and the next two ones.
+    template <class HANDLER>
+    bool ScanScalar(const uint8_t* data, size_t size, size_t index, HANDLER& handler)
+    {
+        while (index + 2 < size) {
+            if (data[index + 2] > 1) {
+                index += 3;
+            }
+            else if (data[index] == 0 && data[index + 1] == 0 && !handler(index)) {
+                return false;
+            }
+            else {
+                ++index;
+            }
+        }
+        return true;
+    }
+
+#if defined(TS_GCC) && defined(TS_LITTLE_ENDIAN) && (defined(TS_X86_64) || defined(TS_ARM64))
+#define TS_STARTCODE_VECTOR 1
+
+    // Report all matches in a 64-bit lane of a comparison mask (one FF byte per match).
+    template <class HANDLER>
+    inline bool ScanLane(size_t index, uint64_t lane, HANDLER& handler)
+    {
+        while (lane != 0) {
+            const int bit = __builtin_ctzll(lane);
+            if (!handler(index + size_t(bit / 8))) {
+                return false;
+            }
+            lane &= ~(uint64_t(0xFF) << bit);
+        }
+        return true;
+    }
+
+    // Vectors of 16 bytes, SSE2 on Intel x86-64, NEON on Arm64.
+    // Three overlapping loads check the three bytes of each position at once.
+    typedef uint8_t Bytes16 __attribute__((vector_size(16)));
+    typedef uint64_t Words16 __attribute__((vector_size(16)));
+
+    template <class HANDLER>
+    bool ScanVector16(const uint8_t* data, size_t size, size_t& index, HANDLER& handler)
+    {
+        const Bytes16 zero = Bytes16();
+        const Bytes16 one = zero + 1;
+        Bytes16 v0, v1, v2;
+        for (; index + sizeof(Bytes16) + 2 <= size; index += sizeof(Bytes16)) {
+            ::memcpy(&v0, data + index, sizeof(Bytes16));
+            ::memcpy(&v1, data + index + 1, sizeof(Bytes16));
+            ::memcpy(&v2, data + index + 2, sizeof(Bytes16));
+            const Words16 mask = (Words16)((v0 == zero) & (v1 == zero) & (v2 <= one));
+            if ((mask[0] | mask[1]) != 0 && (!ScanLane(index, mask[0], handler) || !ScanLane(index + 8, mask[1], handler))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+#endif
+
+#if defined(TS_STARTCODE_VECTOR) && defined(TS_X86_64)
+#define TS_STARTCODE_AVX2 1
+
+    // Vectors of 32 bytes, AVX2 on Intel x86-64, when supported by the CPU.
+    typedef uint8_t Bytes32 __attribute__((vector_size(32)));
+    typedef uint64_t Words32 __attribute__((vector_size(32)));
+
+    template <class HANDLER>
+    __attribute__((target("avx2")))
+    bool ScanVector32(const uint8_t* data, size_t size, size_t& index, HANDLER& handler)
+    {
+        const Bytes32 zero = Bytes32();
+        const Bytes32 one = zero + 1;
+        Bytes32 v0, v1, v2;
+        for (; index + sizeof(Bytes32) + 2 <= size; index += sizeof(Bytes32)) {
+            ::memcpy(&v0, data + index, sizeof(Bytes32));
+            ::memcpy(&v1, data + index + 1, sizeof(Bytes32));
+            ::memcpy(&v2, data + index + 2, sizeof(Bytes32));
+            const Words32 mask = (Words32)((v0 == zero) & (v1 == zero) & (v2 <= one));
+            if ((mask[0] | mask[1] | mask[2] | mask[3]) != 0 &&
+                (!ScanLane(index, mask[0], handler) || !ScanLane(index + 8, mask[1], handler) ||
+                 !ScanLane(index + 16, mask[2], handler) || !ScanLane(index + 24, mask[3], handler)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+#endif
+
+    // Scan using the best available implementation, the scalar one for the end of the area.
+    template <class HANDLER>
+    bool Scan(const uint8_t* data, size_t size, HANDLER& handler)
+    {
+        size_t index = 0;
+#if defined(TS_STARTCODE_AVX2)
+        static const bool avx2 = ts::SysInfo::Instance()->vectorInstructions();
+        if (avx2 && !ScanVector32(data, size, index, handler)) {
+            return false;
+        }
+#endif
+#if defined(TS_STARTCODE_VECTOR)
+        if (!ScanVector16(data, size, index, handler)) {
+            return false;
+        }
+#endif
+        return ScanScalar(data, size, index, handler);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Locate all NALunits in a memory area in one single pass.
+//----------------------------------------------------------------------------
+
+void ts::LocateNALUnits(const uint8_t* data, size_t size, NALUnitLocationVector& units)
+{
+    units.clear();
+
+    // Any 00 00 00 or 00 00 01 ends the current NALunit, 00 00 01 starts a new one.
+    // There is no match in the two bytes after a 00 00 01, so a new NALunit never
+    // contains a position which was already reported.
+    bool in_unit = false;
+    size_t start = 0;
+    auto handler = [data, &units, &in_unit, &start](size_t index) -> bool {
+        if (in_unit) {
+            units.push_back(NALUnitLocation(start, index - start));
+            in_unit = false;
+        }
+        if (data[index + 2] == 0x01) {
+            in_unit = true;
+            start = index + 3;
+        }
+        return true;
+    };
+    Scan(data, size, handler);
+
+    // The last NALunit extends up to the end of the area.
+    if (in_unit) {
+        units.push_back(NALUnitLocation(start, size - start));
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Locate the next start code prefix 00 00 01 in a memory area.
+//----------------------------------------------------------------------------
+
+const uint8_t* ts::LocateStartCodePrefix(const uint8_t* data, size_t size)
+{
+    const uint8_t* found = nullptr;
+    auto handler = [data, &found](size_t index) -> bool {
+        if (data[index + 2] == 0x01) {
+            found = data + index;
+            return false;
+        }
+        return true;
+    };
+    Scan(data, size, handler);
+    return found;
+}
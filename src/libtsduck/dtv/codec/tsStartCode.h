@@ -0,0 +1,90 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Fast location of start codes in video bitstreams.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+namespace ts {
+    //!
+    //! Location of a NALunit in a memory area.
+    //! @ingroup mpeg
+    //!
+    //! In AVC, HEVC and VVC byte streams, a NALunit starts after a start code prefix
+    //! 00 00 01. The start code prefix is not part of the NALunit. The NALunit ends
+    //! before the next 00 00 00 or 00 00 01 sequence or at the end of the memory area.
+    //!
+    class TSDUCKDLL NALUnitLocation
+    {
+    public:
+        size_t offset;  //!< Offset of the first byte of the NALunit (after 00 00 01) in the memory area.
+        size_t size;    //!< Size in bytes of the NALunit.
+
+        //!
+        //! Constructor.
+        //! @param [in] off Offset of the first byte of the NALunit.
+        //! @param [in] sz Size in bytes of the NALunit.
+        //!
+        NALUnitLocation(size_t off = 0, size_t sz = 0) : offset(off), size(sz) {}
+    };
+
+    //!
+    //! Vector of NALunit locations.
+    //!
+    typedef std::vector<NALUnitLocation> NALUnitLocationVector;
+
+    //!
+    //! Locate all NALunits in a memory area in one single pass.
+    //!
+    //! This is the same result as searching each start code prefix 00 00 01
+    //! and then the end of each NALunit, but the memory area is scanned only
+    //! once, using vector instructions when available (SSE2 or AVX2 on Intel
+    //! x86-64, NEON on Arm64).
+    //!
+    //! @param [in] data Address of the memory area, typically a PES packet payload.
+    //! @param [in] size Size in bytes of the memory area.
+    //! @param [out] units Returned locations of all NALunits, in order of appearance.
+    //!
+    TSDUCKDLL void LocateNALUnits(const uint8_t* data, size_t size, NALUnitLocationVector& units);
+
+    //!
+    //! Locate the next start code prefix 00 00 01 in a memory area.
+    //! This is equivalent to LocatePattern() with a 00 00 01 pattern but uses
+    //! vector instructions when available.
+    //! @param [in] data Address of the memory area.
+    //! @param [in] size Size in bytes of the memory area.
+    //! @return Address of the first start code prefix in the memory area or
+    //! a null pointer if there is none.
+    //!
+    TSDUCKDLL const uint8_t* LocateStartCodePrefix(const uint8_t* data, size_t size);
+}
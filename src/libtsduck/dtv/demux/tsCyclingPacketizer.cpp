@@ -29,6 +29,7 @@
 
 #include "tsCyclingPacketizer.h"
 #include "tsNames.h"
+#include <algorithm>
 
 
 //----------------------------------------------------------------------------
@@ -43,9 +44,12 @@ ts::CyclingPacketizer::CyclingPacketizer(const DuckContext& duck, PID pid, Stuff
     _sched_sections(),
     _other_sections(),
     _sched_packets(0),
+    _sched_load(0),
+    _sched_order(0),
     _current_cycle(1),
     _remain_in_cycle(0),
-    _cycle_end(UNDEFINED)
+    _cycle_end(UNDEFINED),
+    _last_desc()
 {
 }
 
@@ -58,7 +62,17 @@ ts::CyclingPacketizer::SectionDesc::SectionDesc(const SectionPtr& sec, MilliSeco
     repetition(rep),
     last_packet(0),
     due_packet(0),
-    last_cycle(0)
+    distance(0),
+    last_cycle(0),
+    cache()
+{
+}
+
+ts::CyclingPacketizer::ScheduledSection::ScheduledSection(const SectionDescPtr& sp, uint64_t ord) :
+    due_packet(sp->due_packet),
+    last_cycle(sp->last_cycle),
+    order(ord),
+    desc(sp)
 {
 }
 
@@ -100,61 +114,63 @@ void ts::CyclingPacketizer::addTable(DuckContext& duck, const AbstractTable& tab
 
 
 //----------------------------------------------------------------------------
-// Check if this section shall be inserted after some other one.
+// Minimum bitrate which is required by a section, in milli-bits/second.
 //----------------------------------------------------------------------------
 
-bool ts::CyclingPacketizer::SectionDesc::insertAfter(const SectionDesc& other) const
+uint64_t ts::CyclingPacketizer::SectionDesc::load() const
 {
-    // Insert sections according due time when due times are different.
-    if (due_packet != other.due_packet) {
-        return due_packet > other.due_packet;
-    }
+    return repetition <= 0 ? 0 : (section->packetCount() * PKT_SIZE_BITS * MilliSecPerSec * MilliSecPerSec) / uint64_t(repetition);
+}
 
-    // At this point, the two sections have the same due time.
-    // Decide insertion order based on the sections contents.
-    const Section& sec1(*section);
-    const Section& sec2(*(other.section));
 
-    if (sec1.tableId() != sec2.tableId() || (sec1.isLongSection() && sec1.tableIdExtension() != sec2.tableIdExtension())) {
-        // Sections do not belong to the same table => insert before
-        return false;
-    }
-    else if (last_cycle > other.last_cycle) {
-        // This section in one cycle in advance => insert after
-        return true;
-    }
-    else if (last_cycle < other.last_cycle) {
-        // This section in one cycle late => insert before
-        return false;
+//----------------------------------------------------------------------------
+// Get the minimum bitrate which is required by all scheduled sections.
+//----------------------------------------------------------------------------
+
+ts::BitRate ts::CyclingPacketizer::scheduledBitRate() const
+{
+    return BitRate(_sched_load) / MilliSecPerSec;
+}
+
+
+//----------------------------------------------------------------------------
+// Comparison for the heap of scheduled sections. The heap is a "max heap",
+// the top of the heap is the "greatest" element, the first section to send.
+//----------------------------------------------------------------------------
+
+bool ts::CyclingPacketizer::ScheduledSection::operator<(const ScheduledSection& other) const
+{
+    if (due_packet != other.due_packet) {
+        // Earliest due time first.
+        return due_packet > other.due_packet;
     }
-    else if (sec1.isShortSection() || sec2.isShortSection() || sec1.tableIdExtension() != sec2.tableIdExtension()) {
-        // Both sections have the same due packet and in the same cycle. They also have the same table id.
-        // Either they are short equivalent sections or do not have the same table id ext => insert after.
-        return true;
+    else if (last_cycle != other.last_cycle) {
+        // Same due time, a section which is late in the cycle first.
+        return last_cycle > other.last_cycle;
     }
     else {
-        // Same due packet, same cycle, same long table => insert in order of section number.
-        return sec1.sectionNumber() >= sec2.sectionNumber();
+        // Same due time and same cycle, first scheduled first served.
+        return order > other.order;
     }
 }
 
 
 //----------------------------------------------------------------------------
-// Insert a scheduled section in the list, sorted by due_packet.
+// Insert a scheduled section in the priority queue, sorted by due_packet.
 //----------------------------------------------------------------------------
 
 void ts::CyclingPacketizer::addScheduledSection(const SectionDescPtr& sect)
 {
-    report().log(2, u"schedule section: PID 0x%X, TID 0x%X, TIDext 0x%X, section %d/%d, cycle: %'d, packet: %'d, due packet: %'d",
-                 {getPID(), sect->section->tableId(), sect->section->tableIdExtension(),
-                  sect->section->sectionNumber(), sect->section->lastSectionNumber(),
-                  sect->last_cycle, sect->last_packet, sect->due_packet});
-
-    auto it = _sched_sections.begin();
-    while (it != _sched_sections.end() && sect->insertAfter(**it)) {
-        ++it;
+    // Avoid building the message arguments for each scheduled section when not logged.
+    if (report().maxSeverity() >= 2) {
+        report().log(2, u"schedule section: PID 0x%X, TID 0x%X, TIDext 0x%X, section %d/%d, cycle: %'d, packet: %'d, due packet: %'d",
+                     {getPID(), sect->section->tableId(), sect->section->tableIdExtension(),
+                      sect->section->sectionNumber(), sect->section->lastSectionNumber(),
+                      sect->last_cycle, sect->last_packet, sect->due_packet});
     }
-    _sched_sections.insert(it, sect);
+
+    _sched_sections.push_back(ScheduledSection(sect, _sched_order++));
+    std::push_heap(_sched_sections.begin(), _sched_sections.end());
 }
 
 
@@ -166,6 +182,7 @@ void ts::CyclingPacketizer::addSection(const SectionPtr& sect, MilliSecond rep_r
 {
     if (!sect.isNull() && sect->isValid()) {
         SectionDescPtr desc(new SectionDesc(sect, rep_rate));
+        desc->distance = PacketDistance(_bitrate, rep_rate);
 
         if (rep_rate == 0 || _bitrate == 0) {
             // Unschedule section, simply add it at end of queue
@@ -176,6 +193,7 @@ void ts::CyclingPacketizer::addSection(const SectionPtr& sect, MilliSecond rep_r
             desc->due_packet = packetCount();
             addScheduledSection(desc);
             _sched_packets += sect->packetCount();
+            _sched_load += desc->load();
         }
 
         _section_count++;
@@ -190,46 +208,46 @@ void ts::CyclingPacketizer::addSection(const SectionPtr& sect, MilliSecond rep_r
 
 void ts::CyclingPacketizer::removeSections(TID tid)
 {
-    removeSections(_sched_sections, tid, 0, 0, false, false, true);
-    removeSections(_other_sections, tid, 0, 0, false, false, false);
+    removeSections(tid, 0, 0, false, false);
 }
 
 void ts::CyclingPacketizer::removeSections(TID tid, uint16_t tid_ext)
 {
-    removeSections(_sched_sections, tid, tid_ext, 0, true, false, true);
-    removeSections(_other_sections, tid, tid_ext, 0, true, false, false);
+    removeSections(tid, tid_ext, 0, true, false);
 }
 
 void ts::CyclingPacketizer::removeSections(TID tid, uint16_t tid_ext, uint8_t sec_number)
 {
-    removeSections(_sched_sections, tid, tid_ext, sec_number, true, true, true);
-    removeSections(_other_sections, tid, tid_ext, sec_number, true, true, false);
+    removeSections(tid, tid_ext, sec_number, true, true);
 }
 
 
 //----------------------------------------------------------------------------
-// Remove all sections with the specified tid/tid_ext in the specified list.
+// Remove all sections with the specified tid/tid_ext/sec_number in the two lists.
 //----------------------------------------------------------------------------
 
-void ts::CyclingPacketizer::removeSections(SectionDescList& list, TID tid, uint16_t tid_ext, uint8_t sec_number, bool use_tid_ext, bool use_sec_number, bool scheduled)
+void ts::CyclingPacketizer::removeSections(TID tid, uint16_t tid_ext, uint8_t sec_number, bool use_tid_ext, bool use_sec_number)
 {
-    SectionDescList::iterator it(list.begin());
-    while (it != list.end()) {
-        const SectionDescPtr& sp(*it);
-        const Section& sect(*sp->section);
-        if (sect.tableId() == tid && (!use_tid_ext || sect.tableIdExtension() == tid_ext) && (!use_sec_number || sect.sectionNumber() == sec_number)) {
-            // Section match, remove it
-            assert(_section_count > 0);
-            _section_count--;
-            if (sp->last_cycle != _current_cycle) {
-                assert(_remain_in_cycle > 0);
-                _remain_in_cycle--;
-            }
-            if (scheduled) {
-                assert(_sched_packets >= sect.packetCount());
-                _sched_packets -= sect.packetCount();
+    // Compact the remaining scheduled sections and rebuild the heap if some sections were removed.
+    size_t count = 0;
+    for (size_t i = 0; i < _sched_sections.size(); ++i) {
+        if (!removeSection(*_sched_sections[i].desc, tid, tid_ext, sec_number, use_tid_ext, use_sec_number, true)) {
+            if (count < i) {
+                _sched_sections[count] = std::move(_sched_sections[i]);
             }
-            it = list.erase(it);
+            count++;
+        }
+    }
+    if (count < _sched_sections.size()) {
+        _sched_sections.erase(_sched_sections.begin() + count, _sched_sections.end());
+        std::make_heap(_sched_sections.begin(), _sched_sections.end());
+    }
+
+    // Unscheduled sections.
+    SectionDescList::iterator it(_other_sections.begin());
+    while (it != _other_sections.end()) {
+        if (removeSection(**it, tid, tid_ext, sec_number, use_tid_ext, use_sec_number, false)) {
+            it = _other_sections.erase(it);
         }
         else {
             ++it;
@@ -238,6 +256,34 @@ void ts::CyclingPacketizer::removeSections(SectionDescList& list, TID tid, uint1
 }
 
 
+//----------------------------------------------------------------------------
+// Check if a section matches a removal request and update the counters.
+//----------------------------------------------------------------------------
+
+bool ts::CyclingPacketizer::removeSection(const SectionDesc& desc, TID tid, uint16_t tid_ext, uint8_t sec_number, bool use_tid_ext, bool use_sec_number, bool scheduled)
+{
+    const Section& sect(*desc.section);
+    if (sect.tableId() != tid || (use_tid_ext && sect.tableIdExtension() != tid_ext) || (use_sec_number && sect.sectionNumber() != sec_number)) {
+        return false;
+    }
+
+    // Section match, it will be removed.
+    assert(_section_count > 0);
+    _section_count--;
+    if (desc.last_cycle != _current_cycle) {
+        assert(_remain_in_cycle > 0);
+        _remain_in_cycle--;
+    }
+    if (scheduled) {
+        assert(_sched_packets >= sect.packetCount());
+        assert(_sched_load >= desc.load());
+        _sched_packets -= sect.packetCount();
+        _sched_load -= desc.load();
+    }
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Remove all sections in the packetized.
 //----------------------------------------------------------------------------
@@ -247,6 +293,7 @@ void ts::CyclingPacketizer::removeAll()
     _section_count = 0;
     _remain_in_cycle = 0;
     _sched_packets = 0;
+    _sched_load = 0;
     _sched_sections.clear();
     _other_sections.clear();
 }
@@ -262,6 +309,7 @@ void ts::CyclingPacketizer::reset()
 {
     removeAll();
     Packetizer::reset();
+    _last_desc.clear();
 }
 
 
@@ -278,12 +326,16 @@ void ts::CyclingPacketizer::setBitRate(const BitRate& new_bitrate)
     }
     else if (new_bitrate == 0) {
         // Bitrate now unknown, unable to schedule sections, move them all
-        // into the list of unscheduled sections.
-        while (!_sched_sections.empty()) {
-            _other_sections.push_back(_sched_sections.front());
-            _sched_sections.pop_front();
+        // into the list of unscheduled sections, in scheduling order.
+        // After sort_heap(), the first section to send is at the end.
+        std::sort_heap(_sched_sections.begin(), _sched_sections.end());
+        for (auto it = _sched_sections.rbegin(); it != _sched_sections.rend(); ++it) {
+            it->desc->distance = 0;
+            _other_sections.push_back(it->desc);
         }
+        _sched_sections.clear();
         _sched_packets = 0;
+        _sched_load = 0;
     }
     else if (_bitrate == 0) {
         // Bitrate was null but is not now. Move all scheduled sections
@@ -302,22 +354,23 @@ void ts::CyclingPacketizer::setBitRate(const BitRate& new_bitrate)
                 if (sp->due_packet < current_packet) {
                     sp->due_packet = current_packet;
                 }
+                sp->distance = PacketDistance(new_bitrate, sp->repetition);
                 addScheduledSection(sp);
                 _sched_packets += sp->section->packetCount();
+                _sched_load += sp->load();
             }
         }
     }
     else {
         // Old and new bitrate not null. Compute new due packet for all
-        // scheduled sections and re-sort list according to new due packet.
-        SectionDescList tmp_list;
-        tmp_list.swap(_sched_sections);
-        while (!tmp_list.empty()) {
-            SectionDesc* sp(tmp_list.back().pointer());
-            sp->due_packet = sp->last_packet + PacketDistance(new_bitrate, sp->repetition);
-            addScheduledSection(tmp_list.back());
-            tmp_list.pop_back();
+        // scheduled sections and rebuild the heap according to new due packet.
+        for (auto& ss : _sched_sections) {
+            SectionDesc* sp(ss.desc.pointer());
+            sp->distance = PacketDistance(new_bitrate, sp->repetition);
+            sp->due_packet = sp->last_packet + sp->distance;
+            ss.due_packet = sp->due_packet;
         }
+        std::make_heap(_sched_sections.begin(), _sched_sections.end());
     }
 
     // Remember new bitrate
@@ -333,7 +386,10 @@ void ts::CyclingPacketizer::setBitRate(const BitRate& new_bitrate)
 void ts::CyclingPacketizer::provideSection(SectionCounter counter, SectionPtr& sect)
 {
     const PacketCounter current_packet(packetCount());
-    SectionDescPtr sp(nullptr);
+
+    // The last provided section is kept in _last_desc, its packet cache is used by the packetizer.
+    SectionDescPtr& sp(_last_desc);
+    sp.clear();
 
     // Cycle end is initially undefined.
     // Will be defined only if end of cycle encountered.
@@ -354,14 +410,14 @@ void ts::CyclingPacketizer::provideSection(SectionCounter counter, SectionPtr& s
          // .. or previous unscheduled section passed in this cycle a long time ago
          spp->last_packet + spp->section->packetCount() + _sched_packets < current_packet);
 
-    if (!force_unscheduled && !_sched_sections.empty() && _sched_sections.front()->due_packet <= current_packet) {
-        // One scheduled section is ready
-        sp = _sched_sections.front();
-        _sched_sections.pop_front();
-        // Reschedule the section. Make sure we add at least one packet to
-        // ensure that all scheduled sections may pass.
-        sp->due_packet = current_packet + std::max(PacketCounter(1), PacketDistance(_bitrate, sp->repetition));
-        addScheduledSection(sp);
+    bool scheduled = false;
+
+    if (!force_unscheduled && !_sched_sections.empty() && _sched_sections.front().due_packet <= current_packet) {
+        // One scheduled section is ready, remove it from the heap, it will be rescheduled later.
+        std::pop_heap(_sched_sections.begin(), _sched_sections.end());
+        sp = std::move(_sched_sections.back().desc);
+        _sched_sections.pop_back();
+        scheduled = true;
     }
     else if (!_other_sections.empty()) {
         // An unscheduled section is ready
@@ -392,6 +448,12 @@ void ts::CyclingPacketizer::provideSection(SectionCounter counter, SectionPtr& s
                 _remain_in_cycle = _section_count;
             }
         }
+        if (scheduled) {
+            // Reschedule the section. Make sure we add at least one packet to
+            // ensure that all scheduled sections may pass.
+            sp->due_packet = current_packet + std::max(PacketCounter(1), sp->distance);
+            addScheduledSection(sp);
+        }
     }
 }
 
@@ -409,6 +471,17 @@ bool ts::CyclingPacketizer::doStuffing()
 }
 
 
+//----------------------------------------------------------------------------
+// This hook returns the packet cache of the last provided section.
+// The last section descriptor is kept alive, even if the section is removed.
+//----------------------------------------------------------------------------
+
+ts::SectionPacketCache* ts::CyclingPacketizer::sectionPacketCache(const SectionPtr& sect)
+{
+    return !_last_desc.isNull() && _last_desc->section == sect ? &_last_desc->cache : nullptr;
+}
+
+
 //----------------------------------------------------------------------------
 // Return true when the last generated packet was the last packet in the cycle.
 //----------------------------------------------------------------------------
@@ -450,9 +523,10 @@ std::ostream& ts::CyclingPacketizer::display(std::ostream& strm) const
         << "  Section cycle end: " << (_cycle_end == UNDEFINED ? u"undefined" : UString::Decimal(_cycle_end)) << std::endl
         << "  Stored sections: " << _section_count << std::endl
         << "  Scheduled sections: " << _sched_sections.size() << std::endl
-        << "  Scheduled packets max: " << _sched_packets << std::endl;
-    for (SectionDescList::const_iterator it = _sched_sections.begin(); it != _sched_sections.end(); ++it) {
-        (*it)->display(duck(), strm);
+        << "  Scheduled packets max: " << _sched_packets << std::endl
+        << "  Scheduled bitrate: " << scheduledBitRate() << " b/s" << std::endl;
+    for (const auto& ss : _sched_sections) {
+        ss.desc->display(duck(), strm);
     }
     strm << "  Unscheduled sections: " << _other_sections.size() << std::endl;
     for (SectionDescList::const_iterator it = _other_sections.begin(); it != _other_sections.end(); ++it) {
@@ -74,6 +74,14 @@ namespace ts {
     //! A bitrate is specified in bits/second. Zero means undefined.
     //! A repetition rate is specified in milliseconds. Zero means undefined.
     //!
+    //! The TS packets which contain only bytes from one section are cached with the
+    //! section and replayed in the next cycles. The sections shall not be modified
+    //! after being added in the packetizer.
+    //!
+    //! The scheduled sections are stored in a priority queue, sorted by due time.
+    //! Selecting and rescheduling a section is a O(log n) operation, allowing
+    //! large carousels with thousands of sections with individual repetition rates.
+    //!
     class TSDUCKDLL CyclingPacketizer: public Packetizer, private SectionProviderInterface
     {
         TS_NOBUILD_NOCOPY(CyclingPacketizer);
@@ -133,6 +141,14 @@ namespace ts {
             return _bitrate;
         }
 
+        //!
+        //! Get the minimum bitrate which is required to broadcast all scheduled sections at their repetition rates.
+        //! When this bitrate is higher than the bitrate of the PID, the scheduled sections are late and the
+        //! unscheduled sections are inserted from time to time.
+        //! @return The bitrate which is required by all scheduled sections, zero if there is none.
+        //!
+        BitRate scheduledBitRate() const;
+
         //!
         //! Add one section into the packetizer.
         //! The contents of the sections are shared.
@@ -231,13 +247,15 @@ namespace ts {
             MilliSecond    repetition;  // Repetition rate, zero if none
             PacketCounter  last_packet; // Packet index of last time the section was sent
             PacketCounter  due_packet;  // Packet index of next time
+            PacketCounter  distance;    // Distance in packets between two occurrences, from repetition rate and bitrate
             SectionCounter last_cycle;  // Cycle index of last time the section was sent
+            SectionPacketCache cache;   // Pre-built TS packets of the section
 
             // Constructor
             SectionDesc(const SectionPtr& sec, MilliSecond rep);
 
-            // Check if this section shall be inserted after some other one.
-            bool insertAfter(const SectionDesc& other) const;
+            // Minimum bitrate which is required by this section at its repetition rate, in milli-bits/second.
+            uint64_t load() const;
 
             // Display the internal state, mainly for debug.
             std::ostream& display(const DuckContext&, std::ostream&) const;
@@ -249,28 +267,55 @@ namespace ts {
         // List of sections
         typedef std::list <SectionDescPtr> SectionDescList;
 
+        // An entry in the priority queue of scheduled sections.
+        // The sort criteria are copied from the SectionDesc to avoid dereferencing the safe pointer in comparisons.
+        class ScheduledSection
+        {
+        public:
+            PacketCounter  due_packet;  // Packet index of next time
+            SectionCounter last_cycle;  // Cycle index of last time the section was sent
+            uint64_t       order;       // Scheduling order, first scheduled first served with same due time and cycle
+            SectionDescPtr desc;        // Section descriptor
+
+            // Constructor
+            ScheduledSection(const SectionDescPtr& sp, uint64_t ord);
+
+            // Comparison for the heap: the top of the heap is the first section to send.
+            bool operator<(const ScheduledSection& other) const;
+        };
+
+        // Priority queue of scheduled sections, a heap using std::push_heap() and std::pop_heap().
+        typedef std::vector<ScheduledSection> ScheduledSectionHeap;
+
         // Private members:
-        StuffingPolicy  _stuffing;
-        BitRate         _bitrate;
-        size_t          _section_count;   // Number of sections in the 2 lists
-        SectionDescList _sched_sections;  // Scheduled sections, with repetition rates
-        SectionDescList _other_sections;  // Unscheduled sections
-        PacketCounter   _sched_packets;   // Size in TS packets of all sections in _sched_sections
-        SectionCounter  _current_cycle;   // Cycle number (start at 1, always increasing)
-        size_t          _remain_in_cycle; // Number of unsent sections in this cycle
-        SectionCounter  _cycle_end;       // At end of cycle, contains the index of last section
+        StuffingPolicy       _stuffing;
+        BitRate              _bitrate;
+        size_t               _section_count;   // Number of sections in the 2 lists
+        ScheduledSectionHeap _sched_sections;  // Scheduled sections, with repetition rates
+        SectionDescList      _other_sections;  // Unscheduled sections
+        PacketCounter        _sched_packets;   // Size in TS packets of all sections in _sched_sections
+        uint64_t             _sched_load;      // Bitrate which is required by all sections in _sched_sections, in milli-bits/second
+        uint64_t             _sched_order;     // Scheduling order of the next scheduled section
+        SectionCounter       _current_cycle;   // Cycle number (start at 1, always increasing)
+        size_t               _remain_in_cycle; // Number of unsent sections in this cycle
+        SectionCounter       _cycle_end;       // At end of cycle, contains the index of last section
+        SectionDescPtr       _last_desc;       // Last provided section, its packet cache is used by the packetizer
 
         static const SectionCounter UNDEFINED = ~SectionCounter(0);
 
-        // Insert a scheduled section in the list, sorted by due_packet.
+        // Insert a scheduled section in the priority queue, sorted by due_packet.
         void addScheduledSection(const SectionDescPtr&);
 
-        // Remove all sections with the specified tid/tid_ext in the specified list.
-        void removeSections(SectionDescList&, TID tid, uint16_t tid_ext, uint8_t sec_number, bool use_tid_ext, bool use_sec_number, bool scheduled);
+        // Remove all sections with the specified tid/tid_ext/sec_number in the two lists.
+        void removeSections(TID tid, uint16_t tid_ext, uint8_t sec_number, bool use_tid_ext, bool use_sec_number);
+
+        // Check if a section matches a removal request. If it does, update the counters and return true.
+        bool removeSection(const SectionDesc&, TID tid, uint16_t tid_ext, uint8_t sec_number, bool use_tid_ext, bool use_sec_number, bool scheduled);
 
         // Inherited from SectionProviderInterface
         virtual void provideSection(SectionCounter, SectionPtr&) override;
         virtual bool doStuffing() override;
+        virtual SectionPacketCache* sectionPacketCache(const SectionPtr&) override;
 
         // Hide this method, we do not want the section provider to be replaced
         void setSectionProvider(SectionProviderInterface*) = delete;
@@ -44,7 +44,8 @@ ts::Packetizer::Packetizer(const DuckContext& duck, PID pid, SectionProviderInte
     _section(nullptr),
     _next_byte(0),
     _section_out_count(0),
-    _section_in_count(0)
+    _section_in_count(0),
+    _cache(nullptr)
 {
 }
 
@@ -62,6 +63,32 @@ void ts::Packetizer::reset()
     AbstractPacketizer::reset();
     _section.clear();
     _next_byte = 0;
+    _cache = nullptr;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the next section from the provider, return false if there is none.
+//----------------------------------------------------------------------------
+
+bool ts::Packetizer::getNextSection(SectionPtr& section)
+{
+    // Note: _provider is never null here.
+    _provider->provideSection(_section_in_count, section);
+    if (section.isNull()) {
+        _cache = nullptr;
+        return false;
+    }
+    else {
+        _section_in_count++;
+        // Only long sections which fill at least one packet can be cached.
+        const Section& sect(*section);
+        _cache = sect.isLongSection() && sect.size() >= SectionPacketCache::PayloadSize(0) ? _provider->sectionPacketCache(section) : nullptr;
+        if (_cache != nullptr) {
+            _cache->validate(sect);
+        }
+        return true;
+    }
 }
 
 
@@ -73,11 +100,8 @@ bool ts::Packetizer::getNextPacket(TSPacket& pkt)
 {
     // If there is no current section, get the next one.
     if (_section.isNull() && _provider != nullptr) {
-        _provider->provideSection(_section_in_count, _section);
+        getNextSection(_section);
         _next_byte = 0;
-        if (!_section.isNull()) {
-            _section_in_count++;
-        }
     }
 
     // If there is still no current section, return a null packet
@@ -86,6 +110,26 @@ bool ts::Packetizer::getNextPacket(TSPacket& pkt)
         return false;
     }
 
+    // When the rest of the current section fills the complete packet, the packet content depends
+    // only on the section and the position in the section. Replay the cached packet if there is one.
+    SectionPacketCache* const cache = _cache != nullptr && _cache->isFullPacket(_next_byte) ? _cache : nullptr;
+    const size_t first_byte = _next_byte;
+    if (cache != nullptr) {
+        const TSPacket* image = cache->packet(_next_byte);
+        if (image != nullptr) {
+            pkt = *image;
+            configurePacket(pkt, false);  // PID, continuity, count packets.
+            _next_byte += SectionPacketCache::PayloadSize(_next_byte);
+            if (_next_byte >= cache->sectionSize()) {
+                // End of current section, with nothing after it in the packet.
+                _section_out_count++;
+                _section.clear();
+                _next_byte = 0;
+            }
+            return true;
+        }
+    }
+
     // Various values to build the MPEG header.
     uint16_t pusi = 0x0000;         // payload_unit_start_indicator (set: 0x4000)
     uint8_t pointer_field = 0x00;   // pointer_field (used only if pusi is set)
@@ -105,14 +149,12 @@ bool ts::Packetizer::getNextPacket(TSPacket& pkt)
         if (!do_stuffing) {
             // No stuffing before next section => get next section.
             // Note that _provider cannot be null here.
-            _provider->provideSection(_section_in_count, next_section);
-            if (next_section.isNull()) {
+            if (!getNextSection(next_section)) {
                 // If no next section, do stuffing anyway.
                 do_stuffing = true;
             }
             else {
                 // Now that we know the actual header size of the next section, recheck if it fits in packet
-                _section_in_count++;
                 do_stuffing = remain_in_section > PKT_SIZE - 5 - (_split_headers ? 0 : next_section->headerSize());
             }
         }
@@ -174,14 +216,10 @@ bool ts::Packetizer::getNextPacket(TSPacket& pkt)
                 if (_provider == nullptr || _provider->doStuffing()) {
                     break;
                 }
-                _provider->provideSection(_section_in_count, _section);
                 // If no next section, stuff the end of packet
-                if (_section.isNull()) {
+                if (!getNextSection(_section)) {
                     break;
                 }
-                else {
-                    _section_in_count++;
-                }
             }
             // We no longer know about stuffing after current section
             do_stuffing = false;
@@ -203,6 +241,11 @@ bool ts::Packetizer::getNextPacket(TSPacket& pkt)
     if (remain_in_packet > 0) {
         ::memset(data, 0xFF, remain_in_packet);
     }
+
+    // Keep the image of a packet which contains only bytes from one section.
+    if (cache != nullptr) {
+        cache->store(first_byte, pkt);
+    }
     return true;
 }
 
@@ -42,6 +42,8 @@ namespace ts {
     //! @ingroup mpeg
     //!
     //! Sections are provided by an object implementing SectionProviderInterface.
+    //! When the provider maintains a SectionPacketCache for a section, the TS packets
+    //! which contain only bytes from that section are replayed from the cache.
     //!
     class TSDUCKDLL Packetizer: public AbstractPacketizer
     {
@@ -64,7 +66,7 @@ namespace ts {
         //! Set the object which provides MPEG sections when the packetizer needs a new section.
         //! @param [in] provider An object which will be called each time a section is required.
         //!
-        void setSectionProvider(SectionProviderInterface* provider) { _provider = provider; }
+        void setSectionProvider(SectionProviderInterface* provider) { _provider = provider; _cache = nullptr; }
 
         //!
         //! Get the object which provides MPEG sections when the packetizer needs a new section.
@@ -111,5 +113,9 @@ namespace ts {
         size_t         _next_byte;         // Next byte to insert in current section
         SectionCounter _section_out_count; // Number of output (packetized) sections
         SectionCounter _section_in_count;  // Number of input (provided) sections
+        SectionPacketCache* _cache;        // Packet cache of last provided section, can be null
+
+        // Get the next section from the provider, return false if there is none.
+        bool getNextSection(SectionPtr& section);
     };
 }
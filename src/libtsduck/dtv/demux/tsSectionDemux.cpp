@@ -34,6 +34,8 @@
 #include "tsTSPacket.h"
 #include "tsEIT.h"
 
+constexpr size_t ts::SectionDemux::DEFAULT_SECTION_POOL_SIZE;
+
 
 //----------------------------------------------------------------------------
 // Demux status information.
@@ -137,9 +139,10 @@ void ts::SectionDemux::ETIDContext::init(uint8_t new_version, uint8_t last_secti
     sect_received = 0;
     sects.resize(sect_expected);
 
-    // Mark all section entries as unused
+    // Mark all section entries as unused. Use clear(), not reset(), because the
+    // sections may be shared with the section pool or the application.
     for (size_t i = 0; i < sect_expected; i++) {
-        sects[i].reset();
+        sects[i].clear();
     }
 }
 
@@ -205,8 +208,53 @@ ts::SectionDemux::SectionDemux(DuckContext& duck, TableHandlerInterface* table_h
     _pids(),
     _status(),
     _get_current(true),
-    _get_next(false)
+    _get_next(false),
+    _pool_size(DEFAULT_SECTION_POOL_SIZE),
+    _pool_next(0),
+    _pool()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Pool of recycled sections.
+//----------------------------------------------------------------------------
+
+void ts::SectionDemux::setSectionPoolSize(size_t size)
+{
+    _pool_size = size;
+    if (_pool.size() > size) {
+        _pool.resize(size);
+    }
+    _pool_next = 0;
+}
+
+ts::SectionPtr ts::SectionDemux::newSection(const uint8_t* data, size_t size, PID pid)
 {
+    // Look for a section which is referenced by the pool only.
+    // Start at the next index after the last reused section.
+    for (size_t i = 0; i < _pool.size(); ++i) {
+        const size_t index = (_pool_next + i) % _pool.size();
+        if (_pool[index].count() == 1 && !_pool[index].isNull()) {
+            _pool_next = (index + 1) % _pool.size();
+            _pool[index]->reload(data, size, pid, CRC32::CHECK);
+            return _pool[index];
+        }
+    }
+
+    // No free section in the pool, allocate a new one.
+    const SectionPtr sect(new Section(data, size, pid, CRC32::CHECK));
+
+    // Add it in the pool. If the pool is full (all sections still used),
+    // replace an old one, which remains referenced by the application.
+    if (_pool.size() < _pool_size) {
+        _pool.push_back(sect);
+    }
+    else if (!_pool.empty()) {
+        _pool[_pool_next] = sect;
+        _pool_next = (_pool_next + 1) % _pool.size();
+    }
+    return sect;
 }
 
 
@@ -491,7 +539,7 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
             SectionPtr sect_ptr;
 
             if (section_ok && (_section_handler != nullptr || (tc != nullptr && tc->sects[section_number].isNull()))) {
-                sect_ptr = new Section(ts_start, section_length, pid, CRC32::CHECK);
+                sect_ptr = newSection(ts_start, section_length, pid);
                 sect_ptr->setFirstTSPacketIndex(pusi_pkt_index);
                 sect_ptr->setLastTSPacketIndex(_packet_count);
                 if (!sect_ptr->isValid()) {
@@ -37,6 +37,7 @@
 #include "tsTableHandlerInterface.h"
 #include "tsSectionHandlerInterface.h"
 #include "tsETID.h"
+#include "tsPIDMap.h"
 
 namespace ts {
     //!
@@ -135,6 +136,21 @@ namespace ts {
             _get_next = next;
         }
 
+        //!
+        //! Default number of sections in the pool of recycled sections.
+        //!
+        static constexpr size_t DEFAULT_SECTION_POOL_SIZE = 64;
+
+        //!
+        //! Set the size of the pool of recycled sections.
+        //! To avoid repeated memory allocations, the demux keeps a pool of sections.
+        //! When a section is no longer referenced by the application, its memory
+        //! is reused for a subsequent section. This is transparent to the application.
+        //! @param [in] size Maximum number of sections in the pool. Zero disables
+        //! the recycling of sections. The default is DEFAULT_SECTION_POOL_SIZE.
+        //!
+        void setSectionPoolSize(size_t size);
+
         //!
         //! Demux status information.
         //! It contains error counters.
@@ -253,13 +269,19 @@ namespace ts {
         // If fill_eit is true, add missing sections in EIT.
         void fixAndFlush(bool pack, bool fill_eit);
 
+        // Get a new section, reusing a free section from the pool when possible.
+        SectionPtr newSection(const uint8_t* data, size_t size, PID pid);
+
         // Private members:
         TableHandlerInterface*   _table_handler;
         SectionHandlerInterface* _section_handler;
-        std::map<PID,PIDContext> _pids;
+        PIDMap<PIDContext>       _pids;
         Status                   _status;
         bool                     _get_current;
         bool                     _get_next;
+        size_t                   _pool_size;   // Max number of sections in _pool.
+        size_t                   _pool_next;   // Next index to check in _pool.
+        SectionPtrVector         _pool;        // Pool of recycled sections.
     };
 }
 
@@ -0,0 +1,126 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "tsSectionPacketCache.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors.
+//----------------------------------------------------------------------------
+
+ts::SectionPacketCache::SectionPacketCache() :
+    _section_size(0),
+    _section_crc(0),
+    _first_offset(0),
+    _packets()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Clear the content of the cache.
+//----------------------------------------------------------------------------
+
+void ts::SectionPacketCache::clear()
+{
+    _section_size = 0;
+    _section_crc = 0;
+    _first_offset = 0;
+    _packets.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Check if the cache applies to a section, before packetizing it.
+//----------------------------------------------------------------------------
+
+void ts::SectionPacketCache::validate(const Section& section)
+{
+    // Short sections have no CRC32 to detect modifications, they are not cached.
+    const size_t size = section.isLongSection() ? section.size() : 0;
+    const uint32_t crc = size >= 4 ? GetUInt32(section.content() + size - 4) : 0;
+
+    if (size != _section_size || crc != _section_crc) {
+        _packets.clear();
+        _section_size = size;
+        _section_crc = crc;
+        _first_offset = 0;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Index in the vector of packets of the packet at the given offset.
+//----------------------------------------------------------------------------
+
+size_t ts::SectionPacketCache::index(size_t offset) const
+{
+    // The cached packets are consecutive, all with PKT_SIZE - 4 bytes of section,
+    // except the first packet of the section which contains a pointer field.
+    const size_t base = _first_offset == 0 && offset > 0 ? PayloadSize(0) : _first_offset;
+    const size_t first = _first_offset == 0 && offset > 0 ? 1 : 0;
+
+    if (offset < base || (offset - base) % PayloadSize(1) != 0) {
+        return NPOS;
+    }
+    else {
+        return first + (offset - base) / PayloadSize(1);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get a cached TS packet.
+//----------------------------------------------------------------------------
+
+const ts::TSPacket* ts::SectionPacketCache::packet(size_t offset) const
+{
+    const size_t i = _packets.empty() ? NPOS : index(offset);
+    return i < _packets.size() ? &_packets[i] : nullptr;
+}
+
+
+//----------------------------------------------------------------------------
+// Store a TS packet in the cache.
+//----------------------------------------------------------------------------
+
+void ts::SectionPacketCache::store(size_t offset, const TSPacket& pkt)
+{
+    if (isFullPacket(offset)) {
+        size_t i = _packets.empty() ? NPOS : index(offset);
+        if (i == NPOS) {
+            // The section is now packetized at another alignment, restart the cache.
+            _packets.clear();
+            _first_offset = offset;
+            i = 0;
+        }
+        if (i == _packets.size()) {
+            _packets.push_back(pkt);
+        }
+    }
+}
@@ -0,0 +1,134 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//!
+//!  @file
+//!  Cache of pre-built TS packets for one section.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsSection.h"
+#include "tsTSPacket.h"
+
+namespace ts {
+    //!
+    //! Cache of pre-built TS packets for one section.
+    //! @ingroup mpeg
+    //!
+    //! When a section is repeatedly packetized, typically in a carousel, the TS packets which
+    //! contain only bytes from this section are identical each time, except the continuity
+    //! counter. A SectionPacketCache keeps the images of these packets so that a Packetizer
+    //! can replay them instead of rebuilding them. The first and last packets of the section,
+    //! which may contain bytes from the adjacent sections or stuffing, are always rebuilt.
+    //!
+    //! The cache is indexed by the position in the section of the first byte in the packet.
+    //! Only long sections are cached, using their CRC32 to detect modified sections.
+    //!
+    //! A SectionPacketCache is owned by a section provider (see SectionProviderInterface)
+    //! which associates it with the section.
+    //!
+    class TSDUCKDLL SectionPacketCache
+    {
+    public:
+        //!
+        //! Constructor.
+        //!
+        SectionPacketCache();
+
+        //!
+        //! Clear the content of the cache.
+        //! No packet is cached or replayed until the next call to validate().
+        //!
+        void clear();
+
+        //!
+        //! Check if the cache applies to a section, before packetizing it.
+        //! If the section is different from the one which was used to build the cache,
+        //! the cache is cleared.
+        //! @param [in] section The section which will be packetized.
+        //!
+        void validate(const Section& section);
+
+        //!
+        //! Check if a TS packet contains only bytes from the section.
+        //! @param [in] offset Position in the section of the first byte in the packet.
+        //! @return True if the TS packet which starts at @a offset in the section is
+        //! completely filled with bytes from the section and can be cached.
+        //!
+        bool isFullPacket(size_t offset) const
+        {
+            return offset < _section_size && _section_size - offset >= PayloadSize(offset);
+        }
+
+        //!
+        //! Get a cached TS packet.
+        //! @param [in] offset Position in the section of the first byte in the packet.
+        //! @return Address of the cached packet or a null pointer if there is none.
+        //!
+        const TSPacket* packet(size_t offset) const;
+
+        //!
+        //! Store a TS packet in the cache.
+        //! @param [in] offset Position in the section of the first byte in the packet.
+        //! @param [in] pkt The packet to store. It shall contain only bytes from the section.
+        //!
+        void store(size_t offset, const TSPacket& pkt);
+
+        //!
+        //! Get the number of bytes from the section in a full TS packet.
+        //! @param [in] offset Position in the section of the first byte in the packet.
+        //! @return Number of bytes from the section in the packet. When @a offset is zero,
+        //! the first packet of the section contains a pointer field.
+        //!
+        static constexpr size_t PayloadSize(size_t offset)
+        {
+            return offset == 0 ? PKT_SIZE - 5 : PKT_SIZE - 4;
+        }
+
+        //!
+        //! Get the size of the section for which the packets are cached.
+        //! @return The size in bytes of the section or zero if no packet can be cached.
+        //!
+        size_t sectionSize() const { return _section_size; }
+
+        //!
+        //! Get the number of cached packets.
+        //! @return The number of cached packets.
+        //!
+        size_t packetCount() const { return _packets.size(); }
+
+    private:
+        size_t         _section_size;  // Size of the cached section, zero when no caching.
+        uint32_t       _section_crc;   // CRC32 of the cached section.
+        size_t         _first_offset;  // Offset in section of first cached packet.
+        TSPacketVector _packets;       // Images of consecutive full packets.
+
+        // Index in _packets of the packet at the given offset, NPOS if not in the same sequence.
+        size_t index(size_t offset) const;
+    };
+}
@@ -32,3 +32,8 @@
 ts::SectionProviderInterface::~SectionProviderInterface()
 {
 }
+
+ts::SectionPacketCache* ts::SectionProviderInterface::sectionPacketCache(const SectionPtr& section)
+{
+    return nullptr;
+}
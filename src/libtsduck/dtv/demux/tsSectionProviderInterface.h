@@ -35,6 +35,7 @@
 
 #pragma once
 #include "tsSection.h"
+#include "tsSectionPacketCache.h"
 
 namespace ts {
     //!
@@ -65,6 +66,18 @@ namespace ts {
         //!
         virtual bool doStuffing() = 0;
 
+        //!
+        //! Get the cache of pre-built TS packets for a section.
+        //! This hook is invoked by the Packetizer after each section which is provided by provideSection().
+        //! A provider which repeatedly provides the same sections should keep one cache per section.
+        //! The default implementation returns a null pointer, the packets are never cached.
+        //! @param [in] section A smart pointer to the section which was returned by the last call to provideSection().
+        //! @return Address of the packet cache for that section or a null pointer if there is none. The cache object
+        //! shall remain valid until the next call to provideSection(). The provider shall clear the cache when it
+        //! modifies the section.
+        //!
+        virtual SectionPacketCache* sectionPacketCache(const SectionPtr& section);
+
         //!
         //! Virtual destructor
         //!
@@ -82,7 +82,7 @@ void ts::SignalizationDemux::reset()
 {
     // Notify that all services disappear.
     if (!_services.empty() && _handler != nullptr) {
-        for (auto it = _services.begin(); it != _services.end(); ) {
+        for (auto it = _services.begin(); it != _services.end(); ++it) {
             _handler->handleService(_ts_id, it->second->service, it->second->pmt, true);
         }
     }
@@ -199,7 +199,7 @@ namespace ts {
 
         // Map of PID contexts, indexed by PID.
         // One context is created per demuxed PES PID.
-        typedef std::map<PID,PIDContext> PIDContextMap;
+        typedef PIDMap<PIDContext> PIDContextMap;
 
         // This internal structure describes the content of one PID.
         struct PIDType
@@ -213,7 +213,7 @@ namespace ts {
 
         // Map of PID types, indexed by PID.
         // All known PID's are referenced here, not only demuxed PES PID's.
-        typedef std::map<PID,PIDType> PIDTypeMap;
+        typedef PIDMap<PIDType> PIDTypeMap;
 
         // Feed the demux with a TS packet (PID already filtered).
         void processPacket(const TSPacket&);
@@ -31,6 +31,7 @@
 #include "tsDuckContext.h"
 #include "tsByteBlock.h"
 #include "tsxmlElement.h"
+#include "tsxmlWriter.h"
 
 const ts::UChar* const ts::AbstractSignalization::XML_GENERIC_DESCRIPTOR  = u"generic_descriptor";
 const ts::UChar* const ts::AbstractSignalization::XML_GENERIC_SHORT_TABLE = u"generic_short_table";
@@ -112,6 +113,23 @@ ts::xml::Element* ts::AbstractSignalization::toXML(DuckContext& duck, xml::Eleme
     return root;
 }
 
+bool ts::AbstractSignalization::toXML(DuckContext& duck, xml::Writer& writer) const
+{
+    if (_is_valid) {
+        writer.startElement(_xml_name);
+        writeXML(duck, writer);
+        writer.endElement();
+    }
+    return _is_valid;
+}
+
+void ts::AbstractSignalization::writeXML(DuckContext& duck, xml::Writer& writer) const
+{
+    // Build the element as an XML tree and write it.
+    buildXML(duck, writer.startDOM());
+    writer.endDOM();
+}
+
 void ts::AbstractSignalization::fromXML(DuckContext& duck, const xml::Element* element)
 {
     // Make sure the object is cleared before analyzing the XML.
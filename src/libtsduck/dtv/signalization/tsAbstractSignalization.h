@@ -92,6 +92,19 @@ namespace ts {
         //!
         xml::Element* toXML(DuckContext& duck, xml::Element* parent) const;
 
+        //!
+        //! This method converts this object to XML, into an XML writer.
+        //!
+        //! When this object is valid, this method starts a new element with the default XML
+        //! name in the writer and then invokes writeXML() in the subclass to write its content.
+        //! Depending on the writer, the XML or JSON text can be directly produced, without XML tree.
+        //!
+        //! @param [in,out] duck TSDuck execution context.
+        //! @param [in,out] writer The XML writer. The new element is a child of its current element.
+        //! @return True if an element was written, false if this object is invalid.
+        //!
+        bool toXML(DuckContext& duck, xml::Writer& writer) const;
+
         //!
         //! This method converts an XML structure to a table or descriptor in this object.
         //!
@@ -172,6 +185,22 @@ namespace ts {
         //!
         virtual void buildXML(DuckContext& duck, xml::Element* root) const = 0;
 
+        //!
+        //! Helper method to convert this object to XML, into an XML writer.
+        //!
+        //! It is called by toXML() only when the object is valid. The root element is
+        //! already started in the writer and is its current element. In writeXML(), the
+        //! subclass shall simply write the attributes and children of the root element.
+        //!
+        //! The default implementation builds the root element using buildXML() and writes
+        //! a copy of it. Subclasses with large XML structures should override writeXML()
+        //! and implement buildXML() using an xml::ElementWriter on the root element.
+        //!
+        //! @param [in,out] duck TSDuck execution context.
+        //! @param [in,out] writer The XML writer.
+        //!
+        virtual void writeXML(DuckContext& duck, xml::Writer& writer) const;
+
         //!
         //! Helper method to convert this object from XML.
         //!
@@ -34,6 +34,7 @@
 #include "tsDuckContext.h"
 #include "tsSection.h"
 #include "tsxmlElement.h"
+#include "tsxmlWriter.h"
 
 
 //----------------------------------------------------------------------------
@@ -568,23 +569,103 @@ ts::xml::Element* ts::BinaryTable::toXML(DuckContext& duck, xml::Element* parent
     }
 
     // Add optional metadata.
-    if ((opt.setPID && _source_pid != PID_NULL) || opt.setLocalTime || opt.setPackets) {
+    if (needMetadataXML(opt)) {
         // Add <metadata> element as first child of the table.
         // This element is not part of the table but describes how the table was collected.
-        xml::Element* meta = new xml::Element(node, u"metadata", CASE_INSENSITIVE, false); // first position
-        if (opt.setPID && _source_pid != PID_NULL) {
-            meta->setIntAttribute(u"PID", _source_pid);
-        }
-        if (opt.setLocalTime) {
-            meta->setDateTimeAttribute(u"time", Time::CurrentLocalTime());
+        buildMetadataXML(new xml::Element(node, u"metadata", CASE_INSENSITIVE, false), opt); // first position
+    }
+
+    return node;
+}
+
+
+//----------------------------------------------------------------------------
+// This method converts the table to XML, into an XML writer.
+//----------------------------------------------------------------------------
+
+bool ts::BinaryTable::toXML(DuckContext& duck, xml::Writer& writer, const XMLOptions& opt) const
+{
+    // Filter invalid tables.
+    if (!_is_valid || _sections.size() == 0 || _sections[0].isNull()) {
+        return false;
+    }
+
+    // The optional metadata are written as first child of the table element, whatever it is.
+    xml::Element meta(nullptr, u"metadata");
+    if (needMetadataXML(opt)) {
+        buildMetadataXML(&meta, opt);
+        writer.setNextFirstChild(&meta);
+    }
+
+    // Try to generate a specialized XML structure.
+    if (!opt.forceGeneric) {
+        // Do we know how to deserialize this table?
+        PSIRepository::TableFactory fac = PSIRepository::Instance()->getTableFactory(_tid, duck.standards(), _source_pid);
+        if (fac != nullptr) {
+            // We know how to deserialize this table.
+            AbstractTablePtr tp = fac();
+            if (!tp.isNull()) {
+                // Deserialize from binary to object.
+                tp->deserialize(duck, *this);
+                // Serialize from object to XML.
+                if (tp->isValid() && tp->toXML(duck, writer)) {
+                    return true;
+                }
+            }
         }
-        if (opt.setPackets) {
-            meta->setIntAttribute(u"first_ts_packet", getFirstTSPacketIndex());
-            meta->setIntAttribute(u"last_ts_packet", getLastTSPacketIndex());
+    }
+
+    // If we could not generate a typed node, generate a generic one.
+    if (_sections[0]->isShortSection()) {
+        // Write a short section node.
+        writer.startElement(AbstractTable::XML_GENERIC_SHORT_TABLE);
+        writer.setIntAttribute(u"table_id", _tid, true);
+        writer.setBoolAttribute(u"private", _sections[0]->isPrivateSection());
+        writer.addHexaText(_sections[0]->payload(), _sections[0]->payloadSize());
+        writer.endElement();
+    }
+    else {
+        // Write a table with long sections.
+        writer.startElement(AbstractTable::XML_GENERIC_LONG_TABLE);
+        writer.setIntAttribute(u"table_id", _tid, true);
+        writer.setIntAttribute(u"table_id_ext", _tid_ext, true);
+        writer.setIntAttribute(u"version", _version);
+        writer.setBoolAttribute(u"current", _sections[0]->isCurrent());
+        writer.setBoolAttribute(u"private", _sections[0]->isPrivateSection());
+
+        // Write each section in binary format.
+        for (size_t index = 0; index < _sections.size(); ++index) {
+            if (!_sections[index].isNull() && _sections[index]->isValid()) {
+                writer.addHexaTextChild(u"section", _sections[index]->payload(), _sections[index]->payloadSize());
+            }
         }
+        writer.endElement();
     }
+    return true;
+}
 
-    return node;
+
+//----------------------------------------------------------------------------
+// Check if XML metadata are required, build them in an XML element.
+//----------------------------------------------------------------------------
+
+bool ts::BinaryTable::needMetadataXML(const XMLOptions& opt) const
+{
+    return (opt.setPID && _source_pid != PID_NULL) || opt.setLocalTime || opt.setPackets;
+}
+
+void ts::BinaryTable::buildMetadataXML(xml::Element* meta, const XMLOptions& opt) const
+{
+    if (opt.setPID && _source_pid != PID_NULL) {
+        meta->setIntAttribute(u"PID", _source_pid);
+    }
+    if (opt.setLocalTime) {
+        meta->setDateTimeAttribute(u"time", Time::CurrentLocalTime());
+    }
+    if (opt.setPackets) {
+        meta->setIntAttribute(u"first_ts_packet", getFirstTSPacketIndex());
+        meta->setIntAttribute(u"last_ts_packet", getLastTSPacketIndex());
+    }
 }
 
 
@@ -324,6 +324,17 @@ namespace ts {
         //!
         xml::Element* toXML(DuckContext& duck, xml::Element* parent, const XMLOptions& opt = XMLOptions()) const;
 
+        //!
+        //! This method converts the table to XML, into an XML writer.
+        //! The XML structure is the same as with the other toXML(). If the table has a specialized
+        //! implementation which directly writes into the XML writer, no XML tree is built.
+        //! @param [in,out] duck TSDuck execution environment.
+        //! @param [in,out] writer The XML writer. The table is written as a child of its current element.
+        //! @param [in] opt Conversion options.
+        //! @return True if the table was written, false if the table is not valid.
+        //!
+        bool toXML(DuckContext& duck, xml::Writer& writer, const XMLOptions& opt = XMLOptions()) const;
+
         //!
         //! This method converts an XML node as a binary table.
         //! @param [in,out] duck TSDuck execution environment.
@@ -339,6 +350,10 @@ namespace ts {
     private:
         BinaryTable(const BinaryTable& table) = delete;
 
+        // Check if XML metadata are required, build them in an XML element.
+        bool needMetadataXML(const XMLOptions& opt) const;
+        void buildMetadataXML(xml::Element* meta, const XMLOptions& opt) const;
+
         // Private fields
         bool             _is_valid;
         TID              _tid;
@@ -28,6 +28,8 @@
 //----------------------------------------------------------------------------
 
 #include "tsCRC32.h"
+#include "tsSysInfo.h"
+#include "tsMemory.h"
 
 
 // The FCS-32 generator polynomial:
@@ -104,13 +106,156 @@ namespace {
     };
 }
 
+
+
+//----------------------------------------------------------------------------
+// Software implementation: "slicing-by-8" algorithm.
+// The first table is fcstab_32. The 7 other tables are computed once so that
+// table[k][i] is the CRC of byte i followed by k zero bytes. Eight input bytes
+// are then processed at once with eight independent table lookups.
+//----------------------------------------------------------------------------
+
+namespace {
+    class SliceTables
+    {
+    public:
+        uint32_t tab[8][256];
+        SliceTables();
+    };
+
+    SliceTables::SliceTables()
+    {
+        for (size_t i = 0; i < 256; ++i) {
+            tab[0][i] = fcstab_32[i];
+        }
+        for (size_t k = 1; k < 8; ++k) {
+            for (size_t i = 0; i < 256; ++i) {
+                const uint32_t prev = tab[k-1][i];
+                tab[k][i] = (prev << 8) ^ fcstab_32[prev >> 24];
+            }
+        }
+    }
+
+    // Process bytes one by one.
+    inline uint32_t AddBytes(uint32_t fcs, const uint8_t* cp, size_t size)
+    {
+        while (size-- > 0) {
+            fcs = (fcs << 8) ^ fcstab_32[((fcs >> 24) ^ (*cp++)) & 0xFF];
+        }
+        return fcs;
+    }
+
+    // Process bytes using slicing-by-8.
+    uint32_t AddSlicing(uint32_t fcs, const uint8_t* cp, size_t size)
+    {
+        // Thread-safe one-time initialization of the tables.
+        static const SliceTables tables;
+        const uint32_t (*t)[256] = tables.tab;
+
+        while (size >= 8) {
+            const uint32_t hi = fcs ^ ts::GetUInt32(cp);
+            fcs = t[7][hi >> 24] ^ t[6][(hi >> 16) & 0xFF] ^ t[5][(hi >> 8) & 0xFF] ^ t[4][hi & 0xFF] ^
+                  t[3][cp[4]] ^ t[2][cp[5]] ^ t[1][cp[6]] ^ t[0][cp[7]];
+            cp += 8;
+            size -= 8;
+        }
+        return AddBytes(fcs, cp, size);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Hardware implementation on Intel x86-64: folding with carry-less multiply.
+// See "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+// Instruction", Intel white paper, 2009. The MPEG CRC32 is not bit-reflected,
+// so the 16-byte blocks are byte-swapped and processed as big-endian 128-bit
+// polynomials. The folding constants are x^n mod P for the fold distances.
+// The final 128-bit remainder is reduced using the table implementation.
+//----------------------------------------------------------------------------
+
+#if defined(TS_X86_64) && defined(TS_GCC)
+#define TS_CRC32_PCLMUL 1
+
+#include <immintrin.h>
+
+// Minimum data size to use the accelerated implementation.
+#define PCLMUL_MIN_SIZE 64
+
+namespace {
+    // Fold a 128-bit polynomial by a distance defined by the constants and add next block.
+    __attribute__((target("pclmul,ssse3")))
+    inline __m128i Fold(__m128i x, __m128i k, __m128i next)
+    {
+        return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), _mm_clmulepi64_si128(x, k, 0x00)), next);
+    }
+
+    __attribute__((target("pclmul,ssse3")))
+    uint32_t AddPCLMUL(uint32_t fcs, const uint8_t* cp, size_t size)
+    {
+        // Byte swap mask for 16-byte blocks.
+        const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+        // Folding constants: high qword for x^(d+64) mod P, low qword for x^d mod P.
+        const __m128i k512 = _mm_set_epi64x(0x8833794C, 0xE6228B11);  // d = 512 bits
+        const __m128i k128 = _mm_set_epi64x(0xC5B9CD4C, 0xE8A45605);  // d = 128 bits
+
+        // Load the first 64 bytes in four accumulators. The previous CRC value
+        // is combined with the first four bytes of data.
+        const __m128i* p = reinterpret_cast<const __m128i*>(cp);
+        __m128i x0 = _mm_xor_si128(_mm_shuffle_epi8(_mm_loadu_si128(p), bswap), _mm_set_epi32(int(fcs), 0, 0, 0));
+        __m128i x1 = _mm_shuffle_epi8(_mm_loadu_si128(p + 1), bswap);
+        __m128i x2 = _mm_shuffle_epi8(_mm_loadu_si128(p + 2), bswap);
+        __m128i x3 = _mm_shuffle_epi8(_mm_loadu_si128(p + 3), bswap);
+        p += 4;
+        size -= 64;
+
+        // Fold 64 bytes at a time in the four accumulators.
+        while (size >= 64) {
+            x0 = Fold(x0, k512, _mm_shuffle_epi8(_mm_loadu_si128(p), bswap));
+            x1 = Fold(x1, k512, _mm_shuffle_epi8(_mm_loadu_si128(p + 1), bswap));
+            x2 = Fold(x2, k512, _mm_shuffle_epi8(_mm_loadu_si128(p + 2), bswap));
+            x3 = Fold(x3, k512, _mm_shuffle_epi8(_mm_loadu_si128(p + 3), bswap));
+            p += 4;
+            size -= 64;
+        }
+
+        // Reduce the four accumulators into one.
+        x0 = Fold(x0, k128, x1);
+        x0 = Fold(x0, k128, x2);
+        x0 = Fold(x0, k128, x3);
+
+        // Fold remaining 16-byte blocks.
+        while (size >= 16) {
+            x0 = Fold(x0, k128, _mm_shuffle_epi8(_mm_loadu_si128(p++), bswap));
+            size -= 16;
+        }
+
+        // The 128-bit remainder is congruent to the data so far. Its CRC is computed
+        // from a zero register. Then add the remaining bytes.
+        uint8_t rem[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(rem), _mm_shuffle_epi8(x0, bswap));
+        return AddSlicing(AddSlicing(0, rem, sizeof(rem)), reinterpret_cast<const uint8_t*>(p), size);
+    }
+}
+
+#endif
+
+
+//----------------------------------------------------------------------------
 // Continue the computation of a data area, following a previous CRC32
+//----------------------------------------------------------------------------
 
-void ts::CRC32::add (const void* data, size_t size)
+void ts::CRC32::add(const void* data, size_t size)
 {
-    const uint8_t* cp = static_cast <const uint8_t*> (data);
+    const uint8_t* cp = static_cast<const uint8_t*>(data);
 
-    while (size-- > 0) {
-        _fcs = (_fcs << 8) ^ fcstab_32 [((_fcs >> 24) ^ (*cp++)) & 0xFF];
+#if defined(TS_CRC32_PCLMUL)
+    static const bool accelerated = SysInfo::Instance()->crcInstructions();
+    if (accelerated && size >= PCLMUL_MIN_SIZE) {
+        _fcs = AddPCLMUL(_fcs, cp, size);
+        return;
     }
+#endif
+
+    _fcs = AddSlicing(_fcs, cp, size);
 }
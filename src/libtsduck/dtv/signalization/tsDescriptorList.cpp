@@ -33,6 +33,7 @@
 #include "tsPrivateDataSpecifierDescriptor.h"
 #include "tsDuckContext.h"
 #include "tsxmlElement.h"
+#include "tsxmlWriter.h"
 
 
 //----------------------------------------------------------------------------
@@ -753,6 +754,17 @@ bool ts::DescriptorList::toXML(DuckContext& duck, xml::Element* parent) const
     return success;
 }
 
+bool ts::DescriptorList::toXML(DuckContext& duck, xml::Writer& writer) const
+{
+    // Descriptors are small, they are built as a temporary XML tree.
+    if (_list.empty()) {
+        return true;
+    }
+    const bool success = toXML(duck, writer.startDOM());
+    writer.endDOM();
+    return success;
+}
+
 
 //----------------------------------------------------------------------------
 // These methods decode an XML list of descriptors.
@@ -389,6 +389,15 @@ namespace ts {
         //!
         bool toXML(DuckContext& duck, xml::Element* parent) const;
 
+        //!
+        //! This method converts a descriptor list to XML, into an XML writer.
+        //! The descriptors are written as children of the current element of the writer.
+        //! @param [in,out] duck TSDuck execution context.
+        //! @param [in,out] writer The XML writer.
+        //! @return True on success, false on error.
+        //!
+        bool toXML(DuckContext& duck, xml::Writer& writer) const;
+
         //!
         //! This method decodes an XML list of descriptors.
         //! @param [in,out] duck TSDuck execution context.
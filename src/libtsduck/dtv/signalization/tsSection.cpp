@@ -127,6 +127,27 @@ ts::Section::Section(const ByteBlockPtr& content_ptr,
 }
 
 
+//----------------------------------------------------------------------------
+// Reload from full binary content.
+//----------------------------------------------------------------------------
+
+void ts::Section::reload(const void* content, size_t content_size, PID source_pid, CRC32::Validation crc_op)
+{
+    const uint8_t* const ptr = reinterpret_cast<const uint8_t*>(content);
+
+    // If the previous data block is not shared and does not overlap with the new content,
+    // reuse it. This avoids the allocation of a new data block and its reference counter.
+    if (!_data.isNull() && _data.count() == 1 && (ptr + content_size <= _data->data() || ptr >= _data->data() + _data->size())) {
+        const ByteBlockPtr bbp(_data);
+        bbp->copy(content, content_size);
+        initialize(bbp, source_pid, crc_op);
+    }
+    else {
+        initialize(new ByteBlock(content, content_size), source_pid, crc_op);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Constructor from a short section payload.
 //----------------------------------------------------------------------------
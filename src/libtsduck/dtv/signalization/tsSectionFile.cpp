@@ -35,7 +35,6 @@
 #include "tsPSIRepository.h"
 #include "tsDuckContext.h"
 #include "tsxmlJSONConverter.h"
-#include "tsjsonNull.h"
 #include "tsFileUtils.h"
 #include "tsEIT.h"
 
@@ -704,35 +703,29 @@ bool ts::SectionFile::parseJSON(const UString& json_content)
 // Create JSON file or text.
 //----------------------------------------------------------------------------
 
-ts::json::ValuePtr ts::SectionFile::convertToJSON()
+bool ts::SectionFile::generateJSONDocument(xml::Document& doc)
 {
-    xml::Document doc(_report);
     doc.setTweaks(_xmlTweaks);
 
-    // Load the XML model, generate the initial XML document, convert XML into JSON.
-    if (loadThisModel() && generateDocument(doc)) {
-        return _model.convertToJSON(doc);
-    }
-    else {
-        return json::ValuePtr(new json::Null);
-    }
+    // Load the XML model and generate the initial XML document. It is later directly converted into JSON text.
+    return loadThisModel() && generateDocument(doc);
 }
 
 bool ts::SectionFile::saveJSON(const UString& file_name)
 {
-    const json::ValuePtr root(convertToJSON());
-    return !root->isNull() && root->save(file_name, 2, true, _report);
+    xml::Document doc(_report);
+    return generateJSONDocument(doc) && _model.saveJSON(doc, file_name, 2, true);
 }
 
 ts::UString ts::SectionFile::toJSON()
 {
-    const json::ValuePtr root(convertToJSON());
-    if (root->isNull()) {
+    xml::Document doc(_report);
+    if (!generateJSONDocument(doc)) {
         return UString();
     }
     TextFormatter text(_report);
     text.setString();
-    root->print(text);
+    _model.printJSON(text, doc);
     return text.toString();
 }
 
@@ -523,7 +523,7 @@ namespace ts {
         // Check it a table can be formed using the last sections in _orphanSections.
         void collectLastTable();
 
-        // Generate a JSON document. Point to a JSON Null literal on error.
-        json::ValuePtr convertToJSON();
+        // Load the model and generate the XML document to convert into JSON.
+        bool generateJSONDocument(xml::Document& doc);
     };
 }
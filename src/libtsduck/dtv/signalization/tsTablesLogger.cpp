@@ -41,6 +41,8 @@
 #include "tsDuckProtocol.h"
 #include "tsxmlComment.h"
 #include "tsxmlElement.h"
+#include "tsxmlTextWriter.h"
+#include "tsxmlJSONWriter.h"
 #include "tsjsonArray.h"
 #include "tsjsonObject.h"
 
@@ -604,38 +606,9 @@ void ts::TablesLogger::handleTable(SectionDemux& demux, const BinaryTable& table
         postDisplay();
     }
 
-    // Save table in XML format.
-    if (_use_xml) {
-        if (_rewrite_xml) {
-            // Build and save a new document each time.
-            xml::Document doc(_report);
-            doc.initialize(u"tsduck");
-            table.toXML(_duck, doc.rootElement(), _xml_options);
-            doc.save(_xml_destination, 2, true);
-        }
-        else {
-            // Just add the table in the running doc.
-            // Convert the table into an XML structure, print and delete the XML table.
-            table.toXML(_duck, _xml_doc.rootElement(), _xml_options);
-            _xml_doc.flush();
-        }
-    }
-
-    // Save table in JSON format.
-    if (_use_json) {
-        // First, build an XML document with the table.
-        xml::Document doc(_report);
-        doc.initialize(u"tsduck");
-        table.toXML(_duck, doc.rootElement(), _xml_options);
-        if (_rewrite_json) {
-            // Convert to JSON and save a new document each time.
-            _x2j_conv.convertToJSON(doc)->save(_json_destination, 2, true, _report);
-        }
-        else {
-            // Convert to JSON. Force "tsduck" root to appear so that the path to the first table is always the same.
-            // Query the first (and only) converted table and add it to the running document.
-            _json_doc.add(_x2j_conv.convertToJSON(doc, true)->query(u"#nodes[0]"));
-        }
+    // Save table in XML and JSON formats, including one-liner logs.
+    if (_use_xml || _use_json || _log_xml_line || _log_json_line) {
+        saveXMLJSON(table);
     }
 
     // Save table in binary format.
@@ -653,11 +626,6 @@ void ts::TablesLogger::handleTable(SectionDemux& demux, const BinaryTable& table
         }
     }
 
-    // Log table as a one-liner XML and/or JSON.
-    if (_log_xml_line || _log_json_line) {
-        logXMLJSON(table);
-    }
-
     // Log table as a one-liner hexadecimal.
     if (_log_hexa_line) {
         UString line;
@@ -803,20 +771,64 @@ void ts::TablesLogger::handleSection(SectionDemux& demux, const Section& sect)
 
 
 //----------------------------------------------------------------------------
-// Log XML or JSON one-liners.
+// Save a table in XML and JSON formats, including one-liner logs.
 //----------------------------------------------------------------------------
 
-void ts::TablesLogger::logXMLJSON(const BinaryTable& table)
+void ts::TablesLogger::saveXMLJSON(const BinaryTable& table)
 {
-    // Build an XML document.
-    xml::Document doc;
-    doc.initialize(u"tsduck");
-    xml::Element* elem = table.toXML(_duck, doc.rootElement(), _xml_options);
-    if (elem == nullptr) {
-        // Error serializing the table, error message already printed.
+    // Invalid tables have no XML representation.
+    if (!table.isValid()) {
         return;
     }
 
+    // Add the table in the running XML document. It is directly printed, without XML tree.
+    if (_use_xml && !_rewrite_xml) {
+        TextFormatter* text = _xml_doc.startElement();
+        if (text != nullptr) {
+            xml::TextWriter writer(*text, _xml_tweaks);
+            table.toXML(_duck, writer, _xml_options);
+        }
+    }
+
+    // Add the table in the running JSON document. It is directly printed, without XML or JSON tree.
+    if (_use_json && !_rewrite_json) {
+        TextFormatter* text = _json_doc.startValue();
+        if (text != nullptr) {
+            xml::JSONWriter writer(*text, _x2j_conv);
+            table.toXML(_duck, writer, _xml_options);
+        }
+    }
+
+    // Rewritten files and one-liner logs use an XML tree of the table, built once for all of them.
+    if ((_use_xml && _rewrite_xml) || (_use_json && _rewrite_json) || _log_xml_line || _log_json_line) {
+        xml::Document doc(_report);
+        doc.initialize(u"tsduck");
+        const xml::Element* elem = table.toXML(_duck, doc.rootElement(), _xml_options);
+
+        // Save a new XML document each time.
+        if (_use_xml && _rewrite_xml) {
+            doc.save(_xml_destination, 2, true);
+        }
+
+        // Convert to JSON and save a new document each time, without intermediate JSON tree.
+        if (_use_json && _rewrite_json) {
+            _x2j_conv.saveJSON(doc, _json_destination, 2, true);
+        }
+
+        // Log table as a one-liner XML and/or JSON.
+        if (elem != nullptr && (_log_xml_line || _log_json_line)) {
+            logXMLJSON(doc, elem);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Log XML or JSON one-liners.
+//----------------------------------------------------------------------------
+
+void ts::TablesLogger::logXMLJSON(const xml::Document& doc, const xml::Element* elem)
+{
     // Initialize a text formatter for one-liner.
     TextFormatter text(_report);
     text.setString();
@@ -831,17 +843,13 @@ void ts::TablesLogger::logXMLJSON(const BinaryTable& table)
     // Log the JSON line.
     if (_log_json_line) {
 
-        // Convert the XML document into JSON.
-        // Force "tsduck" root to appear so that the path to the first table is always the same.
-        const json::ValuePtr root(_x2j_conv.convertToJSON(doc, true));
-
         // Reset the text formatter if already used for XML.
         if (_log_xml_line) {
             text.setString();
         }
 
-        // Query the first (and only) converted table and log it as one line.
-        root->query(u"#nodes[0]").print(text);
+        // Convert the XML table directly into a JSON line.
+        _x2j_conv.printJSON(text, elem);
         _report.info(_log_json_prefix + text.toString());
     }
 }
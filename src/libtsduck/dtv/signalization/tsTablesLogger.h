@@ -238,8 +238,11 @@ namespace ts {
         // Save a section in a binary file
         void saveBinarySection(const Section&);
 
-        // Log XML and/or JSON one-liners.
-        void logXMLJSON(const BinaryTable& table);
+        // Save a table in XML and JSON formats, including one-liner logs.
+        void saveXMLJSON(const BinaryTable& table);
+
+        // Log XML and/or JSON one-liners for an XML table in a document.
+        void logXMLJSON(const xml::Document& doc, const xml::Element* elem);
 
         // Send UDP table and section.
         void sendUDP(const BinaryTable& table);
@@ -40,6 +40,7 @@
 #include "tsPSIBuffer.h"
 #include "tsDuckContext.h"
 #include "tsxmlElement.h"
+#include "tsxmlElementWriter.h"
 
 #define MY_XML_NAME u"EIT"
 #define MY_CLASS ts::EIT
@@ -520,29 +521,37 @@ void ts::EIT::DisplaySection(TablesDisplay& disp, const ts::Section& section, PS
 //----------------------------------------------------------------------------
 
 void ts::EIT::buildXML(DuckContext& duck, xml::Element* root) const
+{
+    // The XML structure is defined once, in writeXML().
+    xml::ElementWriter writer(root);
+    writeXML(duck, writer);
+}
+
+void ts::EIT::writeXML(DuckContext& duck, xml::Writer& writer) const
 {
     if (isPresentFollowing()) {
-        root->setAttribute(u"type", u"pf");
+        writer.setAttribute(u"type", u"pf");
     }
     else {
-        root->setIntAttribute(u"type", _table_id - (isActual() ? TID_EIT_S_ACT_MIN : TID_EIT_S_OTH_MIN));
+        writer.setIntAttribute(u"type", _table_id - (isActual() ? TID_EIT_S_ACT_MIN : TID_EIT_S_OTH_MIN));
     }
-    root->setIntAttribute(u"version", version);
-    root->setBoolAttribute(u"current", is_current);
-    root->setBoolAttribute(u"actual", isActual());
-    root->setIntAttribute(u"service_id", service_id, true);
-    root->setIntAttribute(u"transport_stream_id", ts_id, true);
-    root->setIntAttribute(u"original_network_id", onetw_id, true);
-    root->setIntAttribute(u"last_table_id", last_table_id, true);
+    writer.setIntAttribute(u"version", version);
+    writer.setBoolAttribute(u"current", is_current);
+    writer.setBoolAttribute(u"actual", isActual());
+    writer.setIntAttribute(u"service_id", service_id, true);
+    writer.setIntAttribute(u"transport_stream_id", ts_id, true);
+    writer.setIntAttribute(u"original_network_id", onetw_id, true);
+    writer.setIntAttribute(u"last_table_id", last_table_id, true);
 
     for (auto it = events.begin(); it != events.end(); ++it) {
-        xml::Element* e = root->addElement(u"event");
-        e->setIntAttribute(u"event_id", it->second.event_id, true);
-        e->setDateTimeAttribute(u"start_time", it->second.start_time);
-        e->setTimeAttribute(u"duration", it->second.duration);
-        e->setEnumAttribute(RST::RunningStatusNames, u"running_status", it->second.running_status);
-        e->setBoolAttribute(u"CA_mode", it->second.CA_controlled);
-        it->second.descs.toXML(duck, e);
+        writer.startElement(u"event");
+        writer.setIntAttribute(u"event_id", it->second.event_id, true);
+        writer.setDateTimeAttribute(u"start_time", it->second.start_time);
+        writer.setTimeAttribute(u"duration", it->second.duration);
+        writer.setEnumAttribute(RST::RunningStatusNames, u"running_status", it->second.running_status);
+        writer.setBoolAttribute(u"CA_mode", it->second.CA_controlled);
+        it->second.descs.toXML(duck, writer);
+        writer.endElement();
     }
 }
 
@@ -35,6 +35,7 @@
 #include "tsPSIBuffer.h"
 #include "tsDuckContext.h"
 #include "tsxmlElement.h"
+#include "tsxmlElementWriter.h"
 
 #define MY_XML_NAME u"PMT"
 #define MY_CLASS ts::PMT
@@ -501,19 +502,27 @@ void ts::PMT::DisplaySection(TablesDisplay& disp, const ts::Section& section, PS
 
 void ts::PMT::buildXML(DuckContext& duck, xml::Element* root) const
 {
-    root->setIntAttribute(u"version", version);
-    root->setBoolAttribute(u"current", is_current);
-    root->setIntAttribute(u"service_id", service_id, true);
+    // The XML structure is defined once, in writeXML().
+    xml::ElementWriter writer(root);
+    writeXML(duck, writer);
+}
+
+void ts::PMT::writeXML(DuckContext& duck, xml::Writer& writer) const
+{
+    writer.setIntAttribute(u"version", version);
+    writer.setBoolAttribute(u"current", is_current);
+    writer.setIntAttribute(u"service_id", service_id, true);
     if (pcr_pid != PID_NULL) {
-        root->setIntAttribute(u"PCR_PID", pcr_pid, true);
+        writer.setIntAttribute(u"PCR_PID", pcr_pid, true);
     }
-    descs.toXML(duck, root);
+    descs.toXML(duck, writer);
 
     for (StreamMap::const_iterator it = streams.begin(); it != streams.end(); ++it) {
-        xml::Element* e = root->addElement(u"component");
-        e->setIntAttribute(u"elementary_PID", it->first, true);
-        e->setIntAttribute(u"stream_type", it->second.stream_type, true);
-        it->second.descs.toXML(duck, e);
+        writer.startElement(u"component");
+        writer.setIntAttribute(u"elementary_PID", it->first, true);
+        writer.setIntAttribute(u"stream_type", it->second.stream_type, true);
+        it->second.descs.toXML(duck, writer);
+        writer.endElement();
     }
 }
 
@@ -36,6 +36,7 @@
 #include "tsPSIBuffer.h"
 #include "tsDuckContext.h"
 #include "tsxmlElement.h"
+#include "tsxmlElementWriter.h"
 
 #define MY_XML_NAME u"SDT"
 #define MY_CLASS ts::SDT
@@ -404,20 +405,28 @@ void ts::SDT::DisplaySection(TablesDisplay& disp, const ts::Section& section, PS
 
 void ts::SDT::buildXML(DuckContext& duck, xml::Element* root) const
 {
-    root->setIntAttribute(u"version", version);
-    root->setBoolAttribute(u"current", is_current);
-    root->setIntAttribute(u"transport_stream_id", ts_id, true);
-    root->setIntAttribute(u"original_network_id", onetw_id, true);
-    root->setBoolAttribute(u"actual", isActual());
+    // The XML structure is defined once, in writeXML().
+    xml::ElementWriter writer(root);
+    writeXML(duck, writer);
+}
+
+void ts::SDT::writeXML(DuckContext& duck, xml::Writer& writer) const
+{
+    writer.setIntAttribute(u"version", version);
+    writer.setBoolAttribute(u"current", is_current);
+    writer.setIntAttribute(u"transport_stream_id", ts_id, true);
+    writer.setIntAttribute(u"original_network_id", onetw_id, true);
+    writer.setBoolAttribute(u"actual", isActual());
 
     for (ServiceMap::const_iterator it = services.begin(); it != services.end(); ++it) {
-        xml::Element* e = root->addElement(u"service");
-        e->setIntAttribute(u"service_id", it->first, true);
-        e->setBoolAttribute(u"EIT_schedule", it->second.EITs_present);
-        e->setBoolAttribute(u"EIT_present_following", it->second.EITpf_present);
-        e->setBoolAttribute(u"CA_mode", it->second.CA_controlled);
-        e->setEnumAttribute(RST::RunningStatusNames, u"running_status", it->second.running_status);
-        it->second.descs.toXML(duck, e);
+        writer.startElement(u"service");
+        writer.setIntAttribute(u"service_id", it->first, true);
+        writer.setBoolAttribute(u"EIT_schedule", it->second.EITs_present);
+        writer.setBoolAttribute(u"EIT_present_following", it->second.EITpf_present);
+        writer.setBoolAttribute(u"CA_mode", it->second.CA_controlled);
+        writer.setEnumAttribute(RST::RunningStatusNames, u"running_status", it->second.running_status);
+        it->second.descs.toXML(duck, writer);
+        writer.endElement();
     }
 }
 
@@ -276,6 +276,7 @@ namespace ts {
         virtual void serializePayload(BinaryTable&, PSIBuffer&) const override;
         virtual void deserializePayload(PSIBuffer&, const Section&) override;
         virtual void buildXML(DuckContext&, xml::Element*) const override;
+        virtual void writeXML(DuckContext&, xml::Writer&) const override;
         virtual bool analyzeXML(DuckContext&, const xml::Element*) override;
     };
 }
@@ -0,0 +1,286 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  A map of objects, directly indexed by PID.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTS.h"
+
+namespace ts {
+    //!
+    //! A map of objects, directly indexed by PID.
+    //! @ingroup mpeg
+    //!
+    //! The interface is a subset of @c std::map<PID,T>. Elements are iterated in
+    //! increasing order of PID values. References to elements remain valid until
+    //! the elements are erased.
+    //!
+    //! The implementation uses a table of 8192 pointers, one per PID value. This
+    //! table is allocated when the first element is inserted. Each element is
+    //! individually allocated. Accessing an element from its PID is a direct indexed
+    //! access instead of a binary tree lookup. This is appropriate for the per-packet
+    //! processing of demuxes and analyzers.
+    //!
+    //! @tparam T Type of the mapped values.
+    //!
+    template <typename T>
+    class PIDMap
+    {
+    public:
+        typedef PID key_type;                        //!< Type of keys in the map.
+        typedef T mapped_type;                       //!< Type of mapped values.
+        typedef std::pair<const PID, T> value_type;  //!< Type of elements in the map.
+
+        //!
+        //! Forward iterator template over the elements of the map.
+        //! @tparam MAP The PIDMap type, possibly const.
+        //! @tparam VALUE The element type, possibly const.
+        //!
+        template <class MAP, class VALUE>
+        class IteratorTemplate
+        {
+        public:
+            //! @cond nodoxygen
+            typedef std::forward_iterator_tag iterator_category;
+            typedef VALUE value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef VALUE* pointer;
+            typedef VALUE& reference;
+            //! @endcond
+
+            //!
+            //! Default constructor, an end iterator.
+            //!
+            IteratorTemplate() : _map(nullptr), _pid(PID_MAX) {}
+
+            //!
+            //! Converting constructor, typically from iterator to const_iterator.
+            //! @param [in] other Another iterator.
+            //!
+            template <class MAP2, class VALUE2>
+            IteratorTemplate(const IteratorTemplate<MAP2, VALUE2>& other) : _map(other._map), _pid(other._pid) {}
+
+            //! @cond nodoxygen
+            IteratorTemplate(const IteratorTemplate&) = default;
+            IteratorTemplate& operator=(const IteratorTemplate&) = default;
+            //! @endcond
+
+            //!
+            //! Access the referenced element.
+            //! @return A reference to the element.
+            //!
+            VALUE& operator*() const { return *_map->_slots[_pid]; }
+
+            //!
+            //! Access the referenced element.
+            //! @return A pointer to the element.
+            //!
+            VALUE* operator->() const { return _map->_slots[_pid]; }
+
+            //!
+            //! Move to the next element (prefix increment).
+            //! @return A reference to this object.
+            //!
+            IteratorTemplate& operator++() { _pid = _map->next(_pid + 1); return *this; }
+
+            //!
+            //! Move to the next element (postfix increment).
+            //! @return A copy of this object before increment.
+            //!
+            IteratorTemplate operator++(int) { IteratorTemplate it(*this); ++*this; return it; }
+
+            //!
+            //! Equality operator.
+            //! @param [in] other Another iterator.
+            //! @return True if this object is equal to @a other.
+            //!
+            bool operator==(const IteratorTemplate& other) const { return _pid == other._pid; }
+
+            //!
+            //! Unequality operator.
+            //! @param [in] other Another iterator.
+            //! @return True if this object is different from @a other.
+            //!
+            bool operator!=(const IteratorTemplate& other) const { return _pid != other._pid; }
+
+        private:
+            template <class, class> friend class IteratorTemplate;
+            friend class PIDMap<T>;
+            MAP* _map;
+            PID  _pid;
+            IteratorTemplate(MAP* map, PID pid) : _map(map), _pid(pid) {}
+        };
+
+        typedef IteratorTemplate<PIDMap, value_type> iterator;                    //!< Iterator type.
+        typedef IteratorTemplate<const PIDMap, const value_type> const_iterator;  //!< Constant iterator type.
+
+        //!
+        //! Default constructor.
+        //!
+        PIDMap();
+
+        //!
+        //! Copy constructor.
+        //! @param [in] other Another instance to copy.
+        //!
+        PIDMap(const PIDMap& other);
+
+        //!
+        //! Move constructor.
+        //! @param [in,out] other Another instance to move.
+        //!
+        PIDMap(PIDMap&& other) noexcept;
+
+        //!
+        //! Destructor.
+        //!
+        ~PIDMap();
+
+        //!
+        //! Assignment operator.
+        //! @param [in] other Another instance to copy.
+        //! @return A reference to this object.
+        //!
+        PIDMap& operator=(const PIDMap& other);
+
+        //!
+        //! Move assignment operator.
+        //! @param [in,out] other Another instance to move.
+        //! @return A reference to this object.
+        //!
+        PIDMap& operator=(PIDMap&& other) noexcept;
+
+        //!
+        //! Get the number of elements in the map.
+        //! @return The number of elements in the map.
+        //!
+        size_t size() const { return _count; }
+
+        //!
+        //! Check if the map is empty.
+        //! @return True if the map is empty.
+        //!
+        bool empty() const { return _count == 0; }
+
+        //!
+        //! Remove all elements.
+        //!
+        void clear();
+
+        //!
+        //! Access or create the element for a PID.
+        //! If the element does not exist, a default-constructed element is created.
+        //! @param [in] pid A PID value. Must be lower than PID_MAX. Throw std::out_of_range otherwise.
+        //! @return A reference to the element for @a pid.
+        //!
+        T& operator[](PID pid);
+
+        //!
+        //! Find the element for a PID.
+        //! @param [in] pid A PID value.
+        //! @return An iterator to the element for @a pid or end() if there is none.
+        //!
+        iterator find(PID pid) { return iterator(this, contains(pid) ? pid : PID_MAX); }
+
+        //!
+        //! Find the element for a PID.
+        //! @param [in] pid A PID value.
+        //! @return An iterator to the element for @a pid or end() if there is none.
+        //!
+        const_iterator find(PID pid) const { return const_iterator(this, contains(pid) ? pid : PID_MAX); }
+
+        //!
+        //! Count the elements for a PID.
+        //! @param [in] pid A PID value.
+        //! @return The number of elements for @a pid, 0 or 1.
+        //!
+        size_t count(PID pid) const { return contains(pid) ? 1 : 0; }
+
+        //!
+        //! Insert an element if there is none for the same PID.
+        //! @param [in] value The element to insert.
+        //! @return A pair made of an iterator to the element for the PID and a boolean
+        //! which is true if the element was inserted and false if it already existed.
+        //!
+        std::pair<iterator, bool> insert(const value_type& value);
+
+        //!
+        //! Erase the element for a PID, if there is one.
+        //! @param [in] pid A PID value.
+        //! @return The number of erased elements, 0 or 1.
+        //!
+        size_t erase(PID pid);
+
+        //!
+        //! Erase an element.
+        //! @param [in] it An iterator to the element to erase.
+        //! @return An iterator to the element following the erased one.
+        //!
+        iterator erase(const_iterator it);
+
+        //!
+        //! Get an iterator to the first element.
+        //! @return An iterator to the first element.
+        //!
+        iterator begin() { return iterator(this, next(0)); }
+
+        //!
+        //! Get an iterator to the first element.
+        //! @return An iterator to the first element.
+        //!
+        const_iterator begin() const { return const_iterator(this, next(0)); }
+
+        //!
+        //! Get an iterator after the last element.
+        //! @return An iterator after the last element.
+        //!
+        iterator end() { return iterator(this, PID_MAX); }
+
+        //!
+        //! Get an iterator after the last element.
+        //! @return An iterator after the last element.
+        //!
+        const_iterator end() const { return const_iterator(this, PID_MAX); }
+
+    private:
+        size_t _count;                     // Number of elements in the map.
+        std::vector<value_type*> _slots;   // PID_MAX entries when not empty, one per PID.
+
+        // Check if an element exists for a PID.
+        bool contains(PID pid) const { return pid < _slots.size() && _slots[pid] != nullptr; }
+
+        // Get the first PID with an element, starting at pid, PID_MAX if there is none.
+        PID next(PID pid) const;
+    };
+}
+
+#include "tsPIDMapTemplate.h"
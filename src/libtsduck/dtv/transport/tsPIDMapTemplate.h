@@ -0,0 +1,194 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+template <typename T>
+ts::PIDMap<T>::PIDMap() :
+    _count(0),
+    _slots()
+{
+}
+
+template <typename T>
+ts::PIDMap<T>::PIDMap(const PIDMap& other) :
+    _count(0),
+    _slots()
+{
+    *this = other;
+}
+
+template <typename T>
+ts::PIDMap<T>::PIDMap(PIDMap&& other) noexcept :
+    _count(other._count),
+    _slots(std::move(other._slots))
+{
+    other._count = 0;
+    other._slots.clear();
+}
+
+template <typename T>
+ts::PIDMap<T>::~PIDMap()
+{
+    clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Assignment operators.
+//----------------------------------------------------------------------------
+
+template <typename T>
+ts::PIDMap<T>& ts::PIDMap<T>::operator=(const PIDMap& other)
+{
+    if (&other != this) {
+        clear();
+        if (other._count > 0) {
+            _slots.resize(PID_MAX, nullptr);
+            for (PID pid = other.next(0); pid < PID_MAX; pid = other.next(pid + 1)) {
+                _slots[pid] = new value_type(*other._slots[pid]);
+                _count++;
+            }
+        }
+    }
+    return *this;
+}
+
+template <typename T>
+ts::PIDMap<T>& ts::PIDMap<T>::operator=(PIDMap&& other) noexcept
+{
+    if (&other != this) {
+        clear();
+        _count = other._count;
+        _slots.swap(other._slots);
+        other._count = 0;
+    }
+    return *this;
+}
+
+
+//----------------------------------------------------------------------------
+// Remove all elements.
+//----------------------------------------------------------------------------
+
+template <typename T>
+void ts::PIDMap<T>::clear()
+{
+    for (auto& slot : _slots) {
+        delete slot;
+    }
+    _slots.clear();
+    _count = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Access or create the element for a PID.
+//----------------------------------------------------------------------------
+
+template <typename T>
+T& ts::PIDMap<T>::operator[](PID pid)
+{
+    if (_slots.empty()) {
+        _slots.resize(PID_MAX, nullptr);
+    }
+    value_type*& slot(_slots.at(pid));
+    if (slot == nullptr) {
+        slot = new value_type(std::piecewise_construct, std::forward_as_tuple(pid), std::forward_as_tuple());
+        _count++;
+    }
+    return slot->second;
+}
+
+
+//----------------------------------------------------------------------------
+// Insert an element if there is none for the same PID.
+//----------------------------------------------------------------------------
+
+template <typename T>
+std::pair<typename ts::PIDMap<T>::iterator, bool> ts::PIDMap<T>::insert(const value_type& value)
+{
+    if (_slots.empty()) {
+        _slots.resize(PID_MAX, nullptr);
+    }
+    value_type*& slot(_slots.at(value.first));
+    const bool inserted = slot == nullptr;
+    if (inserted) {
+        slot = new value_type(value);
+        _count++;
+    }
+    return std::make_pair(iterator(this, value.first), inserted);
+}
+
+
+//----------------------------------------------------------------------------
+// Erase elements.
+//----------------------------------------------------------------------------
+
+template <typename T>
+size_t ts::PIDMap<T>::erase(PID pid)
+{
+    if (!contains(pid)) {
+        return 0;
+    }
+    delete _slots[pid];
+    _slots[pid] = nullptr;
+    _count--;
+    return 1;
+}
+
+template <typename T>
+typename ts::PIDMap<T>::iterator ts::PIDMap<T>::erase(const_iterator it)
+{
+    const PID pid = it._pid;
+    erase(pid);
+    return iterator(this, next(pid + 1));
+}
+
+
+//----------------------------------------------------------------------------
+// Get the first PID with an element, starting at pid.
+//----------------------------------------------------------------------------
+
+template <typename T>
+ts::PID ts::PIDMap<T>::next(PID pid) const
+{
+    if (_count > 0) {
+        while (pid < _slots.size()) {
+            if (_slots[pid] != nullptr) {
+                return pid;
+            }
+            pid++;
+        }
+    }
+    return PID_MAX;
+}
@@ -0,0 +1,696 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "tsSharedMemoryRing.h"
+#include "tsThread.h"
+#include "tsMutex.h"
+#include "tsCondition.h"
+#include "tsGuardCondition.h"
+#include "tsSysUtils.h"
+#include <atomic>
+#if defined(TS_LINUX)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+constexpr size_t ts::SharedMemoryRing::MAX_READERS;
+constexpr size_t ts::SharedMemoryRing::DEFAULT_PACKETS;
+constexpr ts::MilliSecond ts::SharedMemoryRing::LEASE_TIMEOUT;
+
+#if !defined(TS_WINDOWS)
+namespace {
+    // Identification of the shared memory layout.
+    constexpr uint32_t SHM_MAGIC = 0x5453484D;  // "TSHM"
+    constexpr uint32_t SHM_VERSION = 3;
+
+    // Polling interval of wait operations, also heartbeat interval.
+    constexpr ts::MilliSecond POLL_INTERVAL = 100;
+
+    // Reader slot states.
+    enum : uint32_t {SLOT_FREE = 0, SLOT_JOINING = 1, SLOT_ACTIVE = 2};
+
+    // Wait on a sequence word, wake up all waiters.
+    // On Linux, futexes on shared memory are used between processes.
+    // On other systems, we poll the word.
+    void Wait(std::atomic<uint32_t>& word, uint32_t value, ts::MilliSecond timeout)
+    {
+#if defined(TS_LINUX)
+        ::timespec ts;
+        ts.tv_sec = time_t(timeout / ts::MilliSecPerSec);
+        ts.tv_nsec = long((timeout % ts::MilliSecPerSec) * ts::NanoSecPerMilliSec);
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, value, &ts, nullptr, 0);
+#else
+        for (ts::MilliSecond waited = 0; waited < timeout && word.load() == value; waited++) {
+            ts::SleepThread(1);
+        }
+#endif
+    }
+
+    void Wake(std::atomic<uint32_t>& word)
+    {
+#if defined(TS_LINUX)
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#else
+        // Nothing to do, the waiters poll the word.
+        TS_UNUSED std::atomic<uint32_t>* unused = &word;
+#endif
+    }
+}
+#endif
+
+
+//----------------------------------------------------------------------------
+// Header of the shared memory segment.
+// The packets and serialized metadata follow the header.
+//----------------------------------------------------------------------------
+
+struct ts::SharedMemoryRing::Header
+{
+    // Description of one reader in the shared memory.
+    struct Reader {
+        std::atomic<uint32_t> state;       // Reader slot state.
+        std::atomic<uint32_t> owner;       // Incremented each time a reader joins with this slot.
+        std::atomic<uint32_t> heartbeat;   // Periodically incremented by the reader.
+        std::atomic<int32_t>  pid;         // Process id of the reader, for messages only.
+        std::atomic<uint64_t> read_index;  // Absolute index of next packet to read.
+
+        // Check if the slot is still active for the reader which joined with this owner value.
+        bool ownedBy(uint32_t id) const { return state.load() == SLOT_ACTIVE && owner.load() == id; }
+    };
+
+    std::atomic<uint32_t> magic;            // Set last, when the header is initialized.
+    uint32_t              version;          // Layout version.
+    uint32_t              capacity;         // Number of packets in the ring.
+    int32_t               writer_pid;       // Process id of the writer, for messages only.
+    std::atomic<uint32_t> writer_heartbeat; // Periodically incremented by the writer.
+    std::atomic<uint32_t> eof;              // Writer has terminated.
+    std::atomic<uint32_t> data_seq;         // Incremented when packets are written (futex word).
+    std::atomic<uint32_t> space_seq;        // Incremented when packets are read (futex word).
+    std::atomic<uint32_t> readers_waiting;  // Number of readers waiting for data.
+    std::atomic<uint32_t> writer_waiting;   // Non-zero when the writer waits for space.
+    std::atomic<uint64_t> write_index;      // Absolute index of next packet to write.
+    Reader                readers[MAX_READERS];
+
+    // Size of the header, rounded up to a cache line.
+    static size_t HeaderSize() { return round_up(sizeof(Header), size_t(64)); }
+
+    // Size of the shared memory for a given number of packets.
+    static size_t SegmentSize(size_t capacity) { return HeaderSize() + capacity * (PKT_SIZE + TSPacketMetadata::SERIALIZATION_SIZE); }
+};
+
+
+//----------------------------------------------------------------------------
+// Heartbeat thread: periodically increment a heartbeat counter in the shared
+// memory. The peers check that the counter is still moving.
+//----------------------------------------------------------------------------
+
+class ts::SharedMemoryRing::HeartbeatThread: private Thread
+{
+    TS_NOBUILD_NOCOPY(HeartbeatThread);
+public:
+    // Constructor and destructor. The thread is started in the constructor, stopped in the destructor.
+    // For a reader, the heartbeat stops when the slot is no longer owned by the reader.
+    HeartbeatThread(std::atomic<uint32_t>& counter, const Header::Reader* reader = nullptr, uint32_t owner = 0);
+    virtual ~HeartbeatThread() override;
+
+private:
+    std::atomic<uint32_t>& _counter;    // Heartbeat counter in shared memory.
+    const Header::Reader*  _reader;     // Reader slot, null for the writer.
+    uint32_t               _owner;      // Owner value of the reader slot.
+    Mutex                  _mutex;      // Protect _terminate.
+    Condition              _wakeup;     // Signaled on termination.
+    bool                   _terminate;  // Termination request.
+
+    // Implementation of Thread.
+    virtual void main() override;
+};
+
+ts::SharedMemoryRing::HeartbeatThread::HeartbeatThread(std::atomic<uint32_t>& counter, const Header::Reader* reader, uint32_t owner) :
+    Thread(),
+    _counter(counter),
+    _reader(reader),
+    _owner(owner),
+    _mutex(),
+    _wakeup(),
+    _terminate(false)
+{
+    // Signal our presence immediately, a reused slot gets a new heartbeat value.
+    _counter.fetch_add(1);
+    start();
+}
+
+ts::SharedMemoryRing::HeartbeatThread::~HeartbeatThread()
+{
+    {
+        GuardCondition lock(_mutex, _wakeup);
+        _terminate = true;
+        lock.signal();
+    }
+    waitForTermination();
+}
+
+void ts::SharedMemoryRing::HeartbeatThread::main()
+{
+    GuardCondition lock(_mutex, _wakeup);
+    while (!_terminate) {
+        lock.waitCondition(POLL_INTERVAL);
+        // Never maintain the heartbeat of a slot which was reclaimed by the writer and maybe reused.
+        if (_reader != nullptr && !_reader->ownedBy(_owner)) {
+            break;
+        }
+        _counter.fetch_add(1);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::SharedMemoryRing::Lease::Lease() :
+    valid(false),
+    value(0),
+    time()
+{
+}
+
+ts::SharedMemoryRing::SharedMemoryRing(Report& report, AbortInterface* abort) :
+    _report(report),
+    _abort(abort),
+    _aborted(false),
+    _name(),
+    _shm_name(),
+    _writer(false),
+    _header(nullptr),
+    _map_size(0),
+    _packets(nullptr),
+    _metadata(nullptr),
+    _capacity(0),
+    _slot(0),
+    _owner(0),
+    _blocked_count(0),
+    _heartbeat(nullptr),
+    _writer_lease(),
+    _reader_leases()
+{
+}
+
+ts::SharedMemoryRing::~SharedMemoryRing()
+{
+    close();
+}
+
+
+//----------------------------------------------------------------------------
+// Check if a string is a valid name for a shared memory ring.
+//----------------------------------------------------------------------------
+
+bool ts::SharedMemoryRing::IsValidName(const UString& name)
+{
+    return !name.empty() && name.find(u'/') == NPOS;
+}
+
+
+//----------------------------------------------------------------------------
+// Set the name of the shared memory.
+//----------------------------------------------------------------------------
+
+bool ts::SharedMemoryRing::setName(const UString& name)
+{
+    close();
+    _aborted = false;
+    _name = name;
+
+    if (!IsValidName(name)) {
+        _report.error(u"invalid shared memory name \"%s\"", {name});
+        return false;
+    }
+#if defined(TS_WINDOWS)
+    _report.error(u"shared memory rings are not supported on Windows");
+    return false;
+#else
+    _shm_name = "/tsduck-shm-" + name.toUTF8();
+
+    // Atomic operations must be performed by the processor, not by a library lock.
+    if (!std::atomic<uint64_t>().is_lock_free() || !std::atomic<uint32_t>().is_lock_free()) {
+        _report.error(u"lock-free atomic operations not supported on this platform");
+        return false;
+    }
+    return true;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Check if the lease of a peer has expired, given its current heartbeat.
+//----------------------------------------------------------------------------
+
+bool ts::SharedMemoryRing::LeaseExpired(Lease& lease, uint32_t heartbeat)
+{
+    // The time of the last change is measured with the local monotonic clock,
+    // the heartbeat counter is the only information from the peer.
+    const Monotonic now(true);
+    if (!lease.valid || lease.value != heartbeat) {
+        lease.valid = true;
+        lease.value = heartbeat;
+        lease.time = now;
+        return false;
+    }
+    return now - lease.time >= LEASE_TIMEOUT * NanoSecPerMilliSec;
+}
+
+
+#if defined(TS_WINDOWS)
+
+//----------------------------------------------------------------------------
+// Windows stubs.
+//----------------------------------------------------------------------------
+
+bool ts::SharedMemoryRing::create(const UString& name, size_t)
+{
+    return setName(name);
+}
+
+bool ts::SharedMemoryRing::attach(const UString& name, MilliSecond)
+{
+    return setName(name);
+}
+
+void ts::SharedMemoryRing::close()
+{
+}
+
+bool ts::SharedMemoryRing::write(const TSPacket*, const TSPacketMetadata*, size_t)
+{
+    return false;
+}
+
+size_t ts::SharedMemoryRing::read(TSPacket*, TSPacketMetadata*, size_t, MilliSecond)
+{
+    return 0;
+}
+
+#else
+
+
+//----------------------------------------------------------------------------
+// Map the shared memory segment.
+//----------------------------------------------------------------------------
+
+bool ts::SharedMemoryRing::map(int fd, size_t size)
+{
+    void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        _report.error(u"error mapping shared memory %s: %s", {_name, SysErrorCodeMessage()});
+        return false;
+    }
+    _header = reinterpret_cast<Header*>(addr);
+    _map_size = size;
+    return true;
+}
+
+void ts::SharedMemoryRing::unmap()
+{
+    if (_header != nullptr) {
+        ::munmap(_header, _map_size);
+        _header = nullptr;
+    }
+    _map_size = 0;
+    _packets = _metadata = nullptr;
+    _capacity = 0;
+}
+
+void ts::SharedMemoryRing::setPointers()
+{
+    _capacity = _header->capacity;
+    _packets = reinterpret_cast<uint8_t*>(_header) + Header::HeaderSize();
+    _metadata = _packets + _capacity * PKT_SIZE;
+}
+
+
+//----------------------------------------------------------------------------
+// Writer: create the shared memory segment.
+//----------------------------------------------------------------------------
+
+bool ts::SharedMemoryRing::create(const UString& name, size_t packet_count)
+{
+    if (!setName(name)) {
+        return false;
+    }
+    _writer = true;
+    _blocked_count = 0;
+    for (size_t i = 0; i < MAX_READERS; ++i) {
+        _reader_leases[i] = Lease();
+    }
+
+    // Remove a previous instance, existing readers keep the old one until they detach.
+    ::shm_unlink(_shm_name.c_str());
+
+    // Only processes of the same user can access the segment.
+    const int fd = ::shm_open(_shm_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        _report.error(u"error creating shared memory %s: %s", {_name, SysErrorCodeMessage()});
+        return false;
+    }
+    const size_t size = Header::SegmentSize(packet_count);
+    const bool ok = ::ftruncate(fd, off_t(size)) == 0;
+    if (!ok) {
+        _report.error(u"error sizing shared memory %s: %s", {_name, SysErrorCodeMessage()});
+    }
+    else if (map(fd, size)) {
+        // Initialize the header. The segment is initially filled with zeroes.
+        new(_header) Header;
+        _header->version = SHM_VERSION;
+        _header->capacity = uint32_t(packet_count);
+        _header->writer_pid = int32_t(::getpid());
+        _header->writer_heartbeat = 0;
+        _header->eof = 0;
+        _header->data_seq = 0;
+        _header->space_seq = 0;
+        _header->readers_waiting = 0;
+        _header->writer_waiting = 0;
+        _header->write_index = 0;
+        for (size_t i = 0; i < MAX_READERS; ++i) {
+            _header->readers[i].state = SLOT_FREE;
+            _header->readers[i].heartbeat = 0;
+            _header->readers[i].pid = 0;
+            _header->readers[i].read_index = 0;
+        }
+        setPointers();
+        _heartbeat = new HeartbeatThread(_header->writer_heartbeat);
+        // Now readers may use the ring.
+        _header->magic.store(SHM_MAGIC);
+    }
+    ::close(fd);
+    if (_header == nullptr) {
+        ::shm_unlink(_shm_name.c_str());
+        return false;
+    }
+    _report.debug(u"created shared memory %s, %'d packets, %'d bytes", {_name, packet_count, size});
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Reader: attach to the shared memory segment.
+//----------------------------------------------------------------------------
+
+bool ts::SharedMemoryRing::attach(const UString& name, MilliSecond timeout)
+{
+    if (!setName(name)) {
+        return false;
+    }
+    _writer = false;
+    _writer_lease = Lease();
+
+    // Wait for the writer to create the shared memory segment.
+    bool reported = false;
+    for (MilliSecond waited = 0; ; waited += POLL_INTERVAL) {
+        const int fd = ::shm_open(_shm_name.c_str(), O_RDWR, 0);
+        if (fd >= 0) {
+            struct ::stat st;
+            const bool ok = ::fstat(fd, &st) == 0 && size_t(st.st_size) >= Header::HeaderSize() && map(fd, size_t(st.st_size));
+            ::close(fd);
+            if (ok) {
+                if (_header->magic.load() == SHM_MAGIC && _header->version == SHM_VERSION && Header::SegmentSize(_header->capacity) <= _map_size) {
+                    break;
+                }
+                unmap();
+            }
+        }
+        if (aborting() || (timeout > 0 && waited >= timeout)) {
+            _report.error(u"shared memory %s not available", {_name});
+            return false;
+        }
+        if (!reported) {
+            _report.verbose(u"waiting for shared memory %s", {_name});
+            reported = true;
+        }
+        SleepThread(POLL_INTERVAL);
+    }
+
+    setPointers();
+    return join();
+}
+
+
+//----------------------------------------------------------------------------
+// Reader: join the list of readers.
+//----------------------------------------------------------------------------
+
+bool ts::SharedMemoryRing::join()
+{
+    for (_slot = 0; _slot < MAX_READERS; ++_slot) {
+        Header::Reader& rd(_header->readers[_slot]);
+        uint32_t expected = SLOT_FREE;
+        if (rd.state.compare_exchange_strong(expected, SLOT_JOINING)) {
+            rd.pid = int32_t(::getpid());
+            _owner = rd.owner.fetch_add(1) + 1;
+            // Start at the current write position. The writer ignores joining slots, so retry
+            // until the position is still in the ring after becoming active.
+            for (;;) {
+                const uint64_t index = _header->write_index.load();
+                rd.read_index.store(index);
+                rd.state.store(SLOT_ACTIVE);
+                if (_header->write_index.load() - index <= _capacity) {
+                    break;
+                }
+                rd.state.store(SLOT_JOINING);
+            }
+            _heartbeat = new HeartbeatThread(rd.heartbeat, &rd, _owner);
+            _report.debug(u"joined shared memory %s as reader #%d", {_name, _slot});
+            return true;
+        }
+    }
+    _report.error(u"too many readers on shared memory %s, max: %d", {_name, MAX_READERS});
+    unmap();
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Detach from the shared memory.
+//----------------------------------------------------------------------------
+
+void ts::SharedMemoryRing::close()
+{
+    // Stop the heartbeat before unmapping the memory.
+    delete _heartbeat;
+    _heartbeat = nullptr;
+
+    if (_header != nullptr) {
+        if (_writer) {
+            // Signal end of stream to all readers and remove the name.
+            // The memory remains available to readers until they detach.
+            _header->eof.store(1);
+            _header->data_seq.fetch_add(1);
+            Wake(_header->data_seq);
+            ::shm_unlink(_shm_name.c_str());
+        }
+        else {
+            // Release our reader slot and unblock the writer if it waits for us.
+            // If the writer reclaimed the slot after a stall, it may belong to another reader now.
+            Header::Reader& rd(_header->readers[_slot]);
+            uint32_t expected = SLOT_ACTIVE;
+            if (rd.owner.load() == _owner) {
+                rd.state.compare_exchange_strong(expected, SLOT_FREE);
+            }
+            _header->space_seq.fetch_add(1);
+            Wake(_header->space_seq);
+        }
+    }
+    unmap();
+}
+
+
+//----------------------------------------------------------------------------
+// Writer: get the index of the slowest reader, free slots of dead readers.
+//----------------------------------------------------------------------------
+
+uint64_t ts::SharedMemoryRing::slowestReader(bool check_dead)
+{
+    uint64_t slowest = _header->write_index.load();
+    for (size_t i = 0; i < MAX_READERS; ++i) {
+        Header::Reader& rd(_header->readers[i]);
+        if (rd.state.load() == SLOT_ACTIVE) {
+            if (check_dead && LeaseExpired(_reader_leases[i], rd.heartbeat.load())) {
+                _report.warning(u"reader process %d on shared memory %s is dead or stalled", {rd.pid.load(), _name});
+                uint32_t expected = SLOT_ACTIVE;
+                rd.state.compare_exchange_strong(expected, SLOT_FREE);
+                _reader_leases[i] = Lease();
+            }
+            else {
+                slowest = std::min(slowest, rd.read_index.load());
+            }
+        }
+    }
+    return slowest;
+}
+
+
+//----------------------------------------------------------------------------
+// Writer: write packets.
+//----------------------------------------------------------------------------
+
+bool ts::SharedMemoryRing::write(const TSPacket* buffer, const TSPacketMetadata* pkt_data, size_t packet_count)
+{
+    if (_header == nullptr || !_writer) {
+        return false;
+    }
+
+    bool check_dead = false;
+    while (packet_count > 0) {
+
+        // Get the free space in the ring, after the slowest reader.
+        const uint32_t seq = _header->space_seq.load();
+        const uint64_t windex = _header->write_index.load();
+        const size_t free_count = _capacity - size_t(windex - slowestReader(check_dead));
+        check_dead = false;
+
+        if (free_count == 0) {
+            // Wait for a reader to consume packets.
+            if (aborting()) {
+                return false;
+            }
+            _blocked_count++;
+            _header->writer_waiting.store(1);
+            Wait(_header->space_seq, seq, POLL_INTERVAL);
+            _header->writer_waiting.store(0);
+            // On timeout, check if a reader has died.
+            check_dead = _header->space_seq.load() == seq;
+            continue;
+        }
+
+        // Copy packets and serialized metadata, in two parts when the ring wraps.
+        const size_t count = std::min(free_count, packet_count);
+        for (size_t done = 0; done < count; ) {
+            const size_t pos = size_t((windex + done) % _capacity);
+            const size_t chunk = std::min(count - done, _capacity - pos);
+            ::memcpy(_packets + pos * PKT_SIZE, buffer[done].b, chunk * PKT_SIZE);
+            for (size_t i = 0; i < chunk; ++i) {
+                pkt_data[done + i].serialize(_metadata + (pos + i) * TSPacketMetadata::SERIALIZATION_SIZE, TSPacketMetadata::SERIALIZATION_SIZE);
+            }
+            done += chunk;
+        }
+
+        // Publish the packets and wake up the readers if some are waiting.
+        _header->write_index.store(windex + count);
+        _header->data_seq.fetch_add(1);
+        if (_header->readers_waiting.load() > 0) {
+            Wake(_header->data_seq);
+        }
+        buffer += count;
+        pkt_data += count;
+        packet_count -= count;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Reader: read packets.
+//----------------------------------------------------------------------------
+
+size_t ts::SharedMemoryRing::read(TSPacket* buffer, TSPacketMetadata* pkt_data, size_t max_packets, MilliSecond timeout)
+{
+    if (_header == nullptr || _writer) {
+        return 0;
+    }
+
+    Header::Reader& rd(_header->readers[_slot]);
+    const uint64_t rindex = rd.read_index.load();
+    MilliSecond waited = 0;
+
+    for (;;) {
+        // If we were stalled longer than the lease, the writer may have reclaimed our slot. It no
+        // longer honours our read index and the slot may be reused by another reader: give up.
+        if (!rd.ownedBy(_owner)) {
+            _report.error(u"reader #%d on shared memory %s was stalled and released by the writer, packets were lost", {_slot, _name});
+            return 0;
+        }
+
+        // Get the number of packets to read.
+        const uint32_t seq = _header->data_seq.load();
+        const uint64_t windex = _header->write_index.load();
+
+        if (windex > rindex) {
+            // Copy packets and deserialize metadata, in two parts when the ring wraps.
+            const size_t count = size_t(std::min<uint64_t>(windex - rindex, max_packets));
+            for (size_t done = 0; done < count; ) {
+                const size_t pos = size_t((rindex + done) % _capacity);
+                const size_t chunk = std::min(count - done, _capacity - pos);
+                ::memcpy(buffer[done].b, _packets + pos * PKT_SIZE, chunk * PKT_SIZE);
+                for (size_t i = 0; i < chunk; ++i) {
+                    pkt_data[done + i].deserialize(_metadata + (pos + i) * TSPacketMetadata::SERIALIZATION_SIZE, TSPacketMetadata::SERIALIZATION_SIZE);
+                }
+                done += chunk;
+            }
+
+            // The writer may have overwritten the packets if it reclaimed the slot during the copy.
+            // The slot is checked again at the beginning of the loop.
+            if (!rd.ownedBy(_owner)) {
+                continue;
+            }
+
+            // Release the space and wake up the writer if it waits for us.
+            rd.read_index.store(rindex + count);
+            _header->space_seq.fetch_add(1);
+            if (_header->writer_waiting.load() != 0) {
+                Wake(_header->space_seq);
+            }
+            return count;
+        }
+
+        // No packet available.
+        if (_header->eof.load() != 0) {
+            _report.verbose(u"end of stream on shared memory %s", {_name});
+            return 0;
+        }
+        if (aborting()) {
+            return 0;
+        }
+        if (timeout > 0 && waited >= timeout) {
+            _report.error(u"receive timeout on shared memory %s", {_name});
+            return 0;
+        }
+        if (LeaseExpired(_writer_lease, _header->writer_heartbeat.load())) {
+            _report.error(u"writer process %d on shared memory %s is dead or stalled", {_header->writer_pid, _name});
+            return 0;
+        }
+
+        // Wait for the writer.
+        _header->readers_waiting.fetch_add(1);
+        Wait(_header->data_seq, seq, timeout > 0 ? std::min(POLL_INTERVAL, timeout - waited) : POLL_INTERVAL);
+        _header->readers_waiting.fetch_sub(1);
+        if (_header->data_seq.load() == seq) {
+            waited += POLL_INTERVAL;
+        }
+    }
+}
+
+#endif // TS_WINDOWS
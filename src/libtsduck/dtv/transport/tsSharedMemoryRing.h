@@ -0,0 +1,211 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//!
+//!  @file
+//!  Ring buffer of TS packets in shared memory, between processes on the same host.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTSPacket.h"
+#include "tsTSPacketMetadata.h"
+#include "tsAbortInterface.h"
+#include "tsMonotonic.h"
+#include "tsReport.h"
+
+namespace ts {
+    //!
+    //! Ring buffer of TS packets in a shared memory segment, between processes on the same host.
+    //! @ingroup mpeg
+    //!
+    //! One writer creates the shared memory segment and feeds several readers, in distinct
+    //! processes or in the same process. Each reader receives all packets which are written
+    //! after it joined the ring. The writer is blocked when the slowest reader lags behind by
+    //! the size of the ring.
+    //!
+    //! Each side maintains a heartbeat counter in the shared memory, using an internal thread.
+    //! When the heartbeat of a reader or the writer stops for more than LEASE_TIMEOUT, the
+    //! process is considered as dead. Process ids are not used since the processes may run
+    //! in distinct PID namespaces (containers). The writer reclaims the slot of a dead reader.
+    //! If that reader was only stalled, its next read() fails: the packets it missed may have
+    //! been overwritten and its slot may already belong to another reader.
+    //!
+    //! Not implemented on Windows.
+    //!
+    class TSDUCKDLL SharedMemoryRing
+    {
+        TS_NOBUILD_NOCOPY(SharedMemoryRing);
+    public:
+        //!
+        //! Maximum number of simultaneous readers.
+        //!
+        static constexpr size_t MAX_READERS = 16;
+
+        //!
+        //! Default ring size in packets.
+        //!
+        static constexpr size_t DEFAULT_PACKETS = 32768;
+
+        //!
+        //! Timeout after which a reader or writer without heartbeat is considered as dead.
+        //!
+        static constexpr MilliSecond LEASE_TIMEOUT = 5000;
+
+        //!
+        //! Constructor.
+        //! @param [in,out] report Where to report errors.
+        //! @param [in] abort An optional interface which is checked during the wait operations.
+        //!
+        SharedMemoryRing(Report& report, AbortInterface* abort = nullptr);
+
+        //!
+        //! Destructor.
+        //!
+        ~SharedMemoryRing();
+
+        //!
+        //! Check if a string is a valid name for a shared memory ring.
+        //! @param [in] name Name of the ring.
+        //! @return True if @a name is valid.
+        //!
+        static bool IsValidName(const UString& name);
+
+        //!
+        //! Writer: create the shared memory segment.
+        //! A previous segment with the same name is removed. The readers which are still
+        //! attached to it keep it until they detach. The segment is accessible to the
+        //! processes of the same user only.
+        //! @param [in] name Name of the ring.
+        //! @param [in] packet_count Size of the ring in packets.
+        //! @return True on success, false on error.
+        //!
+        bool create(const UString& name, size_t packet_count = DEFAULT_PACKETS);
+
+        //!
+        //! Reader: attach to the shared memory segment, wait for the writer to create it.
+        //! @param [in] name Name of the ring.
+        //! @param [in] timeout Maximum time to wait for the writer. Zero means infinite.
+        //! @return True on success, false on error.
+        //!
+        bool attach(const UString& name, MilliSecond timeout = 0);
+
+        //!
+        //! Check if the ring is open, as writer or reader.
+        //! @return True if the ring is open.
+        //!
+        bool isOpen() const { return _header != nullptr; }
+
+        //!
+        //! Detach from the shared memory.
+        //! The writer marks the end of stream and removes the segment name.
+        //!
+        void close();
+
+        //!
+        //! Abort the current and future wait operations.
+        //! Can be called from any thread.
+        //!
+        void abort() { _aborted = true; }
+
+        //!
+        //! Writer: write packets, wait until all are written in the ring.
+        //! @param [in] buffer Address of packets to write.
+        //! @param [in] pkt_data Address of packet metadata, same count as @a buffer.
+        //! @param [in] packet_count Number of packets to write.
+        //! @return True on success, false on abort.
+        //!
+        bool write(const TSPacket* buffer, const TSPacketMetadata* pkt_data, size_t packet_count);
+
+        //!
+        //! Reader: read packets, wait until at least one is available.
+        //! @param [out] buffer Address of the buffer for incoming packets.
+        //! @param [out] pkt_data Address of the buffer for packet metadata, same count as @a buffer.
+        //! @param [in] max_packets Size of @a buffer in packets.
+        //! @param [in] timeout Maximum time to wait for packets. Zero means infinite.
+        //! @return Number of received packets. Zero on end of stream, abort, timeout or error.
+        //!
+        size_t read(TSPacket* buffer, TSPacketMetadata* pkt_data, size_t max_packets, MilliSecond timeout = 0);
+
+        //!
+        //! Writer: number of times the writer waited for a slow reader.
+        //! @return Number of times the writer waited for a slow reader.
+        //!
+        uint64_t blockedCount() const { return _blocked_count; }
+
+    private:
+        struct Header;
+        class HeartbeatThread;
+
+        // Last observed heartbeat of a peer.
+        struct Lease
+        {
+            Lease();
+            bool      valid;  // The heartbeat was already observed.
+            uint32_t  value;  // Last observed heartbeat value.
+            Monotonic time;   // Local time of the last change of the heartbeat.
+        };
+
+        Report&          _report;
+        AbortInterface*  _abort;
+        volatile bool    _aborted;        // Set by abort().
+        UString          _name;           // User-specified name.
+        std::string      _shm_name;       // Actual name of shared memory segment.
+        bool             _writer;         // This is the writer side.
+        Header*          _header;         // Mapped shared memory, null if not mapped.
+        size_t           _map_size;       // Size of mapped memory.
+        uint8_t*         _packets;        // Address of packets in the ring.
+        uint8_t*         _metadata;       // Address of serialized metadata in the ring.
+        size_t           _capacity;       // Ring size in packets.
+        size_t           _slot;           // Reader slot index.
+        uint32_t         _owner;          // Reader: owner value of the slot when we joined.
+        uint64_t         _blocked_count;  // Number of times the writer waited.
+        HeartbeatThread* _heartbeat;      // Thread which maintains our heartbeat in shared memory.
+        Lease            _writer_lease;   // Reader: heartbeat of the writer.
+        Lease            _reader_leases[MAX_READERS];  // Writer: heartbeat of each reader slot.
+
+        // Check if the application is aborting.
+        bool aborting() const { return _aborted || (_abort != nullptr && _abort->aborting()); }
+
+        // Set the name of the shared memory.
+        bool setName(const UString& name);
+
+        // Map the shared memory segment.
+        bool map(int fd, size_t size);
+        void unmap();
+        void setPointers();
+
+        // Reader: join the list of readers.
+        bool join();
+
+        // Writer: get the index of the slowest reader, free slots of dead readers.
+        uint64_t slowestReader(bool check_dead);
+
+        // Check if the lease of a peer has expired, given its current heartbeat.
+        static bool LeaseExpired(Lease& lease, uint32_t heartbeat);
+    };
+}
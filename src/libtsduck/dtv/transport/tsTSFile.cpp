@@ -29,8 +29,336 @@
 
 #include "tsTSFile.h"
 #include "tsTSPacketMetadata.h"
+#include "tsTSFileIndex.h"
 #include "tsNullReport.h"
 #include "tsSysUtils.h"
+#include "tsThread.h"
+#include "tsMutex.h"
+#include "tsCondition.h"
+#include "tsGuardMutex.h"
+#include "tsGuardCondition.h"
+#include "tsMonotonic.h"
+
+constexpr size_t ts::TSFile::DEFAULT_WRITE_BEHIND_BUFFER_SIZE;
+
+namespace {
+    // Alignment of write-behind buffers, a multiple of all page sizes.
+    constexpr size_t WRITE_BEHIND_ALIGN = 4096;
+
+    // Check if a write error is a broken pipe, which is not reported.
+    bool IsBrokenPipe(ts::SysErrorCode code)
+    {
+#if defined(TS_WINDOWS)
+        // Note that ERROR_NO_DATA (= 232) means "the pipe is being closed"
+        // and this is the actual error code which is returned when the pipe
+        // is closing, not ERROR_BROKEN_PIPE.
+        return code == ERROR_BROKEN_PIPE || code == ERROR_NO_DATA;
+#else
+        return code == EPIPE;
+#endif
+    }
+}
+
+const ts::TypedEnumeration<ts::TSFileReadMode> ts::TSFileReadModeEnum({
+    {u"stream", ts::TSFileReadMode::STREAM},
+    {u"mmap",   ts::TSFileReadMode::MMAP},
+    {u"direct", ts::TSFileReadMode::DIRECT},
+});
+
+#if !defined(TS_WINDOWS)
+namespace {
+    // Size of a sliding memory-mapped window (MMAP mode), a multiple of all page sizes.
+    constexpr size_t MAP_WINDOW_SIZE = 64 * 1024 * 1024;
+    // Alignment of memory addresses and file offsets (DIRECT mode).
+    constexpr size_t DIRECT_ALIGN = 4096;
+    // Size of each read operation (DIRECT mode), a multiple of DIRECT_ALIGN.
+    constexpr size_t DIRECT_BUFFER_SIZE = 1024 * 1024;
+}
+#endif
+
+
+//----------------------------------------------------------------------------
+// Write-behind thread: the application fills a ring of buffers, the full
+// buffers are written by the thread. The buffers are page-aligned and their
+// size is a multiple of the page size. There is only one write operation
+// in progress at a time: the file can be a pipe and the order of data must
+// be preserved. While a buffer is being written, the others are filled.
+//----------------------------------------------------------------------------
+
+class ts::TSFile::WriteBehind: private Thread
+{
+    TS_NOBUILD_NOCOPY(WriteBehind);
+public:
+    // Constructor and destructor. The thread is started in the constructor.
+    // All pending data are written in the destructor.
+#if defined(TS_WINDOWS)
+    WriteBehind(::HANDLE handle, size_t buffer_count, size_t buffer_size);
+#else
+    WriteBehind(int fd, size_t buffer_count, size_t buffer_size);
+#endif
+    virtual ~WriteBehind() override;
+
+    // Copy data in the ring of buffers. Block when all buffers are full.
+    // Return false if a previous write operation failed.
+    bool write(const void* addr, size_t size);
+
+    // Wait until all pending data are written. Return false if a write operation failed.
+    bool flush();
+
+    // Discard all pending and future data and close the file (abort from any thread).
+    // The file is closed by the thread, after completion of the current write operation,
+    // if any, so that no write operation can use a closed and reused file descriptor.
+    void abort();
+
+    // Error code of the first failed write operation.
+    SysErrorCode error();
+
+    // Check if an error was already returned by write() to the application.
+    bool errorReturned() const { return _error_returned; }
+
+    // Add statistics into a status structure.
+    void addStatus(WriteBehindStatus& status);
+
+private:
+#if defined(TS_WINDOWS)
+    ::HANDLE          _handle;   // File handle.
+#else
+    int               _fd;       // File descriptor.
+#endif
+    const size_t      _count;    // Number of buffers in the ring.
+    const size_t      _size;     // Size of each buffer, a multiple of WRITE_BEHIND_ALIGN.
+    ByteBlock         _storage;  // Storage of all buffers, with room for alignment.
+    uint8_t*          _base;     // Aligned address of the first buffer in _storage.
+    size_t            _filled;   // Number of bytes in the buffer being filled by the application.
+    size_t            _blocked_count;  // Number of times the application was blocked (application thread only).
+    NanoSecond        _blocked_time;   // Time during which the application was blocked (application thread only).
+    bool              _error_returned; // An error was returned by write() (application thread only).
+    Mutex             _mutex;    // Exclusive access to protected area.
+    Condition         _todo;     // Signaled when a buffer is submitted or on termination.
+    Condition         _done;     // Signaled when a buffer is written.
+    // -- start of protected area --
+    size_t            _next;     // Index of the next buffer to write.
+    size_t            _queued;   // Number of full buffers, starting at _next.
+    std::vector<size_t> _sizes;  // Data size in each buffer.
+    bool              _discard;  // Discard all data, do not write.
+    bool              _close;    // Close the file and terminate the thread (after an abort).
+    bool              _terminate; // Termination request.
+    SysErrorCode      _error;    // First error code.
+    WriteBehindStatus _status;   // Statistics from the thread.
+    // -- end of protected area --
+
+    // Submit the buffer which is being filled by the application.
+    void submit();
+
+    // Implementation of Thread.
+    virtual void main() override;
+};
+
+#if defined(TS_WINDOWS)
+ts::TSFile::WriteBehind::WriteBehind(::HANDLE handle, size_t buffer_count, size_t buffer_size) :
+    Thread(),
+    _handle(handle),
+#else
+ts::TSFile::WriteBehind::WriteBehind(int fd, size_t buffer_count, size_t buffer_size) :
+    Thread(),
+    _fd(fd),
+#endif
+    _count(std::max<size_t>(buffer_count, 2)),
+    _size(round_up(std::max<size_t>(buffer_size, PKT_SIZE), WRITE_BEHIND_ALIGN)),
+    _storage(_count * _size + WRITE_BEHIND_ALIGN),
+    _base(_storage.data() + (WRITE_BEHIND_ALIGN - size_t(reinterpret_cast<uintptr_t>(_storage.data()) % WRITE_BEHIND_ALIGN)) % WRITE_BEHIND_ALIGN),
+    _filled(0),
+    _blocked_count(0),
+    _blocked_time(0),
+    _error_returned(false),
+    _mutex(),
+    _todo(),
+    _done(),
+    _next(0),
+    _queued(0),
+    _sizes(_count, 0),
+    _discard(false),
+    _close(false),
+    _terminate(false),
+    _error(SYS_SUCCESS),
+    _status()
+{
+    start();
+}
+
+ts::TSFile::WriteBehind::~WriteBehind()
+{
+    // Write all pending data and terminate the thread.
+    submit();
+    {
+        GuardCondition lock(_mutex, _todo);
+        _terminate = true;
+        lock.signal();
+    }
+    waitForTermination();
+}
+
+void ts::TSFile::WriteBehind::submit()
+{
+    if (_filled > 0) {
+        GuardCondition lock(_mutex, _todo);
+        if (!_discard) {
+            _sizes[(_next + _queued) % _count] = _filled;
+            _queued++;
+            _status.max_queued = std::max(_status.max_queued, _queued);
+            lock.signal();
+        }
+        _filled = 0;
+    }
+}
+
+bool ts::TSFile::WriteBehind::write(const void* addr, size_t size)
+{
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(addr);
+
+    while (size > 0) {
+        // Get the buffer to fill. Wait until it is no longer used by the thread.
+        size_t index = 0;
+        {
+            GuardCondition lock(_mutex, _done);
+            if (_queued >= _count && !_discard) {
+                // All buffers are full, this is the backpressure from the disk.
+                const Monotonic start(true);
+                while (_queued >= _count && !_discard) {
+                    lock.waitCondition();
+                }
+                _blocked_count++;
+                _blocked_time += Monotonic(true) - start;
+            }
+            if (_error != SYS_SUCCESS || _discard) {
+                _error_returned = true;
+                return false;
+            }
+            index = (_next + _queued) % _count;
+        }
+
+        // Fill the buffer outside the protected area.
+        const size_t chunk = std::min(size, _size - _filled);
+        ::memcpy(_base + index * _size + _filled, data, chunk);  // Flawfinder: ignore: memcpy()
+        _filled += chunk;
+        data += chunk;
+        size -= chunk;
+        if (_filled >= _size) {
+            submit();
+        }
+    }
+    return true;
+}
+
+bool ts::TSFile::WriteBehind::flush()
+{
+    submit();
+    GuardCondition lock(_mutex, _done);
+    while (_queued > 0 && !_discard) {
+        lock.waitCondition();
+    }
+    return _error == SYS_SUCCESS;
+}
+
+void ts::TSFile::WriteBehind::abort()
+{
+    // Wake up the thread if waiting for data.
+    {
+        GuardCondition lock(_mutex, _todo);
+        _discard = _close = true;
+        lock.signal();
+    }
+    // Wake up the application if waiting for a free buffer (abort() may be called from another thread).
+    {
+        GuardCondition lock(_mutex, _done);
+        lock.signal();
+    }
+}
+
+ts::SysErrorCode ts::TSFile::WriteBehind::error()
+{
+    GuardMutex lock(_mutex);
+    return _error;
+}
+
+void ts::TSFile::WriteBehind::addStatus(WriteBehindStatus& status)
+{
+    GuardMutex lock(_mutex);
+    status.write_count += _status.write_count;
+    status.write_bytes += _status.write_bytes;
+    status.write_time += _status.write_time;
+    status.max_write_time = std::max(status.max_write_time, _status.max_write_time);
+    status.blocked_count += _blocked_count;
+    status.blocked_time += _blocked_time;
+    status.max_queued = std::max(status.max_queued, _status.max_queued);
+}
+
+void ts::TSFile::WriteBehind::main()
+{
+    for (;;) {
+        // Wait for a full buffer or a termination request.
+        size_t index = 0;
+        size_t size = 0;
+        bool skip = false;
+        {
+            GuardCondition lock(_mutex, _todo);
+            while (_queued == 0 && !_terminate && !_close) {
+                lock.waitCondition();
+            }
+            if (_close) {
+                // Abort: drop all buffers, the file is closed below.
+                _queued = 0;
+                break;
+            }
+            if (_queued == 0) {
+                // Termination request and no more data.
+                break;
+            }
+            index = _next;
+            size = _sizes[index];
+            skip = _discard || _error != SYS_SUCCESS;
+        }
+
+        // Write the buffer outside the protected area. After an error, drop all data.
+        const Monotonic start(true);
+        size_t written = 0;
+        const SysErrorCode err = skip ? SYS_SUCCESS : WriteData(
+#if defined(TS_WINDOWS)
+            _handle,
+#else
+            _fd,
+#endif
+            _base + index * _size, size, written);
+        const NanoSecond duration = Monotonic(true) - start;
+
+        // Release the buffer and notify the application.
+        GuardCondition lock(_mutex, _done);
+        if (!skip) {
+            _status.write_count++;
+            _status.write_bytes += written;
+            _status.write_time += duration;
+            _status.max_write_time = std::max(_status.max_write_time, duration);
+        }
+        if (_error == SYS_SUCCESS && err != SYS_SUCCESS) {
+            _error = err;
+        }
+        _next = (_next + 1) % _count;
+        _queued--;
+        lock.signal();
+    }
+
+    // After an abort, the file is closed here, when no write operation is in progress.
+    // The application is notified that all buffers were dropped.
+    GuardCondition lock(_mutex, _done);
+    if (_close) {
+#if defined(TS_WINDOWS)
+        ::CloseHandle(_handle);
+#else
+        ::close(_fd);
+#endif
+    }
+    lock.signal();
+}
 
 
 //----------------------------------------------------------------------------
@@ -55,10 +383,25 @@ ts::TSFile::TSFile() :
     _rewindable(false),
     _regular(false),
     _std_inout(false),
+    _read_mode(TSFileReadMode::STREAM),
+    _wb_count(0),
+    _wb_size(DEFAULT_WRITE_BEHIND_BUFFER_SIZE),
+    _wb_status(),
+    _write_behind(nullptr),
 #if defined(TS_WINDOWS)
     _handle(INVALID_HANDLE_VALUE)
 #else
-    _fd(-1)
+    _fd(-1),
+    _actual_mode(TSFileReadMode::STREAM),
+    _file_pos(0),
+    _file_size(0),
+    _map_base(nullptr),
+    _map_offset(0),
+    _map_size(0),
+    _direct_buffer(),
+    _direct_data(nullptr),
+    _direct_offset(0),
+    _direct_size(0)
 #endif
 {
 }
@@ -86,10 +429,25 @@ ts::TSFile::TSFile(const TSFile& other) :
     _rewindable(false),
     _regular(false),
     _std_inout(other._std_inout),
+    _read_mode(other._read_mode),
+    _wb_count(other._wb_count),
+    _wb_size(other._wb_size),
+    _wb_status(),
+    _write_behind(nullptr),
 #if defined(TS_WINDOWS)
     _handle(INVALID_HANDLE_VALUE)
 #else
-    _fd(-1)
+    _fd(-1),
+    _actual_mode(TSFileReadMode::STREAM),
+    _file_pos(0),
+    _file_size(0),
+    _map_base(nullptr),
+    _map_offset(0),
+    _map_size(0),
+    _direct_buffer(),
+    _direct_data(nullptr),
+    _direct_offset(0),
+    _direct_size(0)
 #endif
 {
 }
@@ -117,18 +475,37 @@ ts::TSFile::TSFile(TSFile&& other) noexcept :
     _rewindable(other._rewindable),
     _regular(other._regular),
     _std_inout(other._std_inout),
+    _read_mode(other._read_mode),
+    _wb_count(other._wb_count),
+    _wb_size(other._wb_size),
+    _wb_status(other._wb_status),
+    _write_behind(other._write_behind),
 #if defined(TS_WINDOWS)
     _handle(other._handle)
 #else
-    _fd(other._fd)
+    _fd(other._fd),
+    _actual_mode(other._actual_mode),
+    _file_pos(other._file_pos),
+    _file_size(other._file_size),
+    _map_base(other._map_base),
+    _map_offset(other._map_offset),
+    _map_size(other._map_size),
+    _direct_buffer(std::move(other._direct_buffer)),
+    _direct_data(other._direct_data),
+    _direct_offset(other._direct_offset),
+    _direct_size(other._direct_size)
 #endif
 {
     // Mark other object as closed, just in case.
     other._is_open = false;
+    other._write_behind = nullptr;
 #if defined(TS_WINDOWS)
     other._handle = INVALID_HANDLE_VALUE;
 #else
     other._fd = -1;
+    other._actual_mode = TSFileReadMode::STREAM;
+    other._map_base = other._direct_data = nullptr;
+    other._map_size = other._direct_size = 0;
 #endif
 }
 
@@ -177,6 +554,70 @@ void ts::TSFile::setStuffing(size_t initial, size_t final)
 }
 
 
+//----------------------------------------------------------------------------
+// Get the method to read the file.
+//----------------------------------------------------------------------------
+
+ts::TSFileReadMode ts::TSFile::readMode() const
+{
+#if defined(TS_WINDOWS)
+    return _is_open ? TSFileReadMode::STREAM : _read_mode;
+#else
+    return _is_open ? _actual_mode : _read_mode;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Write-behind mode.
+//----------------------------------------------------------------------------
+
+ts::TSFile::WriteBehindStatus::WriteBehindStatus() :
+    write_count(0),
+    write_bytes(0),
+    write_time(0),
+    max_write_time(0),
+    blocked_count(0),
+    blocked_time(0),
+    max_queued(0)
+{
+}
+
+void ts::TSFile::setWriteBehind(size_t buffer_count, size_t buffer_size)
+{
+    _wb_count = buffer_count;
+    _wb_size = buffer_size;
+    _wb_status = WriteBehindStatus();
+}
+
+void ts::TSFile::getWriteBehindStatus(WriteBehindStatus& status) const
+{
+    status = _wb_status;
+    if (_write_behind != nullptr) {
+        _write_behind->addStatus(status);
+    }
+}
+
+bool ts::TSFile::closeWriteBehind(Report& report)
+{
+    bool ok = true;
+    if (_write_behind != nullptr) {
+        if (!_write_behind->flush()) {
+            // Report the error, unless already reported by writeStream() or after an abort.
+            const SysErrorCode err = _write_behind->error();
+            if (!_aborted && !_write_behind->errorReturned() && !IsBrokenPipe(err)) {
+                report.log(_severity, u"error writing %s: %s (%d)", {getDisplayFileName(), SysErrorCodeMessage(err), err});
+            }
+            ok = false;
+        }
+        _write_behind->addStatus(_wb_status);
+        delete _write_behind;
+        _write_behind = nullptr;
+    }
+    return ok;
+}
+
+
 //----------------------------------------------------------------------------
 // Open file for read in a rewindable mode.
 //----------------------------------------------------------------------------
@@ -379,6 +820,7 @@ bool ts::TSFile::openInternal(bool reopen, Report& report)
 
     // Close first if this is a reopen.
     if (reopen) {
+        releaseReadMode();
         ::close(_fd);
         _fd = -1;
     }
@@ -404,8 +846,15 @@ bool ts::TSFile::openInternal(bool reopen, Report& report)
         _fd = read_access ? STDIN_FILENO : STDOUT_FILENO;
     }
     else {
+        _fd = -1;
+#if defined(O_DIRECT)
+        // Open a named file in direct I/O mode when required. Fallback to a standard open if not supported.
+        if (read_only && _read_mode == TSFileReadMode::DIRECT && (_fd = ::open(_filename.toUTF8().c_str(), uflags | O_DIRECT, mode)) < 0) {
+            report.debug(u"direct I/O not supported on %s: %s", {getDisplayFileName(), SysErrorCodeMessage()});
+        }
+#endif
         // Open a named file.
-        if ((_fd = ::open(_filename.toUTF8().c_str(), uflags, mode)) < 0) {
+        if (_fd < 0 && (_fd = ::open(_filename.toUTF8().c_str(), uflags, mode)) < 0) {
             const SysErrorCode err = LastSysErrorCode();
             report.log(_severity, u"cannot open file %s: %s", {getDisplayFileName(), SysErrorCodeMessage(err)});
             return false;
@@ -444,6 +893,9 @@ bool ts::TSFile::openInternal(bool reopen, Report& report)
         return false;
     }
 
+    // Setup the actual read mode.
+    setupReadMode(st, report);
+
     // If an initial offset is specified, move here
     if (_start_offset != 0 && ::lseek(_fd, off_t(_start_offset), SEEK_SET) == off_t(-1)) {
         const SysErrorCode err = LastSysErrorCode();
@@ -465,6 +917,15 @@ bool ts::TSFile::openInternal(bool reopen, Report& report)
     _at_eof = _aborted = false;
     _is_open = true;
 
+    // Start the write-behind thread on write-only files.
+    if (write_access && !read_access && _wb_count > 0) {
+#if defined(TS_WINDOWS)
+        _write_behind = new WriteBehind(_handle, _wb_count, _wb_size);
+#else
+        _write_behind = new WriteBehind(_fd, _wb_count, _wb_size);
+#endif
+    }
+
     // In write mode, write initial null packets.
     if (write_access && !reopen && _open_null > 0 && !writeStuffing(_open_null, report)) {
         close(report);
@@ -513,6 +974,22 @@ bool ts::TSFile::seekInternal(uint64_t index, Report& report)
 
     report.debug(u"seeking %s at offset %'d", {_filename, _start_offset + index});
 
+    // All pending data must be written before moving the write position.
+    if (_write_behind != nullptr && !_write_behind->flush()) {
+        const SysErrorCode err = _write_behind->error();
+        report.log(_severity, u"error writing %s: %s (%d)", {getDisplayFileName(), SysErrorCodeMessage(err), err});
+        return false;
+    }
+
+#if !defined(TS_WINDOWS)
+    // With memory-mapped files and direct I/O, there is no system call, just move the read position.
+    if (_actual_mode != TSFileReadMode::STREAM) {
+        _file_pos = _start_offset + index;
+        _at_eof = false;
+        return true;
+    }
+#endif
+
 #if defined(TS_WINDOWS)
     // In Win32, LARGE_INTEGER is a 64-bit structure, not an integer type
     uint64_t where = _start_offset + index;
@@ -552,6 +1029,21 @@ bool ts::TSFile::seek(PacketCounter packet_index, Report& report)
 }
 
 
+//----------------------------------------------------------------------------
+// Seek the file at the position of a time, using an index of the file.
+//----------------------------------------------------------------------------
+
+bool ts::TSFile::seekTime(const TSFileIndex& index, MilliSecond time, bool intra, Report& report)
+{
+    PacketCounter packet = index.packetAtTime(time);
+    if (intra && !index.nextEvent(packet, TSFileIndex::EventType::INTRA_FRAME, packet)) {
+        report.log(_severity, u"no video intra-frame after %'d ms in %s", {time, getDisplayFileName()});
+        return false;
+    }
+    return seek(packet, report);
+}
+
+
 //----------------------------------------------------------------------------
 // Close file.
 //----------------------------------------------------------------------------
@@ -568,6 +1060,9 @@ bool ts::TSFile::close(Report& report)
         writeStuffing(_close_null, report);
     }
 
+    // Write all pending data in write-behind mode.
+    const bool ok = closeWriteBehind(report);
+
     if (!_std_inout) {
 #if defined(TS_WINDOWS)
         ::CloseHandle(_handle);
@@ -575,13 +1070,16 @@ bool ts::TSFile::close(Report& report)
         ::close(_fd);
 #endif
     }
+#if !defined(TS_WINDOWS)
+    releaseReadMode();
+#endif
 
     _is_open = _at_eof = _aborted = false;
     _flags = NONE;
     _filename.clear();
     _std_inout = false;
 
-    return true;
+    return ok;
 }
 
 
@@ -636,6 +1134,12 @@ bool ts::TSFile::readStreamPartial(void* buffer, size_t request_size, size_t& re
 #else
 
     // UNIX implementation
+    if (_actual_mode == TSFileReadMode::MMAP) {
+        return readMapped(buffer, request_size, read_size, report);
+    }
+    else if (_actual_mode == TSFileReadMode::DIRECT) {
+        return readDirect(buffer, request_size, read_size, report);
+    }
     for (;;) {
         const ssize_t insize = ::read(_fd, buffer, request_size);
         if (insize == 0) {
@@ -663,6 +1167,141 @@ bool ts::TSFile::readStreamPartial(void* buffer, size_t request_size, size_t& re
 }
 
 
+//----------------------------------------------------------------------------
+// UNIX read modes: memory-mapped files and direct I/O.
+//----------------------------------------------------------------------------
+
+#if !defined(TS_WINDOWS)
+
+void ts::TSFile::setupReadMode(const struct ::stat& st, Report& report)
+{
+    // Alternate read modes are used with read-only regular files only.
+    _actual_mode = _read_mode;
+    if (_actual_mode != TSFileReadMode::STREAM && ((_flags & (READ | WRITE)) != READ || _std_inout || !_regular)) {
+        report.debug(u"%s is not a read-only regular file, using standard read mode", {getDisplayFileName()});
+        _actual_mode = TSFileReadMode::STREAM;
+#if defined(O_DIRECT)
+        // The file may have been opened in direct I/O mode.
+        if (!_std_inout) {
+            ::fcntl(_fd, F_SETFL, ::fcntl(_fd, F_GETFL) & ~O_DIRECT);
+        }
+#endif
+    }
+
+    _file_pos = _start_offset;
+    _file_size = uint64_t(st.st_size);
+    _map_base = nullptr;
+    _map_offset = 0;
+    _map_size = 0;
+    _direct_offset = 0;
+    _direct_size = 0;
+
+    if (_actual_mode == TSFileReadMode::DIRECT) {
+#if defined(TS_MAC)
+        // No O_DIRECT on macOS, disable caching on the file descriptor instead.
+        ::fcntl(_fd, F_NOCACHE, 1);
+#endif
+        // Allocate an aligned read buffer.
+        _direct_buffer.resize(DIRECT_BUFFER_SIZE + DIRECT_ALIGN);
+        _direct_data = _direct_buffer.data() + (DIRECT_ALIGN - size_t(reinterpret_cast<uintptr_t>(_direct_buffer.data()) % DIRECT_ALIGN)) % DIRECT_ALIGN;
+    }
+    if (_actual_mode != TSFileReadMode::STREAM) {
+        report.debug(u"reading %s in %s mode", {getDisplayFileName(), TSFileReadModeEnum.name(_actual_mode)});
+    }
+}
+
+void ts::TSFile::releaseReadMode()
+{
+    if (_map_base != nullptr) {
+        ::munmap(_map_base, _map_size);
+    }
+    _actual_mode = TSFileReadMode::STREAM;
+    _map_base = _direct_data = nullptr;
+    _map_offset = _direct_offset = 0;
+    _map_size = _direct_size = 0;
+    _direct_buffer.clear();
+}
+
+bool ts::TSFile::readMapped(void* buffer, size_t request_size, size_t& read_size, Report& report)
+{
+    // At end of file, check if the file has grown in the meantime.
+    if (_file_pos >= _file_size) {
+        struct stat st;
+        if (::fstat(_fd, &st) == 0) {
+            _file_size = uint64_t(st.st_size);
+        }
+        if (_file_pos >= _file_size) {
+            _at_eof = true;
+            return false;
+        }
+    }
+
+    // Map a new window when the read position is outside the current one.
+    if (_map_base == nullptr || _file_pos < _map_offset || _file_pos >= _map_offset + _map_size) {
+        if (_map_base != nullptr) {
+            ::munmap(_map_base, _map_size);
+            _map_base = nullptr;
+        }
+        _map_offset = _file_pos - _file_pos % MAP_WINDOW_SIZE;
+        _map_size = size_t(std::min<uint64_t>(MAP_WINDOW_SIZE, _file_size - _map_offset));
+        void* addr = ::mmap(nullptr, _map_size, PROT_READ, MAP_SHARED, _fd, off_t(_map_offset));
+        if (addr == MAP_FAILED) {
+            report.error(u"error mapping %s: %s", {getDisplayFileName(), SysErrorCodeMessage()});
+            _map_size = 0;
+            return false;
+        }
+        _map_base = reinterpret_cast<uint8_t*>(addr);
+        ::madvise(addr, _map_size, MADV_SEQUENTIAL);
+#if defined(TS_LINUX)
+        // Start loading the next window in advance.
+        if (_map_offset + _map_size < _file_size) {
+            ::posix_fadvise(_fd, off_t(_map_offset + _map_size), off_t(MAP_WINDOW_SIZE), POSIX_FADV_WILLNEED);
+        }
+#endif
+    }
+
+    // Copy data from the mapped window.
+    read_size = size_t(std::min<uint64_t>(request_size, _map_offset + _map_size - _file_pos));
+    ::memcpy(buffer, _map_base + (_file_pos - _map_offset), read_size);  // Flawfinder: ignore: memcpy()
+    _file_pos += read_size;
+    return true;
+}
+
+bool ts::TSFile::readDirect(void* buffer, size_t request_size, size_t& read_size, Report& report)
+{
+    // Read a new aligned block when the read position is outside the buffer.
+    if (_file_pos < _direct_offset || _file_pos >= _direct_offset + _direct_size) {
+        _direct_offset = _file_pos - _file_pos % DIRECT_ALIGN;
+        _direct_size = 0;
+        for (;;) {
+            const ssize_t insize = ::pread(_fd, _direct_data, DIRECT_BUFFER_SIZE, off_t(_direct_offset));
+            if (insize >= 0) {
+                _direct_size = size_t(insize);
+                break;
+            }
+            const SysErrorCode error_code = LastSysErrorCode();
+            if (error_code != EINTR) {
+                report.error(u"error reading from %s: %s", {getDisplayFileName(), SysErrorCodeMessage(error_code)});
+                return false;
+            }
+        }
+        // The last block of the file may end before the read position.
+        if (_file_pos >= _direct_offset + _direct_size) {
+            _at_eof = true;
+            return false;
+        }
+    }
+
+    // Copy data from the aligned buffer.
+    read_size = size_t(std::min<uint64_t>(request_size, _direct_offset + _direct_size - _file_pos));
+    ::memcpy(buffer, _direct_data + (_file_pos - _direct_offset), read_size);  // Flawfinder: ignore: memcpy()
+    _file_pos += read_size;
+    return true;
+}
+
+#endif
+
+
 //----------------------------------------------------------------------------
 // Read TS packets. Return the actual number of read packets.
 // Override TSPacketStream implementation
@@ -733,47 +1372,79 @@ bool ts::TSFile::writeStream(const void* buffer, size_t data_size, size_t& writt
     written_size = 0;
     SysErrorCode error_code = SYS_SUCCESS;
 
+    if (_write_behind != nullptr) {
+        // Asynchronous write-behind mode.
+        if (_write_behind->write(buffer, data_size)) {
+            written_size = data_size;
+            return true;
+        }
+        error_code = _write_behind->error();
+    }
+    else {
+        // Synchronous write.
+#if defined(TS_WINDOWS)
+        error_code = WriteData(_handle, buffer, data_size, written_size);
+#else
+        error_code = WriteData(_fd, buffer, data_size, written_size);
+#endif
+        if (error_code == SYS_SUCCESS) {
+            return true;
+        }
+    }
+
+    // Don't report error on broken pipe or when write-behind data were discarded after abort.
+    if (error_code != SYS_SUCCESS && !IsBrokenPipe(error_code)) {
+        report.log(_severity, u"error writing %s: %s (%d)", {getDisplayFileName(), SysErrorCodeMessage(error_code), error_code});
+    }
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Low-level synchronous write, return a system error code.
+//----------------------------------------------------------------------------
+
 #if defined(TS_WINDOWS)
 
+ts::SysErrorCode ts::TSFile::WriteData(::HANDLE handle, const void* buffer, size_t data_size, size_t& written_size)
+{
     // Windows implementation
     const char* data = reinterpret_cast<const char*>(buffer);
     ::DWORD remain = ::DWORD(data_size);
     ::DWORD outsize = 0;
+    written_size = 0;
 
     // Loop on write until everything is gone
     while (remain > 0) {
-        if (::WriteFile(_handle, data, remain, &outsize, NULL) != 0)  {
+        if (::WriteFile(handle, data, remain, &outsize, NULL) != 0)  {
             // Normal case, some data were written
             outsize = std::min(outsize, remain);
             data += outsize;
             remain -= outsize;
             written_size += size_t(outsize);
         }
-        else if ((error_code = LastSysErrorCode()) == ERROR_BROKEN_PIPE || error_code == ERROR_NO_DATA) {
-            // Broken pipe: error state but don't report error.
-            // Note that ERROR_NO_DATA (= 232) means "the pipe is being closed"
-            // and this is the actual error code which is returned when the pipe
-            // is closing, not ERROR_BROKEN_PIPE.
-            return false;
-        }
         else {
             // Write error
-            report.log(_severity, u"error writing %s: %s (%d)", {getDisplayFileName(), SysErrorCodeMessage(error_code), error_code});
-            return false;
+            return LastSysErrorCode();
         }
     }
-    return true;
+    return SYS_SUCCESS;
+}
 
 #else
 
+ts::SysErrorCode ts::TSFile::WriteData(int fd, const void* buffer, size_t data_size, size_t& written_size)
+{
     // UNIX implementation
     const char* data = reinterpret_cast<const char*>(buffer);
     size_t remain = data_size;
     ssize_t outsize = 0;
+    SysErrorCode error_code = SYS_SUCCESS;
+    written_size = 0;
 
     // Loop on write until everything is gone
     while (remain > 0) {
-        outsize = ::write(_fd, data, remain);
+        outsize = ::write(fd, data, remain);
         if (outsize > 0) {
             // Normal case, some data were written
             outsize = std::min<ssize_t>(outsize, remain);
@@ -783,17 +1454,13 @@ bool ts::TSFile::writeStream(const void* buffer, size_t data_size, size_t& writt
         }
         else if ((error_code = LastSysErrorCode()) != EINTR) {
             // Actual error (not an interrupt)
-            // Don't report error on broken pipe.
-            if (error_code != EPIPE) {
-                report.log(_severity, u"error writing %s: %s (%d)", {getDisplayFileName(), SysErrorCodeMessage(error_code), error_code});
-            }
-            return false;
+            return error_code;
         }
     }
-    return true;
+    return SYS_SUCCESS;
+}
 
 #endif
-}
 
 
 //----------------------------------------------------------------------------
@@ -833,12 +1500,21 @@ void ts::TSFile::abort()
         // Mark broken pipe, read or write.
         _aborted = _at_eof = true;
 
-        // Close pipe handle, ignore errors.
+        // Close pipe handle, ignore errors. In write-behind mode, drop all data which are
+        // not yet written and let the thread close the file when no write is in progress.
+        if (_write_behind != nullptr) {
+            _write_behind->abort();
+        }
+        else {
+#if defined(TS_WINDOWS)
+            ::CloseHandle(_handle);
+#else
+            ::close(_fd);
+#endif
+        }
 #if defined(TS_WINDOWS)
-        ::CloseHandle(_handle);
         _handle = INVALID_HANDLE_VALUE;
 #else // UNIX
-        ::close(_fd);
         _fd = -1;
 #endif
     }
@@ -36,11 +36,29 @@
 #include "tsTSPacketStream.h"
 #include "tsAbstractReadStreamInterface.h"
 #include "tsAbstractWriteStreamInterface.h"
+#include "tsTypedEnumeration.h"
 #include "tsEnumUtils.h"
+#include "tsByteBlock.h"
+#include "tsSysUtils.h"
 
 namespace ts {
 
     class TSPacketMetadata;
+    class TSFileIndex;
+
+    //!
+    //! Methods to read a transport stream file.
+    //!
+    enum class TSFileReadMode {
+        STREAM,  //!< Sequential read operations, through the system cache (the default).
+        MMAP,    //!< Memory-mapped file, using sliding windows with read-ahead (UNIX only).
+        DIRECT,  //!< Direct I/O, bypassing the system cache (Linux and macOS only).
+    };
+
+    //!
+    //! Enumeration description of ts::TSFileReadMode.
+    //!
+    TSDUCKDLL extern const TypedEnumeration<TSFileReadMode> TSFileReadModeEnum;
 
     //!
     //! Transport stream file, input and/or output.
@@ -178,6 +196,68 @@ namespace ts {
         //!
         void setStuffing(size_t initial, size_t final);
 
+        //!
+        //! Set the method to read the file.
+        //! This method shall be called before opening the file.
+        //! The alternative read modes are used only when the file is a regular file which
+        //! is opened in read-only mode. Otherwise, the file is read in TSFileReadMode::STREAM
+        //! mode. This is also the case on unsupported operating systems.
+        //! - With TSFileReadMode::MMAP, the file is read through a sliding memory-mapped
+        //!   window. Seeking and repeating the file do not require any system call and the
+        //!   system is advised to read the next window in advance.
+        //! - With TSFileReadMode::DIRECT, the file is read in large aligned blocks and the
+        //!   system cache is bypassed. This is useful to replay huge files which would
+        //!   otherwise pollute the system cache.
+        //! @param [in] mode Read mode.
+        //!
+        void setReadMode(TSFileReadMode mode) { _read_mode = mode; }
+
+        //!
+        //! Get the method to read the file.
+        //! @return The requested read mode. When the file is open, this is the actual read mode.
+        //!
+        TSFileReadMode readMode() const;
+
+        //!
+        //! Default size in bytes of each write-behind buffer.
+        //!
+        static constexpr size_t DEFAULT_WRITE_BEHIND_BUFFER_SIZE = 1024 * 1024;
+
+        //!
+        //! Set asynchronous write-behind mode.
+        //! This method shall be called before opening the file.
+        //! When a file is open in write-only mode with write-behind, the data to write are
+        //! copied in a ring of buffers and the actual write operations are performed by
+        //! an internal thread. The application is blocked only when all buffers are full.
+        //! Write errors are reported by subsequent write operations or when closing the file.
+        //! @param [in] buffer_count Number of buffers in the ring. Zero disables write-behind (the default).
+        //! @param [in] buffer_size Size in bytes of each buffer, rounded up to a multiple of the page size.
+        //!
+        void setWriteBehind(size_t buffer_count, size_t buffer_size = DEFAULT_WRITE_BEHIND_BUFFER_SIZE);
+
+        //!
+        //! Statistics of the write-behind mode.
+        //!
+        struct TSDUCKDLL WriteBehindStatus
+        {
+            WriteBehindStatus();        //!< Constructor.
+            uint64_t   write_count;     //!< Number of write operations by the write-behind thread.
+            uint64_t   write_bytes;     //!< Number of written bytes by the write-behind thread.
+            NanoSecond write_time;      //!< Cumulated duration of write operations (write latency).
+            NanoSecond max_write_time;  //!< Maximum duration of one write operation.
+            uint64_t   blocked_count;   //!< Number of times the application was blocked because all buffers were full (backpressure).
+            NanoSecond blocked_time;    //!< Cumulated time during which the application was blocked.
+            size_t     max_queued;      //!< Maximum number of full buffers which were waiting to be written.
+        };
+
+        //!
+        //! Get the statistics of the write-behind mode.
+        //! The statistics are accumulated on all files which were opened by this object
+        //! since the last call to setWriteBehind().
+        //! @param [out] status Returned statistics.
+        //!
+        void getWriteBehindStatus(WriteBehindStatus& status) const;
+
         //!
         //! Abort any currenly read/write operation in progress.
         //! The file is left in a broken state and can be only closed.
@@ -204,10 +284,23 @@ namespace ts {
         //!
         bool seek(PacketCounter packet_index, Report& report);
 
+        //!
+        //! Seek the file at the position of a time in the stream, using an index of the file.
+        //! The file must have been opened in rewindable mode.
+        //! @param [in] index Index of the file, typically loaded from the index file which was built by @a tsindex.
+        //! @param [in] time Time in milliseconds from the beginning of the file, based on PCR's.
+        //! @param [in] intra If true, seek the file at the first video intra-frame at or after @a time.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //! @see TSFileIndex
+        //!
+        bool seekTime(const TSFileIndex& index, MilliSecond time, bool intra, Report& report);
+
         // Override TSPacketStream implementation
         virtual size_t readPackets(TSPacket* buffer, TSPacketMetadata* metadata, size_t max_packets, Report& report) override;
 
     private:
+        class WriteBehind;
         UString       _filename;         //!< Input file name.
         size_t        _repeat;           //!< Repeat count (0 means infinite)
         size_t        _counter;          //!< Current repeat count
@@ -224,10 +317,25 @@ namespace ts {
         bool          _rewindable;       //!< Opened in rewindable mode
         bool          _regular;          //!< Is a regular file (ie. not a pipe or special device)
         bool          _std_inout;        //!< File is standard input or output.
+        TSFileReadMode _read_mode;       //!< Requested read mode.
+        size_t        _wb_count;         //!< Number of write-behind buffers, zero if disabled.
+        size_t        _wb_size;          //!< Size of each write-behind buffer.
+        WriteBehindStatus _wb_status;    //!< Accumulated write-behind statistics from previous files.
+        WriteBehind*  _write_behind;     //!< Write-behind thread, null if not used.
 #if defined(TS_WINDOWS)
         ::HANDLE      _handle;           //!< File handle
 #else
         int           _fd;               //!< File descriptor
+        TSFileReadMode _actual_mode;     //!< Actual read mode of the open file.
+        uint64_t      _file_pos;         //!< Current read position in file (MMAP and DIRECT modes).
+        uint64_t      _file_size;        //!< Last known size of the file (MMAP mode).
+        uint8_t*      _map_base;         //!< Address of current mapped window (MMAP mode).
+        uint64_t      _map_offset;       //!< File offset of current mapped window (MMAP mode).
+        size_t        _map_size;         //!< Size of current mapped window (MMAP mode).
+        ByteBlock     _direct_buffer;    //!< Read buffer, with room for alignment (DIRECT mode).
+        uint8_t*      _direct_data;      //!< Aligned address inside _direct_buffer (DIRECT mode).
+        uint64_t      _direct_offset;    //!< File offset of the data in _direct_data (DIRECT mode).
+        size_t        _direct_size;      //!< Size of valid data in _direct_data (DIRECT mode).
 #endif
 
         // Implementation of AbstractReadStreamInterface
@@ -237,6 +345,16 @@ namespace ts {
         // Implementation of AbstractWriteStreamInterface
         virtual bool writeStream(const void* addr, size_t size, size_t& written_size, Report& report) override;
 
+        // Low-level synchronous write, return a system error code.
+#if defined(TS_WINDOWS)
+        static SysErrorCode WriteData(::HANDLE handle, const void* addr, size_t size, size_t& written_size);
+#else
+        static SysErrorCode WriteData(int fd, const void* addr, size_t size, size_t& written_size);
+#endif
+
+        // Terminate the write-behind mode, if any, after writing all pending data.
+        bool closeWriteBehind(Report& report);
+
         // Read/write artificial stuffing.
         void readStuffing(TSPacket*& buffer, TSPacketMetadata*& metadata, size_t count, Report& report);
         bool writeStuffing(size_t count, Report& report);
@@ -245,6 +363,12 @@ namespace ts {
         bool openInternal(bool reopen, Report& report);
         bool seekCheck(Report& report);
         bool seekInternal(uint64_t index, Report& report);
+#if !defined(TS_WINDOWS)
+        void setupReadMode(const struct ::stat& st, Report& report);
+        void releaseReadMode();
+        bool readMapped(void* addr, size_t max_size, size_t& ret_size, Report& report);
+        bool readDirect(void* addr, size_t max_size, size_t& ret_size, Report& report);
+#endif
 
         // Inaccessible operations.
         TSFile& operator=(TSFile&) = delete;
@@ -0,0 +1,350 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSFileIndex.h"
+#include "tsTSFile.h"
+#include "tsFileUtils.h"
+#include "tsMemory.h"
+
+const ts::UChar* const ts::TSFileIndex::DEFAULT_SUFFIX = u".tsidx";
+
+// Maximum gap between two PCR's in the reference PID. Larger gaps are considered as discontinuities.
+#define MAX_PCR_GAP (10 * ts::SYSTEM_CLOCK_FREQ)
+
+// Number of packets to read at a time when building the index.
+#define BUILD_CHUNK_PACKETS 4096
+
+
+//----------------------------------------------------------------------------
+// Binary format of the index file. All integers are big-endian.
+// - Header: magic (8 bytes), version, file packet size (32 bits), TS file
+//   size, number of packets (64 bits), PCR PID, reserved (16 bits), number
+//   of time points, number of events (32 bits).
+// - Time points: packet index, PCR value, time in milliseconds (64 bits).
+// - Events: packet index (64 bits), PID (16 bits), event type, table id,
+//   table version (8 bits), reserved (24 bits).
+//----------------------------------------------------------------------------
+
+namespace {
+    const char   INDEX_MAGIC[8] = {'T', 'S', 'F', 'I', 'L', 'I', 'D', 'X'};
+    const uint32_t INDEX_VERSION = 1;
+    const size_t INDEX_HEADER_SIZE = 44;
+    const size_t INDEX_TIME_POINT_SIZE = 24;
+    const size_t INDEX_EVENT_SIZE = 16;
+}
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::TSFileIndex::TSFileIndex(Report* report) :
+    _duck(report),
+    _demux(_duck, this, {TID_PAT, TID_CAT, TID_PMT, TID_NIT_ACT, TID_SDT_ACT, TID_BAT}),
+    _pcr_pid(PID_NULL),
+    _packet_count(0),
+    _file_packet_size(PKT_SIZE),
+    _file_size(0),
+    _last_pcr(INVALID_PCR),
+    _elapsed(0),
+    _time_points(),
+    _events()
+{
+}
+
+ts::TSFileIndex::~TSFileIndex()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Get the name of the index file for a TS file.
+//----------------------------------------------------------------------------
+
+ts::UString ts::TSFileIndex::IndexFileName(const UString& ts_file)
+{
+    return ts_file.endWith(DEFAULT_SUFFIX, FileSystemCaseSensitivity) ? ts_file : ts_file + DEFAULT_SUFFIX;
+}
+
+
+//----------------------------------------------------------------------------
+// Reset the index.
+//----------------------------------------------------------------------------
+
+void ts::TSFileIndex::reset()
+{
+    _demux.reset();
+    _demux.addFilteredTableIds({TID_PAT, TID_CAT, TID_PMT, TID_NIT_ACT, TID_SDT_ACT, TID_BAT});
+    _pcr_pid = PID_NULL;
+    _packet_count = 0;
+    _file_packet_size = PKT_SIZE;
+    _file_size = 0;
+    _last_pcr = INVALID_PCR;
+    _elapsed = 0;
+    _time_points.clear();
+    _events.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Feed the index with the next TS packet of the file.
+//----------------------------------------------------------------------------
+
+void ts::TSFileIndex::feedPacket(const TSPacket& pkt)
+{
+    const PID pid = pkt.getPID();
+
+    // The first PID with a PCR is the time reference.
+    if (pkt.hasPCR() && (_pcr_pid == PID_NULL || _pcr_pid == pid)) {
+        const uint64_t pcr = pkt.getPCR();
+        if (_pcr_pid == PID_NULL) {
+            _pcr_pid = pid;
+        }
+        else if (!pkt.getDiscontinuityIndicator()) {
+            // Time does not progress on discontinuities or too large gaps.
+            const uint64_t diff = DiffPCR(_last_pcr, pcr);
+            if (diff != INVALID_PCR && diff <= MAX_PCR_GAP) {
+                _elapsed += diff;
+            }
+        }
+        _last_pcr = pcr;
+        _time_points.push_back(TimePoint(_packet_count, pcr, MilliSecond(_elapsed / (SYSTEM_CLOCK_FREQ / MilliSecPerSec))));
+    }
+
+    // Table events are added by the handlers during feedPacket().
+    _demux.feedPacket(pkt);
+    if (_demux.atIntraFrame(pid)) {
+        _events.push_back(Event(_packet_count, pid, EventType::INTRA_FRAME));
+    }
+
+    _packet_count++;
+}
+
+
+//----------------------------------------------------------------------------
+// Signalization handlers, record new versions of tables.
+//----------------------------------------------------------------------------
+
+void ts::TSFileIndex::addTableEvent(const AbstractLongTable& table, PID pid)
+{
+    _events.push_back(Event(_packet_count, pid, EventType::TABLE_VERSION, table.tableId(), table.version));
+}
+
+void ts::TSFileIndex::handlePAT(const PAT& table, PID pid)
+{
+    addTableEvent(table, pid);
+}
+
+void ts::TSFileIndex::handleCAT(const CAT& table, PID pid)
+{
+    addTableEvent(table, pid);
+}
+
+void ts::TSFileIndex::handlePMT(const PMT& table, PID pid)
+{
+    addTableEvent(table, pid);
+}
+
+void ts::TSFileIndex::handleNIT(const NIT& table, PID pid)
+{
+    addTableEvent(table, pid);
+}
+
+void ts::TSFileIndex::handleSDT(const SDT& table, PID pid)
+{
+    addTableEvent(table, pid);
+}
+
+void ts::TSFileIndex::handleBAT(const BAT& table, PID pid)
+{
+    addTableEvent(table, pid);
+}
+
+
+//----------------------------------------------------------------------------
+// Build the index of a TS file in one pass.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileIndex::build(const UString& ts_file, Report& report, TSPacketFormat format)
+{
+    reset();
+
+    TSFile file;
+    if (!file.openRead(ts_file, 1, 0, report, format)) {
+        return false;
+    }
+
+    std::vector<TSPacket> buffer(BUILD_CHUNK_PACKETS);
+    size_t count = 0;
+    while ((count = file.readPackets(buffer.data(), nullptr, buffer.size(), report)) > 0) {
+        for (size_t i = 0; i < count; ++i) {
+            feedPacket(buffer[i]);
+        }
+    }
+
+    _file_packet_size = file.packetHeaderSize() + PKT_SIZE;
+    _file_size = uint64_t(std::max<int64_t>(0, GetFileSize(ts_file)));
+    file.close(report);
+
+    report.debug(u"%s: %'d packets, %'d time points, %'d events", {ts_file, _packet_count, _time_points.size(), _events.size()});
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Save the index in a binary file.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileIndex::save(const UString& index_file, Report& report) const
+{
+    ByteBlock index;
+    index.reserve(INDEX_HEADER_SIZE + _time_points.size() * INDEX_TIME_POINT_SIZE + _events.size() * INDEX_EVENT_SIZE);
+    index.append(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    index.appendUInt32(INDEX_VERSION);
+    index.appendUInt32(uint32_t(_file_packet_size));
+    index.appendUInt64(_file_size);
+    index.appendUInt64(_packet_count);
+    index.appendUInt16(_pcr_pid);
+    index.appendUInt16(0);
+    index.appendUInt32(uint32_t(_time_points.size()));
+    index.appendUInt32(uint32_t(_events.size()));
+    assert(index.size() == INDEX_HEADER_SIZE);
+
+    for (auto it = _time_points.begin(); it != _time_points.end(); ++it) {
+        index.appendUInt64(it->packet);
+        index.appendUInt64(it->pcr);
+        index.appendUInt64(uint64_t(it->time));
+    }
+    for (auto it = _events.begin(); it != _events.end(); ++it) {
+        index.appendUInt64(it->packet);
+        index.appendUInt16(it->pid);
+        index.appendUInt8(uint8_t(it->type));
+        index.appendUInt8(it->tid);
+        index.appendUInt8(it->version);
+        index.appendUInt24(0);
+    }
+
+    return index.saveToFile(index_file, &report);
+}
+
+
+//----------------------------------------------------------------------------
+// Load the index from a binary file.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileIndex::load(const UString& file_name, Report& report)
+{
+    reset();
+
+    // When a TS file name is specified, the index must not be older than the TS file.
+    const UString index_file(IndexFileName(file_name));
+    const bool check_ts = index_file != file_name && FileExists(file_name);
+    if (!FileExists(index_file)) {
+        report.error(u"index file %s not found", {index_file});
+        return false;
+    }
+    if (check_ts && GetFileModificationTimeUTC(index_file) < GetFileModificationTimeUTC(file_name)) {
+        report.error(u"index file %s is older than %s", {index_file, file_name});
+        return false;
+    }
+
+    ByteBlock index;
+    if (!index.loadFromFile(index_file, std::numeric_limits<size_t>::max(), &report)) {
+        return false;
+    }
+
+    const uint8_t* data = index.data();
+    const size_t time_count = index.size() < INDEX_HEADER_SIZE ? 0 : GetUInt32(data + 36);
+    const size_t event_count = index.size() < INDEX_HEADER_SIZE ? 0 : GetUInt32(data + 40);
+    if (index.size() < INDEX_HEADER_SIZE ||
+        ::memcmp(data, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 ||
+        GetUInt32(data + 8) != INDEX_VERSION ||
+        index.size() != INDEX_HEADER_SIZE + time_count * INDEX_TIME_POINT_SIZE + event_count * INDEX_EVENT_SIZE)
+    {
+        report.error(u"invalid index file %s", {index_file});
+        return false;
+    }
+
+    _file_packet_size = GetUInt32(data + 12);
+    _file_size = GetUInt64(data + 16);
+    _packet_count = GetUInt64(data + 24);
+    _pcr_pid = GetUInt16(data + 32);
+    data += INDEX_HEADER_SIZE;
+
+    if (check_ts && GetFileSize(file_name) != int64_t(_file_size)) {
+        report.error(u"%s was modified after building its index", {file_name});
+        reset();
+        return false;
+    }
+
+    _time_points.reserve(time_count);
+    for (size_t i = 0; i < time_count; ++i, data += INDEX_TIME_POINT_SIZE) {
+        _time_points.push_back(TimePoint(GetUInt64(data), GetUInt64(data + 8), MilliSecond(GetUInt64(data + 16))));
+    }
+    _events.reserve(event_count);
+    for (size_t i = 0; i < event_count; ++i, data += INDEX_EVENT_SIZE) {
+        _events.push_back(Event(GetUInt64(data), GetUInt16(data + 8), EventType(data[10]), data[11], data[12]));
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Binary searches.
+//----------------------------------------------------------------------------
+
+ts::PacketCounter ts::TSFileIndex::packetAtTime(MilliSecond time) const
+{
+    // The time points are sorted by packet index and time.
+    const auto it = std::lower_bound(_time_points.begin(), _time_points.end(), time,
+                                     [](const TimePoint& tp, MilliSecond t) { return tp.time < t; });
+    return it == _time_points.end() ? _packet_count : it->packet;
+}
+
+ts::MilliSecond ts::TSFileIndex::timeAtPacket(PacketCounter packet) const
+{
+    const auto it = std::upper_bound(_time_points.begin(), _time_points.end(), packet,
+                                     [](PacketCounter p, const TimePoint& tp) { return p < tp.packet; });
+    return it == _time_points.begin() ? 0 : (it - 1)->time;
+}
+
+bool ts::TSFileIndex::nextEvent(PacketCounter from, EventType type, PacketCounter& packet, PID pid, TID tid) const
+{
+    // Locate the first event at or after 'from', then the first matching one.
+    for (auto it = std::lower_bound(_events.begin(), _events.end(), from,
+                                    [](const Event& ev, PacketCounter p) { return ev.packet < p; });
+         it != _events.end(); ++it)
+    {
+        if (it->type == type && (pid == PID_NULL || it->pid == pid) && (tid == TID_NULL || it->tid == tid)) {
+            packet = it->packet;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,269 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Random-access index of a transport stream file.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsSignalizationDemux.h"
+#include "tsSignalizationHandlerInterface.h"
+#include "tsDuckContext.h"
+#include "tsTSPacketFormat.h"
+#include "tsTSPacket.h"
+
+namespace ts {
+    //!
+    //! Random-access index of a transport stream file.
+    //! @ingroup mpeg
+    //!
+    //! The index is built in one pass over the file. It records:
+    //! - The position of all PCR's in a reference PID (the first PID containing a PCR),
+    //!   with the corresponding time from the beginning of the file.
+    //! - The position of all video intra-frames (random access points) in all PID's
+    //!   with a known video codec, as found by the AVC, HEVC and other video parsers.
+    //! - The position of all new versions of the PSI/SI tables (PAT, CAT, PMT, NIT, SDT, BAT).
+    //!
+    //! The index is saved in a binary "sidecar" file, next to the TS file. Once the
+    //! index is loaded, searching a time or an event in the file is a binary search.
+    //! All positions are indexes of TS packets in the file, as used in TSFile::seek().
+    //!
+    class TSDUCKDLL TSFileIndex : private SignalizationHandlerInterface
+    {
+        TS_NOCOPY(TSFileIndex);
+    public:
+        //!
+        //! Default suffix of index files. The index of a TS file is stored in a
+        //! file with the same name as the TS file, with this suffix appended.
+        //!
+        static const UChar* const DEFAULT_SUFFIX;
+
+        //!
+        //! Get the name of the index file for a TS file.
+        //! @param [in] ts_file Name of the TS file. If the name already ends with the
+        //! default suffix, this is already the name of an index file.
+        //! @return The name of the index file.
+        //!
+        static UString IndexFileName(const UString& ts_file);
+
+        //!
+        //! Type of indexed events.
+        //!
+        enum class EventType : uint8_t {
+            INTRA_FRAME   = 1,  //!< Start of a video intra-frame (random access point).
+            TABLE_VERSION = 2,  //!< New version of a PSI/SI table.
+        };
+
+        //!
+        //! Position of a PCR in the reference PID.
+        //!
+        class TSDUCKDLL TimePoint
+        {
+        public:
+            PacketCounter packet;  //!< Index of the packet containing the PCR.
+            uint64_t      pcr;     //!< PCR value.
+            MilliSecond   time;    //!< Time from the first PCR in the file, in milliseconds.
+            //!
+            //! Constructor.
+            //! @param [in] pk Packet index.
+            //! @param [in] pc PCR value.
+            //! @param [in] ms Time from the first PCR.
+            //!
+            TimePoint(PacketCounter pk = 0, uint64_t pc = 0, MilliSecond ms = 0) : packet(pk), pcr(pc), time(ms) {}
+        };
+
+        //!
+        //! Position of an indexed event.
+        //!
+        class TSDUCKDLL Event
+        {
+        public:
+            PacketCounter packet;   //!< Index of the packet where the event occurs.
+            PID           pid;      //!< PID of the packet.
+            EventType     type;     //!< Type of event.
+            TID           tid;      //!< Table id for EventType::TABLE_VERSION.
+            uint8_t       version;  //!< Table version for EventType::TABLE_VERSION.
+            //!
+            //! Constructor.
+            //! @param [in] pk Packet index.
+            //! @param [in] pi PID of the packet.
+            //! @param [in] ty Type of event.
+            //! @param [in] ti Table id.
+            //! @param [in] ve Table version.
+            //!
+            Event(PacketCounter pk = 0, PID pi = PID_NULL, EventType ty = EventType::INTRA_FRAME, TID ti = TID_NULL, uint8_t ve = 0) :
+                packet(pk), pid(pi), type(ty), tid(ti), version(ve) {}
+        };
+
+        //!
+        //! Vector of time points, sorted by packet index and time.
+        //!
+        typedef std::vector<TimePoint> TimePointVector;
+
+        //!
+        //! Vector of events, sorted by packet index.
+        //!
+        typedef std::vector<Event> EventVector;
+
+        //!
+        //! Constructor.
+        //! @param [in,out] report Where to report errors during the analysis of the transport stream.
+        //!
+        explicit TSFileIndex(Report* report = nullptr);
+
+        //!
+        //! Virtual destructor.
+        //!
+        virtual ~TSFileIndex() override;
+
+        //!
+        //! Reset the index, forget all previously collected positions.
+        //!
+        void reset();
+
+        //!
+        //! Feed the index with the next TS packet of the file.
+        //! @param [in] pkt A TS packet. The packets must be passed in file order.
+        //!
+        void feedPacket(const TSPacket& pkt);
+
+        //!
+        //! Build the index of a TS file in one pass.
+        //! @param [in] ts_file Name of the TS file.
+        //! @param [in,out] report Where to report errors.
+        //! @param [in] format Format of the TS file.
+        //! @return True on success, false on error.
+        //!
+        bool build(const UString& ts_file, Report& report, TSPacketFormat format = TSPacketFormat::AUTODETECT);
+
+        //!
+        //! Save the index in a binary file.
+        //! @param [in] index_file Name of the index file.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool save(const UString& index_file, Report& report) const;
+
+        //!
+        //! Load the index from a binary file.
+        //! @param [in] file_name Name of the index file or name of the TS file. In the later case,
+        //! the index file is computed using IndexFileName(). The index is rejected if it is older
+        //! than the TS file or if the size of the TS file changed since the index was built.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool load(const UString& file_name, Report& report);
+
+        //!
+        //! Get the reference PCR PID.
+        //! @return The PID which is used as time reference or PID_NULL if there is no PCR in the file.
+        //!
+        PID pcrPID() const { return _pcr_pid; }
+
+        //!
+        //! Get the total number of TS packets in the file.
+        //! @return The total number of TS packets in the file.
+        //!
+        PacketCounter packetCount() const { return _packet_count; }
+
+        //!
+        //! Get the size of each packet in the file, including the optional header (M2TS for instance).
+        //! @return The size in bytes of each packet in the file.
+        //!
+        size_t filePacketSize() const { return _file_packet_size; }
+
+        //!
+        //! Get the duration of the file, based on PCR's.
+        //! @return The time of the last PCR in the file in milliseconds.
+        //!
+        MilliSecond duration() const { return _time_points.empty() ? 0 : _time_points.back().time; }
+
+        //!
+        //! Get all indexed time points.
+        //! @return A constant reference to the vector of time points.
+        //!
+        const TimePointVector& timePoints() const { return _time_points; }
+
+        //!
+        //! Get all indexed events.
+        //! @return A constant reference to the vector of events.
+        //!
+        const EventVector& events() const { return _events; }
+
+        //!
+        //! Get the index of the first packet which is at or after a given time.
+        //! @param [in] time Time from the beginning of the file in milliseconds.
+        //! @return The index of the first packet containing a PCR at or after @a time
+        //! in the reference PID or packetCount() if @a time is after the end of the file.
+        //!
+        PacketCounter packetAtTime(MilliSecond time) const;
+
+        //!
+        //! Get the time of a packet.
+        //! @param [in] packet Index of a packet in the file.
+        //! @return The time of the last PCR in the reference PID at or before @a packet.
+        //!
+        MilliSecond timeAtPacket(PacketCounter packet) const;
+
+        //!
+        //! Find the next event at or after a given packet.
+        //! @param [in] from Index of the first packet to search.
+        //! @param [in] type Type of event to search.
+        //! @param [out] packet Index of the packet where the event is found.
+        //! @param [in] pid If not PID_NULL, search an event in this PID only.
+        //! @param [in] tid If not TID_NULL, search a new version of this table only.
+        //! @return True if the event is found, false otherwise.
+        //!
+        bool nextEvent(PacketCounter from, EventType type, PacketCounter& packet, PID pid = PID_NULL, TID tid = TID_NULL) const;
+
+    private:
+        DuckContext        _duck;              // Execution context for the demux.
+        SignalizationDemux _demux;             // Demux for PSI/SI and video PID's.
+        PID                _pcr_pid;           // Reference PCR PID.
+        PacketCounter      _packet_count;      // Number of TS packets.
+        size_t             _file_packet_size;  // Size of packets in file.
+        uint64_t           _file_size;         // Size in bytes of the TS file.
+        uint64_t           _last_pcr;          // Last PCR in reference PID (while building).
+        uint64_t           _elapsed;           // Elapsed PCR units since first PCR (while building).
+        TimePointVector    _time_points;       // Positions of PCR's in reference PID.
+        EventVector        _events;            // Positions of events.
+
+        // Add an event for a new version of a table.
+        void addTableEvent(const AbstractLongTable& table, PID pid);
+
+        // Implementation of SignalizationHandlerInterface.
+        virtual void handlePAT(const PAT& table, PID pid) override;
+        virtual void handleCAT(const CAT& table, PID pid) override;
+        virtual void handlePMT(const PMT& table, PID pid) override;
+        virtual void handleNIT(const NIT& table, PID pid) override;
+        virtual void handleSDT(const SDT& table, PID pid) override;
+        virtual void handleBAT(const BAT& table, PID pid) override;
+    };
+}
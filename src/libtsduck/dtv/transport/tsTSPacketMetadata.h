@@ -175,6 +175,12 @@ namespace ts {
         //!
         bool hasAllLabels(const LabelSet& mask) const;
 
+        //!
+        //! Get all labels of the TS packet.
+        //! @return The set of labels of the TS packet.
+        //!
+        LabelSet getLabels() const { return _labels; }
+
         //!
         //! Set a specific label for the TS packet.
         //! @param [in] label The label to set.
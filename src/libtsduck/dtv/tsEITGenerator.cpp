@@ -58,7 +58,8 @@ ts::EITGenerator::EITGenerator(DuckContext& duck, PID pid, EITOption options, co
     _services(),
     _injects(),
     _obsolete_count(0),
-    _versions()
+    _versions(),
+    _last_section()
 {
     // We need the PAT as long as the TS id is not known.
     _demux.addPID(PID_PAT);
@@ -92,6 +93,7 @@ void ts::EITGenerator::reset()
     _demux.reset();
     _demux.addPID(PID_PAT);
     _packetizer.reset();
+    _last_section.clear();
     _services.clear();
     for (size_t i = 0; i < _injects.size(); ++i) {
         _injects[i].clear();
@@ -134,7 +136,8 @@ ts::EITGenerator::ESection::ESection(EITGenerator* gen, const ServiceIdTriplet&
     obsolete(false),
     injected(false),
     next_inject(),
-    section()
+    section(),
+    cache()
 {
     // Build section data.
     ByteBlockPtr section_data(new ByteBlock(LONG_SECTION_HEADER_SIZE + EIT::EIT_PAYLOAD_FIXED_SIZE + SECTION_CRC32_SIZE));
@@ -175,6 +178,8 @@ void ts::EITGenerator::ESection::startModifying()
     }
     // Mark the new section data as no longer used by a packetizer.
     injected = false;
+    // The packets of the previous section data are no longer valid.
+    cache.clear();
 }
 
 
@@ -1152,6 +1157,7 @@ void ts::EITGenerator::provideSection(SectionCounter counter, SectionPtr& sectio
                 // This section shall be injected.
                 section = sec->section;
                 sec->injected = true;
+                _last_section = sec;
 
                 // Requeue next iteration of that section.
                 enqueueInjectSection(sec, now + _profile.repetitionSeconds(*sec->section) * MilliSecPerSec, false);
@@ -1167,6 +1173,17 @@ void ts::EITGenerator::provideSection(SectionCounter counter, SectionPtr& sectio
 }
 
 
+//----------------------------------------------------------------------------
+// Implementation of SectionProviderInterface.
+// Get the packet cache of the last provided section.
+//----------------------------------------------------------------------------
+
+ts::SectionPacketCache* ts::EITGenerator::sectionPacketCache(const SectionPtr& section)
+{
+    return !_last_section.isNull() && _last_section->section == section ? &_last_section->cache : nullptr;
+}
+
+
 //----------------------------------------------------------------------------
 // Implementation of SectionHandlerInterface.
 // Process a section from the input stream (invoked by demux).
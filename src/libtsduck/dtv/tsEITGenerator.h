@@ -397,10 +397,11 @@ namespace ts {
         {
             TS_NOBUILD_NOCOPY(ESection);
         public:
-            bool       obsolete;     // The section is obsolete, discard it when found in an injection list.
-            bool       injected;     // Indicate that the data part of the section is used in a packetizer.
-            Time       next_inject;  // Date of next injection.
-            SectionPtr section;      // Safe pointer to the EIT section.
+            bool               obsolete;     // The section is obsolete, discard it when found in an injection list.
+            bool               injected;     // Indicate that the data part of the section is used in a packetizer.
+            Time               next_inject;  // Date of next injection.
+            SectionPtr         section;      // Safe pointer to the EIT section.
+            SectionPacketCache cache;        // Pre-built TS packets of the section.
 
             // Constructor, build an empty section for the specified service (CRC32 not set).
             ESection(EITGenerator* gen, const ServiceIdTriplet& service_id, TID tid, uint8_t section_number, uint8_t last_section_number);
@@ -499,6 +500,7 @@ namespace ts {
         ESectionListArray    _injects;           // Arrays of sections for injection.
         size_t               _obsolete_count;    // Number of obsolete sections in the injection lists.
         std::map<uint32_t,uint8_t> _versions;    // Last version of sections.
+        ESectionPtr          _last_section;      // Last provided section, its packet cache is used by the packetizer.
 
         // Set a bitrate field and update EIT inter-packet.
         void setBitRateField(BitRate EITGenerator::* field, const BitRate& bitrate);
@@ -535,5 +537,6 @@ namespace ts {
         // Implementation of SectionProviderInterface.
         virtual void provideSection(SectionCounter counter, SectionPtr& section) override;
         virtual bool doStuffing() override;
+        virtual SectionPacketCache* sectionPacketCache(const SectionPtr& section) override;
     };
 }
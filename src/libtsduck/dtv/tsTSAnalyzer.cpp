@@ -33,6 +33,11 @@
 #include "tsDuckContext.h"
 #include "tsNames.h"
 #include "tsAlgorithm.h"
+#include "tsThread.h"
+#include "tsMutex.h"
+#include "tsCondition.h"
+#include "tsGuardCondition.h"
+#include "tsNullReport.h"
 
 // Constant string "Unreferenced"
 const ts::UString ts::TSAnalyzer::UNREFERENCED(u"Unreferenced");
@@ -94,9 +99,13 @@ ts::TSAnalyzer::TSAnalyzer(DuckContext& duck, const BitRate& bitrate_hint) :
     _max_consecutive_suspects(1),
     _demux(_duck, this, this),
     _pes_demux(_duck, this),
-    _t2mi_demux(_duck, this)
+    _t2mi_demux(_duck, this),
+    _pes_workers(),
+    _pes_worker_of(),
+    _pes_all_pids()
 {
     resetSectionDemux();
+    resetPESAnalysis();
 }
 
 
@@ -107,6 +116,7 @@ ts::TSAnalyzer::TSAnalyzer(DuckContext& duck, const BitRate& bitrate_hint) :
 ts::TSAnalyzer::~TSAnalyzer()
 {
     this->reset();
+    setAnalysisThreads(0);
 }
 
 
@@ -162,9 +172,9 @@ void ts::TSAnalyzer::reset()
     _ts_bitrate_cnt = 0;
     _preceding_errors = 0;
     _preceding_suspects = 0;
-    _pes_demux.reset();
 
     resetSectionDemux();
+    resetPESAnalysis();
 }
 
 
@@ -626,6 +636,8 @@ void ts::TSAnalyzer::analyzePAT(const PAT& pat)
         ps->carry_section = true;
         // Add a filter on the referenced PID to get the PMT
         _demux.addPID(pmt_pid);
+        // All PES analysis threads need the PMT's to get the stream types.
+        _pes_all_pids.set(pmt_pid);
         // Describe the service
         ServiceContextPtr svp(getService(service_id));
         svp->pmt_pid = pmt_pid;
@@ -1372,6 +1384,299 @@ void ts::TSAnalyzer::handleTSPacket(T2MIDemux& demux, const T2MIPacket& t2mi, co
 }
 
 
+//----------------------------------------------------------------------------
+// A worker thread demuxing and analyzing PES packets on a subset of the PID's.
+//----------------------------------------------------------------------------
+
+class ts::TSAnalyzer::PESWorker: private Thread, private PESHandlerInterface
+{
+    TS_NOCOPY(PESWorker);
+public:
+    // Constructor and destructor. The thread is started in the constructor.
+    PESWorker();
+    virtual ~PESWorker() override;
+
+    // Pass one packet to the worker (from the analyzer thread).
+    void feedPacket(const TSPacket& pkt);
+
+    // Wait until all packets are processed, the worker thread is then idle.
+    void flush();
+
+    // Reset the PES analysis, discard all attributes.
+    void reset();
+
+    // Add standards which are used to interpret the PMT's (from the analyzer thread).
+    void addStandards(Standards mask);
+
+    // New attributes per PID. Accessible only after flush().
+    PIDMap<UStringVector> attributes;
+
+private:
+    // Number of packets which are passed at a time to the worker thread.
+    static constexpr size_t BATCH_SIZE = 512;
+
+    DuckContext    _duck;      // Private context, interpreting PMT's in the worker thread.
+    Standards      _standards; // Standards which were passed to _duck, used in the analyzer thread only.
+    PESDemux       _demux;     // PES demux for the PID's of this worker.
+    TSPacketVector _input;     // Packets being accumulated by the analyzer thread.
+    TSPacketVector _work;      // Packets being analyzed in the worker thread.
+    Mutex          _mutex;     // Exclusive access to protected area.
+    Condition      _todo;      // Signaled when a batch of packets is submitted or on termination.
+    Condition      _done;      // Signaled when a batch of packets is taken or completed.
+    // -- start of protected area --
+    TSPacketVector _pending;   // Batch of packets, submitted but not yet taken by the worker thread.
+    bool           _busy;      // The worker thread is processing packets.
+    bool           _terminate; // Termination request.
+    // -- end of protected area --
+
+    // Submit the accumulated packets to the worker thread.
+    void submit();
+
+    // Implementation of Thread.
+    virtual void main() override;
+
+    // Implementation of PESHandlerInterface. Invoked in the worker thread.
+    virtual void handleNewMPEG2AudioAttributes(PESDemux&, const PESPacket&, const MPEG2AudioAttributes&) override;
+    virtual void handleNewMPEG2VideoAttributes(PESDemux&, const PESPacket&, const MPEG2VideoAttributes&) override;
+    virtual void handleNewAVCAttributes(PESDemux&, const PESPacket&, const AVCAttributes&) override;
+    virtual void handleNewHEVCAttributes(PESDemux&, const PESPacket&, const HEVCAttributes&) override;
+    virtual void handleNewAC3Attributes(PESDemux&, const PESPacket&, const AC3Attributes&) override;
+};
+
+ts::TSAnalyzer::PESWorker::PESWorker() :
+    Thread(),
+    attributes(),
+    _duck(NullReport::Instance()),
+    _standards(Standards::NONE),
+    _demux(_duck, this),
+    _input(),
+    _work(),
+    _mutex(),
+    _todo(),
+    _done(),
+    _pending(),
+    _busy(false),
+    _terminate(false)
+{
+    _input.reserve(BATCH_SIZE);
+    _work.reserve(BATCH_SIZE);
+    _pending.reserve(BATCH_SIZE);
+    start();
+}
+
+ts::TSAnalyzer::PESWorker::~PESWorker()
+{
+    // Process all pending packets and terminate the thread.
+    submit();
+    {
+        GuardCondition lock(_mutex, _todo);
+        _terminate = true;
+        lock.signal();
+    }
+    waitForTermination();
+}
+
+void ts::TSAnalyzer::PESWorker::feedPacket(const TSPacket& pkt)
+{
+    _input.push_back(pkt);
+    if (_input.size() >= BATCH_SIZE) {
+        submit();
+    }
+}
+
+void ts::TSAnalyzer::PESWorker::submit()
+{
+    if (!_input.empty()) {
+        // Wait for the previous batch to be taken by the worker thread.
+        GuardCondition lock(_mutex, _done);
+        while (!_pending.empty()) {
+            lock.waitCondition();
+        }
+        _pending.swap(_input);
+        _todo.signal();
+    }
+}
+
+void ts::TSAnalyzer::PESWorker::flush()
+{
+    submit();
+    GuardCondition lock(_mutex, _done);
+    while (_busy || !_pending.empty()) {
+        lock.waitCondition();
+    }
+}
+
+void ts::TSAnalyzer::PESWorker::addStandards(Standards mask)
+{
+    // The standards of _duck are also updated by the worker thread while deserializing
+    // tables, they are never read here. The worker is idle when _duck is modified.
+    if ((_standards | mask) != _standards) {
+        _standards |= mask;
+        flush();
+        _duck.addStandards(_standards);
+    }
+}
+
+void ts::TSAnalyzer::PESWorker::reset()
+{
+    flush();
+    _demux.reset();
+    attributes.clear();
+}
+
+void ts::TSAnalyzer::PESWorker::main()
+{
+    for (;;) {
+        // Wait for a batch of packets or a termination request.
+        {
+            GuardCondition lock(_mutex, _todo);
+            while (_pending.empty() && !_terminate) {
+                lock.waitCondition();
+            }
+            if (_pending.empty()) {
+                // Termination request and no more packets.
+                break;
+            }
+            _work.swap(_pending);
+            _busy = true;
+            _done.signal();
+        }
+
+        // Analyze the packets outside the protected area.
+        for (const auto& pkt : _work) {
+            _demux.feedPacket(pkt);
+        }
+        _work.clear();
+
+        // Notify the analyzer thread that the worker is idle.
+        GuardCondition lock(_mutex, _done);
+        _busy = false;
+        lock.signal();
+    }
+}
+
+void ts::TSAnalyzer::PESWorker::handleNewMPEG2AudioAttributes(PESDemux&, const PESPacket& pkt, const MPEG2AudioAttributes& attr)
+{
+    AppendUnique(attributes[pkt.getSourcePID()], attr.toString());
+}
+
+void ts::TSAnalyzer::PESWorker::handleNewMPEG2VideoAttributes(PESDemux&, const PESPacket& pkt, const MPEG2VideoAttributes& attr)
+{
+    AppendUnique(attributes[pkt.getSourcePID()], attr.toString());
+}
+
+void ts::TSAnalyzer::PESWorker::handleNewAVCAttributes(PESDemux&, const PESPacket& pkt, const AVCAttributes& attr)
+{
+    AppendUnique(attributes[pkt.getSourcePID()], attr.toString());
+}
+
+void ts::TSAnalyzer::PESWorker::handleNewHEVCAttributes(PESDemux&, const PESPacket& pkt, const HEVCAttributes& attr)
+{
+    AppendUnique(attributes[pkt.getSourcePID()], attr.toString());
+}
+
+void ts::TSAnalyzer::PESWorker::handleNewAC3Attributes(PESDemux&, const PESPacket& pkt, const AC3Attributes& attr)
+{
+    AppendUnique(attributes[pkt.getSourcePID()], attr.toString());
+}
+
+
+//----------------------------------------------------------------------------
+// Set the number of worker threads for the analysis of PES packets.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::setAnalysisThreads(size_t count)
+{
+    if (count <= 1) {
+        count = 0;
+    }
+    if (count != _pes_workers.size()) {
+        for (auto worker : _pes_workers) {
+            delete worker;
+        }
+        _pes_workers.clear();
+        for (size_t i = 0; i < count; ++i) {
+            _pes_workers.push_back(new PESWorker);
+        }
+        resetPESAnalysis();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Reset PES analysis.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::resetPESAnalysis()
+{
+    _pes_demux.reset();
+    for (auto worker : _pes_workers) {
+        worker->reset();
+    }
+    _pes_worker_of.assign(_pes_workers.empty() ? 0 : PID_MAX, NPOS);
+    _pes_all_pids.reset();
+    _pes_all_pids.set(PID_PAT);
+}
+
+
+//----------------------------------------------------------------------------
+// Pass a packet to the PES worker threads.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::feedPESWorkers(const TSPacket& pkt)
+{
+    const PID pid = pkt.getPID();
+
+    if (_pes_all_pids.test(pid)) {
+        // PAT and PMT's are analyzed by all workers. The interpretation of a PMT
+        // depends on the standards which were found so far in the transport stream.
+        for (auto worker : _pes_workers) {
+            worker->addStandards(_duck.standards());
+            worker->feedPacket(pkt);
+        }
+    }
+    else {
+        // Each other PID is permanently assigned to one worker. Because the future
+        // load of a new PID is unknown, it is assigned to the least loaded worker.
+        size_t& index(_pes_worker_of[pid]);
+        if (index == NPOS) {
+            index = 0;
+            std::vector<size_t> load(_pes_workers.size(), 0);
+            for (PIDContextMap::const_iterator it = _pids.begin(); it != _pids.end(); ++it) {
+                if (_pes_worker_of[it->first] != NPOS) {
+                    load[_pes_worker_of[it->first]] += it->second->ts_pkt_cnt;
+                }
+            }
+            for (size_t i = 1; i < load.size(); ++i) {
+                if (load[i] < load[index]) {
+                    index = i;
+                }
+            }
+        }
+        _pes_workers[index]->feedPacket(pkt);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Wait for all PES worker threads and collect their results.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::syncPESWorkers()
+{
+    for (auto worker : _pes_workers) {
+        worker->flush();
+        for (auto it = worker->attributes.begin(); it != worker->attributes.end(); ++it) {
+            PIDContextPtr pc(getPID(it->first));
+            for (const auto& attr : it->second) {
+                AppendUnique(pc->attributes, attr);
+            }
+        }
+        worker->attributes.clear();
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // The following method feeds the analyzer with a TS packet.
 //----------------------------------------------------------------------------
@@ -1426,7 +1731,12 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt)
 
     // Feed packets into the various demux
     _demux.feedPacket(pkt);
-    _pes_demux.feedPacket(pkt);
+    if (_pes_workers.empty()) {
+        _pes_demux.feedPacket(pkt);
+    }
+    else {
+        feedPESWorkers(pkt);
+    }
     _t2mi_demux.feedPacket(pkt);
 
     // Get PID context
@@ -1595,6 +1905,9 @@ void ts::TSAnalyzer::setBitrateHint(const BitRate& bitrate)
 
 void ts::TSAnalyzer::recomputeStatistics()
 {
+    // Collect the results of the PES analysis threads, if any.
+    syncPESWorkers();
+
     // Don't do anything if not necessary
     if (!_modified) {
         return;
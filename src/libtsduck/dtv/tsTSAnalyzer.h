@@ -50,6 +50,7 @@
 #include "tsTime.h"
 #include "tsUString.h"
 #include "tsSafePtr.h"
+#include "tsPIDMap.h"
 
 namespace ts {
     //!
@@ -123,6 +124,17 @@ namespace ts {
             _max_consecutive_suspects = count;
         }
 
+        //!
+        //! Set the number of worker threads for the analysis of audio and video PES packets.
+        //! By default, PES packets are analyzed in the caller's thread, inside feedPacket().
+        //! With worker threads, each PID is assigned to one worker thread which demuxes
+        //! and analyzes its PES packets. The analysis results are identical.
+        //! This method should be called before feeding the first packet. If the
+        //! number of threads is changed, the analysis of PES packets restarts.
+        //! @param [in] count Number of worker threads. Zero or one means no worker thread.
+        //!
+        void setAnalysisThreads(size_t count);
+
         //!
         //! Get the list of service ids.
         //! @param [out] list The returned list of service ids.
@@ -399,7 +411,7 @@ namespace ts {
         //!
         //! Map of PIDContext, indexed by PID.
         //!
-        typedef std::map<PID, PIDContextPtr> PIDContextMap;
+        typedef PIDMap<PIDContextPtr> PIDContextMap;
 
         //!
         //! Check if a PID context exists.
@@ -481,6 +493,18 @@ namespace ts {
         // Reset the section demux.
         void resetSectionDemux();
 
+        // A worker thread demuxing and analyzing PES packets on a subset of the PID's.
+        class PESWorker;
+
+        // Pass a packet to the PES worker threads.
+        void feedPESWorkers(const TSPacket& pkt);
+
+        // Wait for all PES worker threads to complete their pending packets and collect their results.
+        void syncPESWorkers();
+
+        // Reset PES analysis.
+        void resetPESAnalysis();
+
         // Analyze the various PSI tables
         void analyzePAT(const PAT&);
         void analyzeCAT(const CAT&);
@@ -532,5 +556,8 @@ namespace ts {
         SectionDemux _demux;                     // PSI tables analysis
         PESDemux     _pes_demux;                 // Audio/video analysis
         T2MIDemux    _t2mi_demux;                // T2-MI analysis
+        std::vector<PESWorker*> _pes_workers;    // PES analysis threads, empty in sequential mode
+        std::vector<size_t>     _pes_worker_of;  // Index of PES worker for each PID (NPOS if not yet assigned)
+        PIDSet                  _pes_all_pids;   // PID's which are passed to all PES workers (PAT, PMT's)
     };
 }
@@ -56,7 +56,8 @@ ts::TSAnalyzerOptions::TSAnalyzerOptions() :
     prefix(),
     title(),
     suspect_min_error_count(1),
-    suspect_max_consecutive(1)
+    suspect_max_consecutive(1),
+    threads(0)
 {
 }
 
@@ -174,6 +175,15 @@ void ts::TSAnalyzerOptions::defineArgs(Args& args) const
               u"(see option --suspect-min-error-count)\n"
               u"- it immediately follows no more than the specified number consecutive "
               u"suspect packets.");
+
+    args.option(u"threads", 0, Args::INTEGER, 0, 1, 0, 64);
+    args.help(u"threads", u"count",
+              u"Number of worker threads for the analysis of audio and video PES packets. "
+              u"Each worker thread is in charge of a subset of the PID's. "
+              u"The result of the analysis is identical to the default sequential analysis. "
+              u"This can significantly speed up the analysis of large files with many audio "
+              u"and video streams on multi-core systems. "
+              u"By default, all PES packets are analyzed in the same thread as the rest of the analysis.");
 }
 
 
@@ -202,6 +212,7 @@ bool ts::TSAnalyzerOptions::loadArgs(DuckContext& duck, Args& args)
     args.getValue(title, u"title");
     args.getIntValue(suspect_min_error_count, u"suspect-min-error-count", 1);
     args.getIntValue(suspect_max_consecutive, u"suspect-max-consecutive", 1);
+    args.getIntValue(threads, u"threads", 0);
 
     bool ok = json.loadArgs(duck, args);
 
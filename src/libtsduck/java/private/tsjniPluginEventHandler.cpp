@@ -28,7 +28,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsjniPluginEventHandler.h"
-#include "tsPluginEventData.h"
+#include "tsPluginEventPacketData.h"
 
 #if !defined(TS_NO_JAVA)
 
@@ -36,14 +36,18 @@
 // Constructors and destructors.
 //----------------------------------------------------------------------------
 
-ts::jni::PluginEventHandler::PluginEventHandler(JNIEnv* env, jobject obj, jstring handle_method) :
+ts::jni::PluginEventHandler::PluginEventHandler(JNIEnv* env, jobject obj, jstring handle_method, bool zero_copy) :
     _valid(false),
+    _zero_copy(zero_copy),
     _env(env),
     _obj_ref(env == nullptr || obj == nullptr ? nullptr : env->NewGlobalRef(obj)),
     _obj_method(nullptr),
     _pec_class(nullptr),
     _pec_constructor(nullptr),
-    _pec_outdata(nullptr)
+    _pec_outdata(nullptr),
+    _pec_outsize(nullptr),
+    _pec_buffer(nullptr),
+    _pec_evdata(nullptr)
 {
     if (_obj_ref != nullptr) {
         const char* const handle_str = env->GetStringUTFChars(handle_method, nullptr);
@@ -65,9 +69,15 @@ ts::jni::PluginEventHandler::PluginEventHandler(JNIEnv* env, jobject obj, jstrin
             _pec_constructor = env->GetMethodID(_pec_class, JCS_CONSTRUCTOR, "(" JCS_INT JCS_STRING JCS_INT JCS_INT JCS_INT JCS_LONG JCS_LONG JCS_BOOLEAN JCS_INT ")" JCS_VOID);
             // Get the id of the private field "byte[] _outputData":
             _pec_outdata = env->GetFieldID(_pec_class, "_outputData", JCS_ARRAY(JCS_BYTE));
+            // Get the ids of the private fields for direct access to the event data:
+            // "int _outputDataSize", "java.nio.ByteBuffer _buffer", "long _eventData".
+            _pec_outsize = env->GetFieldID(_pec_class, "_outputDataSize", JCS_INT);
+            _pec_buffer = env->GetFieldID(_pec_class, "_buffer", JCS(JCN_BYTE_BUFFER));
+            _pec_evdata = env->GetFieldID(_pec_class, "_eventData", JCS_LONG);
         }
     }
-    _valid = _env != nullptr && _obj_ref != nullptr && _obj_method != nullptr && _pec_class != nullptr && _pec_constructor != nullptr && _pec_outdata != nullptr;
+    _valid = _env != nullptr && _obj_ref != nullptr && _obj_method != nullptr && _pec_class != nullptr && _pec_constructor != nullptr &&
+        _pec_outdata != nullptr && _pec_outsize != nullptr && _pec_buffer != nullptr && _pec_evdata != nullptr;
 }
 
 ts::jni::PluginEventHandler::~PluginEventHandler()
@@ -82,6 +92,9 @@ ts::jni::PluginEventHandler::~PluginEventHandler()
             _pec_class = nullptr;
             _pec_constructor = nullptr;
             _pec_outdata = nullptr;
+            _pec_outsize = nullptr;
+            _pec_buffer = nullptr;
+            _pec_evdata = nullptr;
         }
     }
 }
@@ -113,18 +126,46 @@ void ts::jni::PluginEventHandler::handlePluginEvent(const PluginEventContext& co
                                            jboolean(read_only_data),
                                            jint(max_data_size));
 
-        // Build a Java bytes[] containing the plugin data.
-        const jbyteArray jdata = env->NewByteArray(data_size);
-        if (jdata != nullptr && valid_data && data_size > 0) {
-            env->SetByteArrayRegion(jdata, 0, data_size, reinterpret_cast<const jbyte*>(event_data->data()));
+        // In zero-copy mode, the Java handler directly accesses the event data buffer. Otherwise,
+        // build a Java bytes[] containing the plugin data.
+        jbyteArray jdata = nullptr;
+        jobject jbuffer = nullptr;
+        if (_zero_copy) {
+            if (pec != nullptr && valid_data) {
+                // With read-only data, the buffer is made read-only on Java side.
+                void* const addr = read_only_data ? const_cast<uint8_t*>(event_data->data()) : event_data->outputData();
+                const jlong capacity = read_only_data ? jlong(data_size) : jlong(max_data_size);
+                if (capacity > 0) {
+                    jbuffer = env->NewDirectByteBuffer(addr, capacity);
+                }
+                env->SetObjectField(pec, _pec_buffer, jbuffer);
+                env->SetLongField(pec, _pec_evdata, reinterpret_cast<jlong>(event_data));
+            }
+        }
+        else {
+            jdata = env->NewByteArray(data_size);
+            if (jdata != nullptr && valid_data && data_size > 0) {
+                env->SetByteArrayRegion(jdata, 0, data_size, reinterpret_cast<const jbyte*>(event_data->data()));
+            }
         }
 
         // Call the Java event handler.
         jboolean success = true;
-        if (pec != nullptr && jdata != nullptr) {
+        if (pec != nullptr && (_zero_copy || jdata != nullptr)) {
             success = env->CallBooleanMethod(_obj_ref, _obj_method, pec, jdata);
         }
 
+        // In zero-copy mode, the size of the data which were directly written in the buffer, if any.
+        if (_zero_copy && pec != nullptr) {
+            const jint outsize = env->GetIntField(pec, _pec_outsize);
+            if (success && valid_data && !read_only_data && outsize >= 0 && outsize <= max_data_size) {
+                event_data->updateSize(size_t(outsize));
+            }
+            // The event data are no longer accessible from the Java context.
+            env->SetObjectField(pec, _pec_buffer, nullptr);
+            env->SetLongField(pec, _pec_evdata, 0);
+        }
+
         // If the event data are modifiable, check if the Java handler set some output data.
         if (success && valid_data && !read_only_data) {
             const jbyteArray joutdata = jbyteArray(env->GetObjectField(pec, _pec_outdata));
@@ -140,6 +181,9 @@ void ts::jni::PluginEventHandler::handlePluginEvent(const PluginEventContext& co
         }
 
         // Free local references.
+        if (jbuffer != nullptr) {
+            env->DeleteLocalRef(jbuffer);
+        }
         if (jdata != nullptr) {
             env->DeleteLocalRef(jdata);
         }
@@ -163,14 +207,14 @@ void ts::jni::PluginEventHandler::handlePluginEvent(const PluginEventContext& co
 //----------------------------------------------------------------------------
 
 //
-// private native void initNativeObject(String methodName);
+// private native void initNativeObject(String methodName, boolean zeroCopy);
 //
-TSDUCKJNI void JNICALL Java_io_tsduck_AbstractPluginEventHandler_initNativeObject(JNIEnv* env, jobject obj, jstring method)
+TSDUCKJNI void JNICALL Java_io_tsduck_AbstractPluginEventHandler_initNativeObject(JNIEnv* env, jobject obj, jstring method, jboolean zero_copy)
 {
     // Make sure we do not allocate twice (and lose previous instance).
     ts::jni::PluginEventHandler* handler = ts::jni::GetPointerField<ts::jni::PluginEventHandler>(env, obj, "nativeObject");
     if (env != nullptr && handler == nullptr) {
-        ts::jni::SetPointerField(env, obj, "nativeObject", new ts::jni::PluginEventHandler(env, obj, method));
+        ts::jni::SetPointerField(env, obj, "nativeObject", new ts::jni::PluginEventHandler(env, obj, method, bool(zero_copy)));
     }
 }
 
@@ -186,4 +230,47 @@ TSDUCKJNI void JNICALL Java_io_tsduck_AbstractPluginEventHandler_delete(JNIEnv*
     }
 }
 
+
+
+//----------------------------------------------------------------------------
+// Implementation of native methods of Java class io.tsduck.PluginEventContext
+//----------------------------------------------------------------------------
+
+//
+// private native int getLabels(int index);
+//
+TSDUCKJNI jint JNICALL Java_io_tsduck_PluginEventContext_getLabels(JNIEnv* env, jobject obj, jint index)
+{
+    const ts::PluginEventPacketData* data = dynamic_cast<const ts::PluginEventPacketData*>(ts::jni::GetPointerField<ts::PluginEventData>(env, obj, "_eventData"));
+    const ts::TSPacketMetadata* mdata = data == nullptr || index < 0 ? nullptr : data->packetMetadata(size_t(index));
+    return mdata == nullptr ? 0 : jint(mdata->getLabels().to_ulong());
+}
+
+//
+// private native boolean setLabels(int index, int labels);
+//
+TSDUCKJNI jboolean JNICALL Java_io_tsduck_PluginEventContext_setLabels(JNIEnv* env, jobject obj, jint index, jint labels)
+{
+    const ts::PluginEventPacketData* data = dynamic_cast<const ts::PluginEventPacketData*>(ts::jni::GetPointerField<ts::PluginEventData>(env, obj, "_eventData"));
+    ts::TSPacketMetadata* mdata = data == nullptr || index < 0 ? nullptr : data->outputPacketMetadata(size_t(index));
+    if (mdata == nullptr) {
+        return false;
+    }
+    else {
+        mdata->clearAllLabels();
+        mdata->setLabels(ts::TSPacketMetadata::LabelSet(uint32_t(labels)));
+        return true;
+    }
+}
+
+//
+// private native long getInputTimeStamp(int index);
+//
+TSDUCKJNI jlong JNICALL Java_io_tsduck_PluginEventContext_getInputTimeStamp(JNIEnv* env, jobject obj, jint index)
+{
+    const ts::PluginEventPacketData* data = dynamic_cast<const ts::PluginEventPacketData*>(ts::jni::GetPointerField<ts::PluginEventData>(env, obj, "_eventData"));
+    const ts::TSPacketMetadata* mdata = data == nullptr || index < 0 ? nullptr : data->packetMetadata(size_t(index));
+    return mdata == nullptr || !mdata->hasInputTimeStamp() ? -1 : jlong(mdata->getInputTimeStamp());
+}
+
 #endif // TS_NO_JAVA
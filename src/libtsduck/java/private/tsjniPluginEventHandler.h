@@ -58,8 +58,11 @@ namespace ts {
             //! @code
             //! boolean handlePluginEvent(PluginEventContext context, byte[] data);
             //! @endcode
+            //! @param [in] zero_copy If true, the event data are not copied into a Java byte array.
+            //! The @a data parameter of the Java method is null and the Java handler directly accesses
+            //! the event data buffer as a direct java.nio.ByteBuffer in the PluginEventContext.
             //!
-            PluginEventHandler(JNIEnv* env, jobject obj, jstring handle_method);
+            PluginEventHandler(JNIEnv* env, jobject obj, jstring handle_method, bool zero_copy = false);
 
             //!
             //! Destructor.
@@ -72,12 +75,16 @@ namespace ts {
             virtual void handlePluginEvent(const PluginEventContext& context) override;
 
             bool      _valid;            // If true, all JNI references are valid.
+            bool      _zero_copy;        // Direct access to event data, without copy.
             JNIEnv*   _env;              // JNI environment in the thread which called the constructor.
             jobject   _obj_ref;          // Global JNI reference to the Java object to notify.
             jmethodID _obj_method;       // Method to handle events in the Java object.
             jclass    _pec_class;        // Global reference to Java class io.tsduck.PluginEventContext
             jmethodID _pec_constructor;  // Constructor method to create a io.tsduck.PluginEventContext
             jfieldID  _pec_outdata;      // Internal private field "_outputData" in io.tsduck.PluginEventContext
+            jfieldID  _pec_outsize;      // Internal private field "_outputDataSize" in io.tsduck.PluginEventContext
+            jfieldID  _pec_buffer;       // Internal private field "_buffer" in io.tsduck.PluginEventContext
+            jfieldID  _pec_evdata;       // Internal private field "_eventData" in io.tsduck.PluginEventContext
         };
     }
 }
@@ -108,6 +108,7 @@ TSDUCKJNI jboolean JNICALL Java_io_tsduck_TSProcessor_start(JNIEnv* env, jobject
     ts::TSProcessorArgs args;
     args.ignore_jt = ts::jni::GetBoolField(env, obj, "ignoreJointTermination");
     args.log_plugin_index = ts::jni::GetBoolField(env, obj, "logPluginIndex");
+    args.lock_free = ts::jni::GetBoolField(env, obj, "lockFree");
     args.ts_buffer_size = size_t(std::max<jint>(0, ts::jni::GetIntField(env, obj, "bufferSize")));
     if (args.ts_buffer_size == 0) {
         args.ts_buffer_size = ts::TSProcessorArgs::DEFAULT_BUFFER_SIZE;
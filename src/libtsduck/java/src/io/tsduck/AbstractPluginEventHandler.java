@@ -38,13 +38,23 @@ public abstract class AbstractPluginEventHandler extends NativeObject {
     /*
      * Set the address of the C++ object.
      */
-    private native void initNativeObject(String handlerMethodName);
+    private native void initNativeObject(String handlerMethodName, boolean zeroCopy);
 
     /**
      * Constructor (for subclasses).
      */
     protected AbstractPluginEventHandler() {
-        initNativeObject("handlePluginEvent");
+        this(false);
+    }
+
+    /**
+     * Constructor (for subclasses).
+     * @param zeroCopy If true, the event data are not copied into a Java byte array.
+     * The @a data parameter of @a handlePluginEvent() is null and the event data are
+     * directly accessed using @a context.acquireBuffer().
+     */
+    protected AbstractPluginEventHandler(boolean zeroCopy) {
+        initNativeObject("handlePluginEvent", zeroCopy);
     }
 
     /**
@@ -67,6 +77,7 @@ public abstract class AbstractPluginEventHandler extends NativeObject {
      * @param context An instance of PluginEventContext containing the details of the event.
      * @param data A byte array containing the data of the event. This is a read-only
      * sequence of bytes. There is no way to return data from Java to the plugin.
+     * In zero-copy mode, this parameter is null.
      * @return True in case of success, false to set the error indicator of the event.
      */
     abstract public boolean handlePluginEvent(PluginEventContext context, byte[] data);
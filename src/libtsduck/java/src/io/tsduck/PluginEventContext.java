@@ -29,6 +29,8 @@
 
 package io.tsduck;
 
+import java.nio.ByteBuffer;
+
 /**
  * Context of a plugin event.
  * Each time a plugin signals an event for the application, a PluginEventContext
@@ -48,6 +50,16 @@ public class PluginEventContext {
     private int     _maxDataSize = 0;
     private byte[]  _outputData = null;
 
+    // Direct access to the event data, set by the native event handler in zero-copy mode.
+    private ByteBuffer _buffer = null;
+    private int        _outputDataSize = -1;
+    private long       _eventData = 0;
+
+    // Access to packet metadata in the native event data.
+    private native int getLabels(int index);
+    private native boolean setLabels(int index, int labels);
+    private native long getInputTimeStamp(int index);
+
     /**
      * Constructor.
      *
@@ -169,4 +181,78 @@ public class PluginEventContext {
     public byte[] outputData() {
         return _outputData;
     }
+
+    /**
+     * Get a direct access to the event data buffer, without copy.
+     *
+     * This is available only when the event handler was created in zero-copy mode.
+     * With the @e memory input and output plugins, the event data buffer is a range of
+     * the tsp packet buffer. If the event data are read-only, the returned buffer is
+     * read-only and contains the event data. Otherwise, it is writable and its capacity
+     * is @a maxDataSize(). The returned TS packets shall be written in the buffer and
+     * their size shall be set using @a releaseBuffer().
+     *
+     * The returned buffer is valid only until the event handler returns. After that,
+     * the memory belongs to tsp again and the buffer shall no longer be used.
+     *
+     * @return A direct byte buffer on the event data or null if there is no data.
+     */
+    public ByteBuffer acquireBuffer() {
+        if (_buffer == null) {
+            return null;
+        }
+        else {
+            return _readOnlyData ? _buffer.asReadOnlyBuffer() : _buffer.duplicate();
+        }
+    }
+
+    /**
+     * Set the size of the event returned data which were directly written in the buffer.
+     * @param size New size in bytes of the event data, as written in the buffer returned
+     * by @a acquireBuffer(). Typically, with the @e memory input plugin, this is the size
+     * of the returned TS packets.
+     * @return True on success, false if the event data are read-only or the size is invalid.
+     */
+    public boolean releaseBuffer(int size) {
+        if (_readOnlyData || _buffer == null || size < 0 || size > _maxDataSize) {
+            return false;
+        }
+        else {
+            _outputDataSize = size;
+            return true;
+        }
+    }
+
+    /**
+     * Get the labels of a TS packet in the event data.
+     * Labels are set by plugins on TS packets, for instance using the plugin "filter".
+     * This is available with the @e memory input and output plugins in zero-copy mode only.
+     * @param index Index of the TS packet in the event data.
+     * @return A bit mask of labels (bit 0 = label 0, etc.) or zero if there is no metadata for that packet.
+     */
+    public int packetLabels(int index) {
+        return _eventData == 0 ? 0 : getLabels(index);
+    }
+
+    /**
+     * Set the labels of a TS packet in the event data.
+     * This is available with the @e memory input plugin in zero-copy mode only. The labels
+     * of the input packets can be used by the next plugins in the tsp chain.
+     * @param index Index of the TS packet in the event data.
+     * @param labels A bit mask of labels (bit 0 = label 0, etc.)
+     * @return True on success, false if the event data are read-only or @a index is out of range.
+     */
+    public boolean setPacketLabels(int index, int labels) {
+        return _eventData != 0 && setLabels(index, labels);
+    }
+
+    /**
+     * Get the input timestamp of a TS packet in the event data.
+     * This is available with the @e memory output plugin in zero-copy mode only.
+     * @param index Index of the TS packet in the event data.
+     * @return The input timestamp in PCR units (27 MHz) or -1 if there is none.
+     */
+    public long packetInputTimestamp(int index) {
+        return _eventData == 0 ? -1 : getInputTimeStamp(index);
+    }
 }
@@ -45,6 +45,7 @@ public final class TSProcessor extends PluginEventHandlerRegistry {
      */
     public boolean ignoreJointTermination = false;  //!< Option -\-ignore-joint-termination
     public boolean logPluginIndex = false;          //!< Option -\-log-plugin-index
+    public boolean lockFree = false;                //!< Option -\-lock-free
     public int bufferSize = 16 * 1024 * 1024;       //!< Option -\-buffer-size-mb (in bytes here)
     public int maxFlushedPackets = 0;               //!< Option -\-max-flushed-packets (zero means default)
     public int maxInputPackets = 0;                 //!< Option -\-max-input-packets (zero means default)
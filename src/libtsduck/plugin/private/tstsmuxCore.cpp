@@ -54,6 +54,7 @@ ts::tsmux::Core::Core(const MuxerArgs& opt, const PluginEventHandlerRegistry& ha
     _inputs(_opt.inputs.size(), nullptr),
     _output(_opt, handlers, _log),
     _terminated_inputs(),
+    _sched_candidates(_inputs.size(), false),
     _pat_pzer(_duck, PID_PAT, CyclingPacketizer::StuffingPolicy::ALWAYS),
     _cat_pzer(_duck, PID_CAT, CyclingPacketizer::StuffingPolicy::ALWAYS),
     _nit_pzer(_duck, PID_NIT, CyclingPacketizer::StuffingPolicy::ALWAYS),
@@ -248,6 +249,10 @@ void ts::tsmux::Core::main()
 
     // Next input plugin to read from.
     size_t input_index = 0;
+    for (size_t i = 0; i < _inputs.size(); ++i) {
+        _inputs[i]->resetSchedule();
+    }
+    const bool deadline_scheduling = _opt.scheduling == MuxScheduling::DEADLINE;
 
     // Reset output packet counter.
     _output_packets = 0;
@@ -291,7 +296,7 @@ void ts::tsmux::Core::main()
                 // Got an SDT packet.
                 next_sdt_packet += sdt_interval;
             }
-            else if (getInputPacket(input_index, pkt, pkt_data)) {
+            else if (deadline_scheduling ? getScheduledInputPacket(input_index, pkt, pkt_data) : getInputPacket(input_index, pkt, pkt_data)) {
                 // Got a packet from an input plugin.
             }
             else if (_eit_pzer.getNextPacket(pkt)) {
@@ -340,16 +345,7 @@ bool ts::tsmux::Core::getInputPacket(size_t& input_index, TSPacket& pkt, TSPacke
     size_t plugin_count = 0;
     do {
         // Try to get a packet from current plugin.
-        success = _inputs[input_index]->getPacket(pkt, pkt_data);
-
-        // Keep track of terminated input plugins.
-        if (!success && _inputs[input_index]->isTerminated()) {
-            _terminated_inputs.insert(input_index);
-            if (_terminated_inputs.size() >= _inputs.size()) {
-                // All input plugins are now terminated. Request global termination.
-                _terminate = true;
-            }
-        }
+        success = getPacketFrom(input_index, pkt, pkt_data);
 
         // Point to next plugin.
         input_index = (input_index + 1) % _inputs.size();
@@ -358,6 +354,61 @@ bool ts::tsmux::Core::getInputPacket(size_t& input_index, TSPacket& pkt, TSPacke
     return success;
 }
 
+bool ts::tsmux::Core::getPacketFrom(size_t input_index, TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    const bool success = _inputs[input_index]->getPacket(pkt, pkt_data);
+
+    // Keep track of terminated input plugins.
+    if (!success && _inputs[input_index]->isTerminated()) {
+        _terminated_inputs.insert(input_index);
+        if (_terminated_inputs.size() >= _inputs.size()) {
+            // All input plugins are now terminated. Request global termination.
+            _terminate = true;
+        }
+    }
+    return success;
+}
+
+
+//----------------------------------------------------------------------------
+// Get a packet from the input plugins using deadline scheduling.
+//----------------------------------------------------------------------------
+
+bool ts::tsmux::Core::getScheduledInputPacket(size_t& input_index, TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    // Candidate inputs: the transport buffer model of which can accept one packet now.
+    // The rotating input index is only used to break ties between equal deadlines.
+    // The candidate buffer is allocated once, this function is called for each packet.
+    std::vector<bool>& candidate(_sched_candidates);
+    size_t candidate_count = 0;
+    for (size_t i = 0; i < _inputs.size(); ++i) {
+        candidate[i] = _inputs[i]->bufferReady();
+        if (candidate[i]) {
+            candidate_count++;
+        }
+    }
+
+    // Try candidates by earliest deadline, until one of them provides a packet.
+    while (!_terminate && candidate_count > 0) {
+        size_t best = NPOS;
+        for (size_t n = 0; n < _inputs.size(); ++n) {
+            const size_t i = (input_index + n) % _inputs.size();
+            if (candidate[i] && (best == NPOS || _inputs[i]->deadline() < _inputs[best]->deadline())) {
+                best = i;
+            }
+        }
+        assert(best != NPOS);
+        candidate[best] = false;
+        candidate_count--;
+        if (getPacketFrom(best, pkt, pkt_data)) {
+            _inputs[best]->packetScheduled();
+            input_index = (best + 1) % _inputs.size();
+            return true;
+        }
+    }
+    return false;
+}
+
 
 //----------------------------------------------------------------------------
 // Try to extract a UTC time from a TDT or TOT in one TS packet.
@@ -443,7 +494,11 @@ ts::tsmux::Core::Input::Input(Core& core, size_t index) :
     _next_insertion(0),
     _next_packet(),
     _next_metadata(),
-    _pid_clocks()
+    _pid_clocks(),
+    _pcr_analyzer(),
+    _tb_level(0.0),
+    _tb_update(0),
+    _deadline(0.0)
 {
     // Filter all global PSI/SI for merging in output PSI.
     _demux.addPID(PID_PAT);
@@ -499,6 +554,11 @@ bool ts::tsmux::Core::Input::getPacket(TSPacket& pkt, TSPacketMetadata& pkt_data
     }
     const PID pid = pkt.getPID();
 
+    // Evaluate the input bitrate for deadline scheduling.
+    if (_core._opt.scheduling == MuxScheduling::DEADLINE) {
+        _pcr_analyzer.feedPacket(pkt);
+    }
+
     // Feed the two PSI/SI demux.
     _demux.feedPacket(pkt);
     _eit_demux.feedPacket(pkt);
@@ -557,6 +617,51 @@ bool ts::tsmux::Core::Input::getPacket(TSPacket& pkt, TSPacketMetadata& pkt_data
 }
 
 
+//----------------------------------------------------------------------------
+// T-STD model of an input stream for deadline scheduling.
+//----------------------------------------------------------------------------
+
+constexpr size_t ts::tsmux::Core::Input::TB_SIZE;
+
+void ts::tsmux::Core::Input::resetSchedule()
+{
+    _pcr_analyzer.reset();
+    _tb_level = 0.0;
+    _tb_update = 0;
+    _deadline = 0.0;
+}
+
+bool ts::tsmux::Core::Input::bufferReady()
+{
+    if (!_pcr_analyzer.bitrateIsValid() || _core._bitrate == 0) {
+        // Input bitrate not yet known, no constraint.
+        return true;
+    }
+
+    // The transport buffer leaks at 1.2 times the input bitrate, as Rx in the T-STD.
+    // Compute the leaked bytes since last update, in output packet durations.
+    const double leak = 1.2 * double(PKT_SIZE) * _pcr_analyzer.bitrate188().toDouble() / _core._bitrate.toDouble();
+    _tb_level = std::max(0.0, _tb_level - leak * double(_core._output_packets - _tb_update));
+    _tb_update = _core._output_packets;
+    return _tb_level + double(PKT_SIZE) <= double(TB_SIZE);
+}
+
+void ts::tsmux::Core::Input::packetScheduled()
+{
+    const double now = double(_core._output_packets);
+    if (!_pcr_analyzer.bitrateIsValid() || _core._bitrate == 0) {
+        // Input bitrate not yet known, the next packet is due immediately.
+        _deadline = now;
+    }
+    else {
+        // The next packet is due one input packet duration later, in output packets.
+        // An input which has been starving catches up, within the limits of its transport buffer.
+        _deadline = std::max(_deadline, now - double(TB_SIZE / PKT_SIZE)) + _core._bitrate.toDouble() / _pcr_analyzer.bitrate188().toDouble();
+        _tb_level += double(PKT_SIZE);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Adjust the PCR of a packet before insertion.
 //----------------------------------------------------------------------------
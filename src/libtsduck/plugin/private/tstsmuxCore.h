@@ -41,6 +41,7 @@
 #include "tsSectionDemux.h"
 #include "tsCyclingPacketizer.h"
 #include "tsPCRMerger.h"
+#include "tsPCRAnalyzer.h"
 #include "tsPAT.h"
 #include "tsCAT.h"
 #include "tsSDT.h"
@@ -120,6 +121,7 @@ namespace ts {
             std::vector<Input*> _inputs;            // Input plugins threads.
             OutputExecutor      _output;            // Output plugin thread.
             std::set<size_t>    _terminated_inputs; // Set of terminated input plugins.
+            std::vector<bool>   _sched_candidates;  // Candidate inputs during deadline scheduling (one per input).
             CyclingPacketizer   _pat_pzer;          // Packetizer for output PAT.
             CyclingPacketizer   _cat_pzer;          // Packetizer for output CAT.
             CyclingPacketizer   _nit_pzer;          // Packetizer for output NIT's.
@@ -131,7 +133,7 @@ namespace ts {
             NIT                 _output_nit;        // NIT Actual for output stream.
             size_t              _max_eits;          // Maximum number of buffered EIT sections.
             std::list<SectionPtr>     _eits;            // List of EIT sections to insert.
-            std::map<PID,Origin>      _pid_origin;      // Map of PID's to original input stream.
+            PIDMap<Origin>            _pid_origin;      // Map of PID's to original input stream.
             std::map<uint16_t,Origin> _service_origin;  // Map of service ids to original input stream.
 
             // Implementation of Thread.
@@ -141,6 +143,13 @@ namespace ts {
             // Update the plugin index. Return false if all input plugins were tried without success.
             bool getInputPacket(size_t& input_index, TSPacket& pkt, TSPacketMetadata& pkt_data);
 
+            // Same with deadline scheduling: try the input plugins by earliest deadline, among
+            // those which can accept a packet in their transport buffer model.
+            bool getScheduledInputPacket(size_t& input_index, TSPacket& pkt, TSPacketMetadata& pkt_data);
+
+            // Get a packet from one input plugin, keep track of terminated plugins.
+            bool getPacketFrom(size_t input_index, TSPacket& pkt, TSPacketMetadata& pkt_data);
+
             // Try to extract a UTC time from a TDT or TOT in one TS packet.
             bool getUTC(Time& utc, const TSPacket& pkt);
 
@@ -180,6 +189,18 @@ namespace ts {
                 // Get one input packet. Return false when none is immediately available.
                 bool getPacket(TSPacket& pkt, TSPacketMetadata& pkt_data);
 
+                // Reset the T-STD model for deadline scheduling.
+                void resetSchedule();
+
+                // Check if the transport buffer model can accept one packet at the current output position.
+                bool bufferReady();
+
+                // Deadline of the next packet from this input, in output packets.
+                double deadline() const { return _deadline; }
+
+                // Update the T-STD model after inserting one packet from this input.
+                void packetScheduled();
+
             private:
                 Core&            _core;           // Reference to the parent Core.
                 const size_t     _plugin_index;   // Input plugin index.
@@ -194,7 +215,14 @@ namespace ts {
                 PacketCounter    _next_insertion; // Insertion point of next packet.
                 TSPacket         _next_packet;    // Next packet to insert if already received but not yet inserted.
                 TSPacketMetadata _next_metadata;  // Associated metadata.
-                std::map<PID,PIDClock> _pid_clocks;  // Output clock of each input PID.
+                PIDMap<PIDClock> _pid_clocks;  // Output clock of each input PID.
+                PCRAnalyzer      _pcr_analyzer;   // Evaluate the input bitrate, for deadline scheduling.
+                double           _tb_level;       // Occupancy in bytes of the transport buffer model.
+                PacketCounter    _tb_update;      // Output packet index of the last transport buffer update.
+                double           _deadline;       // Deadline of next packet, in output packets.
+
+                // Size of the transport buffer in the T-STD model.
+                static constexpr size_t TB_SIZE = 512;
 
                 // Adjust the PCR of a packet before insertion.
                 void adjustPCR(TSPacket& pkt);
@@ -75,6 +75,7 @@ ts::tsp::ControlServer::ControlServer(TSProcessorArgs& options, Report& log, Mut
     _reference.setCommandLineHandler(this, &ControlServer::executeExit, u"exit");
     _reference.setCommandLineHandler(this, &ControlServer::executeSetLog, u"set-log");
     _reference.setCommandLineHandler(this, &ControlServer::executeList, u"list");
+    _reference.setCommandLineHandler(this, &ControlServer::executeMetrics, u"metrics");
     _reference.setCommandLineHandler(this, &ControlServer::executeSuspend, u"suspend");
     _reference.setCommandLineHandler(this, &ControlServer::executeResume, u"resume");
     _reference.setCommandLineHandler(this, &ControlServer::executeRestart, u"restart");
@@ -164,6 +165,20 @@ void ts::tsp::ControlServer::main()
         else if (conn.setReceiveTimeout(_options.control_timeout, _log) && conn.receiveLine(line, nullptr, _log)) {
             _log.verbose(u"received from %s: %s", {source, line});
 
+            // An HTTP GET request is a request for performance metrics (typically from a Prometheus server).
+            // Skip the HTTP headers, up to the empty line, and return the metrics, whatever the URL is.
+            if (line.startWith(u"GET ")) {
+                UString header;
+                while (conn.receiveLine(header, nullptr, NULLREP) && !header.empty()) {
+                }
+                const std::string body(formatMetrics().toUTF8());
+                conn.send(UString::Format(u"HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: %d\r\n\r\n", {body.size()}), _log);
+                conn.send(body, _log);
+                conn.closeWriter(_log);
+                conn.close(_log);
+                continue;
+            }
+
             // Reset the severity of the connection before analysing the line.
             // A previous analysis may have used --verbose or --debug.
             conn.setMaxSeverity(Severity::Info);
@@ -269,6 +284,77 @@ void ts::tsp::ControlServer::listOnePlugin(size_t index, UChar type, PluginExecu
 }
 
 
+//----------------------------------------------------------------------------
+// Metrics command.
+//----------------------------------------------------------------------------
+
+ts::CommandStatus ts::tsp::ControlServer::executeMetrics(const UString& command, Args& args)
+{
+    UString text(formatMetrics());
+    text.trim(false, true);
+    args.info(text);
+    return CommandStatus::SUCCESS;
+}
+
+
+//----------------------------------------------------------------------------
+// Format the performance metrics of all plugins in Prometheus text format.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Add one metric, with one value per plugin.
+    void AddMetric(ts::UString& text, const ts::UChar* name, const ts::UChar* type, const ts::UChar* help, const ts::UStringVector& labels, const ts::UStringVector& values)
+    {
+        text.format(u"# HELP %s %s\n# TYPE %s %s\n", {name, help, name, type});
+        for (size_t i = 0; i < labels.size() && i < values.size(); ++i) {
+            text.format(u"%s{%s} %s\n", {name, labels[i], values[i]});
+        }
+    }
+
+    // Format a duration in seconds.
+    ts::UString Seconds(ts::NanoSecond ns)
+    {
+        return ts::UString::Format(u"%d.%09d", {ns / ts::NanoSecPerSec, ns % ts::NanoSecPerSec});
+    }
+}
+
+ts::UString ts::tsp::ControlServer::formatMetrics()
+{
+    // All plugins in chain order, using the same indexes as the "list" command.
+    std::vector<PluginExecutor*> plugins;
+    plugins.push_back(_input);
+    plugins.insert(plugins.end(), _plugins.begin(), _plugins.end());
+    plugins.push_back(_output);
+
+    // Get a snapshot of the metrics of all plugins.
+    UStringVector labels, packets, bytes, dropped, process, wait, buffered;
+    for (size_t i = 0; i < plugins.size(); ++i) {
+        PluginExecutor::Metrics metrics;
+        plugins[i]->getMetrics(metrics);
+        labels.push_back(UString::Format(u"index=\"%d\",plugin=\"%s\"", {i, plugins[i]->pluginName()}));
+        packets.push_back(UString::Decimal(metrics.packets, 0, true, UString()));
+        bytes.push_back(UString::Decimal(metrics.packets * PKT_SIZE, 0, true, UString()));
+        dropped.push_back(UString::Decimal(metrics.dropped, 0, true, UString()));
+        process.push_back(Seconds(metrics.process_time));
+        wait.push_back(Seconds(metrics.wait_time));
+        buffered.push_back(UString::Decimal(metrics.buffered, 0, true, UString()));
+    }
+
+    UString text;
+    text.format(u"# HELP tsp_buffer_size_packets Size of the global buffer in TS packets.\n"
+                u"# TYPE tsp_buffer_size_packets gauge\n"
+                u"tsp_buffer_size_packets %d\n",
+                {_options.ts_buffer_size / PKT_SIZE});
+    AddMetric(text, u"tsp_plugin_packets_total", u"counter", u"Number of TS packets which went through the plugin.", labels, packets);
+    AddMetric(text, u"tsp_plugin_bytes_total", u"counter", u"Number of bytes which went through the plugin.", labels, bytes);
+    AddMetric(text, u"tsp_plugin_dropped_packets_total", u"counter", u"Number of TS packets which were dropped by the plugin.", labels, dropped);
+    AddMetric(text, u"tsp_plugin_process_seconds_total", u"counter", u"Time spent by the plugin thread processing packets.", labels, process);
+    AddMetric(text, u"tsp_plugin_wait_seconds_total", u"counter", u"Time spent by the plugin thread waiting for packets or free buffer space.", labels, wait);
+    AddMetric(text, u"tsp_plugin_buffer_packets", u"gauge", u"Number of TS packets in the buffer of the plugin (free buffer space for the input plugin).", labels, buffered);
+    return text;
+}
+
+
 //----------------------------------------------------------------------------
 // Suspend/resume commands.
 //----------------------------------------------------------------------------
@@ -98,11 +98,16 @@ namespace ts {
             CommandStatus executeExit(const UString&, Args&);
             CommandStatus executeSetLog(const UString&, Args&);
             CommandStatus executeList(const UString&, Args&);
+            CommandStatus executeMetrics(const UString&, Args&);
             void listOnePlugin(size_t index, UChar type, PluginExecutor* plugin, Report& report);
             CommandStatus executeSuspend(const UString&, Args&);
             CommandStatus executeResume(const UString&, Args&);
             CommandStatus executeSuspendResume(bool state, Args&);
             CommandStatus executeRestart(const UString&, Args&);
+
+            // Format the performance metrics of all plugins in Prometheus text format.
+            // Each line is terminated with a new-line character.
+            UString formatMetrics();
         };
     }
 }
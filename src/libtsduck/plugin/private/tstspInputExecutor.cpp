@@ -112,16 +112,18 @@ bool ts::tsp::InputExecutor::initAllBuffers(PacketBuffer* buffer, PacketMetadata
         verbose(u"initial input bitrate is %'d b/s", {init_bitrate});
     }
 
-    // Indicate that the loaded packets are now available to the next packet processor.
-    PluginExecutor* next = ringNext<PluginExecutor>();
-    next->initBuffer(buffer, metadata, 0, pkt_read, pkt_read == 0, pkt_read == 0, init_bitrate);
+    // Indicate that the loaded packets are now available to the next packet processor
+    // (or to all processors of a group of parallel branches).
+    for (auto it = _next_set.begin(); it != _next_set.end(); ++it) {
+        (*it)->initBuffer(buffer, metadata, 0, pkt_read, pkt_read == 0, pkt_read == 0, init_bitrate);
+    }
 
     // The rest of the buffer belongs to this input processor for reading additional packets.
     initBuffer(buffer, metadata, pkt_read % buffer->count(), buffer->count() - pkt_read, pkt_read == 0, pkt_read == 0, init_bitrate);
 
     // All other processors have an implicit empty buffer (_pkt_first and _pkt_cnt are zero).
     // Propagate initial input bitrate to all processors
-    while ((next = next->ringNext<PluginExecutor>()) != this) {
+    for (PluginExecutor* next = _next_set.back()->ringNext<PluginExecutor>(); next != this; next = next->ringNext<PluginExecutor>()) {
         next->initBuffer(buffer, metadata, 0, 0, pkt_read == 0, pkt_read == 0, init_bitrate);
     }
 
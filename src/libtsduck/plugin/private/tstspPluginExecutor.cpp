@@ -32,6 +32,9 @@
 #include "tsGuardCondition.h"
 #include "tsGuardMutex.h"
 
+// In lock-free mode, number of polling iterations before parking an idle thread.
+#define LOCK_FREE_SPIN_COUNT 64
+
 
 //----------------------------------------------------------------------------
 // Constructors and destructors.
@@ -50,6 +53,7 @@ ts::tsp::PluginExecutor::PluginExecutor(const TSProcessorArgs& options,
     _buffer(nullptr),
     _metadata(nullptr),
     _suspended(false),
+    _next_set(),
     _handlers(handlers),
     _to_do(),
     _pkt_first(0),
@@ -57,7 +61,27 @@ ts::tsp::PluginExecutor::PluginExecutor(const TSProcessorArgs& options,
     _input_end(false),
     _bitrate(0),
     _restart(false),
-    _restart_data()
+    _restart_data(),
+    _local_mutex(),
+    _pkt_out(0),
+    _pkt_base(0),
+    _lf_input_end(false),
+    _parked(false),
+    _bitrate_seq(0),
+    _bitrate_seen(0),
+    _bitrate_cache(0),
+    _passed_bitrate(0),
+    _branch_first(nullptr),
+    _branch_last(nullptr),
+    _branch_released(0),
+    _branch_end(false),
+    _previous_set(),
+    _metrics_packets(0),
+    _metrics_dropped(0),
+    _metrics_process(0),
+    _metrics_wait(0),
+    _metrics_start(),
+    _metrics_now()
 {
     // Preset common default options.
     if (plugin() != nullptr) {
@@ -99,9 +123,144 @@ void ts::tsp::PluginExecutor::signalPluginEvent(uint32_t event_code, Object* plu
 
 void ts::tsp::PluginExecutor::setAbort()
 {
-    GuardMutex lock(_global_mutex);
-    _tsp_aborting = true;
-    ringPrevious<PluginExecutor>()->_to_do.signal();
+    if (_options.lock_free) {
+        _tsp_aborting = true;
+        wakeOnAbort();
+    }
+    else {
+        GuardMutex lock(_global_mutex);
+        _tsp_aborting = true;
+        wakeOnAbort();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Parallel branches and neighbours in the chain.
+// Executed in synchronous environment, before starting all executor threads.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::setBranch(PluginExecutor* first, PluginExecutor* last)
+{
+    _branch_first = first;
+    _branch_last = last;
+}
+
+void ts::tsp::PluginExecutor::initNeighbours()
+{
+    // Next executors: the next one in the ring or all executors of the next group.
+    _next_set.clear();
+    PluginExecutor* proc = (_branch_last != nullptr ? _branch_last : this)->ringNext<PluginExecutor>();
+    if (proc->_branch_first == nullptr) {
+        _next_set.push_back(proc);
+    }
+    else {
+        for (;;) {
+            _next_set.push_back(proc);
+            if (proc == proc->_branch_last) {
+                break;
+            }
+            proc = proc->ringNext<PluginExecutor>();
+        }
+    }
+
+    // Previous executors: the previous one in the ring or all executors of the previous group.
+    _previous_set.clear();
+    proc = (_branch_first != nullptr ? _branch_first : this)->ringPrevious<PluginExecutor>();
+    if (proc->_branch_last == nullptr) {
+        _previous_set.push_back(proc);
+    }
+    else {
+        for (proc = proc->_branch_first; ; proc = proc->ringNext<PluginExecutor>()) {
+            _previous_set.push_back(proc);
+            if (proc == proc->_branch_last) {
+                break;
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Check if any of the next executors is aborting.
+//----------------------------------------------------------------------------
+
+bool ts::tsp::PluginExecutor::nextAborting() const
+{
+    for (auto it = _next_set.begin(); it != _next_set.end(); ++it) {
+        if ((*it)->_tsp_aborting) {
+            return true;
+        }
+    }
+    // In a group of branches, stop when another branch aborts. Otherwise, the group
+    // would never release its end of input since the input plugin silently stops.
+    for (PluginExecutor* proc = _branch_first; proc != nullptr; proc = proc == _branch_last ? nullptr : proc->ringNext<PluginExecutor>()) {
+        if (proc != this && proc->_tsp_aborting) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Wake up the previous executors and the other branches of our group when aborting.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::wakeOnAbort()
+{
+    for (auto it = _previous_set.begin(); it != _previous_set.end(); ++it) {
+        (*it)->wakeUp(false);
+    }
+    for (PluginExecutor* proc = _branch_first; proc != nullptr; proc = proc == _branch_last ? nullptr : proc->ringNext<PluginExecutor>()) {
+        if (proc != this) {
+            proc->wakeUp(false);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// In a group of branches, minimum number of passed packets and common end of input.
+//----------------------------------------------------------------------------
+
+ts::PacketCounter ts::tsp::PluginExecutor::branchPassed(bool& input_end) const
+{
+    // The end of input flags are read before the packet counters, see passPacketsLockFree().
+    input_end = true;
+    for (PluginExecutor* proc = _branch_first; ; proc = proc->ringNext<PluginExecutor>()) {
+        input_end = input_end && proc->_branch_end;
+        if (proc == _branch_last) {
+            break;
+        }
+    }
+    PacketCounter passed = _pkt_out;
+    for (PluginExecutor* proc = _branch_first; ; proc = proc->ringNext<PluginExecutor>()) {
+        passed = std::min<PacketCounter>(passed, proc->_pkt_out);
+        if (proc == _branch_last) {
+            break;
+        }
+    }
+    return passed;
+}
+
+
+//----------------------------------------------------------------------------
+// Wake up the executor thread if it waits for something to do.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::wakeUp(bool parked_only)
+{
+    if (!_options.lock_free) {
+        // The caller holds the global mutex.
+        _to_do.signal();
+    }
+    else if (!parked_only || _parked) {
+        // The thread is parked or about to be parked, while holding its local mutex.
+        // Acquiring the local mutex guarantees that the signal is not lost.
+        GuardMutex lock(_local_mutex);
+        _to_do.signal();
+    }
 }
 
 
@@ -138,6 +297,21 @@ void ts::tsp::PluginExecutor::initBuffer(PacketBuffer*  buffer,
     _tsp_aborting = aborted;
     _bitrate = bitrate;
     _tsp_bitrate = bitrate;
+    _branch_released = 0;
+    _branch_end = false;
+
+    // Initial state of the lock-free cursors.
+    _pkt_out = 0;
+    _pkt_base = pkt_cnt;
+    _lf_input_end = input_end;
+    _bitrate_seq = 0;
+    _bitrate_seen = 0;
+    _bitrate_cache = bitrate;
+    _passed_bitrate = bitrate;
+
+    // The initial packets which were loaded by the input plugin were not passed through passPackets().
+    _metrics_packets = plugin()->type() == PluginType::INPUT ? buffer->count() - pkt_cnt : 0;
+    _metrics_start.getSystemTime();
 }
 
 
@@ -151,6 +325,12 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
 
     log(10, u"passPackets(count = %'d, bitrate = %'d, input_end = %s, aborted = %s)", {count, bitrate, input_end, aborted});
 
+    _metrics_packets += count;
+
+    if (_options.lock_free) {
+        return passPacketsLockFree(count, bitrate, input_end, aborted);
+    }
+
     // We access data under the protection of the global mutex.
     GuardMutex lock(_global_mutex);
 
@@ -158,29 +338,31 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
     _pkt_first = (_pkt_first + count) % _buffer->count();
     _pkt_cnt -= count;
 
-    // Update next processor's buffer: add 'count' packets at the end of its slice of the buffer.
-    PluginExecutor* next = ringNext<PluginExecutor>();
-    next->_pkt_cnt += count;
-
-    // Propagate bitrate and end of input flag to next processor.
-    next->_bitrate = bitrate;
-    next->_input_end = next->_input_end || input_end;
-
-    // Wake the next processor when there is some new input data or end of input.
-    if (count > 0 || input_end) {
-        next->_to_do.signal();
+    if (_branch_first == nullptr) {
+        // Update next processor's buffer: add 'count' packets at the end of its slice of the buffer.
+        passToNext(count, bitrate, input_end);
+    }
+    else {
+        // In a group of branches, the packets are released when all branches have passed them.
+        _pkt_out += count;
+        _branch_end = _branch_end || input_end;
+        bool group_end = false;
+        const PacketCounter passed = branchPassed(group_end);
+        const size_t released = size_t(passed - _branch_first->_branch_released);
+        _branch_first->_branch_released = passed;
+        passToNext(released, bitrate, group_end);
     }
 
     // Force to abort our processor when the next one is aborting. Already done in waitWork() but force immediately.
     // Don't do that if current is output and next is input because there is no propagation of packets from output back to input.
     if (plugin()->type() != PluginType::OUTPUT) {
-        aborted = aborted || next->_tsp_aborting;
+        aborted = aborted || nextAborting();
     }
 
-    // Wake the previous processor when we abort (propagate abort conditions backward).
+    // Wake the previous processors when we abort (propagate abort conditions backward).
     if (aborted) {
         _tsp_aborting = true; // volatile bool in TSP superclass
-        ringPrevious<PluginExecutor>()->_to_do.signal();
+        wakeOnAbort();
     }
 
     // Return false when the current processor shall stop.
@@ -188,6 +370,30 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, const BitRate& bitrate,
 }
 
 
+//----------------------------------------------------------------------------
+// Pass packets and end of input to the next executors (global mutex mode).
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::passToNext(size_t count, const BitRate& bitrate, bool input_end)
+{
+    for (auto it = _next_set.begin(); it != _next_set.end(); ++it) {
+        PluginExecutor* next = *it;
+
+        // Add 'count' packets at the end of the slice of the buffer of the next processor.
+        next->_pkt_cnt += count;
+
+        // Propagate bitrate and end of input flag to next processor.
+        next->_bitrate = bitrate;
+        next->_input_end = next->_input_end || input_end;
+
+        // Wake the next processor when there is some new input data or end of input.
+        if (count > 0 || input_end) {
+            next->_to_do.signal();
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Wait for packets to process or some error condition.
 //----------------------------------------------------------------------------
@@ -196,20 +402,30 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
 {
     log(10, u"waitWork(min_pkt_cnt = %'d, ...)", {min_pkt_cnt});
 
+    // The time since the previous waitWork() was spent processing packets.
+    addMetricsTime(_metrics_process);
+
     // Cannot allocate more than the buffer size.
     if (min_pkt_cnt > _buffer->count()) {
         debug(u"requests too many packets at a time: %'d, larger than buffer size: %'d", {min_pkt_cnt, _buffer->count()});
         min_pkt_cnt = _buffer->count();
     }
 
+    if (_options.lock_free) {
+        waitWorkLockFree(min_pkt_cnt, pkt_first, pkt_cnt, bitrate, input_end, aborted, timeout);
+        addMetricsTime(_metrics_wait);
+        log(10, u"waitWork(min_pkt_cnt = %'d, pkt_first = %'d, pkt_cnt = %'d, bitrate = %'d, input_end = %s, aborted = %s, timeout = %s)",
+            {min_pkt_cnt, pkt_first, pkt_cnt, bitrate, input_end, aborted, timeout});
+        return;
+    }
+
     // We access data under the protection of the global mutex.
     GuardCondition lock(_global_mutex, _to_do);
 
-    PluginExecutor* next = ringNext<PluginExecutor>();
     timeout = false;
 
     // Loop until enough packets are available (or some error condition).
-    while (_pkt_cnt < min_pkt_cnt && !_input_end && !timeout && !next->_tsp_aborting) {
+    while (_pkt_cnt < min_pkt_cnt && !_input_end && !timeout && !nextAborting()) {
         // If packet area for this processor is empty, wait for some packet.
         // The mutex is implicitely released, we wait for the condition
         // '_to_do' and, once we get it, implicitely relock the mutex.
@@ -240,13 +456,205 @@ void ts::tsp::PluginExecutor::waitWork(size_t min_pkt_cnt, size_t& pkt_first, si
     // Force to abort our processor when the next one is aborting.
     // Don't do that if current is output and next is input because
     // there is no propagation of packets from output back to input.
-    aborted = plugin()->type() != PluginType::OUTPUT && next->_tsp_aborting;
+    aborted = plugin()->type() != PluginType::OUTPUT && nextAborting();
+
+    // The time in this method was spent waiting for packets.
+    addMetricsTime(_metrics_wait);
 
     log(10, u"waitWork(min_pkt_cnt = %'d, pkt_first = %'d, pkt_cnt = %'d, bitrate = %'d, input_end = %s, aborted = %s, timeout = %s)",
         {min_pkt_cnt, pkt_first, pkt_cnt, bitrate, input_end, aborted, timeout});
 }
 
 
+//----------------------------------------------------------------------------
+// Performance metrics.
+//----------------------------------------------------------------------------
+
+ts::tsp::PluginExecutor::Metrics::Metrics() :
+    packets(0),
+    dropped(0),
+    buffered(0),
+    process_time(0),
+    wait_time(0)
+{
+}
+
+void ts::tsp::PluginExecutor::addMetricsTime(std::atomic<NanoSecond>& counter)
+{
+    _metrics_now.getSystemTime();
+    counter += _metrics_now - _metrics_start;
+    _metrics_start = _metrics_now;
+}
+
+void ts::tsp::PluginExecutor::getMetrics(Metrics& metrics) const
+{
+    metrics.packets = _metrics_packets;
+    metrics.dropped = _metrics_dropped;
+    metrics.process_time = _metrics_process;
+    metrics.wait_time = _metrics_wait;
+
+    // Size of our slice of the buffer.
+    if (_options.lock_free) {
+        metrics.buffered = availablePackets();
+    }
+    else {
+        GuardMutex lock(_global_mutex);
+        metrics.buffered = _pkt_cnt;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Lock-free mode: number of packets which are currently available.
+//----------------------------------------------------------------------------
+
+size_t ts::tsp::PluginExecutor::availablePackets() const
+{
+    // The previous executor is the only writer of its _pkt_out, we are the only writer of ours.
+    // Initially, all _pkt_out are zero and our slice of the buffer contains _pkt_base packets.
+    // After a group of branches, use the slowest branch.
+    PacketCounter passed = _previous_set.front()->_pkt_out;
+    for (size_t i = 1; i < _previous_set.size(); ++i) {
+        passed = std::min<PacketCounter>(passed, _previous_set[i]->_pkt_out);
+    }
+    return size_t(passed + _pkt_base - _pkt_out.load(std::memory_order_relaxed));
+}
+
+
+//----------------------------------------------------------------------------
+// Lock-free mode: pass processed packets to the next executor.
+//----------------------------------------------------------------------------
+
+bool ts::tsp::PluginExecutor::passPacketsLockFree(size_t count, const BitRate& bitrate, bool input_end, bool aborted)
+{
+    // Update our buffer. Only this thread reads or writes _pkt_first and _pkt_cnt.
+    _pkt_first = (_pkt_first + count) % _buffer->count();
+    _pkt_cnt -= count;
+
+    // Propagate the bitrate to the next processors, only when it changes.
+    // In a group of branches, only the first branch propagates the bitrate.
+    if (bitrate != _passed_bitrate && (_branch_first == nullptr || _branch_first == this)) {
+        _passed_bitrate = bitrate;
+        for (auto it = _next_set.begin(); it != _next_set.end(); ++it) {
+            GuardMutex lock((*it)->_local_mutex);
+            (*it)->_bitrate = bitrate;
+            ++(*it)->_bitrate_seq;
+        }
+    }
+
+    // Publish the packets. The sequentially consistent store makes the packet contents
+    // visible to the next processor and is ordered before the check of its parked state.
+    // The end of input is published after the packets: when the next processor sees the
+    // end of input, it also sees all previous packets. In a group of branches, the end
+    // of input is published by the last branch to reach it.
+    bool next_end = input_end;
+    if (count > 0) {
+        _pkt_out += count;
+    }
+    if (input_end && _branch_first != nullptr) {
+        _branch_end = true;
+        branchPassed(next_end);
+    }
+    if (next_end) {
+        for (auto it = _next_set.begin(); it != _next_set.end(); ++it) {
+            (*it)->_lf_input_end = true;
+        }
+    }
+
+    // Wake the next processors when there is some new input data or end of input.
+    if (count > 0 || next_end) {
+        for (auto it = _next_set.begin(); it != _next_set.end(); ++it) {
+            (*it)->wakeUp(true);
+        }
+    }
+
+    // Force to abort our processor when the next one is aborting (same as passPackets()).
+    if (plugin()->type() != PluginType::OUTPUT) {
+        aborted = aborted || nextAborting();
+    }
+
+    // Wake the previous processors when we abort (propagate abort conditions backward).
+    if (aborted) {
+        _tsp_aborting = true;
+        wakeOnAbort();
+    }
+
+    // Return false when the current processor shall stop.
+    return !input_end && !aborted;
+}
+
+
+//----------------------------------------------------------------------------
+// Lock-free mode: wait for packets to process or some error condition.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::waitWorkLockFree(size_t min_pkt_cnt, size_t& pkt_first, size_t& pkt_cnt, BitRate& bitrate, bool& input_end, bool& aborted, bool &timeout)
+{
+    bool end = false;
+    timeout = false;
+
+    // Loop until enough packets are available (or some error condition).
+    // The end of input flag must be read before the number of packets.
+    for (size_t spin = 0; ; ++spin) {
+        end = _lf_input_end;
+        _pkt_cnt = availablePackets();
+        if (_pkt_cnt >= min_pkt_cnt || end || nextAborting()) {
+            break;
+        }
+        if (spin < LOCK_FREE_SPIN_COUNT) {
+            // Spin for a short while, the previous processor is probably working.
+            Thread::Yield();
+            continue;
+        }
+
+        // Park the thread on our local condition. The previous processor checks _parked
+        // after publishing its packets. Check again after setting _parked to avoid losing
+        // a notification which was sent between the last check and now.
+        bool signaled = true;
+        {
+            GuardCondition lock(_local_mutex, _to_do);
+            _parked = true;
+            end = _lf_input_end;
+            _pkt_cnt = availablePackets();
+            if (_pkt_cnt < min_pkt_cnt && !end && !nextAborting()) {
+                signaled = lock.waitCondition(_tsp_timeout);
+            }
+            _parked = false;
+        }
+
+        // The timeout handler is called outside the local mutex since the plugin may
+        // call TSP services which acquire the global mutex.
+        if (!signaled && !plugin()->handlePacketTimeout()) {
+            timeout = true;
+            break;
+        }
+    }
+
+    // Same logic as waitWork() to return a contiguous area when possible.
+    if (timeout) {
+        pkt_cnt = 0;
+    }
+    else if (_pkt_first + min_pkt_cnt <= _buffer->count()) {
+        pkt_cnt = std::min(_pkt_cnt, _buffer->count() - _pkt_first);
+    }
+    else {
+        pkt_cnt = _pkt_cnt;
+    }
+
+    // Get the last bitrate from the previous processor, only when it was updated.
+    if (_bitrate_seq != _bitrate_seen) {
+        GuardMutex lock(_local_mutex);
+        _bitrate_seen = _bitrate_seq;
+        _bitrate_cache = _bitrate;
+    }
+
+    pkt_first = _pkt_first;
+    bitrate = _bitrate_cache;
+    input_end = end && pkt_cnt == _pkt_cnt;
+    aborted = plugin()->type() != PluginType::OUTPUT && nextAborting();
+}
+
+
 //----------------------------------------------------------------------------
 // Description of a restart operation (constructor).
 //----------------------------------------------------------------------------
@@ -281,7 +689,7 @@ void ts::tsp::PluginExecutor::restart(const RestartDataPtr& rd)
     // Acquire the global mutex to modify global data.
     // To avoid deadlocks, always acquire the global mutex first, then a RestartData mutex.
     {
-        GuardCondition lock1(_global_mutex, _to_do);
+        GuardMutex lock1(_global_mutex);
 
         // If there was a previous pending restart operation, cancel it.
         if (!_restart_data.isNull()) {
@@ -297,7 +705,7 @@ void ts::tsp::PluginExecutor::restart(const RestartDataPtr& rd)
         _restart = true;
 
         // Signal the plugin thread that there is something to do.
-        lock1.signal();
+        wakeUp(false);
     }
 
     // Now wait for the restart operation to complete.
@@ -42,6 +42,8 @@
 #include "tsCondition.h"
 #include "tsMutex.h"
 #include "tsThread.h"
+#include "tsMonotonic.h"
+#include <atomic>
 
 namespace ts {
     namespace tsp {
@@ -95,6 +97,30 @@ namespace ts {
                             bool           aborted,
                             const BitRate& bitrate);
 
+            //!
+            //! Declare this executor as a member of a group of parallel read-only branches.
+            //! All executors of a group are adjacent in the ring. They receive the same packets
+            //! from the previous executor and the packets are passed to the next executor when
+            //! all executors of the group have passed them.
+            //! Must be executed in synchronous environment, before initNeighbours().
+            //! @param [in] first First executor of the group.
+            //! @param [in] last Last executor of the group.
+            //!
+            void setBranch(PluginExecutor* first, PluginExecutor* last);
+
+            //!
+            //! Check if this executor is a member of a group of parallel branches.
+            //! @return True if this executor is a member of a group of parallel branches.
+            //!
+            bool isBranch() const { return _branch_first != nullptr; }
+
+            //!
+            //! Compute the previous and next executors in the chain, taking branches into account.
+            //! Must be executed in synchronous environment, after building the complete ring
+            //! and declaring all branches, before initBuffer().
+            //!
+            void initNeighbours();
+
             //!
             //! Inform if all plugins should use defaults for real-time.
             //! @param [in] on True if all plugins should use defaults for real-time.
@@ -143,6 +169,28 @@ namespace ts {
             //!
             void restart(Report& report);
 
+            //!
+            //! Performance metrics of a plugin executor.
+            //! All counters are cumulated since the start of the executor.
+            //!
+            class Metrics
+            {
+            public:
+                Metrics();                  //!< Constructor.
+                PacketCounter packets;      //!< Number of packets which were passed to the next executor.
+                PacketCounter dropped;      //!< Number of packets which were dropped by the plugin.
+                size_t        buffered;     //!< Number of packets in the slice of the buffer of this executor (free area for the input).
+                NanoSecond    process_time; //!< Time spent by the executor thread outside waitWork(), processing packets.
+                NanoSecond    wait_time;    //!< Time spent by the executor thread in waitWork(), waiting for packets or free space.
+            };
+
+            //!
+            //! Get a snapshot of the performance metrics of this executor.
+            //! This method can be called from any thread, without holding the global mutex.
+            //! @param [out] metrics Returned performance metrics.
+            //!
+            void getMetrics(Metrics& metrics) const;
+
             // Implementation of TSP virtual methods.
             virtual size_t pluginCount() const override;
             virtual void signalPluginEvent(uint32_t event_code, Object* plugin_data = nullptr) const override;
@@ -152,6 +200,12 @@ namespace ts {
             PacketMetadataBuffer* _metadata;  //!< Description of shared packet metadata buffer.
             volatile bool         _suspended; //!< The plugin is suspended / resumed.
 
+            //!
+            //! Executors which receive the packets we pass, in ring order.
+            //! This is the next executor in the ring or all executors of the next group of branches.
+            //!
+            std::vector<PluginExecutor*> _next_set;
+
             //!
             //! Pass processed packets to the next packet processor.
             //!
@@ -211,6 +265,12 @@ namespace ts {
             //!
             bool processPendingRestart(bool& restarted);
 
+            //!
+            //! Publish the number of packets which were dropped by the plugin, for performance metrics.
+            //! @param [in] count Total number of dropped packets since the start of the executor.
+            //!
+            void setDroppedPackets(PacketCounter count) { _metrics_dropped = count; }
+
         private:
             // Registry of plugin event handlers.
             const PluginEventHandlerRegistry& _handlers;
@@ -220,6 +280,7 @@ namespace ts {
             typedef SafePtr<RestartData,Mutex> RestartDataPtr;
 
             // The following private data must be accessed exclusively under the protection of the global mutex.
+            // In lock-free mode, _pkt_cnt and _input_end are not used, see the lock-free fields below.
             // Implementation details: see the file src/docs/developing-plugins.dox.
             // [*] After initialization, these fields are read/written only in passPackets() and waitWork().
             Condition      _to_do;         // Notify processor to do something.
@@ -248,6 +309,71 @@ namespace ts {
 
             // Restart this plugin.
             void restart(const RestartDataPtr&);
+
+            // Lock-free handoff between adjacent executors (tsp option --lock-free).
+            // Each executor publishes the total number of packets it has passed to the next
+            // one in _pkt_out. The number of packets in our slice of the buffer is computed
+            // from the _pkt_out of the previous executor and our own _pkt_out. There is only
+            // one writer for each field and the global mutex is never used on the data path.
+            // _local_mutex and _to_do are used to park an idle thread. _bitrate is protected
+            // by _local_mutex and each update is notified by incrementing _bitrate_seq.
+            Mutex                      _local_mutex;    // Protect _to_do and _bitrate in lock-free mode.
+            std::atomic<PacketCounter> _pkt_out;        // Total packets passed to next executor.
+            PacketCounter              _pkt_base;       // Initial size of packet area (from initBuffer).
+            std::atomic<bool>          _lf_input_end;   // No more packet after current ones (written by previous).
+            std::atomic<bool>          _parked;         // This thread waits on _to_do.
+            std::atomic<uint32_t>      _bitrate_seq;    // Incremented when previous executor updates _bitrate.
+            uint32_t                   _bitrate_seen;   // Last seen value of _bitrate_seq.
+            BitRate                    _bitrate_cache;  // Local copy of _bitrate.
+            BitRate                    _passed_bitrate; // Last bitrate passed to next executor.
+
+            // Lock-free versions of passPackets() and waitWork().
+            bool passPacketsLockFree(size_t count, const BitRate& bitrate, bool input_end, bool aborted);
+            void waitWorkLockFree(size_t min_pkt_cnt, size_t& pkt_first, size_t& pkt_cnt, BitRate& bitrate, bool& input_end, bool& aborted, bool &timeout);
+
+            // Number of packets which are currently available in our slice of the buffer (lock-free mode).
+            size_t availablePackets() const;
+
+            // Parallel branches. In a group of branches, each executor publishes the total number of
+            // packets it has passed in _pkt_out (in all modes). The packets are released to the next
+            // executor up to the minimum _pkt_out in the group. _branch_released is used in the first
+            // executor of the group only and is protected by the global mutex.
+            PluginExecutor*              _branch_first;    // First executor of our group of branches.
+            PluginExecutor*              _branch_last;     // Last executor of our group of branches.
+            PacketCounter                _branch_released; // Number of packets released by the group (global mutex mode).
+            std::atomic<bool>            _branch_end;      // This branch has passed its end of input.
+            std::vector<PluginExecutor*> _previous_set;    // Executors which pass packets to us.
+
+            // Check if any of the next executors (or another branch of our group) is aborting.
+            bool nextAborting() const;
+
+            // Wake up the previous executors and the other branches of our group when aborting.
+            // In global synchronization mode, must be called with the global mutex held.
+            void wakeOnAbort();
+
+            // Pass packets and end of input to the next executors (global mutex mode).
+            void passToNext(size_t count, const BitRate& bitrate, bool input_end);
+
+            // In a group of branches, minimum number of passed packets and common end of input.
+            PacketCounter branchPassed(bool& input_end) const;
+
+            // Performance metrics. The atomic fields are written by the executor thread only and can be
+            // read by any thread (typically the control server). The other fields are used by the
+            // executor thread only. The time is measured once on entry and once on exit of waitWork().
+            std::atomic<PacketCounter> _metrics_packets;  // Packets passed to next executor.
+            std::atomic<PacketCounter> _metrics_dropped;  // Packets dropped by the plugin.
+            std::atomic<NanoSecond>    _metrics_process;  // Time spent outside waitWork().
+            std::atomic<NanoSecond>    _metrics_wait;     // Time spent in waitWork().
+            Monotonic                  _metrics_start;    // Start of current phase (in or out of waitWork()).
+            Monotonic                  _metrics_now;      // Current time (preallocated).
+
+            // Add the duration of the current phase into a time counter and start a new phase.
+            void addMetricsTime(std::atomic<NanoSecond>& counter);
+
+            // Wake up the executor thread if it waits for something to do.
+            // In global synchronization mode, must be called with the global mutex held.
+            // In lock-free mode, if parked_only is true, do nothing when the thread is not parked.
+            void wakeUp(bool parked_only);
         };
     }
 }
@@ -89,13 +89,26 @@ void ts::tsp::ProcessorExecutor::main()
         window_size = _processor->getPacketWindowSize();
     }
 
-    // Perform the complete packet processing in individual-packet or packet-window mode.
-    if (window_size == 0) {
-        processIndividualPackets();
+    // Perform the complete packet processing in individual-packet, packet-window or packet-batch mode.
+    // In a parallel branch, the packets are always processed one by one, on private copies.
+    if (isBranch()) {
+        if (_processor->getPacketWindowSize() != 0) {
+            error(u"packet window processing is not supported in parallel branches");
+            passPackets(0, _tsp_bitrate, true, true);
+        }
+        else {
+            processBranchPackets();
+        }
     }
-    else {
+    else if (window_size != 0) {
         processPacketWindows(window_size);
     }
+    else if (_processor->usePacketBatch()) {
+        processPacketBatches();
+    }
+    else {
+        processIndividualPackets();
+    }
 
     // Close the packet processor.
     debug(u"stopping the plugin");
@@ -245,6 +258,310 @@ void ts::tsp::ProcessorExecutor::processIndividualPackets()
             // Perform periodic flush to avoid waiting too long before two output operations.
             // Also propagate new bitrate values immediately.
             if (pkt_data->getFlush() || got_new_bitrate || pkt_done == pkt_cnt || (_options.max_flush_pkt > 0 && pkt_flush >= _options.max_flush_pkt)) {
+                setDroppedPackets(dropped_packets);
+                aborted = !passPackets(pkt_flush, output_bitrate, pkt_done == pkt_cnt && input_end, aborted);
+                pkt_flush = 0;
+            }
+        }
+
+    } while (!input_end && !aborted);
+
+    debug(u"packet processing thread %s after %'d packets, %'d passed, %'d dropped, %'d nullified",
+          {input_end ? u"terminated" : u"aborted", pluginPackets(), passed_packets, dropped_packets, nullified_packets});
+}
+
+
+//----------------------------------------------------------------------------
+// Process packets one by one in a parallel branch.
+//----------------------------------------------------------------------------
+
+void ts::tsp::ProcessorExecutor::processBranchPackets()
+{
+    debug(u"using parallel branch processing");
+
+    TSPacketMetadata::LabelSet only_labels(_processor->getOnlyLabelOption());
+    PacketCounter ignored_packets = 0;
+    bool input_end = false;
+    bool aborted = false;
+    bool restarted = false;
+
+    // Other branches read the same packets concurrently. The plugin processes private copies
+    // of the packets and their metadata. Any modification is discarded.
+    TSPacket pkt;
+    TSPacketMetadata pkt_data;
+
+    do {
+        // Wait for packets to process
+        size_t pkt_first = 0;
+        size_t pkt_cnt = 0;
+        bool timeout = false;
+        waitWork(1, pkt_first, pkt_cnt, _tsp_bitrate, input_end, aborted, timeout);
+
+        // Process restart requests.
+        if (!processPendingRestart(restarted)) {
+            timeout = true; // restart error
+        }
+        else if (restarted) {
+            // Plugin was restarted, need to recheck --only-label
+            only_labels = _processor->getOnlyLabelOption();
+        }
+
+        // In case of abort on timeout, notify previous and next plugin, then exit.
+        if (timeout) {
+            passPackets(0, _tsp_bitrate, true, true);
+            break;
+        }
+
+        // If next processor has aborted, abort as well.
+        if (aborted && !input_end) {
+            passPackets(0, _tsp_bitrate, true, true);
+            break;
+        }
+
+        // Exit thread if no more packet to process.
+        if (pkt_cnt == 0 && input_end) {
+            passPackets(0, _tsp_bitrate, true, false);
+            break;
+        }
+
+        // Now process the packets. The bitrate is always passed unmodified.
+        size_t pkt_done = 0;
+        size_t pkt_flush = 0;
+
+        while (pkt_done < pkt_cnt && !aborted) {
+
+            const TSPacket* const buf_pkt = _buffer->base() + pkt_first + pkt_done;
+            const TSPacketMetadata* const buf_data = _metadata->base() + pkt_first + pkt_done;
+            bool flush = false;
+
+            pkt_done++;
+            pkt_flush++;
+
+            if (buf_pkt->b[0] == 0 || _suspended || (only_labels.any() && !buf_data->hasAnyLabel(only_labels))) {
+                // Dropped by a previous packet processor, plugin suspended, packet not in --only-label.
+                addNonPluginPackets(1);
+            }
+            else {
+                pkt = *buf_pkt;
+                pkt_data = *buf_data;
+                pkt_data.setFlush(false);
+                pkt_data.setBitrateChanged(false);
+                const ProcessorPlugin::Status status = _processor->processPacket(pkt, pkt_data);
+                addPluginPackets(1);
+                flush = pkt_data.getFlush();
+
+                if (status == ProcessorPlugin::TSP_END) {
+                    // Signal end of input to successors and abort to predecessors
+                    debug(u"plugin requests termination");
+                    input_end = aborted = true;
+                    pkt_done--;
+                    pkt_flush--;
+                    pkt_cnt = pkt_done;
+                }
+                else if (status != ProcessorPlugin::TSP_OK) {
+                    // Packets cannot be dropped or nullified in a branch.
+                    ignored_packets++;
+                }
+            }
+
+            // Perform periodic flush to avoid waiting too long before passing packets.
+            if (flush || pkt_done == pkt_cnt || (_options.max_flush_pkt > 0 && pkt_flush >= _options.max_flush_pkt)) {
+                aborted = !passPackets(pkt_flush, _tsp_bitrate, pkt_done == pkt_cnt && input_end, aborted);
+                pkt_flush = 0;
+            }
+        }
+
+    } while (!input_end && !aborted);
+
+    if (ignored_packets > 0) {
+        warning(u"ignored %'d packet drop or nullify requests in parallel branch", {ignored_packets});
+    }
+    debug(u"packet processing thread %s after %'d packets", {input_end ? u"terminated" : u"aborted", pluginPackets()});
+}
+
+
+//----------------------------------------------------------------------------
+// Process packets using contiguous batches of packets.
+//----------------------------------------------------------------------------
+
+void ts::tsp::ProcessorExecutor::processPacketBatches()
+{
+    debug(u"using packet batch processing");
+
+    TSPacketMetadata::LabelSet only_labels(_processor->getOnlyLabelOption());
+    PacketCounter passed_packets = 0;
+    PacketCounter dropped_packets = 0;
+    PacketCounter nullified_packets = 0;
+    BitRate output_bitrate = _tsp_bitrate;
+    bool bitrate_never_modified = true;
+    bool input_end = false;
+    bool aborted = false;
+    bool restarted = false;
+
+    // Per-packet status and initial null state of a batch, reused from one batch to another.
+    std::vector<ProcessorPlugin::Status> status;
+    std::vector<bool> was_null;
+
+    do {
+        // Wait for packets to process
+        size_t pkt_first = 0;
+        size_t pkt_cnt = 0;
+        bool timeout = false;
+        waitWork(1, pkt_first, pkt_cnt, _tsp_bitrate, input_end, aborted, timeout);
+
+        // If bitrate was never modified by the plugin, always copy the input bitrate as output bitrate.
+        // Otherwise, keep previous output bitrate, as modified by the plugin.
+        if (bitrate_never_modified) {
+            output_bitrate = _tsp_bitrate;
+        }
+
+        // Process restart requests.
+        if (!processPendingRestart(restarted)) {
+            timeout = true; // restart error
+        }
+        else if (restarted) {
+            // Plugin was restarted, need to recheck --only-label
+            only_labels = _processor->getOnlyLabelOption();
+        }
+
+        // In case of abort on timeout, notify previous and next plugin, then exit.
+        if (timeout) {
+            passPackets(0, output_bitrate, true, true);
+            break;
+        }
+
+        // If next processor has aborted, abort as well.
+        if (aborted && !input_end) {
+            passPackets(0, output_bitrate, true, true);
+            break;
+        }
+
+        // Exit thread if no more packet to process.
+        if (pkt_cnt == 0 && input_end) {
+            passPackets(0, output_bitrate, true, false);
+            break;
+        }
+
+        // Now process the packets. Since waitWork() was called with a minimum of one packet,
+        // the returned area is contiguous in the buffer.
+        size_t pkt_done = 0;
+        size_t pkt_flush = 0;
+
+        while (pkt_done < pkt_cnt && !aborted) {
+
+            TSPacket* const pkt = _buffer->base() + pkt_first + pkt_done;
+            TSPacketMetadata* const pkt_data = _metadata->base() + pkt_first + pkt_done;
+
+            // Maximum number of packets to consider before the next flush.
+            size_t max_cnt = pkt_cnt - pkt_done;
+            if (_options.max_flush_pkt > 0) {
+                max_cnt = std::min(max_cnt, _options.max_flush_pkt - pkt_flush);
+            }
+
+            // Skip leading packets which shall not be submitted to the plugin: dropped by a previous
+            // packet processor, plugin suspended, packet not in --only-label.
+            size_t skip_cnt = 0;
+            while (skip_cnt < max_cnt && (pkt[skip_cnt].b[0] == 0 || _suspended || (only_labels.any() && !pkt_data[skip_cnt].hasAnyLabel(only_labels)))) {
+                if (pkt[skip_cnt].b[0] != 0) {
+                    pkt_data[skip_cnt].setFlush(false);
+                    pkt_data[skip_cnt].setBitrateChanged(false);
+                }
+                skip_cnt++;
+            }
+            addNonPluginPackets(skip_cnt);
+
+            // Then collect the contiguous batch of packets to submit to the plugin.
+            TSPacket* const batch_pkt = pkt + skip_cnt;
+            TSPacketMetadata* const batch_data = pkt_data + skip_cnt;
+            size_t batch_cnt = 0;
+            was_null.clear();
+            while (skip_cnt + batch_cnt < max_cnt && batch_pkt[batch_cnt].b[0] != 0 && (only_labels.none() || batch_data[batch_cnt].hasAnyLabel(only_labels))) {
+                was_null.push_back(batch_pkt[batch_cnt].getPID() == PID_NULL);
+                batch_data[batch_cnt].setFlush(false);
+                batch_data[batch_cnt].setBitrateChanged(false);
+                batch_cnt++;
+            }
+
+            size_t pkt_used = skip_cnt + batch_cnt;
+            bool flush = false;
+            bool got_new_bitrate = false;
+
+            if (batch_cnt > 0) {
+                // Let the plugin process the batch in one single call.
+                status.resize(batch_cnt);
+                _processor->processPacketBatch(batch_pkt, batch_data, status.data(), batch_cnt);
+
+                // Use the returned statuses.
+                bool bitrate_changed = false;
+                size_t processed_cnt = batch_cnt;
+                for (size_t i = 0; i < batch_cnt; ++i) {
+                    switch (status[i]) {
+                        case ProcessorPlugin::TSP_OK:
+                            // Normal case, pass packet
+                            passed_packets++;
+                            break;
+                        case ProcessorPlugin::TSP_NULL:
+                            // Replace the packet with a complete null packet
+                            batch_pkt[i] = NullPacket;
+                            break;
+                        case ProcessorPlugin::TSP_DROP:
+                            // Drop this packet.
+                            batch_pkt[i].b[0] = 0;
+                            dropped_packets++;
+                            break;
+                        case ProcessorPlugin::TSP_END:
+                            // Signal end of input to successors and abort to predecessors.
+                            // This packet and all subsequent ones are not passed to the next processor.
+                            debug(u"plugin requests termination");
+                            input_end = aborted = true;
+                            processed_cnt = i;
+                            break;
+                        default:
+                            // Invalid status, report error and accept packet.
+                            error(u"invalid packet processing status %d", {status[i]});
+                            break;
+                    }
+                    if (processed_cnt < batch_cnt) {
+                        break;
+                    }
+
+                    // Detect if the packet was nullified by the plugin, either by returning TSP_NULL or by overwriting the packet.
+                    if (!was_null[i] && batch_pkt[i].getPID() == PID_NULL) {
+                        batch_data[i].setNullified(true);
+                        nullified_packets++;
+                    }
+                    flush = flush || batch_data[i].getFlush();
+                    bitrate_changed = bitrate_changed || batch_data[i].getBitrateChanged();
+                }
+
+                // Packets which were submitted to the plugin, including the one which returned TSP_END.
+                addPluginPackets(std::min(processed_cnt + 1, batch_cnt));
+
+                // If the packet processor has signaled a new bitrate, get it.
+                if (bitrate_changed) {
+                    const BitRate new_bitrate = _processor->getBitrate();
+                    if (new_bitrate != 0) {
+                        bitrate_never_modified = false;
+                        got_new_bitrate = new_bitrate != output_bitrate;
+                        output_bitrate = new_bitrate;
+                    }
+                }
+
+                // On termination, don't pass packets after the last processed one.
+                if (processed_cnt < batch_cnt) {
+                    pkt_used = skip_cnt + processed_cnt;
+                    pkt_cnt = pkt_done + pkt_used;
+                }
+            }
+
+            pkt_done += pkt_used;
+            pkt_flush += pkt_used;
+
+            // Do not wait to process pkt_cnt packets before notifying the next processor.
+            // Perform periodic flush to avoid waiting too long before two output operations.
+            // Also propagate new bitrate values immediately.
+            if (flush || got_new_bitrate || pkt_done == pkt_cnt || (_options.max_flush_pkt > 0 && pkt_flush >= _options.max_flush_pkt)) {
+                setDroppedPackets(dropped_packets);
                 aborted = !passPackets(pkt_flush, output_bitrate, pkt_done == pkt_cnt && input_end, aborted);
                 pkt_flush = 0;
             }
@@ -396,6 +713,7 @@ void ts::tsp::ProcessorExecutor::processPacketWindows(size_t window_size)
         passed_packets += processed_packets - win.dropCount();
         dropped_packets += win.dropCount();
         nullified_packets += win.nullifyCount();
+        setDroppedPackets(dropped_packets);
         addPluginPackets(processed_packets);
         addNonPluginPackets(allocated_packets - processed_packets);
 
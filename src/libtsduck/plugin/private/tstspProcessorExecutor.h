@@ -78,9 +78,11 @@ namespace ts {
             // Inherited from Thread
             virtual void main() override;
 
-            // Process packets one by one or using packet windows.
+            // Process packets one by one, using packet windows, using packet batches or in a parallel branch.
             void processIndividualPackets();
             void processPacketWindows(size_t window_size);
+            void processPacketBatches();
+            void processBranchPackets();
         };
     }
 }
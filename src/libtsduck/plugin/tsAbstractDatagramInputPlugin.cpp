@@ -42,7 +42,8 @@ ts::AbstractDatagramInputPlugin::AbstractDatagramInputPlugin(TSP* tsp_,
                                                              const UString& syntax,
                                                              const UString& system_time_name,
                                                              const UString& system_time_description,
-                                                             bool real_time) :
+                                                             bool real_time,
+                                                             size_t max_datagrams) :
     InputPlugin(tsp_, description, syntax),
     _real_time(real_time),
     _eval_time(0),
@@ -60,8 +61,16 @@ ts::AbstractDatagramInputPlugin::AbstractDatagramInputPlugin(TSP* tsp_,
     _inbuf_count(0),
     _inbuf_next(0),
     _mdata_next(0),
-    _inbuf(std::max(buffer_size, 7 * PKT_SIZE)),
-    _mdata(_inbuf.size() / PKT_SIZE)
+    _dg_size(std::max(buffer_size, 7 * PKT_SIZE)),
+    _dg_max(std::max<size_t>(max_datagrams, 1)),
+    _dg_count(0),
+    _dg_next(0),
+    _dg_offset(0),
+    _inbuf(_dg_max * _dg_size),
+    _dg_sizes(_dg_max),
+    _dg_timestamps(_dg_max),
+    _dg_segments(_dg_max),
+    _mdata(_dg_size / PKT_SIZE)
 {
     if (_real_time) {
         option(u"display-interval", 'd', POSITIVE);
@@ -136,6 +145,7 @@ bool ts::AbstractDatagramInputPlugin::start()
 {
     // Initialize working data.
     _inbuf_count = _inbuf_next = _mdata_next = 0;
+    _dg_count = _dg_next = _dg_offset = 0;
     _start = _start_0 = _start_1 = _next_display = Time::Epoch;
     _packets = _packets_0 = _packets_1 = 0;
     return true;
@@ -162,88 +172,152 @@ ts::BitRate ts::AbstractDatagramInputPlugin::getBitrate()
 
 
 //----------------------------------------------------------------------------
-// Input method
+// Default implementation of the reception of several datagrams.
 //----------------------------------------------------------------------------
 
-size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetadata* pkt_data, size_t max_packets)
+bool ts::AbstractDatagramInputPlugin::receiveDatagrams(uint8_t* buffer,
+                                                       size_t buffer_size,
+                                                       size_t max_count,
+                                                       size_t* ret_sizes,
+                                                       MicroSecond* timestamps,
+                                                       size_t* segment_sizes,
+                                                       size_t& ret_count)
 {
-    MicroSecond timestamp = -1;
+    ret_count = 0;
+    if (max_count == 0 || !receiveDatagram(buffer, buffer_size, ret_sizes[0], timestamps[0])) {
+        return false;
+    }
+    segment_sizes[0] = 0;
+    ret_count = 1;
+    return true;
+}
+
 
-    // Check if we receive new packets or process remain of previous buffer.
-    bool new_packets = false;
+//----------------------------------------------------------------------------
+// Locate TS packets in a datagram from the input buffer.
+//----------------------------------------------------------------------------
 
-    // If there is no remaining packet in the input buffer, wait for a datagram message.
-    // Loop until we get some TS packets.
-    while (_inbuf_count == 0) {
+bool ts::AbstractDatagramInputPlugin::processDatagram(const uint8_t* data, size_t size, MicroSecond timestamp)
+{
+    // Look for TS packets in the UDP message.
+    size_t start = 0;
+    if (!TSPacket::Locate(data, size, start, _inbuf_count)) {
+        // No TS packet found in UDP message.
+        _inbuf_count = 0;
+        tsp->debug(u"no TS packet in message, %s bytes", {size});
+        return false;
+    }
+    _inbuf_next = size_t(data - _inbuf.data()) + start;
+
+    // Look for an RTP header before the first packet. There is no clear proof of the presence of the RTP header.
+    // We check if the header size is large enough for an RTP header and if the "RTP payload type" is MPEG-2 TS.
+    const bool rtp = start >= RTP_HEADER_SIZE && (data[1] & 0x7F) == RTP_PT_MP2T;
+    const uint32_t rtp_timestamp = rtp ? GetUInt32(data + 4) : 0;
+
+    // Use RTP time stamp if there is one and RTP is the preferred choice.
+    bool use_rtp = false;
+    bool use_kernel = false;
+    switch (_time_priority) {
+        case RTP_SYSTEM_TSP:
+            use_rtp = rtp;
+            use_kernel = !rtp && timestamp >= 0;
+            break;
+        case SYSTEM_RTP_TSP:
+            use_kernel = timestamp >= 0;
+            use_rtp = !use_kernel && rtp;
+            break;
+        case RTP_TSP:
+            use_rtp = rtp;
+            use_kernel = false;
+            break;
+        case SYSTEM_TSP:
+            use_kernel = timestamp >= 0;
+            use_rtp = false;
+            break;
+        case TSP_ONLY:
+        default:
+            use_rtp = false;
+            use_kernel = false;
+            break;
+    }
 
-        // Wait for a datagram message
-        size_t insize = 0;
-        if (!receiveDatagram(_inbuf.data(), _inbuf.size(), insize, timestamp)) {
-            return 0;
+    // Build time stamps in packet metadata.
+    _mdata_next = 0;
+    for (size_t i = 0; i < _inbuf_count; ++i) {
+        if (use_rtp) {
+            // RTP time stamp unit is 90 kHz (RTP_RATE_MP2T)
+            _mdata[i].setInputTimeStamp(rtp_timestamp, RTP_RATE_MP2T, TimeSource::RTP);
+        }
+        else if (use_kernel) {
+            // IP time stamp unit is microseconds.
+            _mdata[i].setInputTimeStamp(uint64_t(timestamp), MicroSecPerSec, TimeSource::KERNEL);
         }
+        else {
+            _mdata[i].clearInputTimeStamp();
+        }
+    }
+    return true;
+}
 
-        // Look for TS packets in the UDP message.
-        new_packets = TSPacket::Locate(_inbuf.data(), insize, _inbuf_next, _inbuf_count);
-
-        if (new_packets) {
-
-            // Look for an RTP header before the first packet. There is no clear proof of the presence of the RTP header.
-            // We check if the header size is large enough for an RTP header and if the "RTP payload type" is MPEG-2 TS.
-            const bool rtp = _inbuf_next >= RTP_HEADER_SIZE && (_inbuf[1] & 0x7F) == RTP_PT_MP2T;
-            const uint32_t rtp_timestamp = rtp ? GetUInt32(_inbuf.data() + 4) : 0;
-
-            // Use RTP time stamp if there is one and RTP is the preferred choice.
-            bool use_rtp = false;
-            bool use_kernel = false;
-            switch (_time_priority) {
-                case RTP_SYSTEM_TSP:
-                    use_rtp = rtp;
-                    use_kernel = !rtp && timestamp >= 0;
-                    break;
-                case SYSTEM_RTP_TSP:
-                    use_kernel = timestamp >= 0;
-                    use_rtp = !use_kernel && rtp;
-                    break;
-                case RTP_TSP:
-                    use_rtp = rtp;
-                    use_kernel = false;
-                    break;
-                case SYSTEM_TSP:
-                    use_kernel = timestamp >= 0;
-                    use_rtp = false;
-                    break;
-                case TSP_ONLY:
-                default:
-                    use_rtp = false;
-                    use_kernel = false;
-                    break;
-            }
 
-            // Build time stamps in packet metadata.
-            _mdata_next = 0;
-            for (size_t i = 0; i < _inbuf_count; ++i) {
-                if (use_rtp) {
-                    // RTP time stamp unit is 90 kHz (RTP_RATE_MP2T)
-                    _mdata[i].setInputTimeStamp(rtp_timestamp, RTP_RATE_MP2T, TimeSource::RTP);
-                }
-                else if (use_kernel) {
-                    // IP time stamp unit is microseconds.
-                    _mdata[i].setInputTimeStamp(uint64_t(timestamp), MicroSecPerSec, TimeSource::KERNEL);
-                }
-                else {
-                    _mdata[i].clearInputTimeStamp();
-                }
-            }
+//----------------------------------------------------------------------------
+// Input method
+//----------------------------------------------------------------------------
 
-            break; // found packets.
+size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetadata* pkt_data, size_t max_packets)
+{
+    // Number of returned packets and number of newly located packets.
+    size_t pkt_cnt = 0;
+    size_t new_packets = 0;
+
+    // Fill the output buffer from all datagrams which were received in the last batch.
+    // Wait for new datagrams only when there is nothing to return.
+    while (pkt_cnt < max_packets) {
+
+        if (_inbuf_count > 0) {
+            // Return packets from the current datagram.
+            const size_t count = std::min(_inbuf_count, max_packets - pkt_cnt);
+            TSPacket::Copy(buffer + pkt_cnt, _inbuf.data() + _inbuf_next, count);
+            TSPacketMetadata::Copy(pkt_data + pkt_cnt, &_mdata[_mdata_next], count);
+            _inbuf_count -= count;
+            _inbuf_next += count * PKT_SIZE;
+            _mdata_next += count;
+            pkt_cnt += count;
+        }
+        else if (_dg_next < _dg_count) {
+            // Look for TS packets in the next datagram of the last batch.
+            // A coalesced datagram is processed one segment at a time.
+            const uint8_t* const data = _inbuf.data() + _dg_next * _dg_size + _dg_offset;
+            const MicroSecond timestamp = _dg_timestamps[_dg_next];
+            size_t size = _dg_sizes[_dg_next] - _dg_offset;
+            if (_dg_segments[_dg_next] > 0) {
+                size = std::min(size, _dg_segments[_dg_next]);
+            }
+            _dg_offset += size;
+            if (_dg_offset >= _dg_sizes[_dg_next]) {
+                _dg_next++;
+                _dg_offset = 0;
+            }
+            if (processDatagram(data, size, timestamp)) {
+                new_packets += _inbuf_count;
+            }
+        }
+        else if (pkt_cnt > 0) {
+            // All received datagrams are processed, return what we have.
+            break;
+        }
+        else {
+            // Wait for new datagram messages.
+            _dg_count = _dg_next = _dg_offset = 0;
+            if (!receiveDatagrams(_inbuf.data(), _dg_size, _dg_max, _dg_sizes.data(), _dg_timestamps.data(), _dg_segments.data(), _dg_count)) {
+                return 0;
+            }
+            _dg_count = std::min(_dg_count, _dg_max);
         }
-
-        // No TS packet found in UDP message, wait for another one.
-        tsp->debug(u"no TS packet in message, %s bytes", {insize});
     }
 
     // If new packets were received, we may need to re-evaluate the real-time input bitrate.
-    if (new_packets && _real_time && _eval_time > 0) {
+    if (new_packets > 0 && _real_time && _eval_time > 0) {
 
         const Time now(Time::CurrentUTC());
 
@@ -256,9 +330,9 @@ size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetada
         }
 
         // Count packets
-        _packets += _inbuf_count;
-        _packets_0 += _inbuf_count;
-        _packets_1 += _inbuf_count;
+        _packets += new_packets;
+        _packets_0 += new_packets;
+        _packets_1 += new_packets;
 
         // Detect new evaluation period
         if (now >= _start_1 + _eval_time) {
@@ -282,13 +356,5 @@ size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetada
         }
     }
 
-    // Return packets from the input buffer
-    size_t pkt_cnt = std::min(_inbuf_count, max_packets);
-    TSPacket::Copy(buffer, _inbuf.data() + _inbuf_next, pkt_cnt);
-    TSPacketMetadata::Copy(pkt_data, &_mdata[_mdata_next], pkt_cnt);
-    _inbuf_count -= pkt_cnt;
-    _inbuf_next += pkt_cnt * PKT_SIZE;
-    _mdata_next += pkt_cnt;
-
     return pkt_cnt;
 }
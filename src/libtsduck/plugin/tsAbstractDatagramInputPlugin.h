@@ -70,6 +70,9 @@ namespace ts {
         //! @param [in] system_time_description Description of @a system_time_name for help text.
         //! @param [in] real_time If true, the reception occurs in real-time, typically from
         //! the network. When false, the "reception" can be reading a capture file.
+        //! @param [in] max_datagrams Maximum number of datagrams which can be received at once
+        //! using receiveDatagrams(). The input buffer contains @a max_datagrams slots of
+        //! @a buffer_size bytes each.
         //!
         AbstractDatagramInputPlugin(TSP* tsp,
                                     size_t buffer_size,
@@ -77,7 +80,8 @@ namespace ts {
                                     const UString& syntax,
                                     const UString& system_time_name,
                                     const UString& system_time_description,
-                                    bool real_time);
+                                    bool real_time,
+                                    size_t max_datagrams = 1);
 
         //!
         //! Receive a datagram message.
@@ -90,6 +94,35 @@ namespace ts {
         //!
         virtual bool receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp) = 0;
 
+        //!
+        //! Receive several datagram messages at once.
+        //! The default implementation receives one single datagram using receiveDatagram().
+        //! Subclasses which can receive several datagrams in one operation should override it.
+        //! The method shall wait for at least one datagram and return all datagrams which are
+        //! immediately available, up to @a max_count.
+        //! @param [out] buffer Address of the buffer for the received messages. This buffer contains
+        //! @a max_count consecutive slots of @a buffer_size bytes each. Datagram number N is received
+        //! at address @a buffer + N * @a buffer_size.
+        //! @param [in] buffer_size Size in bytes of each slot in the reception buffer.
+        //! @param [in] max_count Maximum number of datagrams to receive. Never zero.
+        //! @param [out] ret_sizes Array of @a max_count sizes. Receive the size in bytes of each datagram.
+        //! @param [out] timestamps Array of @a max_count timestamps. Receive the timestamp in micro-seconds
+        //! of each datagram or -1 if not available.
+        //! @param [out] segment_sizes Array of @a max_count segment sizes. When the system coalesces
+        //! several datagrams of identical size into one large message (UDP receive offload), receive
+        //! the size of the original datagrams. The message is then split into segments of that size.
+        //! Zero if the datagram is not coalesced.
+        //! @param [out] ret_count Number of received datagrams.
+        //! @return True on success, false on error.
+        //!
+        virtual bool receiveDatagrams(uint8_t* buffer,
+                                      size_t buffer_size,
+                                      size_t max_count,
+                                      size_t* ret_sizes,
+                                      MicroSecond* timestamps,
+                                      size_t* segment_sizes,
+                                      size_t& ret_count);
+
     private:
         // Order of priority for input timestamps. SYSTEM means lower layer from subclass (UDP, SRT, etc).
         enum TimePriority {RTP_SYSTEM_TSP, SYSTEM_RTP_TSP, RTP_TSP, SYSTEM_TSP, TSP_ONLY};
@@ -110,10 +143,22 @@ namespace ts {
         PacketCounter _packets_0;             // Number of received packets since _start_0
         Time          _start_1;               // Start of previous bitrate evaluation period
         PacketCounter _packets_1;             // Number of received packets since _start_1
-        size_t        _inbuf_count;           // Number of remaining TS packets in inbuf
+        size_t        _inbuf_count;           // Number of remaining TS packets in current datagram
         size_t        _inbuf_next;            // Byte index in _inbuf of next TS packet to return
         size_t        _mdata_next;            // Index in _mdata of next TS packet metadata to return
-        ByteBlock     _inbuf;                 // Input buffer
-        TSPacketMetadataVector _mdata;        // Metadata for packets in _inbuf
+        size_t        _dg_size;               // Size of each datagram slot in _inbuf
+        size_t        _dg_max;                // Maximum number of datagrams in _inbuf
+        size_t        _dg_count;              // Number of datagrams in _inbuf
+        size_t        _dg_next;               // Index of next datagram to process in _inbuf
+        size_t        _dg_offset;             // Offset of next segment to process in a coalesced datagram
+        ByteBlock     _inbuf;                 // Input buffer, _dg_max slots of _dg_size bytes
+        std::vector<size_t>      _dg_sizes;       // Size of each datagram in _inbuf
+        std::vector<MicroSecond> _dg_timestamps;  // Receive timestamp of each datagram in _inbuf
+        std::vector<size_t>      _dg_segments;    // Segment size of each coalesced datagram in _inbuf, zero if not coalesced
+        TSPacketMetadataVector   _mdata;          // Metadata for packets in current datagram
+
+        // Locate TS packets in a datagram from the input buffer and build their metadata.
+        // Return true if TS packets are found.
+        bool processDatagram(const uint8_t* data, size_t size, MicroSecond timestamp);
     };
 }
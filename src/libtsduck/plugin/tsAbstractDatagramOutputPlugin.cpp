@@ -36,6 +36,9 @@ constexpr size_t ts::AbstractDatagramOutputPlugin::DEFAULT_PACKET_BURST;
 constexpr size_t ts::AbstractDatagramOutputPlugin::MAX_PACKET_BURST;
 #endif
 
+// Maximum number of datagrams to send at once.
+#define MAX_DATAGRAMS 64
+
 
 //----------------------------------------------------------------------------
 // Output constructor
@@ -62,7 +65,11 @@ ts::AbstractDatagramOutputPlugin::AbstractDatagramOutputPlugin(TSP* tsp_, const
     _rtp_pcr_offset(0),
     _pkt_count(0),
     _out_count(0),
-    _out_buffer()
+    _out_buffer(),
+    _dg_count(0),
+    _dg_addresses(MAX_DATAGRAMS),
+    _dg_sizes(MAX_DATAGRAMS),
+    _rtp_buffer()
 {
     option(u"enforce-burst", 'e');
     help(u"enforce-burst",
@@ -167,6 +174,10 @@ bool ts::AbstractDatagramOutputPlugin::start()
     _rtp_pcr_offset = 0;
     _pkt_count = 0;
 
+    // Prepare batches of datagrams. With RTP, each datagram is built in a slot of _rtp_buffer.
+    _dg_count = 0;
+    _rtp_buffer.resize(_use_rtp ? MAX_DATAGRAMS * (RTP_HEADER_SIZE + _pkt_burst * PKT_SIZE) : 0);
+
     return true;
 }
 
@@ -180,7 +191,7 @@ bool ts::AbstractDatagramOutputPlugin::stop()
     // Flush incomplete datagram, if any.
     bool success = true;
     if (_out_count > 0) {
-        success = sendPackets(_out_buffer.data(), _out_count);
+        success = addDatagram(_out_buffer.data(), _out_count) && flushDatagrams();
         _out_count = 0;
     }
     return success;
@@ -212,7 +223,7 @@ bool ts::AbstractDatagramOutputPlugin::send(const TSPacket* pkt, const TSPacketM
 
         // Send the output buffer when full.
         if (_out_count == _pkt_burst) {
-            if (!sendPackets(_out_buffer.data(), _out_count)) {
+            if (!addDatagram(_out_buffer.data(), _out_count)) {
                 return false;
             }
             _out_count = 0;
@@ -222,13 +233,18 @@ bool ts::AbstractDatagramOutputPlugin::send(const TSPacket* pkt, const TSPacketM
     // Send subsequent packets from the global buffer.
     while (packet_count >= min_burst) {
         size_t count = std::min(packet_count, _pkt_burst);
-        if (!sendPackets(pkt, count)) {
+        if (!addDatagram(pkt, count)) {
             return false;
         }
         pkt += count;
         packet_count -= count;
     }
 
+    // Send the last batch of datagrams. Must be done before reusing the output buffer.
+    if (!flushDatagrams()) {
+        return false;
+    }
+
     // If remaining packets are present, save them in output buffer.
     if (packet_count > 0) {
         assert(_enforce_burst);
@@ -242,12 +258,42 @@ bool ts::AbstractDatagramOutputPlugin::send(const TSPacket* pkt, const TSPacketM
 
 
 //----------------------------------------------------------------------------
-// Send contiguous packets in one single datagram.
+// Default implementation of the transmission of several datagrams.
+//----------------------------------------------------------------------------
+
+bool ts::AbstractDatagramOutputPlugin::sendDatagrams(const void* const* addresses, const size_t* sizes, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        if (!sendDatagram(addresses[i], sizes[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Send all datagrams in the current batch.
 //----------------------------------------------------------------------------
 
-bool ts::AbstractDatagramOutputPlugin::sendPackets(const TSPacket* pkt, size_t packet_count)
+bool ts::AbstractDatagramOutputPlugin::flushDatagrams()
 {
-    bool status = true;
+    const bool status = _dg_count == 0 || sendDatagrams(_dg_addresses.data(), _dg_sizes.data(), _dg_count);
+    _dg_count = 0;
+    return status;
+}
+
+
+//----------------------------------------------------------------------------
+// Add contiguous packets as one single datagram in the current batch.
+//----------------------------------------------------------------------------
+
+bool ts::AbstractDatagramOutputPlugin::addDatagram(const TSPacket* pkt, size_t packet_count)
+{
+    // Send the current batch when full.
+    if (_dg_count >= _dg_addresses.size() && !flushDatagrams()) {
+        return false;
+    }
 
     if (_use_rtp) {
         // RTP datagram are relatively trivial to build, except the time stamp.
@@ -259,14 +305,16 @@ bool ts::AbstractDatagramOutputPlugin::sendPackets(const TSPacket* pkt, size_t p
         // Then keep this difference and resynchronize at each PCR.
         // But never jump back in RTP timestamps, only increase "more slowly" when adjusting.
 
-        // Build an RTP datagram. Use a simple RTP header without options nor extensions.
-        ByteBlock buffer(RTP_HEADER_SIZE + packet_count * PKT_SIZE);
+        // Build an RTP datagram in the next slot of the batch buffer.
+        // Use a simple RTP header without options nor extensions.
+        assert(packet_count <= _pkt_burst);
+        uint8_t* const buffer = _rtp_buffer.data() + _dg_count * (RTP_HEADER_SIZE + _pkt_burst * PKT_SIZE);
 
         // Build the RTP header, except the timestamp.
         buffer[0] = 0x80;             // Version = 2, P = 0, X = 0, CC = 0
         buffer[1] = _rtp_pt & 0x7F;   // M = 0, payload type
-        PutUInt16(&buffer[2], _rtp_sequence++);
-        PutUInt32(&buffer[8], _rtp_ssrc);
+        PutUInt16(buffer + 2, _rtp_sequence++);
+        PutUInt32(buffer + 8, _rtp_ssrc);
 
         // Get current bitrate to compute timestamps.
         const BitRate bitrate = tsp->bitrate();
@@ -329,23 +377,26 @@ bool ts::AbstractDatagramOutputPlugin::sendPackets(const TSPacket* pkt, size_t p
         }
 
         // Insert the RTP timestamp in RTP clock units.
-        PutUInt32(&buffer[4], uint32_t((rtp_pcr * RTP_RATE_MP2T) / SYSTEM_CLOCK_FREQ));
+        PutUInt32(buffer + 4, uint32_t((rtp_pcr * RTP_RATE_MP2T) / SYSTEM_CLOCK_FREQ));
 
         // Remember position and value of last datagram.
         _last_rtp_pcr = rtp_pcr;
         _last_rtp_pcr_pkt = _pkt_count;
 
-        // Copy the TS packets after the RTP header and send the packets.
-        ::memcpy(buffer.data() + RTP_HEADER_SIZE, pkt, packet_count * PKT_SIZE);
-        status = sendDatagram(buffer.data(), buffer.size());
+        // Copy the TS packets after the RTP header.
+        ::memcpy(buffer + RTP_HEADER_SIZE, pkt, packet_count * PKT_SIZE);
+        _dg_addresses[_dg_count] = buffer;
+        _dg_sizes[_dg_count] = RTP_HEADER_SIZE + packet_count * PKT_SIZE;
     }
     else {
         // No RTP, send TS packets directly as datagram.
-        status = sendDatagram(pkt, packet_count * PKT_SIZE);
+        _dg_addresses[_dg_count] = pkt;
+        _dg_sizes[_dg_count] = packet_count * PKT_SIZE;
     }
+    _dg_count++;
 
     // Count packets datagram per datagram.
     _pkt_count += packet_count;
 
-    return status;
+    return true;
 }
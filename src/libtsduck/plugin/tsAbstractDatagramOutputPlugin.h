@@ -34,6 +34,7 @@
 
 #pragma once
 #include "tsOutputPlugin.h"
+#include "tsByteBlock.h"
 
 namespace ts {
     //!
@@ -92,6 +93,17 @@ namespace ts {
         //!
         virtual bool sendDatagram(const void* address, size_t size) = 0;
 
+        //!
+        //! Send several datagram messages at once.
+        //! The default implementation calls sendDatagram() for each datagram.
+        //! Subclasses which can send several datagrams in one operation should override it.
+        //! @param [in] addresses Array of @a count addresses of datagrams.
+        //! @param [in] sizes Array of @a count sizes in bytes of datagrams.
+        //! @param [in] count Number of datagrams to send.
+        //! @return True on success, false on error.
+        //!
+        virtual bool sendDatagrams(const void* const* addresses, const size_t* sizes, size_t count);
+
     private:
         // Configuration and command line options.
         const Options  _flags;              // Configuration flags.
@@ -116,8 +128,16 @@ namespace ts {
         PacketCounter  _pkt_count;          // Total packet counter for output packets
         size_t         _out_count;          // Number of packets in _out_buffer
         TSPacketVector _out_buffer;         // Buffered packets for output with --enforce-burst
+        size_t         _dg_count;           // Number of datagrams in current batch
+        std::vector<const void*> _dg_addresses;  // Addresses of datagrams in current batch
+        std::vector<size_t>      _dg_sizes;      // Sizes of datagrams in current batch
+        ByteBlock      _rtp_buffer;         // Buffer for RTP datagrams in current batch
+
+        // Add a buffer of TS packets as one datagram in the current batch.
+        // The batch is sent when full.
+        bool addDatagram(const TSPacket* packet, size_t count);
 
-        // Send a buffer of TS packets.
-        bool sendPackets(const TSPacket* packet, size_t count);
+        // Send all datagrams in the current batch.
+        bool flushDatagrams();
     };
 }
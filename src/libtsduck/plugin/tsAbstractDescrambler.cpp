@@ -50,6 +50,8 @@ ts::AbstractDescrambler::AbstractDescrambler(TSP* tsp_, const UString& descripti
     _pids(),
     _service(duck, this),
     _stack_usage(stack_usage),
+    _window_size(0),
+    _batch(),
     _demux(duck, nullptr, this),
     _ecm_streams(),
     _scrambled_streams(),
@@ -87,6 +89,13 @@ ts::AbstractDescrambler::AbstractDescrambler(TSP* tsp_, const UString& descripti
          u"mode, the packet processing continues while processing ECM's. This option "
          u"is always on in offline mode.");
 
+    option(u"packet-window", 0, UNSIGNED);
+    help(u"packet-window", u"packet-count",
+         u"Number of packets which are processed together. The packets which use the same control "
+         u"word inside this window are descrambled in one batch, which is much faster with DVB-CSA2. "
+         u"A larger window introduces more latency in the processing. With a zero value, the packets "
+         u"are descrambled one by one. The default is " + UString::Decimal(DEFAULT_PACKET_WINDOW) + u" packets.");
+
     option(u"swap-cw");
     help(u"swap-cw",
         u"Swap even and odd control words from the ECM's. "
@@ -105,6 +114,7 @@ bool ts::AbstractDescrambler::getOptions()
     _service.set(value(u""));
     _synchronous = present(u"synchronous") || !tsp->realtime();
     _swap_cw = present(u"swap-cw");
+    getIntValue(_window_size, u"packet-window", DEFAULT_PACKET_WINDOW);
     getIntValues(_pids, u"pid");
     if (!duck.loadArgs(*this) || !_scrambling.loadArgs(duck, *this)) {
         return false;
@@ -512,14 +522,103 @@ void ts::AbstractDescrambler::ECMThread::main()
 //----------------------------------------------------------------------------
 
 ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    TSScrambling* scrambling = nullptr;
+    ECMStream* ecm = nullptr;
+
+    if (!getDescrambling(pkt, scrambling, ecm)) {
+        return TSP_END;
+    }
+    if (ecm != nullptr && NeedNewCW(*ecm, pkt.getScrambling())) {
+        loadNewCW(*ecm, pkt.getScrambling());
+    }
+
+    // Descramble the packet payload.
+    return scrambling == nullptr || scrambling->decrypt(pkt) ? TSP_OK : TSP_END;
+}
+
+
+//----------------------------------------------------------------------------
+// Packet window processing method.
+//----------------------------------------------------------------------------
+
+size_t ts::AbstractDescrambler::getPacketWindowSize()
+{
+    return _window_size;
+}
+
+size_t ts::AbstractDescrambler::processPacketWindow(TSPacketWindow& win)
+{
+    // Consecutive packets which use the same descrambler and the same control words are
+    // accumulated in _batch and descrambled together. The packets are analyzed in order,
+    // the batch is descrambled before loading new control words in the descrambler.
+    TSScrambling* batch_scrambling = nullptr;
+    size_t batch_start = 0;
+    _batch.clear();
+
+    for (size_t index = 0; index < win.size(); ++index) {
+
+        // Skip dropped packets.
+        TSPacket* pkt = win.packet(index);
+        if (pkt == nullptr) {
+            continue;
+        }
+
+        TSScrambling* scrambling = nullptr;
+        ECMStream* ecm = nullptr;
+        const bool ok = getDescrambling(*pkt, scrambling, ecm);
+        const bool new_cw = ok && ecm != nullptr && NeedNewCW(*ecm, pkt->getScrambling());
+
+        // Descramble the previous packets on error, change of descrambler or new control words.
+        // Packets which are not descrambled do not interrupt the batch.
+        if (!_batch.empty() && (!ok || new_cw || (scrambling != nullptr && scrambling != batch_scrambling))) {
+            if (!batch_scrambling->decrypt(_batch.data(), _batch.size())) {
+                return batch_start;
+            }
+            _batch.clear();
+        }
+        if (!ok) {
+            return index;
+        }
+        if (new_cw) {
+            loadNewCW(*ecm, pkt->getScrambling());
+        }
+        if (scrambling != nullptr) {
+            if (_batch.empty()) {
+                batch_scrambling = scrambling;
+                batch_start = index;
+            }
+            _batch.push_back(pkt);
+        }
+    }
+
+    // Descramble the last packets.
+    if (!_batch.empty() && !batch_scrambling->decrypt(_batch.data(), _batch.size())) {
+        return batch_start;
+    }
+    _batch.clear();
+    return win.size();
+}
+
+
+//----------------------------------------------------------------------------
+// Get the descrambling context of a packet.
+//----------------------------------------------------------------------------
+
+bool ts::AbstractDescrambler::getDescrambling(TSPacket& pkt, TSScrambling*& scrambling, ECMStream*& ecm)
 {
     const PID pid = pkt.getPID();
+    scrambling = nullptr;
+    ecm = nullptr;
 
     // Descramble packets from fixed PID's using fixed control words.
     // If there is a user-specified list of PID's, we don't manage a service
     // and there is nothing else to do.
     if (_pids.any()) {
-        return !_pids.test(pid) || _scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+        if (_pids.test(pid)) {
+            scrambling = &_scrambling;
+        }
+        return true;
     }
 
     // Filter sections to locate the service and grab ECM's.
@@ -528,27 +627,28 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
 
     // If the service is definitely unknown or a fatal error occured during table analysis, give up.
     if (_abort || _service.nonExistentService()) {
-        return TSP_END;
+        return false;
     }
 
     // Get scrambling_control_value in packet.
-    uint8_t scv = pkt.getScrambling();
+    const uint8_t scv = pkt.getScrambling();
 
     // If the packet has no payload or is clear, there is nothing to descramble.
     if (!pkt.hasPayload() || (scv != SC_EVEN_KEY && scv != SC_ODD_KEY)) {
-        return TSP_OK;
+        return true;
     }
 
     // Without ECM's, we descramble using fixed control words.
     if (!_need_ecm) {
-        return _scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+        scrambling = &_scrambling;
+        return true;
     }
 
     // Get PID context. If the PID is not known as a scrambled PID,
     // with a corresponding ECM stream, we cannot descramble it.
     ScrambledStreamMap::iterator ssit = _scrambled_streams.find(pid);
     if (ssit == _scrambled_streams.end()) {
-        return TSP_OK;
+        return true;
     }
     ScrambledStream& ss(ssit->second);
 
@@ -561,38 +661,40 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
             pecm.clear();
         }
     }
-    if (pecm.isNull()) {
-        // No ECM stream has valid Control Word now, cannot descramble
-        return TSP_OK;
+    if (!pecm.isNull()) {
+        // The ECM stream remains in _ecm_streams, the pointer remains valid.
+        ecm = pecm.pointer();
+        scrambling = &ecm->scrambling;
     }
+    // Without ECM stream with valid Control Word now, we cannot descramble.
+    return true;
+}
 
-    // We found a valid CW, check if new CW were deciphered and store them in the descrambler.
-    // Flags new_cw_even/odd are "write-protected, read-volatile", no mutex needed.
-    if ((scv == SC_EVEN_KEY && pecm->new_cw_even) || (scv == SC_ODD_KEY && pecm->new_cw_odd)) {
 
-        // A new CW was deciphered.
-        // In asynchronous mode, the CW are accessed under mutex protection.
-        if (!_synchronous) {
-            _mutex.acquire();
-        }
+//----------------------------------------------------------------------------
+// Load a new control word in the descrambler of an ECM stream.
+//----------------------------------------------------------------------------
 
-        // Store the new CW in the descrambler.
-        if (scv == SC_EVEN_KEY) {
-            pecm->scrambling.setScramblingType(pecm->cw_even.scrambling, false);
-            pecm->scrambling.setCW(pecm->cw_even.cw, SC_EVEN_KEY);
-            pecm->new_cw_even = false;
-        }
-        else {
-            pecm->scrambling.setScramblingType(pecm->cw_odd.scrambling, false);
-            pecm->scrambling.setCW(pecm->cw_odd.cw, SC_ODD_KEY);
-            pecm->new_cw_odd = false;
-        }
+void ts::AbstractDescrambler::loadNewCW(ECMStream& ecm, uint8_t scv)
+{
+    // In asynchronous mode, the CW are accessed under mutex protection.
+    if (!_synchronous) {
+        _mutex.acquire();
+    }
 
-        if (!_synchronous) {
-            _mutex.release();
-        }
+    // Store the new CW in the descrambler.
+    if (scv == SC_EVEN_KEY) {
+        ecm.scrambling.setScramblingType(ecm.cw_even.scrambling, false);
+        ecm.scrambling.setCW(ecm.cw_even.cw, SC_EVEN_KEY);
+        ecm.new_cw_even = false;
+    }
+    else {
+        ecm.scrambling.setScramblingType(ecm.cw_odd.scrambling, false);
+        ecm.scrambling.setCW(ecm.cw_odd.cw, SC_ODD_KEY);
+        ecm.new_cw_odd = false;
     }
 
-    // Descramble the packet payload.
-    return pecm->scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+    if (!_synchronous) {
+        _mutex.release();
+    }
 }
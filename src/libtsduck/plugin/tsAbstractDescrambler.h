@@ -61,7 +61,9 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual bool stop() override;
+        virtual size_t getPacketWindowSize() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     protected:
         //!
@@ -70,6 +72,11 @@ namespace ts {
         //!
         static const size_t DEFAULT_ECM_THREAD_STACK_USAGE = 128 * 1024;
 
+        //!
+        //! Default number of packets which are processed together (option -\-packet-window).
+        //!
+        static const size_t DEFAULT_PACKET_WINDOW = 128;
+
         //!
         //! Constructor for subclasses.
         //! @param [in] tsp Object to communicate with the Transport Stream Processor main executable.
@@ -259,6 +266,18 @@ namespace ts {
         // Analyze a list of descriptors from the PMT, looking for ECM PID's
         void analyzeDescriptors(const DescriptorList& dlist, std::set<PID>& ecm_pids, uint8_t& scrambling);
 
+        // Get the descrambling context of a packet. Return false if the processing must stop.
+        // Set scrambling to null if the packet shall not be descrambled. Set ecm to the
+        // ECM stream which provides the control words, null if fixed control words are used.
+        bool getDescrambling(TSPacket& pkt, TSScrambling*& scrambling, ECMStream*& ecm);
+
+        // Check if new control words must be loaded before descrambling a packet with this scrambling control value.
+        // Flags new_cw_even/odd are "write-protected, read-volatile", no mutex needed.
+        static bool NeedNewCW(const ECMStream& ecm, uint8_t scv) { return (scv == SC_EVEN_KEY && ecm.new_cw_even) || (scv == SC_ODD_KEY && ecm.new_cw_odd); }
+
+        // Load the new control word for a scrambling control value in the descrambler of the ECM stream.
+        void loadNewCW(ECMStream& ecm, uint8_t scv);
+
         // Abstract descrambler private data.
         bool               _use_service;       // Descramble a service (ie. not a specific list of PID's).
         bool               _need_ecm;          // We need to get control words from ECM's.
@@ -269,6 +288,8 @@ namespace ts {
         PIDSet             _pids;              // Explicit PID's to descramble.
         ServiceDiscovery   _service;           // Service to descramble (by name, id or none).
         size_t             _stack_usage;       // Stack usage for ECM deciphering.
+        size_t             _window_size;       // Packet window size, zero for packet per packet processing.
+        std::vector<TSPacket*> _batch;         // Packets which are descrambled together in a packet window.
         SectionDemux       _demux;             // Section demux to extract ECM's.
         ECMStreamMap       _ecm_streams;       // ECM streams, indexed by PID.
         ScrambledStreamMap _scrambled_streams; // Scrambled streams, indexed by PID.
@@ -29,6 +29,7 @@
 
 #include "tsFileInputPlugin.h"
 #include "tsPluginRepository.h"
+#include "tsTSFileIndex.h"
 #include "tsAlgorithm.h"
 
 TS_REGISTER_INPUT_PLUGIN(u"file", ts::FileInputPlugin);
@@ -52,8 +53,12 @@ ts::FileInputPlugin::FileInputPlugin(TSP* tsp_) :
     _current_file(0),
     _repeat_count(1),
     _start_offset(0),
+    _use_index(false),
+    _start_intra(false),
+    _start_time(0),
     _base_label(0),
     _file_format(TSPacketFormat::AUTODETECT),
+    _read_mode(TSFileReadMode::STREAM),
     _filenames(),
     _start_stuffing(),
     _stop_stuffing(),
@@ -126,6 +131,31 @@ ts::FileInputPlugin::FileInputPlugin(TSP* tsp_) :
          u"Start reading each file at the specified TS packet (default: 0). "
          u"This option is allowed only if all input files are regular files.");
 
+    option(u"read-mode", 0, TSFileReadModeEnum);
+    help(u"read-mode", u"name",
+         u"Specify how the input files are read. "
+         u"The default is \"stream\", sequential read operations through the system cache. "
+         u"With \"mmap\", the files are read through sliding memory-mapped windows, "
+         u"with read-ahead of the next window. Repeating or seeking the files does not need any system call. "
+         u"With \"direct\", the files are read in large aligned blocks, bypassing the system cache. "
+         u"This is useful to replay huge files without polluting the system cache. "
+         u"The alternative read modes apply to regular files only and are not available on all operating systems. "
+         u"When they cannot be used, the standard read mode is silently used instead.");
+
+    option(u"start-intra");
+    help(u"start-intra",
+         u"Start reading each file at the first video intra-frame (random access point), "
+         u"at or after the time which is specified by --start-time, if any. "
+         u"The position of the intra-frame is found in the index of the file, as built by the command tsindex. "
+         u"This option is allowed only if all input files are regular files.");
+
+    option(u"start-time", 0, UNSIGNED);
+    help(u"start-time", u"milliseconds",
+         u"Start reading each file at the specified time from the beginning of the file. "
+         u"The time is based on the PCR's of the file. The corresponding position in the file "
+         u"is found in the index of the file, as built by the command tsindex. "
+         u"This option is allowed only if all input files are regular files.");
+
     option(u"repeat", 'r', POSITIVE);
     help(u"repeat",
          u"Repeat the playout of each file the specified number of times (default: only once). "
@@ -143,11 +173,15 @@ bool ts::FileInputPlugin::getOptions()
     getValues(_filenames);
     _repeat_count = present(u"infinite") ? 0 : intValue<size_t>(u"repeat", 1);
     _start_offset = intValue<uint64_t>(u"byte-offset", intValue<uint64_t>(u"packet-offset", 0) * PKT_SIZE);
+    _start_intra = present(u"start-intra");
+    _use_index = _start_intra || present(u"start-time");
+    getIntValue(_start_time, u"start-time", 0);
     _interleave = present(u"interleave");
     _first_terminate = present(u"first-terminate");
     getIntValue(_interleave_chunk, u"interleave", 1);
     getIntValue(_base_label, u"label-base", TSPacketMetadata::LABEL_MAX + 1);
     getIntValue(_file_format, u"format", TSPacketFormat::AUTODETECT);
+    getIntValue(_read_mode, u"read-mode", TSFileReadMode::STREAM);
     getIntValues(_start_stuffing, u"add-start-stuffing");
     getIntValues(_stop_stuffing, u"add-stop-stuffing");
 
@@ -169,6 +203,15 @@ bool ts::FileInputPlugin::getOptions()
         return false;
     }
 
+    if (_use_index && (present(u"byte-offset") || present(u"packet-offset"))) {
+        tsp->error(u"--start-time and --start-intra are incompatible with --byte-offset and --packet-offset");
+        return false;
+    }
+    if (_use_index && std::find(_filenames.begin(), _filenames.end(), UString()) != _filenames.end()) {
+        tsp->error(u"--start-time and --start-intra cannot be used with the standard input");
+        return false;
+    }
+
     // Make sure start and stop stuffing vectors have the same size as the file vector.
     // If the vectors must be enlarged, repeat the last value in the array.
     _start_stuffing.resize(_filenames.size(), _start_stuffing.empty() ? 0 : _start_stuffing.back());
@@ -194,11 +237,28 @@ bool ts::FileInputPlugin::openFile(size_t name_index, size_t file_index)
         tsp->verbose(u"reading file %s", {name.empty() ? u"'stdin'" : name});
     }
 
-    // Preset artificial stuffing.
+    // Preset artificial stuffing and read mode.
     _files[file_index].setStuffing(_start_stuffing[name_index], _stop_stuffing[name_index]);
+    _files[file_index].setReadMode(_read_mode);
+
+    // With --start-time or --start-intra, get the start offset of the file from its index.
+    uint64_t start_offset = _start_offset;
+    if (_use_index) {
+        TSFileIndex index;
+        if (!index.load(name, *tsp)) {
+            return false;
+        }
+        PacketCounter packet = index.packetAtTime(_start_time);
+        if (_start_intra && !index.nextEvent(packet, TSFileIndex::EventType::INTRA_FRAME, packet)) {
+            tsp->error(u"no video intra-frame after %'d ms in %s", {_start_time, name});
+            return false;
+        }
+        tsp->verbose(u"%s: starting at packet %'d", {name, packet});
+        start_offset = packet * index.filePacketSize();
+    }
 
     // Actually open the file.
-    return _files[file_index].openRead(name, _repeat_count, _start_offset, *tsp, _file_format);
+    return _files[file_index].openRead(name, _repeat_count, start_offset, *tsp, _file_format);
 }
 
 
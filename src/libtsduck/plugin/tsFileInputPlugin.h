@@ -73,8 +73,12 @@ namespace ts {
         size_t         _current_file;       // Current file index in _files. Depends on _interleave.
         size_t         _repeat_count;
         uint64_t       _start_offset;
+        bool           _use_index;          // Compute start offset from index of file.
+        bool           _start_intra;        // Start at first video intra-frame.
+        MilliSecond    _start_time;         // Start at this time in file.
         size_t         _base_label;
         TSPacketFormat _file_format;
+        TSFileReadMode _read_mode;
         UStringVector  _filenames;
         std::vector<size_t>  _start_stuffing;
         std::vector<size_t>  _stop_stuffing;
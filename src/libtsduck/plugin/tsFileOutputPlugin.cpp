@@ -38,6 +38,7 @@ TS_REGISTER_OUTPUT_PLUGIN(u"file", ts::FileOutputPlugin);
 const int ts::FileOutputPlugin::REFERENCE = 0;
 
 #define DEF_RETRY_INTERVAL 2000 // milliseconds
+#define DEF_WB_COUNT          16 // write-behind buffers
 
 
 //----------------------------------------------------------------------------
@@ -57,6 +58,8 @@ ts::FileOutputPlugin::FileOutputPlugin(TSP* tsp_) :
     _max_size(0),
     _max_duration(0),
     _multiple_files(false),
+    _wb_count(0),
+    _wb_size(0),
     _file(),
     _name_gen(),
     _current_size(0),
@@ -122,6 +125,22 @@ ts::FileOutputPlugin::FileOutputPlugin(TSP* tsp_) :
          u"Then, the integer part is incremented. "
          u"Example: if the specified file name is foo-027.ts, the various files are named foo-027.ts, foo-028.ts, etc.\n\n"
          u"The options --max-duration and --max-size are mutually exclusive.");
+
+    option(u"write-behind", 0, INTEGER, 0, 1, 2, 1024, true);
+    help(u"write-behind", u"count",
+         u"Write the file asynchronously, in an internal thread. "
+         u"The output packets are copied into a ring of buffers and the output plugin is blocked "
+         u"only when all buffers are waiting to be written. This prevents a temporarily slow disk "
+         u"from blocking the complete processing chain. "
+         u"The optional value is the number of buffers in the ring (default: " + UString::Decimal(DEF_WB_COUNT) + u"). "
+         u"The write latency and the number of times the output was blocked are reported in verbose mode. "
+         u"A write error is reported on the next output operation.");
+
+    option(u"write-buffer-size", 0, INTEGER, 0, 1, PKT_SIZE, 256 * 1024 * 1024);
+    help(u"write-buffer-size", u"bytes",
+         u"With --write-behind, specify the size in bytes of each buffer in the ring. "
+         u"The size is rounded up to a multiple of 4096 bytes (memory page size). "
+         u"The default is " + UString::Decimal(TSFile::DEFAULT_WRITE_BEHIND_BUFFER_SIZE) + u" bytes.");
 }
 
 
@@ -141,6 +160,8 @@ bool ts::FileOutputPlugin::getOptions()
     getIntValue(_max_size, u"max-size", 0);
     getIntValue(_max_duration, u"max-duration", 0);
     _multiple_files = _max_size > 0 || _max_duration > 0;
+    getIntValue(_wb_count, u"write-behind", present(u"write-behind") ? DEF_WB_COUNT : 0);
+    getIntValue(_wb_size, u"write-buffer-size", TSFile::DEFAULT_WRITE_BEHIND_BUFFER_SIZE);
 
     _flags = TSFile::WRITE | TSFile::SHARED;
     if (present(u"append")) {
@@ -177,6 +198,7 @@ bool ts::FileOutputPlugin::start()
     }
 
     _file.setStuffing(_start_stuffing, _stop_stuffing);
+    _file.setWriteBehind(_wb_count, _wb_size);
     size_t retry_allowed = _retry_max == 0 ? std::numeric_limits<size_t>::max() : _retry_max;
     return openAndRetry(false, retry_allowed);
 }
@@ -188,7 +210,18 @@ bool ts::FileOutputPlugin::start()
 
 bool ts::FileOutputPlugin::stop()
 {
-    return _file.close(*tsp);
+    const bool ok = _file.close(*tsp);
+
+    // Report write-behind statistics.
+    if (_wb_count > 0) {
+        TSFile::WriteBehindStatus st;
+        _file.getWriteBehindStatus(st);
+        tsp->verbose(u"write-behind: %'d write operations, %'d bytes, average latency: %'d us, max latency: %'d us",
+                     {st.write_count, st.write_bytes, st.write_count == 0 ? 0 : st.write_time / NanoSecond(st.write_count) / NanoSecPerMicroSec, st.max_write_time / NanoSecPerMicroSec});
+        tsp->verbose(u"write-behind: output blocked %'d times, total blocked time: %'d ms, max queued buffers: %d/%d",
+                     {st.blocked_count, st.blocked_time / NanoSecPerMilliSec, st.max_queued, _wb_count});
+    }
+    return ok;
 }
 
 
@@ -76,6 +76,8 @@ namespace ts {
         uint64_t          _max_size;
         Second            _max_duration;
         bool              _multiple_files;
+        size_t            _wb_count;
+        size_t            _wb_size;
 
         // Working data:
         TSFile            _file;
@@ -37,6 +37,9 @@ TS_REGISTER_INPUT_PLUGIN(u"ip", ts::IPInputPlugin);
 // A dummy storage value to force inclusion of this module when using the static library.
 const int ts::IPInputPlugin::REFERENCE = 0;
 
+// Maximum number of datagrams to receive at once.
+#define MAX_DATAGRAMS 16
+
 
 //----------------------------------------------------------------------------
 // Input constructor
@@ -45,11 +48,20 @@ const int ts::IPInputPlugin::REFERENCE = 0;
 ts::IPInputPlugin::IPInputPlugin(TSP* tsp_) :
     AbstractDatagramInputPlugin(tsp_, IP_MAX_PACKET_SIZE, u"Receive TS packets from UDP/IP, multicast or unicast", u"[options] [address:]port",
                                 u"kernel", u"A kernel-provided time-stamp for the packet, when available (Linux only)",
-                                true), // real-time network reception
-    _sock(*tsp_)
+                                true, // real-time network reception
+                                MAX_DATAGRAMS),
+    _sock(*tsp_),
+    _recv_offload(false),
+    _msgs(MAX_DATAGRAMS)
 {
     // Add UDP receiver common options.
     _sock.defineArgs(*this);
+
+    option(u"receive-offload");
+    help(u"receive-offload",
+         u"Enable UDP Generic Receive Offload (GRO). The kernel coalesces consecutive datagrams "
+         u"from the same sender into large messages which are received at once. This reduces "
+         u"the system overhead on high bitrate streams. Linux only, ignored on other systems.");
 }
 
 
@@ -60,6 +72,7 @@ ts::IPInputPlugin::IPInputPlugin(TSP* tsp_) :
 bool ts::IPInputPlugin::getOptions()
 {
     // Get command line arguments for superclass and socket.
+    _recv_offload = present(u"receive-offload");
     return AbstractDatagramInputPlugin::getOptions() && _sock.loadArgs(duck, *this);
 }
 
@@ -71,7 +84,9 @@ bool ts::IPInputPlugin::getOptions()
 bool ts::IPInputPlugin::start()
 {
     // Initialize superclass and UDP socket.
-    return AbstractDatagramInputPlugin::start() && _sock.open(*tsp);
+    return AbstractDatagramInputPlugin::start() &&
+           _sock.open(*tsp) &&
+           (!_recv_offload || _sock.setReceiveCoalescing(true, *tsp));
 }
 
 
@@ -121,3 +136,42 @@ bool ts::IPInputPlugin::receiveDatagram(uint8_t* buffer, size_t buffer_size, siz
     IPv4SocketAddress destination;
     return _sock.receive(buffer, buffer_size, ret_size, sender, destination, tsp, *tsp, &timestamp);
 }
+
+
+//----------------------------------------------------------------------------
+// Input method: receive several datagrams at once.
+//----------------------------------------------------------------------------
+
+bool ts::IPInputPlugin::receiveDatagrams(uint8_t* buffer,
+                                         size_t buffer_size,
+                                         size_t max_count,
+                                         size_t* ret_sizes,
+                                         MicroSecond* timestamps,
+                                         size_t* segment_sizes,
+                                         size_t& ret_count)
+{
+    // Datagram N is received in slot N of the buffer.
+    max_count = std::min(max_count, _msgs.size());
+    for (size_t i = 0; i < max_count; ++i) {
+        _msgs[i].data = buffer + i * buffer_size;
+        _msgs[i].max_size = buffer_size;
+    }
+
+    if (!_sock.receiveBatch(_msgs.data(), max_count, ret_count, tsp, *tsp)) {
+        ret_count = 0;
+        return false;
+    }
+
+    // The socket may have filtered out some messages and compacted the array.
+    // Make sure that datagram N is in slot N. Messages are always moved downward.
+    for (size_t i = 0; i < ret_count; ++i) {
+        uint8_t* const slot = buffer + i * buffer_size;
+        if (_msgs[i].data != slot) {
+            ::memmove(slot, _msgs[i].data, _msgs[i].size);
+        }
+        ret_sizes[i] = _msgs[i].size;
+        timestamps[i] = _msgs[i].timestamp;
+        segment_sizes[i] = _msgs[i].segment_size;
+    }
+    return true;
+}
@@ -66,8 +66,17 @@ namespace ts {
     protected:
         // Implementation of AbstractDatagramInputPlugin.
         virtual bool receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, MicroSecond& timestamp) override;
+        virtual bool receiveDatagrams(uint8_t* buffer,
+                                      size_t buffer_size,
+                                      size_t max_count,
+                                      size_t* ret_sizes,
+                                      MicroSecond* timestamps,
+                                      size_t* segment_sizes,
+                                      size_t& ret_count) override;
 
     private:
-        UDPReceiver _sock; // Incoming socket with associated command line options.
+        UDPReceiver _sock;          // Incoming socket with associated command line options.
+        bool        _recv_offload;  // Use UDP receive offload.
+        std::vector<UDPSocket::ReceivedMessage> _msgs;  // Descriptions of messages in a batch.
     };
 }
@@ -49,6 +49,7 @@ ts::IPOutputPlugin::IPOutputPlugin(TSP* tsp_) :
     _ttl(0),
     _tos(-1),
     _force_mc_local(false),
+    _send_offload(false),
     _sock(false, *tsp_)
 {
     option(u"", 0, STRING, 1, 1);
@@ -79,6 +80,13 @@ ts::IPOutputPlugin::IPOutputPlugin(TSP* tsp_) :
          u"Specify the local UDP source port for outgoing packets. "
          u"By default, a random source port is used.");
 
+    option(u"segmentation-offload");
+    help(u"segmentation-offload",
+         u"Enable UDP Generic Segmentation Offload (GSO). Consecutive datagrams of the same size "
+         u"are passed to the kernel as one large buffer and the kernel or the network interface "
+         u"splits it into individual datagrams. This reduces the system overhead on high bitrate "
+         u"streams. Linux only, ignored on other systems.");
+
     option(u"tos", 's', INTEGER, 0, 1, 1, 255);
     help(u"tos",
          u"Specifies the TOS (Type-Of-Service) socket option. Setting this value "
@@ -120,6 +128,7 @@ bool ts::IPOutputPlugin::getOptions()
     getIntValue(_ttl, u"ttl", 0);
     getIntValue(_tos, u"tos", -1);
     _force_mc_local = present(u"force-local-multicast-outgoing");
+    _send_offload = present(u"segmentation-offload");
 
     return success;
 }
@@ -143,7 +152,8 @@ bool ts::IPOutputPlugin::start()
         !_sock.setDefaultDestination(_destination, *tsp) ||
         (_force_mc_local && _destination.isMulticast() && _local_addr.hasAddress() && !_sock.setOutgoingMulticast(_local_addr, *tsp)) ||
         (_tos >= 0 && !_sock.setTOS(_tos, *tsp)) ||
-        (_ttl > 0 && !_sock.setTTL(_ttl, *tsp)))
+        (_ttl > 0 && !_sock.setTTL(_ttl, *tsp)) ||
+        (_send_offload && !_sock.setSendSegmentation(true, *tsp)))
     {
         _sock.close(*tsp);
         return false;
@@ -173,3 +183,13 @@ bool ts::IPOutputPlugin::sendDatagram(const void* address, size_t size)
 {
     return _sock.send(address, size, *tsp);
 }
+
+
+//----------------------------------------------------------------------------
+// Implementation of AbstractDatagramOutputPlugin: send several datagrams.
+//----------------------------------------------------------------------------
+
+bool ts::IPOutputPlugin::sendDatagrams(const void* const* addresses, const size_t* sizes, size_t count)
+{
+    return _sock.sendBatch(addresses, sizes, count, *tsp);
+}
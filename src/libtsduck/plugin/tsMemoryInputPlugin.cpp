@@ -29,7 +29,7 @@
 
 #include "tsMemoryInputPlugin.h"
 #include "tsPluginRepository.h"
-#include "tsPluginEventData.h"
+#include "tsPluginEventPacketData.h"
 
 TS_REGISTER_INPUT_PLUGIN(u"memory", ts::MemoryInputPlugin);
 
@@ -52,7 +52,7 @@ ts::MemoryInputPlugin::MemoryInputPlugin(TSP* tsp_) :
     option(u"event-code", 'e', UINT32);
     help(u"event-code",
          u"Signal a plugin event with the specified code each time the plugin needs input packets. "
-         u"The event data is an instance of PluginEventData pointing to the input buffer. "
+         u"The event data is an instance of PluginEventPacketData pointing to the input buffer and metadata. "
          u"The application shall handle the event, waiting for input packets as long as necessary. "
          u"Returning zero packet (or not handling the event) means end if input.");
 }
@@ -75,8 +75,8 @@ bool ts::MemoryInputPlugin::getOptions()
 
 size_t ts::MemoryInputPlugin::receive(TSPacket* buffer, TSPacketMetadata* metadata, size_t max_packets)
 {
-    // Prepare an event data block pointing to the input buffer.
-    PluginEventData data(buffer->b, 0, PKT_SIZE * max_packets);
+    // Prepare an event data block pointing to the input buffer and metadata, in place.
+    PluginEventPacketData data(buffer, metadata, 0, max_packets);
     tsp->signalPluginEvent(_event_code, &data);
-    return data.size() / PKT_SIZE;
+    return data.packetCount();
 }
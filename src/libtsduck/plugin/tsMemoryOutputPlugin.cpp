@@ -29,7 +29,7 @@
 
 #include "tsMemoryOutputPlugin.h"
 #include "tsPluginRepository.h"
-#include "tsPluginEventData.h"
+#include "tsPluginEventPacketData.h"
 
 TS_REGISTER_OUTPUT_PLUGIN(u"memory", ts::MemoryOutputPlugin);
 
@@ -52,7 +52,7 @@ ts::MemoryOutputPlugin::MemoryOutputPlugin(TSP* tsp_) :
     option(u"event-code", 'e', UINT32);
     help(u"event-code",
          u"Signal a plugin event with the specified code each time the plugin output packets. "
-         u"The event data is an instance of PluginEventData pointing to the output packets. "
+         u"The event data is an instance of PluginEventPacketData pointing to the output packets and metadata. "
          u"If an event handler sets the error indicator in the event data, the transmission is aborted.");
 }
 
@@ -74,8 +74,8 @@ bool ts::MemoryOutputPlugin::getOptions()
 
 bool ts::MemoryOutputPlugin::send(const TSPacket* packets, const TSPacketMetadata* metadata, size_t packet_count)
 {
-    // Prepare an event data block pointing to the output packets.
-    PluginEventData data(packets->b, PKT_SIZE * packet_count);
+    // Prepare an event data block pointing to the output packets and metadata, in place.
+    PluginEventPacketData data(packets, metadata, packet_count);
     tsp->signalPluginEvent(_event_code, &data);
     return !data.hasError();
 }
@@ -45,6 +45,12 @@ constexpr ts::BitRate::int_t ts::MuxerArgs::DEFAULT_PSI_BITRATE;
 #endif
 
 
+const ts::Enumeration ts::MuxSchedulingEnum({
+    {u"round-robin", int(ts::MuxScheduling::ROUND_ROBIN)},
+    {u"deadline",    int(ts::MuxScheduling::DEADLINE)},
+});
+
+
 //----------------------------------------------------------------------------
 // Constructors.
 //----------------------------------------------------------------------------
@@ -76,6 +82,7 @@ ts::MuxerArgs::MuxerArgs() :
     sdtScope(TableScope::ACTUAL),
     eitScope(TableScope::ACTUAL),
     timeInputIndex(NPOS),
+    scheduling(MuxScheduling::DEADLINE),
     duckArgs()
 {
 }
@@ -185,6 +192,16 @@ void ts::MuxerArgs::defineArgs(Args& args) const
               u"In case of initial restart error, wait the specified delay before retrying. "
               u"The default is " + UString::Decimal(DEFAULT_RESTART_DELAY) + u" milliseconds.");
 
+    args.option(u"scheduling", 0, MuxSchedulingEnum);
+    args.help(u"scheduling", u"name",
+              u"Specify how packets from the input streams are scheduled in the output stream. "
+              u"With \"deadline\", the default, the bitrate of each input stream is evaluated from its PCR's "
+              u"and the transport buffer of each input stream is modeled as in the MPEG T-STD (512 bytes, "
+              u"leak rate of 1.2 times the input bitrate). The input packets are inserted by earliest deadline "
+              u"when the transport buffer model can accept them. This avoids bursts of packets from one input. "
+              u"With \"round-robin\", the input streams are polled in turn and packets are inserted as soon "
+              u"as they are available.");
+
     args.option(u"sdt", 0, TableScopeEnum);
     args.help(u"sdt", u"type",
               u"Specify which type of SDT shall be merged in the output stream. The default is \"actual\".");
@@ -239,6 +256,7 @@ bool ts::MuxerArgs::loadArgs(DuckContext& duck, Args& args)
     args.getIntValue(sdtScope, u"sdt", TableScope::ACTUAL);
     args.getIntValue(eitScope, u"eit", TableScope::ACTUAL);
     args.getIntValue(timeInputIndex, u"time-reference-input", NPOS);
+    args.getIntValue(scheduling, u"scheduling", MuxScheduling::DEADLINE);
     args.getValue(patBitRate, u"pat-bitrate", DEFAULT_PSI_BITRATE);
     args.getValue(catBitRate, u"cat-bitrate", DEFAULT_PSI_BITRATE);
     args.getValue(nitBitRate, u"nit-bitrate", DEFAULT_PSI_BITRATE);
@@ -37,6 +37,19 @@
 #include "tsPluginOptions.h"
 
 namespace ts {
+    //!
+    //! Scheduling method of input packets in a transport stream multiplexer.
+    //!
+    enum class MuxScheduling {
+        ROUND_ROBIN,  //!< Poll input streams in turn, insert packets as soon as they are available.
+        DEADLINE,     //!< Model the transport buffer of each input stream, insert packets by earliest deadline.
+    };
+
+    //!
+    //! Enumeration description of ts::MuxScheduling.
+    //!
+    TSDUCKDLL extern const Enumeration MuxSchedulingEnum;
+
     //!
     //! Transport stream multiplexer command-line options.
     //! @ingroup plugin
@@ -70,6 +83,7 @@ namespace ts {
         TableScope             sdtScope;           //!< Type of SDT to filter.
         TableScope             eitScope;           //!< Type of EIT to filter.
         size_t                 timeInputIndex;     //!< Index of input plugin from which the TDT/TOT PID is used. By default, use the first found.
+        MuxScheduling          scheduling;         //!< Scheduling method of input packets.
         DuckContext::SavedArgs duckArgs;           //!< Default TSDuck context options for all plugins. Each plugin can override them in its context.
 
         static constexpr size_t DEFAULT_MAX_INPUT_PACKETS = 128;      //!< Default maximum input packets to read at a time.
@@ -46,6 +46,39 @@ ts::Plugin::Plugin(TSP* to_tsp, const UString& description, const UString& synta
     tsp(to_tsp),
     duck(to_tsp)
 {
+    // The options --cpu and --numa-node are defined in all plugins.
+    option(u"cpu", 0, INTEGER, 0, UNLIMITED_COUNT, 0, 4095);
+    help(u"cpu", u"cpu1[-cpu2]",
+         u"Run the thread of this plugin on the specified CPU's. "
+         u"Several --cpu options may be specified. "
+         u"This is a generic option which is defined in all plugins. "
+         u"It is implemented on Linux and Windows only.");
+
+    option(u"numa-node", 0, UNSIGNED);
+    help(u"numa-node",
+         u"Run the thread of this plugin on the CPU's of the specified NUMA node. "
+         u"This is a generic option which is defined in all plugins. "
+         u"It is implemented on Linux only.");
+}
+
+
+//----------------------------------------------------------------------------
+// Get the content of the --cpu and --numa-node options.
+//----------------------------------------------------------------------------
+
+bool ts::Plugin::getAffinityOptions(std::set<size_t>& cpus)
+{
+    getIntValues(cpus, u"cpu");
+    if (present(u"numa-node")) {
+        const size_t node = intValue<size_t>(u"numa-node");
+        std::set<size_t> node_cpus;
+        if (!GetNUMANodeCPUs(node, node_cpus)) {
+            error(u"NUMA node %d not found", {node});
+            return false;
+        }
+        cpus.insert(node_cpus.begin(), node_cpus.end());
+    }
+    return true;
 }
 
 
@@ -175,6 +175,13 @@ namespace ts {
         //!
         void resetContext(const DuckContext::SavedArgs& state);
 
+        //!
+        //! Get the content of the --cpu and --numa-node options.
+        //! @param [out] cpus Set of CPU's on which the plugin thread shall run. Empty if none is specified.
+        //! @return True on success, false if the NUMA node does not exist.
+        //!
+        bool getAffinityOptions(std::set<size_t>& cpus);
+
     protected:
         TSP* const  tsp;   //!< The TSP callback structure can be directly accessed by subclasses.
         DuckContext duck;  //!< The TSDuck context with various MPEG/DVB features.
@@ -0,0 +1,60 @@
+//----------------------------------------------------------------------------
+//
+//  TSDuck - The MPEG Transport Stream Toolkit
+//  Copyright (c) 2005-2021, Thierry Lelegard
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions are met:
+//
+//  1. Redistributions of source code must retain the above copyright notice,
+//     this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+//  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+//  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+//  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+//  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+//  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+//  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+//  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+//  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+//  THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "tsPluginEventPacketData.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::PluginEventPacketData::PluginEventPacketData(const TSPacket* packets, const TSPacketMetadata* metadata, size_t count) :
+    PluginEventData(packets == nullptr ? nullptr : packets->b, PKT_SIZE * count),
+    _metadata(const_cast<TSPacketMetadata*>(metadata))
+{
+}
+
+ts::PluginEventPacketData::PluginEventPacketData(TSPacket* packets, TSPacketMetadata* metadata, size_t count, size_t max_count) :
+    PluginEventData(packets == nullptr ? nullptr : packets->b, PKT_SIZE * count, PKT_SIZE * max_count),
+    _metadata(metadata)
+{
+}
+
+ts::PluginEventPacketData::~PluginEventPacketData()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Get the address of the metadata of one TS packet.
+//----------------------------------------------------------------------------
+
+const ts::TSPacketMetadata* ts::PluginEventPacketData::packetMetadata(size_t index) const
+{
+    return _metadata == nullptr || index >= (readOnly() ? packetCount() : maxPacketCount()) ? nullptr : _metadata + index;
+}
@@ -0,0 +1,124 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Plugin event data referencing TS packets and their metadata.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPluginEventData.h"
+#include "tsTSPacket.h"
+#include "tsTSPacketMetadata.h"
+
+namespace ts {
+    //!
+    //! Plugin event data referencing TS packets and their metadata in the buffers of a plugin.
+    //! @ingroup plugin
+    //!
+    //! This subclass of PluginEventData is used by plugins which pass ranges of the
+    //! tsp packet buffer and packet metadata buffer to applications, such as the
+    //! @e memory input and output plugins. The binary data of the event are the
+    //! TS packets, in place in the packet buffer. The application can read or update
+    //! them directly, without copy, as long as the event handler is executing.
+    //!
+    class TSDUCKDLL PluginEventPacketData : public PluginEventData
+    {
+        TS_NOBUILD_NOCOPY(PluginEventPacketData);
+    public:
+        //!
+        //! Constructor passing read-only TS packets.
+        //! @param [in] packets Address of the TS packets. It can be a null pointer.
+        //! @param [in] metadata Address of the metadata of the TS packets. It can be a null pointer.
+        //! @param [in] count Number of TS packets.
+        //!
+        PluginEventPacketData(const TSPacket* packets, const TSPacketMetadata* metadata, size_t count);
+
+        //!
+        //! Constructor passing a modifiable buffer of TS packets.
+        //! @param [in] packets Address of the TS packets buffer. It can be a null pointer.
+        //! @param [in] metadata Address of the metadata buffer of the TS packets. It can be a null pointer.
+        //! @param [in] count Initial number of TS packets in the buffer.
+        //! @param [in] max_count Maximum number of TS packets in the buffer. It must not be less than @a count.
+        //!
+        PluginEventPacketData(TSPacket* packets, TSPacketMetadata* metadata, size_t count, size_t max_count);
+
+        //!
+        //! Destructor.
+        //!
+        virtual ~PluginEventPacketData() override;
+
+        //!
+        //! Get the current number of TS packets in the event data.
+        //! @return The current number of TS packets in the event data.
+        //!
+        size_t packetCount() const { return size() / PKT_SIZE; }
+
+        //!
+        //! Get the maximum number of TS packets in the event data.
+        //! @return The maximum number of TS packets in the event data.
+        //!
+        size_t maxPacketCount() const { return maxSize() / PKT_SIZE; }
+
+        //!
+        //! Get the address of the read-only packet metadata.
+        //! @return The address of the metadata of the TS packets or a null pointer if there is none.
+        //!
+        const TSPacketMetadata* metadata() const { return _metadata; }
+
+        //!
+        //! Get the address of the modifiable packet metadata.
+        //! When the event data are not read-only, the application may update the metadata
+        //! of the TS packets, within the limits of maxPacketCount().
+        //! @return The address of the metadata of the TS packets or a null pointer if there
+        //! is none or if the event data area is read-only.
+        //!
+        TSPacketMetadata* outputMetadata() const { return readOnly() ? nullptr : _metadata; }
+
+        //!
+        //! Get the address of the read-only metadata of one TS packet.
+        //! @param [in] index Index of the TS packet in the event data.
+        //! @return The address of the metadata of the TS packet or a null pointer if there
+        //! is no metadata or @a index is out of range (packetCount() if the event data area
+        //! is read-only, maxPacketCount() otherwise).
+        //!
+        const TSPacketMetadata* packetMetadata(size_t index) const;
+
+        //!
+        //! Get the address of the modifiable metadata of one TS packet.
+        //! @param [in] index Index of the TS packet in the event data, less than maxPacketCount().
+        //! @return The address of the metadata of the TS packet or a null pointer if there
+        //! is no metadata, if the event data area is read-only or @a index is out of range.
+        //!
+        TSPacketMetadata* outputPacketMetadata(size_t index) const { return readOnly() ? nullptr : const_cast<TSPacketMetadata*>(packetMetadata(index)); }
+
+    private:
+        TSPacketMetadata* _metadata;
+    };
+}
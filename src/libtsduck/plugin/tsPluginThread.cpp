@@ -94,6 +94,18 @@ ts::PluginThread::PluginThread(Report* report, const UString& appName, PluginTyp
     // Define thread stack size
     ThreadAttributes attr(attributes);
     attr.setStackSize(STACK_SIZE_OVERHEAD + _shlib->stackUsage());
+
+    // The CPU affinity of the plugin overrides the default one from the application.
+    // On error (invalid NUMA node), the plugin is unusable, same as an allocation error.
+    std::set<size_t> cpus;
+    if (!_shlib->getAffinityOptions(cpus)) {
+        delete _shlib;
+        _shlib = nullptr;
+        return;
+    }
+    if (!cpus.empty()) {
+        attr.setAffinity(cpus);
+    }
     Thread::setAttributes(attr);
 }
 
@@ -44,6 +44,16 @@ ts::ProcessorPlugin::ProcessorPlugin(TSP* tsp_, const UString& description, cons
          u"Other packets are transparently passed to the next plugin, without going through this one. "
          u"Several --only-label options may be specified. "
          u"This is a generic option which is defined in all packet processing plugins.");
+
+    // The option --branch is defined in all packet processing plugins.
+    option(u"branch");
+    help(u"branch",
+         u"Run this plugin in a parallel read-only branch. "
+         u"Consecutive plugins with --branch receive the same packets concurrently, in distinct threads. "
+         u"The packets are passed to the next plugin when all plugins of the branch group have processed them. "
+         u"In a branch, a plugin cannot modify, drop or nullify packets, it can only analyze them. "
+         u"This is typically used to run several monitoring plugins on distinct CPU cores. "
+         u"This is a generic option which is defined in all packet processing plugins.");
 }
 
 
@@ -59,6 +69,16 @@ ts::TSPacketMetadata::LabelSet ts::ProcessorPlugin::getOnlyLabelOption() const
 }
 
 
+//----------------------------------------------------------------------------
+// Get the content of the --branch option (packet processing plugins).
+//----------------------------------------------------------------------------
+
+bool ts::ProcessorPlugin::getBranchOption() const
+{
+    return present(u"branch");
+}
+
+
 //----------------------------------------------------------------------------
 // Default implementations of virtual methods.
 //----------------------------------------------------------------------------
@@ -79,6 +99,28 @@ ts::ProcessorPlugin::Status ts::ProcessorPlugin::processPacket(TSPacket& pkt, TS
 }
 
 
+//----------------------------------------------------------------------------
+// Default implementations of packet batch processing interface.
+//----------------------------------------------------------------------------
+
+bool ts::ProcessorPlugin::usePacketBatch()
+{
+    return false;
+}
+
+void ts::ProcessorPlugin::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    // The default implementation calls processPacket() for each packet.
+    // Note that tsp->pluginPackets() is not incremented for each packet.
+    for (size_t i = 0; i < count; ++i) {
+        status[i] = processPacket(pkt[i], pkt_data[i]);
+        if (status[i] == TSP_END) {
+            break;
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Default implementations of packet window processing interface.
 //----------------------------------------------------------------------------
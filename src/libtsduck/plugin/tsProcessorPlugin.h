@@ -93,6 +93,17 @@ namespace ts {
     //! sizes is larger than the size of the global buffer, the stream processing can enter a deadlock and
     //! stops. The global @c tsp command shall be carefully tuned to avoid that.
     //!
+    //! The third way is the "packet batch method". This is an optimization of the "packet method" for
+    //! simple plugins which are invoked on all packets of high bitrate streams. To trigger this type of
+    //! processing, the plugin class shall override ProcessorPlugin::usePacketBatch() to return true and
+    //! ProcessorPlugin::processPacketBatch(). The application calls processPacketBatch() with a contiguous
+    //! array of packets from the global buffer, instead of calling processPacket() for each packet.
+    //! The batch contains only packets which must be processed by the plugin (packets which were dropped
+    //! by a previous plugin or which are excluded by --only-label are never part of a batch). There is no
+    //! additional latency: the batch contains packets which are already available. The plugin shall also
+    //! override processPacket() with the same processing because processPacket() is still used when the
+    //! "packet window method" is forced (see the environment variable TSP_FORCED_WINDOW_SIZE).
+    //!
     class TSDUCKDLL ProcessorPlugin : public Plugin
     {
         TS_NOBUILD_NOCOPY(ProcessorPlugin);
@@ -153,6 +164,38 @@ namespace ts {
         //!
         virtual size_t processPacketWindow(TSPacketWindow& win);
 
+        //!
+        //! Check if the plugin prefers the "packet batch" processing method.
+        //!
+        //! This method shall be overriden by plugins which implement processPacketBatch().
+        //! It is called once by the application after start() but before processing any packet.
+        //!
+        //! @return True if the TS packets shall be processed using processPacketBatch() instead
+        //! of processPacket(). If this method is not overriden, the default implementation returns false.
+        //!
+        virtual bool usePacketBatch();
+
+        //!
+        //! Packet batch processing interface.
+        //!
+        //! The main application invokes processPacketBatch() to let the plugin process a contiguous
+        //! array of TS packets. The result is equivalent to @a count calls to processPacket() on each
+        //! packet but there is only one virtual call and no per-packet bookkeeping in the application.
+        //!
+        //! During the execution of processPacketBatch(), tsp->pluginPackets() returns the number of
+        //! packets which were processed by the plugin before the first packet of the batch. Plugins
+        //! which need the index of each packet in their stream shall add the index in the batch.
+        //!
+        //! @param [in,out] pkt Address of the first TS packet to process.
+        //! @param [in,out] pkt_data Address of the metadata of the first TS packet.
+        //! @param [out] status Address of an array of @a count values. The plugin shall return the
+        //! processing status of each packet in this array, as if it was returned by processPacket().
+        //! When a packet returns TSP_END, the packet processing is terminated and the statuses
+        //! of all subsequent packets are ignored.
+        //! @param [in] count Number of TS packets in the batch (never zero).
+        //!
+        virtual void processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count);
+
         //!
         //! Get the content of the --only-label options.
         //! The value of the option is fetched each time this method is called.
@@ -160,6 +203,12 @@ namespace ts {
         //!
         TSPacketMetadata::LabelSet getOnlyLabelOption() const;
 
+        //!
+        //! Get the content of the --branch option.
+        //! @return True if the plugin shall run in a parallel read-only branch.
+        //!
+        bool getBranchOption() const;
+
         // Implementation of inherited interface.
         virtual PluginType type() const override;
 
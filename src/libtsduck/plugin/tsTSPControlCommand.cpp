@@ -56,6 +56,16 @@ ts::TSPControlCommand::TSPControlCommand(Report& report) :
 
     arg = command(u"list", u"List all running plugins", u"[options]", flags);
 
+    arg = command(u"metrics", u"Report performance metrics of all plugins", u"[options]", flags | Args::NO_VERBOSE);
+    arg->setIntro(u"Report the performance metrics of all running plugins in Prometheus text format: "
+                  u"processed packets and bytes, dropped packets, time spent processing packets, "
+                  u"time spent waiting for packets and number of packets in the buffer of each plugin. "
+                  u"The counters are cumulated since the start of tsp, use the Prometheus function "
+                  u"rate() to get packets or bytes per second. "
+                  u"The same metrics are also returned to an HTTP GET request on the control port. "
+                  u"Thus, the tsp control port can be directly used as a Prometheus scrape target, "
+                  u"provided that the Prometheus server is allowed using --control-source.");
+
     arg = command(u"suspend", u"Suspend a plugin", u"[options] plugin-index", flags);
     arg->setIntro(u"Suspend a plugin. When a packet processing plugin is suspended, "
                   u"the TS packets are directly passed from the previous to the next plugin, "
@@ -35,6 +35,15 @@
 #include "tsMonotonic.h"
 #include "tsGuardMutex.h"
 
+// Check if a plugin executor is a packet processor with option --branch.
+namespace {
+    bool IsBranchProcessor(ts::tsp::PluginExecutor* proc)
+    {
+        const ts::Plugin* plugin = proc->plugin();
+        return plugin != nullptr && plugin->type() == ts::PluginType::PROCESSOR && static_cast<const ts::ProcessorPlugin*>(plugin)->getBranchOption();
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Constructor and destructor.
@@ -140,10 +149,17 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         // plugin has a hight priority to make room in the buffer, but not as
         // high as the input which must remain the top-most priority?
 
-        _input = new tsp::InputExecutor(_args, *this, _args.input, ThreadAttributes().setPriority(ts::ThreadAttributes::GetMaximumPriority()), _mutex, &_report);
+        // With --numa-node, all threads run by default on the CPU's of the NUMA node.
+        std::set<size_t> cpus;
+        if (_args.numa_node != NPOS && !GetNUMANodeCPUs(_args.numa_node, cpus)) {
+            _report.error(u"NUMA node %d not found", {_args.numa_node});
+            return false;
+        }
+
+        _input = new tsp::InputExecutor(_args, *this, _args.input, ThreadAttributes().setPriority(ts::ThreadAttributes::GetMaximumPriority()).setAffinity(cpus), _mutex, &_report);
         CheckNonNull(_input);
 
-        _output = new tsp::OutputExecutor(_args, *this, _args.output, ThreadAttributes().setPriority(ts::ThreadAttributes::GetHighPriority()), _mutex, &_report);
+        _output = new tsp::OutputExecutor(_args, *this, _args.output, ThreadAttributes().setPriority(ts::ThreadAttributes::GetHighPriority()).setAffinity(cpus), _mutex, &_report);
         CheckNonNull(_output);
 
         _output->ringInsertAfter(_input);
@@ -152,7 +168,7 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         bool realtime = _args.realtime == Tristate::TRUE || _input->isRealTime() || _output->isRealTime();
 
         for (size_t i = 0; i < _args.plugins.size(); ++i) {
-            tsp::PluginExecutor* p = new tsp::ProcessorExecutor(_args, *this, i, ThreadAttributes(), _mutex, &_report);
+            tsp::PluginExecutor* p = new tsp::ProcessorExecutor(_args, *this, i, ThreadAttributes().setAffinity(cpus), _mutex, &_report);
             CheckNonNull(p);
             p->ringInsertBefore(_output);
             realtime = realtime || p->isRealTime();
@@ -187,18 +203,48 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
             }
         } while ((proc = proc->ringNext<ts::tsp::PluginExecutor>()) != _input);
 
+        // Declare groups of consecutive packet processors which run in parallel branches.
+        proc = _input->ringNext<tsp::PluginExecutor>();
+        while (proc != _output) {
+            tsp::PluginExecutor* last = proc;
+            if (IsBranchProcessor(proc)) {
+                tsp::PluginExecutor* next = nullptr;
+                while ((next = last->ringNext<tsp::PluginExecutor>()) != _output && IsBranchProcessor(next)) {
+                    last = next;
+                }
+                _report.debug(u"tsp: parallel branches from %s to %s", {proc->pluginName(), last->pluginName()});
+                for (tsp::PluginExecutor* p = proc; ; p = p->ringNext<tsp::PluginExecutor>()) {
+                    p->setBranch(proc, last);
+                    if (p == last) {
+                        break;
+                    }
+                }
+            }
+            proc = last->ringNext<tsp::PluginExecutor>();
+        }
+
+        // Compute the neighbours of each executor, including branches.
+        proc = _input;
+        do {
+            proc->initNeighbours();
+        } while ((proc = proc->ringNext<ts::tsp::PluginExecutor>()) != _input);
+
         // Allocate a memory-resident buffer of TS packets
-        _packet_buffer = new PacketBuffer(_args.ts_buffer_size / ts::PKT_SIZE);
+        _packet_buffer = new PacketBuffer(_args.ts_buffer_size / ts::PKT_SIZE, _args.numa_node);
         CheckNonNull(_packet_buffer);
         if (!_packet_buffer->isLocked()) {
             _report.verbose(u"tsp: buffer failed to lock into physical memory (%d: %s), risk of real-time issue",
                             {_packet_buffer->lockErrorCode(), ts::SysErrorCodeMessage(_packet_buffer->lockErrorCode())});
         }
+        if (_args.numa_node != NPOS && !_packet_buffer->isNUMABound()) {
+            _report.verbose(u"tsp: buffer failed to allocate on NUMA node %d (%d: %s)",
+                            {_args.numa_node, _packet_buffer->numaErrorCode(), ts::SysErrorCodeMessage(_packet_buffer->numaErrorCode())});
+        }
         _report.debug(u"tsp: buffer size: %'d TS packets, %'d bytes", {_packet_buffer->count(), _packet_buffer->count() * ts::PKT_SIZE});
 
         // Buffer for the packet metadata.
         // A packet and its metadata have the same index in their respective buffer.
-        _metadata_buffer = new PacketMetadataBuffer(_packet_buffer->count());
+        _metadata_buffer = new PacketMetadataBuffer(_packet_buffer->count(), _args.numa_node);
         CheckNonNull(_metadata_buffer);
 
         // End of locked section.
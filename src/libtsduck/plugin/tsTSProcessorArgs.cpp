@@ -53,7 +53,9 @@ ts::TSProcessorArgs::TSProcessorArgs() :
     app_name(),
     ignore_jt(false),
     log_plugin_index(false),
+    lock_free(false),
     ts_buffer_size(DEFAULT_BUFFER_SIZE),
+    numa_node(NPOS),
     max_flush_pkt(0),
     max_input_pkt(0),
     max_output_pkt(NPOS), // unlimited
@@ -174,12 +176,29 @@ void ts::TSProcessorArgs::defineArgs(Args& args) const
               u"a valid bitrate value from the beginning. "
               u"The default initial load is half the size of the global buffer.");
 
+    args.option(u"lock-free");
+    args.help(u"lock-free",
+              u"Use a lock-free handoff of packets between adjacent plugins. "
+              u"By default, all plugin threads synchronize their access to the global "
+              u"packet buffer using one single global lock. With many plugins and high "
+              u"bitrates, the contention on this lock may become significant. "
+              u"With --lock-free, each plugin thread only synchronizes with the previous "
+              u"and next plugins in the chain. An idle thread polls briefly its previous "
+              u"plugin before waiting. This option increases the CPU usage of idle threads.");
+
     args.option(u"log-plugin-index");
     args.help(u"log-plugin-index",
               u"In log messages, add the plugin index to the plugin name. "
               u"This can be useful if the same plugin is used several times "
               u"and all instances log many messages.");
 
+    args.option(u"numa-node", 0, Args::UNSIGNED);
+    args.help(u"numa-node",
+              u"Allocate the global packet buffer on the specified NUMA node and run all plugin threads "
+              u"on the CPU's of this node, unless a plugin specifies its own --cpu or --numa-node option. "
+              u"On servers with several processor sockets, this avoids moving packets between sockets. "
+              u"This option is implemented on Linux only.");
+
     args.option(u"receive-timeout", 0, Args::POSITIVE);
     args.help(u"receive-timeout", u"milliseconds",
               u"Specify a timeout in milliseconds for all input operations. "
@@ -228,7 +247,9 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
 {
     app_name = args.appName();
     log_plugin_index = args.present(u"log-plugin-index");
+    lock_free = args.present(u"lock-free");
     ts_buffer_size = args.intValue<size_t>(u"buffer-size-mb", DEFAULT_BUFFER_SIZE);
+    args.getIntValue(numa_node, u"numa-node", NPOS);
     args.getValue(fixed_bitrate, u"bitrate", 0);
     bitrate_adj = MilliSecPerSec * args.intValue(u"bitrate-adjust-interval", DEF_BITRATE_INTERVAL);
     args.getIntValue(max_flush_pkt, u"max-flushed-packets", 0);
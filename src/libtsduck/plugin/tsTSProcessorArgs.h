@@ -49,7 +49,9 @@ namespace ts {
         UString           app_name;         //!< Application name, for help messages.
         bool              ignore_jt;        //!< Ignore "joint termination" options in plugins.
         bool              log_plugin_index; //!< Log plugin index with plugin name.
+        bool              lock_free;        //!< Use lock-free packet handoff between adjacent plugins instead of a global mutex.
         size_t            ts_buffer_size;   //!< Size in bytes of the global TS packet buffer.
+        size_t            numa_node;        //!< NUMA node for the global buffers and, by default, the plugin threads (NPOS if none).
         size_t            max_flush_pkt;    //!< Max processed packets before flush.
         size_t            max_input_pkt;    //!< Max packets per input operation.
         size_t            max_output_pkt;   //!< Max packets per outsput operation.
@@ -28,7 +28,7 @@
 //----------------------------------------------------------------------------
 
 #include "tspyPluginEventHandler.h"
-#include "tsPluginEventData.h"
+#include "tsPluginEventPacketData.h"
 #include "tspy.h"
 
 
@@ -63,6 +63,42 @@ TSDUCKPY void tspyPyPluginEventHandlerUpdateData(void* obj, void* data, size_t s
     }
 }
 
+// Update the size of a PluginEventData after a direct update of its buffer.
+// Called from the Python callback.
+TSDUCKPY bool tspyPyPluginEventHandlerUpdateSize(void* obj, size_t size)
+{
+    ts::PluginEventData* event_data = reinterpret_cast<ts::PluginEventData*>(obj);
+    return event_data != nullptr && event_data->updateSize(size);
+}
+
+// Get the metadata of a packet in a PluginEventPacketData.
+// Called from the Python callback.
+TSDUCKPY bool tspyPyPluginEventHandlerGetMetadata(void* obj, size_t index, uint32_t* labels, uint64_t* input_time)
+{
+    ts::PluginEventPacketData* event_data = dynamic_cast<ts::PluginEventPacketData*>(reinterpret_cast<ts::PluginEventData*>(obj));
+    const ts::TSPacketMetadata* mdata = event_data == nullptr ? nullptr : event_data->packetMetadata(index);
+    if (mdata != nullptr && labels != nullptr && input_time != nullptr) {
+        *labels = uint32_t(mdata->getLabels().to_ulong());
+        *input_time = mdata->getInputTimeStamp();
+        return true;
+    }
+    return false;
+}
+
+// Set the labels of a packet in a PluginEventPacketData.
+// Called from the Python callback.
+TSDUCKPY bool tspyPyPluginEventHandlerSetLabels(void* obj, size_t index, uint32_t labels)
+{
+    ts::PluginEventPacketData* event_data = dynamic_cast<ts::PluginEventPacketData*>(reinterpret_cast<ts::PluginEventData*>(obj));
+    ts::TSPacketMetadata* mdata = event_data == nullptr ? nullptr : event_data->outputPacketMetadata(index);
+    if (mdata != nullptr) {
+        mdata->clearLabels(ts::TSPacketMetadata::AllLabels);
+        mdata->setLabels(ts::TSPacketMetadata::LabelSet(labels));
+        return true;
+    }
+    return false;
+}
+
 //----------------------------------------------------------------------------
 // Constructors and destructors.
 //----------------------------------------------------------------------------
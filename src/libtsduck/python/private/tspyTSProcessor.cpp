@@ -57,6 +57,7 @@ TSDUCKPY struct tspyTSProcessorArgs
     long bitrate_adjust_interval;  // Bitrate adjust interval in (milliseconds).
     long receive_timeout;          // Timeout on input operations (in milliseconds).
     long log_plugin_index;         // Log plugin index with plugin name (bool).
+    long lock_free;                // Lock-free packet handoff between plugins (bool).
     const uint8_t* plugins;        // Address of UTF-16 multi-strings buffer for plugins.
     size_t plugins_size;           // Size in bytes of plugins multi-strings buffer.
 };
@@ -119,6 +120,7 @@ TSDUCKPY bool tspyStartTSProcessor(void* tsp, const tspyTSProcessorArgs* pyargs)
     args.bitrate_adj = ts::MilliSecond(pyargs->bitrate_adjust_interval);
     args.receive_timeout = ts::MilliSecond(pyargs->receive_timeout);
     args.log_plugin_index = bool(pyargs->log_plugin_index);
+    args.lock_free = bool(pyargs->lock_free);
 
     // Default input and output plugins.
     args.input.set(u"null");
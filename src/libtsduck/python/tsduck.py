@@ -730,6 +730,115 @@ class PluginEventContext:
         self.read_only_data = True
         ## Maximum returned data size in bytes (if they can be modified).
         self.max_data_size = 0
+        # Direct access to the event data, set by AbstractPluginEventHandler.
+        self._event_data = None
+        self._data_addr = None
+        self._data_size = 0
+        self._views = []
+
+    ##
+    # Acquire a direct access to the event data buffer, without copy.
+    #
+    # With the @e memory input and output plugins, the event data buffer is a range of
+    # the tsp packet buffer. The returned object is a memoryview on this buffer which can
+    # be used as a buffer object, for instance by numpy.frombuffer(). If the event data
+    # are read-only, the memoryview is read-only and contains the event data. Otherwise,
+    # it is writable and contains the complete buffer of @a max_data_size bytes.
+    #
+    # The memoryview is valid only until releaseBuffer() is called or the event handler
+    # returns, whichever comes first. After that, the buffer belongs to tsp again and
+    # no object which was built on top of the memoryview (numpy arrays, slices of the
+    # memoryview, ctypes arrays, etc.) shall be used. When such objects still hold an
+    # export of the buffer (numpy arrays for instance), the release fails and the event
+    # is considered as failed. Other objects cannot be detected.
+    #
+    # @return A memoryview on the event data buffer.
+    #
+    def acquireBuffer(self):
+        size = self._data_size if self.read_only_data else self.max_data_size
+        if self._data_addr is None or size == 0:
+            view = memoryview(bytearray())
+        else:
+            view = memoryview((ctypes.c_uint8 * size).from_address(self._data_addr)).cast('B')
+        if self.read_only_data:
+            view = view.toreadonly()
+        self._views.append(view)
+        return view
+
+    ##
+    # Release all direct accesses to the event data buffer which were acquired by acquireBuffer().
+    #
+    # @param size If the event data are not read-only, new size in bytes of the event data,
+    # as written in the buffer. Typically, with the @e memory input plugin, this is the size
+    # of the returned TS packets. If omitted, the size of the event data is unchanged.
+    # @return True on success, False if the data size is invalid or if some objects still
+    # reference the buffer.
+    #
+    def releaseBuffer(self, size = None):
+        success = True
+        while len(self._views) > 0:
+            try:
+                self._views.pop().release()
+            except BufferError:
+                success = False
+        if size is not None:
+            # bool tspyPyPluginEventHandlerUpdateSize(void* obj, size_t size)
+            cfunc = _lib.tspyPyPluginEventHandlerUpdateSize
+            cfunc.restype = ctypes.c_bool
+            cfunc.argtypes = [ctypes.c_void_p, ctypes.c_size_t]
+            success = bool(cfunc(self._event_data, size)) and success
+        return success
+
+    ##
+    # Get the labels of a TS packet in the event data.
+    # Labels are set by plugins on TS packets, for instance using the plugin "filter".
+    # This is available with the @e memory input and output plugins only.
+    # @param index Index of the TS packet in the event data.
+    # @return An integer containing the bit mask of labels (bit 0 = label 0, etc.)
+    # or None if there is no metadata for that packet.
+    #
+    def packetLabels(self, index):
+        mdata = self._packetMetadata(index)
+        return None if mdata is None else mdata[0]
+
+    ##
+    # Set the labels of a TS packet in the event data.
+    # This is available with the @e memory input plugin only. The labels of the input packets
+    # can be used by the next plugins in the tsp chain.
+    # @param index Index of the TS packet in the event data.
+    # @param labels An integer containing the bit mask of labels (bit 0 = label 0, etc.)
+    # @return True on success, False if the event data are read-only or @a index is out of range.
+    #
+    def setPacketLabels(self, index, labels):
+        # bool tspyPyPluginEventHandlerSetLabels(void* obj, size_t index, uint32_t labels)
+        cfunc = _lib.tspyPyPluginEventHandlerSetLabels
+        cfunc.restype = ctypes.c_bool
+        cfunc.argtypes = [ctypes.c_void_p, ctypes.c_size_t, ctypes.c_uint32]
+        return bool(cfunc(self._event_data, index, labels))
+
+    ##
+    # Get the input timestamp of a TS packet in the event data.
+    # This is available with the @e memory output plugin only.
+    # @param index Index of the TS packet in the event data.
+    # @return The input timestamp of the packet in PCR units (27 MHz) or None if the packet
+    # has no input timestamp.
+    #
+    def packetInputTimestamp(self, index):
+        mdata = self._packetMetadata(index)
+        return None if mdata is None or mdata[1] == 0xFFFFFFFFFFFFFFFF else mdata[1]
+
+    # Get the labels and input timestamp of a TS packet (internal use only).
+    def _packetMetadata(self, index):
+        # bool tspyPyPluginEventHandlerGetMetadata(void* obj, size_t index, uint32_t* labels, uint64_t* input_time)
+        cfunc = _lib.tspyPyPluginEventHandlerGetMetadata
+        cfunc.restype = ctypes.c_bool
+        cfunc.argtypes = [ctypes.c_void_p, ctypes.c_size_t, ctypes.POINTER(ctypes.c_uint32), ctypes.POINTER(ctypes.c_uint64)]
+        labels = ctypes.c_uint32(0)
+        input_time = ctypes.c_uint64(0)
+        if cfunc(self._event_data, index, ctypes.byref(labels), ctypes.byref(input_time)):
+            return (labels.value, input_time.value)
+        else:
+            return None
 
 
 #-----------------------------------------------------------------------------
@@ -744,8 +853,11 @@ class AbstractPluginEventHandler(NativeObject):
 
     ##
     # Constructor.
+    # @param zero_copy If True, the event data are not copied into a bytes object before
+    # calling handlePluginEvent() and its parameter @a data is None. The event handler shall
+    # access the event data using @a context.acquireBuffer() and @a context.releaseBuffer().
     #
-    def __init__(self):
+    def __init__(self, zero_copy = False):
         super().__init__()
 
         # Profile of the Python callback!
@@ -774,12 +886,17 @@ class AbstractPluginEventHandler(NativeObject):
             context.total_packets = total_packets
             context.read_only_data = bool(data_read_only)
             context.max_data_size = 0 if data_read_only else data_max_size
+            context._event_data = event_data_obj
+            context._data_addr = ctypes.cast(data_addr, ctypes.c_void_p).value
+            context._data_size = data_size
 
-            # Build the input binary data of the event.
-            event_data = bytes(ctypes.string_at(data_addr, data_size))
+            # Build the input binary data of the event, unless accessed in place.
+            event_data = None if zero_copy else bytes(ctypes.string_at(data_addr, data_size))
 
-            # Call the public Python callback.
+            # Call the public Python callback. The direct accesses to the event data
+            # buffer are no longer valid after returning from the handler.
             ret = self.handlePluginEvent(context, event_data)
+            released = context.releaseBuffer()
 
             # Analyze the result: bool, bytearray or tuple of both.
             success = True
@@ -810,7 +927,7 @@ class AbstractPluginEventHandler(NativeObject):
                 carray = ctypes.cast(carray_type.from_buffer(outdata), _c_uint8_p)
                 cfunc(event_data_obj, carray, ctypes.c_size_t(len(outdata)))
 
-            return success
+            return success and released
 
         # -- back to __init__():
         # Keep a reference on the callback in the object instance.
@@ -847,6 +964,19 @@ class AbstractPluginEventHandler(NativeObject):
     #
     # It is also possible to signal an error state by returning False.
     #
+    # To avoid copying the event data, typically TS packets at high bitrates, the event handler
+    # can directly access the plugin data buffer, using @a context.acquireBuffer(). With the
+    # @e memory input plugin, the TS packets are written in place and their size is set using
+    # @a context.releaseBuffer(). In that case, the handler shall return nothing or a bool.
+    # Example:
+    # @code
+    #   buffer = context.acquireBuffer()
+    #   count = min(len(buffer) // tsduck.PKT_SIZE, len(self._packets))
+    #   for i in range(count):
+    #       buffer[i * tsduck.PKT_SIZE : (i + 1) * tsduck.PKT_SIZE] = self._packets[i]
+    #   context.releaseBuffer(count * tsduck.PKT_SIZE)
+    # @endcode
+    #
     # The return value of this function can consequently be a bool, a bytearray or a tuple of both.
     # The bool is True on success or False to set the error indicator of the event. The bytearray
     # is the updated output event data (if the even data is not read-only). The default is no error,
@@ -874,6 +1004,7 @@ class AbstractPluginEventHandler(NativeObject):
     # @param context An instance of PluginEventContext containing the details of the event.
     # @param data A bytes object containing the data of the event. This is a read-only
     # sequence of bytes. There is no way to return data from Python to the plugin.
+    # This is None if the event handler was created with @a zero_copy.
     # @return A bool, a bytearray or a tuple of both.
     #
     def handlePluginEvent(self, context, data):
@@ -1309,6 +1440,7 @@ class TSProcessor(PluginEventHandlerRegistry):
             ("bitrate_adjust_interval", ctypes.c_long),   # Bitrate adjust interval (in milliseconds).
             ("receive_timeout", ctypes.c_long),           # Timeout on input operations (in milliseconds).
             ("log_plugin_index", ctypes.c_long),          # Log plugin index with plugin name (bool).
+            ("lock_free", ctypes.c_long),                 # Lock-free packet handoff between plugins (bool).
             ("plugins", _c_uint8_p),                      # Address of UTF-16 multi-strings buffer for plugins.
             ("plugins_size", ctypes.c_size_t),            # Size in bytes of plugins multi-strings buffer.
         ]
@@ -1334,6 +1466,8 @@ class TSProcessor(PluginEventHandlerRegistry):
         self.ignore_joint_termination = False
         ## Option -\-log-plugin-index.
         self.log_plugin_index = False
+        ## Option -\-lock-free.
+        self.lock_free = False
         ## Option -\-buffer-size-mb (in bytes here).
         self.buffer_size = 16 * 1024 * 1024
         ## Option -\-max-flushed-packets (zero means default).
@@ -1396,6 +1530,7 @@ class TSProcessor(PluginEventHandlerRegistry):
         args.bitrate_adjust_interval = ctypes.c_long(self.bitrate_adjust_interval)
         args.receive_timeout = ctypes.c_long(self.receive_timeout)
         args.log_plugin_index = ctypes.c_long(self.log_plugin_index)
+        args.lock_free = ctypes.c_long(self.lock_free)
 
         # Build UTF-16 buffer with application names and plugins.
         plugins = _InByteBuffer(self.app_name)
@@ -472,6 +472,7 @@
 #include "tsPESPacketizer.h"
 #include "tsPESProviderInterface.h"
 #include "tsPESStreamPacketizer.h"
+#include "tsPIDMap.h"
 #include "tsPIDOperator.h"
 #include "tsPlatform.h"
 #include "tsPlugin.h"
@@ -479,6 +480,7 @@
 #include "tsPluginEventData.h"
 #include "tsPluginEventHandlerInterface.h"
 #include "tsPluginEventHandlerRegistry.h"
+#include "tsPluginEventPacketData.h"
 #include "tsPluginOptions.h"
 #include "tsPluginRepository.h"
 #include "tsPluginThread.h"
@@ -528,6 +530,7 @@
 #include "tsSectionFile.h"
 #include "tsSectionFileArgs.h"
 #include "tsSectionHandlerInterface.h"
+#include "tsSectionPacketCache.h"
 #include "tsSectionProviderInterface.h"
 #include "tsSelectionInformationTable.h"
 #include "tsSeriesDescriptor.h"
@@ -546,6 +549,7 @@
 #include "tsSHA256.h"
 #include "tsSHA512.h"
 #include "tsSharedLibrary.h"
+#include "tsSharedMemoryRing.h"
 #include "tsSHDeliverySystemDescriptor.h"
 #include "tsShortEventDescriptor.h"
 #include "tsShortNodeInformationDescriptor.h"
@@ -585,6 +589,7 @@
 #include "tsSSUURIDescriptor.h"
 #include "tsStandaloneTableDemux.h"
 #include "tsStandards.h"
+#include "tsStartCode.h"
 #include "tsStaticInstance.h"
 #include "tsSTCReferenceDescriptor.h"
 #include "tsSTDDescriptor.h"
@@ -681,6 +686,7 @@
 #include "tsTSAnalyzerReport.h"
 #include "tsTSDT.h"
 #include "tsTSFile.h"
+#include "tsTSFileIndex.h"
 #include "tsTSFileInputBuffered.h"
 #include "tsTSFileOutputResync.h"
 #include "tsTSForkPipe.h"
@@ -739,14 +745,18 @@
 #include "tsxmlDeclaration.h"
 #include "tsxmlDocument.h"
 #include "tsxmlElement.h"
+#include "tsxmlElementWriter.h"
 #include "tsxmlJSONConverter.h"
+#include "tsxmlJSONWriter.h"
 #include "tsxmlModelDocument.h"
 #include "tsxmlNode.h"
 #include "tsxmlPatchDocument.h"
 #include "tsxmlRunningDocument.h"
 #include "tsxmlText.h"
+#include "tsxmlTextWriter.h"
 #include "tsxmlTweaks.h"
 #include "tsxmlUnknown.h"
+#include "tsxmlWriter.h"
 
 #if defined(TS_LINUX)
 #include "tsDTVProperties.h"
@@ -50,6 +50,8 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual bool usePacketBatch() override;
+        virtual void processPacketBatch(TSPacket*, TSPacketMetadata*, Status*, size_t) override;
 
     private:
         UString            _tag;          // Message tag
@@ -142,3 +144,21 @@ ts::ProcessorPlugin::Status ts::ContinuityPlugin::processPacket(TSPacket& pkt, T
     _cc_analyzer.feedPacket(pkt);
     return TSP_OK;
 }
+
+
+//----------------------------------------------------------------------------
+// Packet batch processing method
+//----------------------------------------------------------------------------
+
+bool ts::ContinuityPlugin::usePacketBatch()
+{
+    return true;
+}
+
+void ts::ContinuityPlugin::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        _cc_analyzer.feedPacket(pkt[i]);
+        status[i] = TSP_OK;
+    }
+}
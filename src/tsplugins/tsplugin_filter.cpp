@@ -54,6 +54,8 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual bool usePacketBatch() override;
+        virtual void processPacketBatch(TSPacket*, TSPacketMetadata*, Status*, size_t) override;
 
     private:
         // Packet intervals and list of them.
@@ -114,6 +116,9 @@ namespace ts {
 
         // Implementation of SignalizationHandlerInterface
         virtual void handleService(uint16_t ts_id, const Service& service, const PMT& pmt, bool removed) override;
+
+        // Process one packet, index is the packet number in the plugin stream.
+        Status processOnePacket(TSPacket& pkt, TSPacketMetadata& pkt_data, PacketCounter index);
     };
 }
 
@@ -534,6 +539,38 @@ bool ts::FilterPlugin::stop()
 //----------------------------------------------------------------------------
 
 ts::ProcessorPlugin::Status ts::FilterPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    return processOnePacket(pkt, pkt_data, tsp->pluginPackets());
+}
+
+
+//----------------------------------------------------------------------------
+// Packet batch processing method
+//----------------------------------------------------------------------------
+
+bool ts::FilterPlugin::usePacketBatch()
+{
+    return true;
+}
+
+void ts::FilterPlugin::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    // Index of first packet in the batch.
+    const PacketCounter first = tsp->pluginPackets();
+    for (size_t i = 0; i < count; ++i) {
+        status[i] = processOnePacket(pkt[i], pkt_data[i], first + i);
+        if (status[i] == TSP_END) {
+            break;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Process one packet.
+//----------------------------------------------------------------------------
+
+ts::ProcessorPlugin::Status ts::FilterPlugin::processOnePacket(TSPacket& pkt, TSPacketMetadata& pkt_data, PacketCounter index)
 {
     const PID pid = pkt.getPID();
 
@@ -543,8 +580,7 @@ ts::ProcessorPlugin::Status ts::FilterPlugin::processPacket(TSPacket& pkt, TSPac
     }
 
     // Pass initial packets without filtering.
-    const PacketCounter packetIndex = tsp->pluginPackets();
-    if (packetIndex < _after_packets) {
+    if (index < _after_packets) {
         return TSP_OK;
     }
 
@@ -586,7 +622,7 @@ ts::ProcessorPlugin::Status ts::FilterPlugin::processPacket(TSPacket& pkt, TSPac
         (int(pkt.getPayloadSize()) <= _max_payload) ||
         (_min_af >= 0 && int(pkt.getAFSize()) >= _min_af) ||
         (int(pkt.getAFSize()) <= _max_af) ||
-        (_every_packets > 0 && (tsp->pluginPackets() - _after_packets) % _every_packets == 0) ||
+        (_every_packets > 0 && (index - _after_packets) % _every_packets == 0) ||
         (_with_pes && pkt.startPES());
 
     // Search binary patterns in packets.
@@ -604,7 +640,7 @@ ts::ProcessorPlugin::Status ts::FilterPlugin::processPacket(TSPacket& pkt, TSPac
 
     // Search if packet is in one selected range.
     for (auto it = _ranges.begin(); !ok && it != _ranges.end(); ++it) {
-        ok = packetIndex >= it->first && packetIndex <= it->second;
+        ok = index >= it->first && index <= it->second;
     }
 
     // Reverse selection criteria with --negate.
@@ -88,6 +88,8 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual bool usePacketBatch() override;
+        virtual void processPacketBatch(TSPacket*, TSPacketMetadata*, Status*, size_t) override;
 
     private:
         // Description of PID's. Map of safe pointers to PID contexts, indexed by PID.
@@ -111,6 +113,9 @@ namespace ts {
         // Get the context for a PID. Create one when necessary.
         PIDContextPtr getContext(PID pid);
 
+        // Process one packet, index is the packet number in the plugin stream.
+        Status processOnePacket(TSPacket& pkt, TSPacketMetadata& pkt_data, PacketCounter index);
+
         // Description of one PID. One structure is created per PID in the TS.
         class PIDContext
         {
@@ -387,6 +392,38 @@ void ts::PCRAdjustPlugin::handleTable(SectionDemux& demux, const BinaryTable& ta
 //----------------------------------------------------------------------------
 
 ts::ProcessorPlugin::Status ts::PCRAdjustPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    return processOnePacket(pkt, pkt_data, tsp->pluginPackets());
+}
+
+
+//----------------------------------------------------------------------------
+// Packet batch processing method
+//----------------------------------------------------------------------------
+
+bool ts::PCRAdjustPlugin::usePacketBatch()
+{
+    return true;
+}
+
+void ts::PCRAdjustPlugin::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    // Index of first packet in the batch.
+    const PacketCounter first = tsp->pluginPackets();
+    for (size_t i = 0; i < count; ++i) {
+        status[i] = processOnePacket(pkt[i], pkt_data[i], first + i);
+        if (status[i] == TSP_END) {
+            break;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Process one packet.
+//----------------------------------------------------------------------------
+
+ts::ProcessorPlugin::Status ts::PCRAdjustPlugin::processOnePacket(TSPacket& pkt, TSPacketMetadata& pkt_data, PacketCounter index)
 {
     // Pass all packets to the demux.
     _demux.feedPacket(pkt);
@@ -394,7 +431,7 @@ ts::ProcessorPlugin::Status ts::PCRAdjustPlugin::processPacket(TSPacket& pkt, TS
     // Get PID context.
     const PID pid = pkt.getPID();
     const PIDContextPtr ctx(getContext(pid));
-    const PacketCounter current_packet = tsp->pluginPackets();
+    const PacketCounter current_packet = index;
 
     // Keep track of scrambled PID's (or which contain at least one scrambled packet).
     if (pkt.isScrambled()) {
@@ -54,6 +54,8 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual bool usePacketBatch() override;
+        virtual void processPacketBatch(TSPacket*, TSPacketMetadata*, Status*, size_t) override;
 
     private:
         // Command line options:
@@ -67,6 +69,9 @@ namespace ts {
         bool            _pass_all;       // Pass all packets after an error.
         PacketCounter   _init_packets;   // Count packets in PID's to shift during initial evaluation phase.
         TimeShiftBuffer _buffer;         // The timeshift buffer logic.
+
+        // Process one packet, index is the packet number in the plugin stream.
+        Status processOnePacket(TSPacket& pkt, TSPacketMetadata& pkt_data, PacketCounter index);
     };
 }
 
@@ -205,6 +210,38 @@ bool ts::PIDShiftPlugin::stop()
 //----------------------------------------------------------------------------
 
 ts::ProcessorPlugin::Status ts::PIDShiftPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
+{
+    return processOnePacket(pkt, pkt_data, tsp->pluginPackets());
+}
+
+
+//----------------------------------------------------------------------------
+// Packet batch processing method
+//----------------------------------------------------------------------------
+
+bool ts::PIDShiftPlugin::usePacketBatch()
+{
+    return true;
+}
+
+void ts::PIDShiftPlugin::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, Status* status, size_t count)
+{
+    // Index of first packet in the batch.
+    const PacketCounter first = tsp->pluginPackets();
+    for (size_t i = 0; i < count; ++i) {
+        status[i] = processOnePacket(pkt[i], pkt_data[i], first + i);
+        if (status[i] == TSP_END) {
+            break;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Process one packet.
+//----------------------------------------------------------------------------
+
+ts::ProcessorPlugin::Status ts::PIDShiftPlugin::processOnePacket(TSPacket& pkt, TSPacketMetadata& pkt_data, PacketCounter index)
 {
     const PID pid = pkt.getPID();
 
@@ -223,7 +260,7 @@ ts::ProcessorPlugin::Status ts::PIDShiftPlugin::processPacket(TSPacket& pkt, TSP
 
         // Evaluate the duration from the beginning of the TS (zero if bitrate is unknown).
         const BitRate ts_bitrate = tsp->bitrate();
-        const PacketCounter ts_packets = tsp->pluginPackets() + 1;
+        const PacketCounter ts_packets = index + 1;
         const MilliSecond ms = PacketInterval(ts_bitrate, ts_packets);
 
         if (ms >= _eval_ms) {
@@ -46,6 +46,7 @@
 
 #define DEFAULT_ECM_BITRATE 30000
 #define ASYNC_HANDLER_EXTRA_STACK_SIZE (1024 * 1024)
+#define DEFAULT_PACKET_WINDOW 128
 
 
 //----------------------------------------------------------------------------
@@ -102,7 +103,9 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual bool stop() override;
+        virtual size_t getPacketWindowSize() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
 
     private:
         // Description of a crypto-period.
@@ -169,6 +172,7 @@ namespace ts {
         BitRate           _ecm_bitrate;         // ECM PID's bitrate
         PID               _ecm_pid;             // PID for ECM
         PacketCounter     _partial_scrambling;  // Do not scramble all packets if > 1
+        size_t            _window_size;         // Packet window size, zero for packet per packet processing.
         ECMGClientArgs    _ecmg_args;           // Parameters for ECMG client
         tlv::Logger       _logger;              // Message logger for ECMG <=> SCS protocol
         ecmgscs::ChannelStatus _channel_status; // Initial response to ECMG channel_setup
@@ -194,6 +198,8 @@ namespace ts {
         size_t            _current_ecm;         // Index to current ECM (ECM being broadcast)
         TSScrambling      _scrambling;          // Scrambler
         CyclingPacketizer _pzer_pmt;            // Packetizer for modified PMT
+        std::vector<TSPacket*> _batch;          // Packets to scramble together with the current CW in a packet window.
+        size_t            _batch_start;         // Index in the packet window of the first packet in _batch.
 
         // Return current/next CryptoPeriod for CW or ECM
         CryptoPeriod& currentCW()  { return _cp[_current_cw]; }
@@ -201,6 +207,12 @@ namespace ts {
         CryptoPeriod& currentECM() { return _cp[_current_ecm]; }
         CryptoPeriod& nextECM()    { return _cp[(_current_ecm + 1) & 0x01]; }
 
+        // Process one packet. Set scramble to true when the packet payload must be scrambled with the current CW.
+        Status processOnePacket(TSPacket& pkt, bool& scramble);
+
+        // Scramble the packets in _batch. Keep them in _batch on error.
+        bool scrambleBatch();
+
         // Perform CW and ECM transition
         bool changeCW();
         void changeECM();
@@ -241,6 +253,7 @@ ts::ScramblerPlugin::ScramblerPlugin(TSP* tsp_) :
     _ecm_bitrate(0),
     _ecm_pid(PID_NULL),
     _partial_scrambling(0),
+    _window_size(0),
     _ecmg_args(),
     _logger(Severity::Debug, tsp_),
     _channel_status(),
@@ -263,7 +276,9 @@ ts::ScramblerPlugin::ScramblerPlugin(TSP* tsp_) :
     _current_cw(0),
     _current_ecm(0),
     _scrambling(*tsp),
-    _pzer_pmt(duck)
+    _pzer_pmt(duck),
+    _batch(),
+    _batch_start(0)
 {
     // We need to define character sets to specify service names.
     duck.defineArgsForCharset(*this);
@@ -314,6 +329,13 @@ ts::ScramblerPlugin::ScramblerPlugin(TSP* tsp_) :
          u"Specifying higher values is a way to reduce the scrambling CPU load "
          u"while keeping the service mostly scrambled.");
 
+    option(u"packet-window", 0, UNSIGNED);
+    help(u"packet-window", u"packet-count",
+         u"Number of packets which are processed together. The packets which use the same control "
+         u"word inside this window are scrambled in one batch, which is much faster with DVB-CSA2. "
+         u"A larger window introduces more latency in the processing. With a zero value, the packets "
+         u"are scrambled one by one. The default is " + UString::Decimal(DEFAULT_PACKET_WINDOW) + u" packets.");
+
     option(u"pid", 'p', PIDVAL, 0, UNLIMITED_COUNT);
     help(u"pid", u"pid1[-pid2]",
          u"Scramble packets with these PID values. Several -p or --pid options may be "
@@ -366,6 +388,7 @@ bool ts::ScramblerPlugin::getOptions()
     _scramble_subtitles = present(u"subtitles");
     _ignore_scrambled = present(u"ignore-scrambled");
     getIntValue(_partial_scrambling, u"partial-scrambling", 1);
+    getIntValue(_window_size, u"packet-window", DEFAULT_PACKET_WINDOW);
     getIntValue(_ecm_pid, u"pid-ecm", PID_NULL);
     getValue(_ecm_bitrate, u"bitrate-ecm", DEFAULT_ECM_BITRATE);
 
@@ -429,6 +452,8 @@ bool ts::ScramblerPlugin::start()
     _delay_start = 0;
     _current_cw = 0;
     _current_ecm = 0;
+    _batch.clear();
+    _batch_start = 0;
 
     // Initialize the scrambling engine.
     if (!_scrambling.start()) {
@@ -682,6 +707,11 @@ bool ts::ScramblerPlugin::tryExitDegradedMode()
 
 bool ts::ScramblerPlugin::changeCW()
 {
+    // The pending packets of a packet window are scrambled with the previous CW.
+    if (!_batch.empty() && !scrambleBatch()) {
+        return false;
+    }
+
     if (_scrambling.hasFixedCW()) {
         // A list of fixed CW was loaded from a file.
 
@@ -746,6 +776,93 @@ void ts::ScramblerPlugin::changeECM()
 
 ts::ProcessorPlugin::Status ts::ScramblerPlugin::processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data)
 {
+    bool scramble = false;
+    const Status status = processOnePacket(pkt, scramble);
+
+    // Scramble the packet payload.
+    if (scramble) {
+        if (!_scrambling.encrypt(pkt)) {
+            return TSP_END;
+        }
+        _scrambled_count++;
+    }
+    return status;
+}
+
+
+//----------------------------------------------------------------------------
+// Packet window processing method.
+//----------------------------------------------------------------------------
+
+size_t ts::ScramblerPlugin::getPacketWindowSize()
+{
+    return _window_size;
+}
+
+size_t ts::ScramblerPlugin::processPacketWindow(TSPacketWindow& win)
+{
+    // The packets to scramble are accumulated in _batch and scrambled together.
+    // When the CW changes in the middle of the window, changeCW() scrambles the
+    // accumulated packets with the previous CW first.
+    _batch.clear();
+
+    for (size_t index = 0; index < win.size(); ++index) {
+
+        // Skip dropped packets.
+        TSPacket* pkt = win.packet(index);
+        if (pkt == nullptr) {
+            continue;
+        }
+
+        bool scramble = false;
+        const Status status = processOnePacket(*pkt, scramble);
+
+        if (status == TSP_END) {
+            // Scramble the previous packets, the processing ends at this packet.
+            return _batch.empty() || scrambleBatch() ? index : _batch_start;
+        }
+        else if (status == TSP_NULL) {
+            win.nullify(index);
+        }
+        else if (status == TSP_DROP) {
+            win.drop(index);
+        }
+        else if (scramble) {
+            if (_batch.empty()) {
+                _batch_start = index;
+            }
+            _batch.push_back(pkt);
+        }
+    }
+
+    // Scramble the last packets.
+    return _batch.empty() || scrambleBatch() ? win.size() : _batch_start;
+}
+
+
+//----------------------------------------------------------------------------
+// Scramble the packets of a packet window with the current CW.
+//----------------------------------------------------------------------------
+
+bool ts::ScramblerPlugin::scrambleBatch()
+{
+    if (!_scrambling.encrypt(_batch.data(), _batch.size())) {
+        return false;
+    }
+    _scrambled_count += _batch.size();
+    _batch.clear();
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Process one packet, except the scrambling of its payload.
+//----------------------------------------------------------------------------
+
+ts::ProcessorPlugin::Status ts::ScramblerPlugin::processOnePacket(TSPacket& pkt, bool& scramble)
+{
+    scramble = false;
+
     // Count packets
     _packet_count++;
 
@@ -847,12 +964,8 @@ ts::ProcessorPlugin::Status ts::ScramblerPlugin::processPacket(TSPacket& pkt, TS
         _partial_clear = _partial_scrambling - 1;
     }
 
-    // Scramble the packet payload.
-    if (!_scrambling.encrypt(pkt)) {
-        return TSP_END;
-    }
-    _scrambled_count++;
-
+    // The packet payload must be scrambled.
+    scramble = true;
     return TSP_OK;
 }
 
@@ -0,0 +1,224 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Transport stream processor shared library:
+//  Shared memory input/output plugin for tsp.
+//  Packets are exchanged through a ring buffer in a shared memory segment
+//  between processes on the same host. One output plugin (the writer) can
+//  feed several input plugins (the readers) in distinct processes.
+//
+//----------------------------------------------------------------------------
+
+#include "tsPluginRepository.h"
+#include "tsSharedMemoryRing.h"
+
+
+//----------------------------------------------------------------------------
+// Command line option which is common to input and output plugins.
+//----------------------------------------------------------------------------
+
+namespace {
+    void DefineNameOption(ts::Args* args)
+    {
+        args->option(u"", 0, ts::Args::STRING, 1, 1);
+        args->help(u"", u"name",
+                   u"Name of the shared memory ring. "
+                   u"The output plugin and all input plugins on the same host must use the same name. "
+                   u"The shared memory is accessible to the processes of the same user only.");
+    }
+
+    bool GetNameOption(ts::Args* args, ts::UString& name)
+    {
+        args->getValue(name, u"");
+        if (!ts::SharedMemoryRing::IsValidName(name)) {
+            args->error(u"invalid shared memory name \"%s\"", {name});
+            return false;
+        }
+        return true;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Input plugin definition
+//----------------------------------------------------------------------------
+
+namespace ts {
+    class ShmInputPlugin: public InputPlugin
+    {
+        TS_NOBUILD_NOCOPY(ShmInputPlugin);
+    public:
+        // Implementation of plugin API
+        ShmInputPlugin(TSP*);
+        virtual bool getOptions() override;
+        virtual bool isRealTime() override {return true;}
+        virtual bool setReceiveTimeout(MilliSecond timeout) override;
+        virtual bool start() override;
+        virtual bool stop() override;
+        virtual bool abortInput() override;
+        virtual size_t receive(TSPacket*, TSPacketMetadata*, size_t) override;
+
+    private:
+        UString          _name;     // Shared memory name.
+        MilliSecond      _timeout;  // Receive timeout.
+        SharedMemoryRing _ring;
+    };
+}
+
+TS_REGISTER_INPUT_PLUGIN(u"shm", ts::ShmInputPlugin);
+
+
+//----------------------------------------------------------------------------
+// Input plugin constructor
+//----------------------------------------------------------------------------
+
+ts::ShmInputPlugin::ShmInputPlugin(TSP* tsp_) :
+    InputPlugin(tsp_, u"Receive TS packets from a shared memory ring on the same host", u"[options] name"),
+    _name(),
+    _timeout(0),
+    _ring(*tsp, tsp)
+{
+    DefineNameOption(this);
+}
+
+
+//----------------------------------------------------------------------------
+// Input plugin methods
+//----------------------------------------------------------------------------
+
+bool ts::ShmInputPlugin::getOptions()
+{
+    return GetNameOption(this, _name);
+}
+
+bool ts::ShmInputPlugin::setReceiveTimeout(MilliSecond timeout)
+{
+    if (timeout > 0) {
+        _timeout = timeout;
+    }
+    return true;
+}
+
+bool ts::ShmInputPlugin::start()
+{
+    return _ring.attach(_name, _timeout);
+}
+
+bool ts::ShmInputPlugin::stop()
+{
+    _ring.close();
+    return true;
+}
+
+bool ts::ShmInputPlugin::abortInput()
+{
+    // The ring is polled at short intervals, the abort state is checked there.
+    _ring.abort();
+    return true;
+}
+
+size_t ts::ShmInputPlugin::receive(TSPacket* buffer, TSPacketMetadata* pkt_data, size_t max_packets)
+{
+    return _ring.read(buffer, pkt_data, max_packets, _timeout);
+}
+
+
+//----------------------------------------------------------------------------
+// Output plugin definition
+//----------------------------------------------------------------------------
+
+namespace ts {
+    class ShmOutputPlugin: public OutputPlugin
+    {
+        TS_NOBUILD_NOCOPY(ShmOutputPlugin);
+    public:
+        // Implementation of plugin API
+        ShmOutputPlugin(TSP*);
+        virtual bool getOptions() override;
+        virtual bool isRealTime() override {return true;}
+        virtual bool start() override;
+        virtual bool stop() override;
+        virtual bool send(const TSPacket*, const TSPacketMetadata*, size_t) override;
+
+    private:
+        UString          _name;          // Shared memory name.
+        size_t           _packet_count;  // Ring size in packets.
+        SharedMemoryRing _ring;
+    };
+}
+
+TS_REGISTER_OUTPUT_PLUGIN(u"shm", ts::ShmOutputPlugin);
+
+
+//----------------------------------------------------------------------------
+// Output plugin constructor
+//----------------------------------------------------------------------------
+
+ts::ShmOutputPlugin::ShmOutputPlugin(TSP* tsp_) :
+    OutputPlugin(tsp_, u"Send TS packets to a shared memory ring on the same host", u"[options] name"),
+    _name(),
+    _packet_count(0),
+    _ring(*tsp, tsp)
+{
+    DefineNameOption(this);
+
+    option(u"buffer-packets", 'b', POSITIVE);
+    help(u"buffer-packets",
+         u"Size of the shared memory ring in TS packets. "
+         u"The default is " + UString::Decimal(SharedMemoryRing::DEFAULT_PACKETS) + u" packets. "
+         u"When the slowest reader lags behind by that number of packets, the output is blocked.");
+}
+
+
+//----------------------------------------------------------------------------
+// Output plugin methods
+//----------------------------------------------------------------------------
+
+bool ts::ShmOutputPlugin::getOptions()
+{
+    getIntValue(_packet_count, u"buffer-packets", SharedMemoryRing::DEFAULT_PACKETS);
+    return GetNameOption(this, _name);
+}
+
+bool ts::ShmOutputPlugin::start()
+{
+    return _ring.create(_name, _packet_count);
+}
+
+bool ts::ShmOutputPlugin::stop()
+{
+    tsp->verbose(u"output blocked %'d times by slow readers", {_ring.blockedCount()});
+    _ring.close();
+    return true;
+}
+
+bool ts::ShmOutputPlugin::send(const TSPacket* buffer, const TSPacketMetadata* pkt_data, size_t packet_count)
+{
+    return _ring.write(buffer, pkt_data, packet_count);
+}
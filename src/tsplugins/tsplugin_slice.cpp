@@ -34,6 +34,7 @@
 
 #include "tsPluginRepository.h"
 #include "tsPCRAnalyzer.h"
+#include "tsTSFileIndex.h"
 #include "tsEnumeration.h"
 
 
@@ -113,6 +114,13 @@ ts::SlicePlugin::SlicePlugin(TSP* tsp_) :
          u"compute time values. Only rely on bitrate as determined by previous "
          u"plugins in the chain.");
 
+    option(u"index", 0, STRING);
+    help(u"index", u"filename",
+         u"With --seconds or --milli-seconds, convert the time values into packet numbers using the index "
+         u"of the input file. The specified file is the input TS file or its index file, as built by the "
+         u"command tsindex. The time is based on the PCR's of the file. This is more accurate than "
+         u"using the bitrate but the plugin must receive all packets from the beginning of the file.");
+
     option(u"milli-seconds", 'm');
     help(u"milli-seconds",
          u"With options --drop, --null, --pass and --stop, interpret the integer "
@@ -168,6 +176,18 @@ bool ts::SlicePlugin::start()
     std::sort(_events.begin(), _events.end());
     _next_index = 0;
 
+    // With --index, convert time values into packet numbers, the order is unchanged.
+    if (_use_time && present(u"index")) {
+        TSFileIndex index;
+        if (!index.load(value(u"index"), *tsp)) {
+            return false;
+        }
+        for (auto it = _events.begin(); it != _events.end(); ++it) {
+            it->value = index.packetAtTime(MilliSecond(it->value));
+        }
+        _use_time = false;
+    }
+
     if (tsp->verbose()) {
         tsp->verbose(u"initial packet processing: %s", {_status_names.name(_status)});
         for (SliceEventVector::iterator it = _events.begin(); it != _events.end(); ++it) {
@@ -33,6 +33,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsPluginRepository.h"
+#include "tsTSFileIndex.h"
 #include "tsTime.h"
 
 
@@ -58,8 +59,10 @@ namespace ts {
         PacketCounter  _unit_start_max;   // Stop at Nth packet with payload unit start
         PacketCounter  _null_seq_max;     // Stop at Nth sequence of null packets
         MilliSecond    _msec_max;         // Stop after N milli-seconds
+        UString        _index_file;       // Index of input file, for stream time
 
         // Working data:
+        PacketCounter  _msec_pack_max;    // Stop at Nth packet, from _msec_max in stream time
         PacketCounter  _unit_start_cnt;   // Payload unit start counter
         PacketCounter  _null_seq_cnt;     // Sequence of null packets counter
         Time           _start_time;       // Time of first packet reception
@@ -83,6 +86,8 @@ ts::UntilPlugin::UntilPlugin (TSP* tsp_) :
     _unit_start_max(0),
     _null_seq_max(0),
     _msec_max(0),
+    _index_file(),
+    _msec_pack_max(0),
     _unit_start_cnt(0),
     _null_seq_cnt(0),
     _start_time(Time::Epoch),
@@ -96,6 +101,13 @@ ts::UntilPlugin::UntilPlugin (TSP* tsp_) :
     option(u"exclude-last", 'e');
     help(u"exclude-last", u"Exclude the last packet (the one which triggers the final condition).");
 
+    option(u"index", 'i', STRING);
+    help(u"index", u"filename",
+         u"With --seconds or --milli-seconds, measure the time in the stream instead of real time. "
+         u"The specified file is the input TS file or its index file, as built by the command tsindex. "
+         u"The time is based on the PCR's of the file and the corresponding position is found in the index. "
+         u"The plugin must receive all packets from the beginning of the file.");
+
     option(u"joint-termination", 'j');
     help(u"joint-termination",
          u"When the final condition is triggered, perform a \"joint termination\" instead of unconditional termination. "
@@ -132,6 +144,7 @@ bool ts::UntilPlugin::getOptions()
     _unit_start_max = intValue<PacketCounter>(u"unit-start-count");
     _null_seq_max = intValue<PacketCounter>(u"null-sequence-count");
     _msec_max = intValue<MilliSecond>(u"milli-seconds", intValue<MilliSecond>(u"seconds") * MilliSecPerSec);
+    getValue(_index_file, u"index");
     tsp->useJointTermination(present(u"joint-termination"));
     return true;
 }
@@ -148,6 +161,17 @@ bool ts::UntilPlugin::start()
     _previous_pid = PID_MAX; // Invalid value
     _terminated = false;
     _transparent = false;
+
+    // With --index, the stream time is converted into a number of packets.
+    _msec_pack_max = 0;
+    if (_msec_max > 0 && !_index_file.empty()) {
+        TSFileIndex index;
+        if (!index.load(_index_file, *tsp)) {
+            return false;
+        }
+        _msec_pack_max = index.packetAtTime(_msec_max) + 1;
+        tsp->verbose(u"%'d ms in stream reached after %'d packets", {_msec_max, _msec_pack_max});
+    }
     return true;
 }
 
@@ -193,7 +217,8 @@ ts::ProcessorPlugin::Status ts::UntilPlugin::processPacket(TSPacket& pkt, TSPack
         (_pack_max > 0 && tsp->pluginPackets() + 1 >= _pack_max) ||
         (_null_seq_max > 0 && _null_seq_cnt >= _null_seq_max) ||
         (_unit_start_max > 0 && _unit_start_cnt >= _unit_start_max) ||
-        (_msec_max > 0 && Time::CurrentUTC() - _start_time >= _msec_max);
+        (_msec_pack_max > 0 && tsp->pluginPackets() + 1 >= _msec_pack_max) ||
+        (_msec_max > 0 && _msec_pack_max == 0 && Time::CurrentUTC() - _start_time >= _msec_max);
 
     // Update context information for next packet.
     _previous_pid = pkt.getPID();
@@ -55,6 +55,7 @@ namespace {
         ts::BitRate           bitrate;   // Expected bitrate (188-byte packets)
         ts::UString           infile;    // Input file name
         ts::TSPacketFormat    format;    // Input file format.
+        ts::TSFileReadMode    read_mode; // Input file read mode.
         ts::TSAnalyzerOptions analysis;  // Analysis options.
         ts::PagerArgs         pager;     // Output paging options.
     };
@@ -66,6 +67,7 @@ Options::Options(int argc, char *argv[]) :
     bitrate(0),
     infile(),
     format(ts::TSPacketFormat::AUTODETECT),
+    read_mode(ts::TSFileReadMode::STREAM),
     analysis(),
     pager(true, true)
 {
@@ -94,6 +96,14 @@ Options::Options(int argc, char *argv[]) :
          u"(for instance when the first time-stamp of an M2TS file starts with 0x47). "
          u"Using this option forces a specific format.");
 
+    option(u"read-mode", 0, ts::TSFileReadModeEnum);
+    help(u"read-mode", u"name",
+         u"Specify how the input file is read. "
+         u"The default is \"stream\", sequential read operations through the system cache. "
+         u"With \"mmap\", the file is read through sliding memory-mapped windows. "
+         u"With \"direct\", the file is read in large aligned blocks, bypassing the system cache. "
+         u"The alternative read modes apply to regular files only and are not available on all operating systems.");
+
     analyze(argc, argv);
 
     // Define all standard analysis options.
@@ -104,6 +114,7 @@ Options::Options(int argc, char *argv[]) :
     getValue(infile, u"");
     getValue(bitrate, u"bitrate");
     getIntValue(format, u"format", ts::TSPacketFormat::AUTODETECT);
+    getIntValue(read_mode, u"read-mode", ts::TSFileReadMode::STREAM);
 
     exitOnError();
 }
@@ -124,6 +135,7 @@ int MainCode(int argc, char *argv[])
 
     // Open the TS file.
     ts::TSFile file;
+    file.setReadMode(opt.read_mode);
     if (!file.openRead(opt.infile, 1, 0, opt, opt.format)) {
         return EXIT_FAILURE;
     }
@@ -62,6 +62,7 @@ namespace {
         bool               all;      // Report all tables, not only the first one.
         ts::UString        infile;   // Input file name
         ts::TSPacketFormat format;   // Input file format.
+        ts::TSFileReadMode read_mode; // Input file read mode.
     };
 }
 
@@ -73,7 +74,8 @@ Options::Options(int argc, char *argv[]) :
     no_tot(false),
     all(false),
     infile(),
-    format(ts::TSPacketFormat::AUTODETECT)
+    format(ts::TSPacketFormat::AUTODETECT),
+    read_mode(ts::TSFileReadMode::STREAM)
 {
     duck.defineArgsForStandards(*this);
     duck.defineArgsForTimeReference(*this);
@@ -92,6 +94,14 @@ Options::Options(int argc, char *argv[]) :
          u"(for instance when the first time-stamp of an M2TS file starts with 0x47). "
          u"Using this option forces a specific format.");
 
+    option(u"read-mode", 0, ts::TSFileReadModeEnum);
+    help(u"read-mode", u"name",
+         u"Specify how the input file is read. "
+         u"The default is \"stream\", sequential read operations through the system cache. "
+         u"With \"mmap\", the file is read through sliding memory-mapped windows. "
+         u"With \"direct\", the file is read in large aligned blocks, bypassing the system cache. "
+         u"The alternative read modes apply to regular files only and are not available on all operating systems.");
+
     option(u"notdt", 0);
     help(u"notdt", u"Ignore Time & Date Table (TDT).");
 
@@ -107,6 +117,7 @@ Options::Options(int argc, char *argv[]) :
     no_tdt = present(u"notdt");
     no_tot = present(u"notot");
     getIntValue(format, u"format", ts::TSPacketFormat::AUTODETECT);
+    getIntValue(read_mode, u"read-mode", ts::TSFileReadMode::STREAM);
 
     exitOnError();
 }
@@ -228,6 +239,7 @@ int MainCode(int argc, char *argv[])
 
     // Open the TS file.
     ts::TSFile file;
+    file.setReadMode(opt.read_mode);
     if (!file.openRead(opt.infile, 1, 0, opt, opt.format)) {
         return EXIT_FAILURE;
     }
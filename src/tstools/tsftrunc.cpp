@@ -34,6 +34,7 @@
 #include "tsMain.h"
 #include "tsFileUtils.h"
 #include "tsSysUtils.h"
+#include "tsTSFileIndex.h"
 #include "tsTS.h"
 TS_MAIN(MainCode);
 
@@ -52,6 +53,9 @@ namespace {
         bool              check_only;   // check only, do not truncate
         size_t            packet_size;  // packet size in bytes
         ts::PacketCounter trunc_pkt;    // first packet to truncate (0 means eof)
+        bool              use_index;    // use index of files to get truncation point
+        ts::MilliSecond   trunc_time;   // time of first packet to truncate
+        bool              trunc_intra;  // truncate at first intra-frame after trunc_time
         ts::UStringVector files;        // file names
     };
 }
@@ -61,6 +65,9 @@ Options::Options(int argc, char *argv[]) :
     check_only(false),
     packet_size(ts::PKT_SIZE),
     trunc_pkt(0),
+    use_index(false),
+    trunc_time(0),
+    trunc_intra(false),
     files()
 {
     option(u"", 0, STRING, 1, UNLIMITED_COUNT);
@@ -71,6 +78,18 @@ Options::Options(int argc, char *argv[]) :
          u"Truncate the file at the next packet boundary after the specified size "
          u"in bytes. Mutually exclusive with --packet.");
 
+    option(u"intra", 'i');
+    help(u"intra",
+         u"Truncate the file at the first video intra-frame (random access point), at or "
+         u"after the time which is specified by --milli-seconds, if any. The position of "
+         u"the intra-frame is found in the index of the file, as built by the command tsindex.");
+
+    option(u"milli-seconds", 'm', UNSIGNED);
+    help(u"milli-seconds",
+         u"Truncate the file at the specified time from the beginning of the file. "
+         u"The time is based on the PCR's of the file. The corresponding position in the file "
+         u"is found in the index of the file, as built by the command tsindex.");
+
     option(u"noaction", 'n');
     help(u"noaction", u"Do not perform truncation, check mode only.");
 
@@ -91,8 +110,12 @@ Options::Options(int argc, char *argv[]) :
     check_only = present(u"noaction");
     packet_size = intValue<size_t>(u"size-of-packet", ts::PKT_SIZE);
 
-    if (present(u"byte") && present(u"packet")) {
-        error(u"--byte and --packet are mutually exclusive");
+    use_index = present(u"milli-seconds") || present(u"intra");
+    trunc_intra = present(u"intra");
+    getIntValue(trunc_time, u"milli-seconds", 0);
+
+    if (present(u"byte") + present(u"packet") + use_index > 1) {
+        error(u"--byte, --packet and --milli-seconds or --intra are mutually exclusive");
     }
     if (present(u"byte")) {
         trunc_pkt = (intValue<ts::PacketCounter>(u"byte") + packet_size - 1) / packet_size;
@@ -138,11 +161,34 @@ int MainCode(int argc, char *argv[])
         const uint64_t extra = file_size % opt.packet_size;
         uint64_t keep;
 
-        if (opt.trunc_pkt == 0 || opt.trunc_pkt > pkt_count) {
+        // Get the first packet to truncate from the index of the file, if required.
+        ts::PacketCounter trunc_pkt = opt.trunc_pkt;
+        if (opt.use_index) {
+            ts::TSFileIndex index;
+            if (!index.load(*file, opt)) {
+                success = false;
+                continue;
+            }
+            if (index.filePacketSize() != opt.packet_size) {
+                opt.error(u"%s: %d-byte packets in index, use --size-of-packet %d", {*file, index.filePacketSize(), index.filePacketSize()});
+                success = false;
+                continue;
+            }
+            trunc_pkt = index.packetAtTime(opt.trunc_time);
+            if (opt.trunc_intra && !index.nextEvent(trunc_pkt, ts::TSFileIndex::EventType::INTRA_FRAME, trunc_pkt)) {
+                trunc_pkt = pkt_count;
+            }
+        }
+
+        // With an index, packet 0 means an empty file, not "no truncation".
+        if (opt.use_index && trunc_pkt == 0) {
+            keep = 0;
+        }
+        else if (trunc_pkt == 0 || trunc_pkt > pkt_count) {
             keep = pkt_count * opt.packet_size;
         }
         else {
-            keep = opt.trunc_pkt * opt.packet_size;
+            keep = trunc_pkt * opt.packet_size;
         }
 
         // Display info in verbose or check mode
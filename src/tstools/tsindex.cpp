@@ -0,0 +1,174 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Build the random-access index of TS files
+//
+//----------------------------------------------------------------------------
+
+#include "tsMain.h"
+#include "tsTSFileIndex.h"
+#include "tsDuckContext.h"
+#include "tsNames.h"
+TS_MAIN(MainCode);
+
+
+//----------------------------------------------------------------------------
+//  Command line options
+//----------------------------------------------------------------------------
+
+namespace {
+    class Options: public ts::Args
+    {
+        TS_NOBUILD_NOCOPY(Options);
+    public:
+        Options(int argc, char *argv[]);
+
+        ts::UStringVector  files;   // Input file names
+        ts::UString        output;  // Output index file name
+        ts::TSPacketFormat format;  // Input file format
+        bool               list;    // List existing indexes
+    };
+}
+
+Options::Options(int argc, char *argv[]) :
+    Args(u"Build the random-access index of transport stream files", u"[options] filename ..."),
+    files(),
+    output(),
+    format(ts::TSPacketFormat::AUTODETECT),
+    list(false)
+{
+    option(u"", 0, STRING, 1, UNLIMITED_COUNT);
+    help(u"",
+         u"Names of the TS files to index. For each file, the index is stored in a file with the "
+         u"same name and the suffix \"" + ts::UString(ts::TSFileIndex::DEFAULT_SUFFIX) + u"\". "
+         u"The index records the position of the PCR's in the first PID with PCR's, the position "
+         u"of the video intra-frames and the position of the new versions of the PSI/SI tables. "
+         u"It is used by the options --start-time and --start-intra of the file input plugin, "
+         u"the option --index of the plugins slice and until and the options --milli-seconds "
+         u"and --intra of the command tsftrunc.");
+
+    option(u"format", 'f', ts::TSPacketFormatEnum);
+    help(u"format", u"name",
+         u"Specify the format of the input files. "
+         u"By default, the format is automatically and independently detected for each file.");
+
+    option(u"list", 'l');
+    help(u"list",
+         u"Do not build the indexes. Display the content of the existing indexes of the files. "
+         u"With --verbose, list all indexed events.");
+
+    option(u"output", 'o', STRING);
+    help(u"output", u"filename",
+         u"Specify the name of the output index file. "
+         u"This option is allowed only when there is only one input file.");
+
+    analyze(argc, argv);
+
+    getValues(files);
+    getValue(output, u"output");
+    getIntValue(format, u"format", ts::TSPacketFormat::AUTODETECT);
+    list = present(u"list");
+
+    if (!output.empty() && files.size() > 1) {
+        error(u"--output cannot be used with more than one input file");
+    }
+
+    exitOnError();
+}
+
+
+//----------------------------------------------------------------------------
+//  Display the content of an index.
+//----------------------------------------------------------------------------
+
+namespace {
+    void DisplayIndex(Options& opt, const ts::UString& name, const ts::TSFileIndex& index)
+    {
+        const ts::TSFileIndex::EventVector& events(index.events());
+        size_t intra_count = 0;
+        for (auto it = events.begin(); it != events.end(); ++it) {
+            intra_count += it->type == ts::TSFileIndex::EventType::INTRA_FRAME;
+        }
+
+        std::cout << ts::UString::Format(u"%s: %'d packets, %'d ms", {name, index.packetCount(), index.duration()});
+        if (index.pcrPID() != ts::PID_NULL) {
+            std::cout << ts::UString::Format(u", PCR PID 0x%X (%<d)", {index.pcrPID()});
+        }
+        std::cout << ts::UString::Format(u", %'d intra-frames, %'d table versions", {intra_count, events.size() - intra_count}) << std::endl;
+
+        if (opt.verbose()) {
+            ts::DuckContext duck(&opt);
+            for (auto it = events.begin(); it != events.end(); ++it) {
+                std::cout << ts::UString::Format(u"  packet %'d, %'d ms, PID 0x%X (%<d), ", {it->packet, index.timeAtPacket(it->packet), it->pid});
+                if (it->type == ts::TSFileIndex::EventType::INTRA_FRAME) {
+                    std::cout << "intra-frame";
+                }
+                else {
+                    std::cout << ts::UString::Format(u"%s, version %d", {ts::names::TID(duck, it->tid), it->version});
+                }
+                std::cout << std::endl;
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+//  Program entry point
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    Options opt(argc, argv);
+    ts::TSFileIndex index(&opt);
+    bool success = true;
+
+    for (auto file = opt.files.begin(); file != opt.files.end(); ++file) {
+        if (opt.list) {
+            if (index.load(*file, opt)) {
+                DisplayIndex(opt, *file, index);
+            }
+            else {
+                success = false;
+            }
+        }
+        else {
+            const ts::UString index_file(opt.output.empty() ? ts::TSFileIndex::IndexFileName(*file) : opt.output);
+            if (index.build(*file, opt, opt.format) && index.save(index_file, opt)) {
+                if (opt.verbose()) {
+                    DisplayIndex(opt, *file, index);
+                }
+            }
+            else {
+                success = false;
+            }
+        }
+    }
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,140 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::CRC32
+//
+//----------------------------------------------------------------------------
+
+#include "tsCRC32.h"
+#include "tsByteBlock.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class CRC32Test: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testReference();
+    void testSizes();
+    void testContinue();
+
+    TSUNIT_TEST_BEGIN(CRC32Test);
+    TSUNIT_TEST(testReference);
+    TSUNIT_TEST(testSizes);
+    TSUNIT_TEST(testContinue);
+    TSUNIT_TEST_END();
+
+private:
+    ts::ByteBlock _data;
+    static uint32_t BitwiseCRC32(uint32_t crc, const uint8_t* data, size_t size);
+};
+
+TSUNIT_REGISTER(CRC32Test);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void CRC32Test::beforeTest()
+{
+    // Pseudo-random test data, deterministic.
+    _data.resize(4096);
+    uint32_t seed = 0x12345678;
+    for (size_t i = 0; i < _data.size(); ++i) {
+        seed = seed * 1103515245 + 12345;
+        _data[i] = uint8_t(seed >> 16);
+    }
+}
+
+// Test suite cleanup method.
+void CRC32Test::afterTest()
+{
+}
+
+// Reference bit-by-bit implementation.
+uint32_t CRC32Test::BitwiseCRC32(uint32_t crc, const uint8_t* data, size_t size)
+{
+    while (size-- > 0) {
+        crc ^= uint32_t(*data++) << 24;
+        for (int i = 0; i < 8; ++i) {
+            crc = (crc & 0x80000000) != 0 ? (crc << 1) ^ 0x04C11DB7 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void CRC32Test::testReference()
+{
+    // Well-known check value of CRC-32/MPEG-2.
+    TSUNIT_EQUAL(0x0376E6E7, ts::CRC32("123456789", 9).value());
+    TSUNIT_EQUAL(0xFFFFFFFF, ts::CRC32(nullptr, 0).value());
+
+    // A section including its CRC32 gives a zero CRC32.
+    const uint8_t pat[] = {0x00, 0xB0, 0x0D, 0x00, 0x01, 0xC1, 0x00, 0x00, 0x00, 0x01, 0xE0, 0x20};
+    ts::ByteBlock sec(pat, sizeof(pat));
+    sec.appendUInt32(ts::CRC32(pat, sizeof(pat)).value());
+    TSUNIT_EQUAL(0, ts::CRC32(sec.data(), sec.size()).value());
+}
+
+void CRC32Test::testSizes()
+{
+    // Check all small sizes and alignments, then larger sizes which use the accelerated implementation, if any.
+    for (size_t offset = 0; offset < 16; ++offset) {
+        for (size_t size = 0; size < 300 && offset + size <= _data.size(); ++size) {
+            TSUNIT_EQUAL(BitwiseCRC32(0xFFFFFFFF, &_data[offset], size), ts::CRC32(&_data[offset], size).value());
+        }
+        for (size_t size = 300; offset + size <= _data.size(); size += 97) {
+            TSUNIT_EQUAL(BitwiseCRC32(0xFFFFFFFF, &_data[offset], size), ts::CRC32(&_data[offset], size).value());
+        }
+    }
+}
+
+void CRC32Test::testContinue()
+{
+    // Splitting the data in several add() must give the same result.
+    const uint32_t ref = BitwiseCRC32(0xFFFFFFFF, _data.data(), _data.size());
+    for (size_t split = 0; split <= _data.size(); split += 61) {
+        ts::CRC32 crc(_data.data(), split);
+        crc.add(&_data[split], _data.size() - split);
+        TSUNIT_EQUAL(ref, crc.value());
+    }
+}
@@ -32,6 +32,9 @@
 //----------------------------------------------------------------------------
 
 #include "tsAccessUnitIterator.h"
+#include "tsStartCode.h"
+#include "tsMemory.h"
+#include "tsByteBlock.h"
 #include "tsAVC.h"
 #include "tsunit.h"
 
@@ -47,9 +50,11 @@ public:
     virtual void afterTest() override;
 
     void testIterator();
+    void testStartCode();
 
     TSUNIT_TEST_BEGIN(CodecsTest);
     TSUNIT_TEST(testIterator);
+    TSUNIT_TEST(testStartCode);
     TSUNIT_TEST_END();
 };
 
@@ -142,3 +147,64 @@ void CodecsTest::testIterator()
     TSUNIT_ASSERT(iter.atEnd());
     TSUNIT_EQUAL(3, iter.currentAccessUnitIndex());
 }
+
+void CodecsTest::testStartCode()
+{
+    static const uint8_t Zero3[] = {0x00, 0x00, 0x00};
+    static const uint8_t StartCodePrefix[] = {0x00, 0x00, 0x01};
+
+    // Pseudo-random data with many 00 and 01 bytes, all sizes around the vector sizes.
+    ts::ByteBlock data(300);
+    uint32_t seed = 12345;
+    for (size_t size = 0; size <= data.size(); ++size) {
+        for (size_t i = 0; i < size; ++i) {
+            seed = seed * 1103515245 + 12345;
+            const uint32_t r = (seed >> 16) & 0x0F;
+            data[i] = r < 8 ? 0x00 : (r < 10 ? 0x01 : uint8_t(seed >> 8));
+        }
+
+        // Reference implementation: search patterns from each NALunit.
+        ts::NALUnitLocationVector ref;
+        const uint8_t* p = data.data();
+        size_t remain = size;
+        for (;;) {
+            const uint8_t* p1 = ts::LocatePattern(p, remain, StartCodePrefix, sizeof(StartCodePrefix));
+            if (p1 == nullptr) {
+                break;
+            }
+            remain -= p1 - p + sizeof(StartCodePrefix);
+            p = p1 + sizeof(StartCodePrefix);
+            const uint8_t* p2 = ts::LocatePattern(p, remain, StartCodePrefix, sizeof(StartCodePrefix));
+            const uint8_t* p3 = ts::LocatePattern(p, remain, Zero3, sizeof(Zero3));
+            const uint8_t* end = p2 == nullptr ? p3 : (p3 == nullptr ? p2 : std::min(p2, p3));
+            ref.push_back(ts::NALUnitLocation(p - data.data(), end == nullptr ? remain : end - p));
+        }
+
+        ts::NALUnitLocationVector units;
+        ts::LocateNALUnits(data.data(), size, units);
+        TSUNIT_EQUAL(ref.size(), units.size());
+        for (size_t i = 0; i < ref.size() && i < units.size(); ++i) {
+            TSUNIT_EQUAL(ref[i].offset, units[i].offset);
+            TSUNIT_EQUAL(ref[i].size, units[i].size);
+        }
+
+        for (size_t start = 0; start < size; start += 7) {
+            TSUNIT_ASSERT(ts::LocatePattern(data.data() + start, size - start, StartCodePrefix, sizeof(StartCodePrefix)) ==
+                          ts::LocateStartCodePrefix(data.data() + start, size - start));
+        }
+    }
+
+    // Large area without any start code.
+    ts::ByteBlock large(100000, 0x47);
+    ts::NALUnitLocationVector units;
+    ts::LocateNALUnits(large.data(), large.size(), units);
+    TSUNIT_ASSERT(units.empty());
+    TSUNIT_ASSERT(ts::LocateStartCodePrefix(large.data(), large.size()) == nullptr);
+    large[99997] = large[99998] = 0x00;
+    large[99999] = 0x01;
+    TSUNIT_ASSERT(ts::LocateStartCodePrefix(large.data(), large.size()) == large.data() + 99997);
+    ts::LocateNALUnits(large.data(), large.size(), units);
+    TSUNIT_EQUAL(1, units.size());
+    TSUNIT_EQUAL(100000, units[0].offset);
+    TSUNIT_EQUAL(0, units[0].size);
+}
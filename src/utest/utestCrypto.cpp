@@ -85,6 +85,7 @@ public:
     void testAES_CTS3();
     void testAES_CTS4();
     void testAES_DVS042();
+    void testAES_Blocks();
     void testDES();
     void testTDES();
     void testTDES_CBC();
@@ -107,6 +108,7 @@ public:
     TSUNIT_TEST(testAES_CTS3);
     TSUNIT_TEST(testAES_CTS4);
     TSUNIT_TEST(testAES_DVS042);
+    TSUNIT_TEST(testAES_Blocks);
     TSUNIT_TEST(testDES);
     TSUNIT_TEST(testTDES);
     TSUNIT_TEST(testTDES_CBC);
@@ -412,6 +414,82 @@ void CryptoTest::testAES_DVS042()
     testChainingSizes(dvs042_aes, 16, 17, 23, 31, 32, 33, 45, 64, 67, 184, 12345, 0);
 }
 
+void CryptoTest::testAES_Blocks()
+{
+    // Check that chaining modes which process several blocks at once produce
+    // the same result as a block-by-block reference implementation.
+    constexpr size_t BSIZE = ts::AES::BLOCK_SIZE;
+    constexpr size_t COUNT = 45;    // more than several rounds of parallel blocks
+    constexpr size_t RESIDUE = 7;   // for CTR
+
+    ts::SystemRandomGenerator prng;
+    ts::AES aes;
+    ts::ECB<ts::AES> ecb;
+    ts::CBC<ts::AES> cbc;
+    ts::CTR<ts::AES> ctr;
+    ts::ByteBlock iv(BSIZE);
+    ts::ByteBlock plain(COUNT * BSIZE + RESIDUE);
+    ts::ByteBlock ref(plain.size());
+    ts::ByteBlock out(plain.size());
+    ts::ByteBlock counter(BSIZE);
+    ts::ByteBlock stream(BSIZE);
+
+    for (size_t key_size = 16; key_size <= 32; key_size += 8) {
+
+        ts::ByteBlock key(key_size);
+        TSUNIT_ASSERT(prng.read(key.data(), key.size()));
+        TSUNIT_ASSERT(prng.read(iv.data(), iv.size()));
+        TSUNIT_ASSERT(prng.read(plain.data(), plain.size()));
+        TSUNIT_ASSERT(aes.setKey(key.data(), key.size()));
+        TSUNIT_ASSERT(ecb.setKey(key.data(), key.size()));
+        TSUNIT_ASSERT(cbc.setKey(key.data(), key.size()));
+        TSUNIT_ASSERT(cbc.setIV(iv.data(), iv.size()));
+        TSUNIT_ASSERT(ctr.setKey(key.data(), key.size()));
+        TSUNIT_ASSERT(ctr.setIV(iv.data(), iv.size()));
+
+        // ECB reference.
+        for (size_t i = 0; i < COUNT * BSIZE; i += BSIZE) {
+            TSUNIT_ASSERT(aes.encrypt(&plain[i], BSIZE, &ref[i], BSIZE));
+        }
+        TSUNIT_ASSERT(ecb.encrypt(plain.data(), COUNT * BSIZE, out.data(), out.size()));
+        TSUNIT_EQUAL(0, ::memcmp(ref.data(), out.data(), COUNT * BSIZE));
+        TSUNIT_ASSERT(aes.encryptBlocks(plain.data(), out.data(), COUNT));
+        TSUNIT_EQUAL(0, ::memcmp(ref.data(), out.data(), COUNT * BSIZE));
+        TSUNIT_ASSERT(ecb.decryptInPlace(out.data(), COUNT * BSIZE));
+        TSUNIT_EQUAL(0, ::memcmp(plain.data(), out.data(), COUNT * BSIZE));
+
+        // CBC reference.
+        for (size_t i = 0; i < COUNT * BSIZE; i += BSIZE) {
+            for (size_t j = 0; j < BSIZE; ++j) {
+                out[j] = plain[i + j] ^ (i == 0 ? iv[j] : ref[i + j - BSIZE]);
+            }
+            TSUNIT_ASSERT(aes.encrypt(out.data(), BSIZE, &ref[i], BSIZE));
+        }
+        TSUNIT_ASSERT(cbc.encrypt(plain.data(), COUNT * BSIZE, out.data(), out.size()));
+        TSUNIT_EQUAL(0, ::memcmp(ref.data(), out.data(), COUNT * BSIZE));
+        TSUNIT_ASSERT(cbc.decrypt(ref.data(), COUNT * BSIZE, out.data(), out.size()));
+        TSUNIT_EQUAL(0, ::memcmp(plain.data(), out.data(), COUNT * BSIZE));
+        out.copy(ref.data(), COUNT * BSIZE);
+        TSUNIT_ASSERT(cbc.decryptInPlace(out.data(), COUNT * BSIZE));
+        TSUNIT_EQUAL(0, ::memcmp(plain.data(), out.data(), COUNT * BSIZE));
+
+        // CTR reference, with default counter size (64 bits).
+        counter = iv;
+        for (size_t i = 0; i < plain.size(); i += BSIZE) {
+            TSUNIT_ASSERT(aes.encrypt(counter.data(), BSIZE, stream.data(), BSIZE));
+            for (size_t j = 0; j < BSIZE && i + j < plain.size(); ++j) {
+                ref[i + j] = plain[i + j] ^ stream[j];
+            }
+            ts::PutUInt64(&counter[8], ts::GetUInt64(&counter[8]) + 1);
+        }
+        out.resize(plain.size());
+        TSUNIT_ASSERT(ctr.encrypt(plain.data(), plain.size(), out.data(), out.size()));
+        TSUNIT_EQUAL(0, ::memcmp(ref.data(), out.data(), plain.size()));
+        TSUNIT_ASSERT(ctr.decryptInPlace(out.data(), out.size()));
+        TSUNIT_EQUAL(0, ::memcmp(plain.data(), out.data(), plain.size()));
+    }
+}
+
 void CryptoTest::testDES()
 {
     ts::DES des;
@@ -92,6 +92,8 @@ public:
     void testTDT();
     void testTOT();
     void testHEVC();
+    void testSectionPool();
+    void testSectionPoolNewVersion();
 
     TSUNIT_TEST_BEGIN(DemuxTest);
     TSUNIT_TEST(testPAT);
@@ -105,6 +107,8 @@ public:
     TSUNIT_TEST(testTDT);
     TSUNIT_TEST(testTOT);
     TSUNIT_TEST(testHEVC);
+    TSUNIT_TEST(testSectionPool);
+    TSUNIT_TEST(testSectionPoolNewVersion);
     TSUNIT_TEST_END();
 
 private:
@@ -489,3 +493,96 @@ void DemuxTest::testHEVC()
 {
     TEST_TABLE("PMT with HEVC descriptor", pmt_hevc);
 }
+
+// A section handler which keeps all sections, either shared or copied.
+namespace {
+    class KeepSections: public ts::SectionHandlerInterface
+    {
+        TS_NOCOPY(KeepSections);
+    public:
+        KeepSections() : shared(), contents() {}
+        ts::SectionPtrVector shared;
+        ts::ByteBlock contents;
+        virtual void handleSection(ts::SectionDemux&, const ts::Section& section) override
+        {
+            shared.push_back(new ts::Section(section, ts::ShareMode::SHARE));
+            contents.append(section.content(), section.size());
+        }
+    };
+}
+
+void DemuxTest::testSectionPool()
+{
+    ts::DuckContext duck;
+    const ts::TSPacket* pkt = reinterpret_cast<const ts::TSPacket*>(psi_bat_cplus_packets);
+    const size_t pkt_count = sizeof(psi_bat_cplus_packets) / ts::PKT_SIZE;
+    const size_t repeat = 4;
+
+    // The sections must be identical, with or without pool, whatever the pool size.
+    static const size_t pool_sizes[] = {0, 1, 2, ts::SectionDemux::DEFAULT_SECTION_POOL_SIZE};
+
+    for (size_t pi = 0; pi < sizeof(pool_sizes) / sizeof(pool_sizes[0]); ++pi) {
+        KeepSections handler;
+        ts::SectionDemux demux(duck, nullptr, &handler, ts::AllPIDs);
+        demux.setSectionPoolSize(pool_sizes[pi]);
+        for (size_t ri = 0; ri < repeat; ++ri) {
+            demux.reset();
+            for (size_t i = 0; i < pkt_count; ++i) {
+                demux.feedPacket(pkt[i]);
+            }
+        }
+
+        // All sections which were kept by the application must be left untouched.
+        ts::ByteBlock ref;
+        for (size_t ri = 0; ri < repeat; ++ri) {
+            ref.append(psi_bat_cplus_sections, sizeof(psi_bat_cplus_sections));
+        }
+        ts::ByteBlock kept;
+        for (size_t i = 0; i < handler.shared.size(); ++i) {
+            TSUNIT_ASSERT(handler.shared[i]->isValid());
+            kept.append(handler.shared[i]->content(), handler.shared[i]->size());
+        }
+        debug() << "DemuxTest::testSectionPool: pool size: " << pool_sizes[pi] << ", sections: " << handler.shared.size() << std::endl;
+        TSUNIT_ASSERT(handler.contents == ref);
+        TSUNIT_ASSERT(kept == ref);
+    }
+}
+
+// A table handler which counts tables.
+namespace {
+    class CountTables: public ts::TableHandlerInterface
+    {
+        TS_NOCOPY(CountTables);
+    public:
+        CountTables() : count(0) {}
+        size_t count;
+        virtual void handleTable(ts::SectionDemux&, const ts::BinaryTable& table) override
+        {
+            TSUNIT_ASSERT(table.isValid());
+            count++;
+        }
+    };
+}
+
+void DemuxTest::testSectionPoolNewVersion()
+{
+    // A new version of a table on the same PID, followed by another table.
+    // The sections of the previous version are released while still in the pool.
+    ts::DuckContext duck;
+    CountTables handler;
+    ts::SectionDemux demux(duck, &handler, nullptr, ts::AllPIDs);
+
+    const ts::TSPacket* pkt = reinterpret_cast<const ts::TSPacket*>(psi_cat_r3_packets);
+    for (size_t i = 0; i < sizeof(psi_cat_r3_packets) / ts::PKT_SIZE; ++i) {
+        demux.feedPacket(pkt[i]);
+    }
+    pkt = reinterpret_cast<const ts::TSPacket*>(psi_cat_r6_packets);
+    for (size_t i = 0; i < sizeof(psi_cat_r6_packets) / ts::PKT_SIZE; ++i) {
+        demux.feedPacket(pkt[i]);
+    }
+    pkt = reinterpret_cast<const ts::TSPacket*>(psi_nit_tntv23_packets);
+    for (size_t i = 0; i < sizeof(psi_nit_tntv23_packets) / ts::PKT_SIZE; ++i) {
+        demux.feedPacket(pkt[i]);
+    }
+    TSUNIT_EQUAL(3, handler.count);
+}
@@ -65,6 +65,7 @@ public:
     void testQuery();
     void testRunningDocumentEmpty();
     void testRunningDocument();
+    void testRunningDocumentStartValue();
 
     TSUNIT_TEST_BEGIN(JsonTest);
     TSUNIT_TEST(testSimple);
@@ -73,6 +74,7 @@ public:
     TSUNIT_TEST(testQuery);
     TSUNIT_TEST(testRunningDocumentEmpty);
     TSUNIT_TEST(testRunningDocument);
+    TSUNIT_TEST(testRunningDocumentStartValue);
     TSUNIT_TEST_END();
 
 private:
@@ -821,3 +823,36 @@ void JsonTest::testRunningDocument()
                  u"}",
                  loadTempFile());
 }
+
+void JsonTest::testRunningDocumentStartValue()
+{
+    ts::json::RunningDocument doc(CERR);
+
+    // Not open, nothing can be printed.
+    TSUNIT_ASSERT(doc.startValue() == nullptr);
+
+    TSUNIT_ASSERT(!ts::FileExists(_tempFileName));
+    TSUNIT_ASSERT(doc.open(ts::json::ValuePtr(), _tempFileName));
+
+    doc.add(ts::json::String(u"foo"));
+    ts::TextFormatter* text = doc.startValue();
+    TSUNIT_ASSERT(text != nullptr);
+    *text << "true";
+    doc.add(ts::json::Number(-23));
+    text = doc.startValue();
+    TSUNIT_ASSERT(text != nullptr);
+    *text << "{" << ts::indent << ts::endl << ts::margin << "\"val\": 12" << ts::endl << ts::unindent << ts::margin << "}";
+    doc.close();
+    TSUNIT_ASSERT(doc.startValue() == nullptr);
+
+    TSUNIT_ASSERT(ts::FileExists(_tempFileName));
+    TSUNIT_EQUAL(u"[\n"
+                 u"  \"foo\",\n"
+                 u"  true,\n"
+                 u"  -23,\n"
+                 u"  {\n"
+                 u"    \"val\": 12\n"
+                 u"  }\n"
+                 u"]",
+                 loadTempFile());
+}
@@ -32,7 +32,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsPluginEventHandlerInterface.h"
-#include "tsPluginEventData.h"
+#include "tsPluginEventPacketData.h"
 #include "tsTSProcessor.h"
 #include "tsAsyncReport.h"
 #include "tsunit.h"
@@ -49,9 +49,13 @@ public:
     virtual void afterTest() override;
 
     void testAll();
+    void testLockFree();
+    void testMetadata();
 
     TSUNIT_TEST_BEGIN(MemoryPluginTest);
     TSUNIT_TEST(testAll);
+    TSUNIT_TEST(testLockFree);
+    TSUNIT_TEST(testMetadata);
     TSUNIT_TEST_END();
 };
 
@@ -172,6 +176,78 @@ namespace {
 }
 
 
+//----------------------------------------------------------------------------
+// Event handlers for memory plugins with access to packet metadata:
+// the input sets label N on packet N, the output collects all labels.
+//----------------------------------------------------------------------------
+
+namespace {
+    class LabelInput : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(LabelInput);
+    public:
+        LabelInput(const ts::TSPacket* packets, size_t count);
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+    private:
+        const ts::TSPacket* _packets;
+        size_t _packets_count;
+    };
+
+    LabelInput::LabelInput(const ts::TSPacket* packets, size_t count) :
+        _packets(packets),
+        _packets_count(count)
+    {
+    }
+
+    void LabelInput::handlePluginEvent(const ts::PluginEventContext& context)
+    {
+        ts::PluginEventPacketData* data = dynamic_cast<ts::PluginEventPacketData*>(context.pluginData());
+        if (data != nullptr && _packets_count > 0 && data->maxPacketCount() >= _packets_count) {
+            // Write directly in the tsp buffer.
+            ts::TSPacket::Copy(reinterpret_cast<ts::TSPacket*>(data->outputData()), _packets, _packets_count);
+            for (size_t i = 0; i < _packets_count; ++i) {
+                ts::TSPacketMetadata* mdata = data->outputPacketMetadata(i);
+                if (mdata != nullptr) {
+                    mdata->setLabel(i);
+                }
+            }
+            data->updateSize(_packets_count * ts::PKT_SIZE);
+            _packets_count = 0;
+        }
+    }
+
+    class LabelOutput : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(LabelOutput);
+    public:
+        LabelOutput(std::vector<uint32_t>& labels);
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+    private:
+        std::vector<uint32_t>& _labels;
+    };
+
+    LabelOutput::LabelOutput(std::vector<uint32_t>& labels) :
+        _labels(labels)
+    {
+    }
+
+    void LabelOutput::handlePluginEvent(const ts::PluginEventContext& context)
+    {
+        const ts::PluginEventPacketData* data = dynamic_cast<const ts::PluginEventPacketData*>(context.pluginData());
+        if (data != nullptr) {
+            // Output packets are read-only.
+            TSUNIT_ASSERT(data->outputPacketMetadata(0) == nullptr);
+            TSUNIT_ASSERT(data->packetMetadata(data->packetCount()) == nullptr);
+            for (size_t i = 0; i < data->packetCount(); ++i) {
+                const ts::TSPacketMetadata* mdata = data->packetMetadata(i);
+                TSUNIT_ASSERT(mdata != nullptr);
+                _labels.push_back(uint32_t(mdata->getLabels().to_ulong()));
+            }
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Reference TS packets, all on PID 100.
 //----------------------------------------------------------------------------
@@ -254,3 +330,58 @@ void MemoryPluginTest::testAll()
     TSUNIT_EQUAL(0, ::memcmp(&output_packets[0], REF_PACKETS, ts::PKT_SIZE * REF_PACKETS_COUNT));
     TSUNIT_EQUAL(u"", log_buffer);
 }
+
+void MemoryPluginTest::testLockFree()
+{
+    ts::UString log_buffer;
+    TestReport log(log_buffer);
+
+    ts::TSPacketVector output_packets;
+    Input input(REF_PACKETS, REF_PACKETS_COUNT);
+    Output output(output_packets);
+
+    // Use a few packet processors to exercise the handoff between adjacent plugins.
+    ts::TSProcessorArgs opt;
+    opt.lock_free = true;
+    opt.input = {u"memory", {}};
+    opt.plugins = {{u"skip", {u"0"}}, {u"skip", {u"1"}}, {u"skip", {u"0"}}};
+    opt.output = {u"memory", {}};
+
+    ts::TSProcessor tsp(log);
+    tsp.registerEventHandler(&input, ts::PluginType::INPUT);
+    tsp.registerEventHandler(&output, ts::PluginType::OUTPUT);
+
+    TSUNIT_ASSERT(tsp.start(opt));
+    tsp.waitForTermination();
+
+    TSUNIT_EQUAL(REF_PACKETS_COUNT - 1, output_packets.size());
+    TSUNIT_EQUAL(0, ::memcmp(&output_packets[0], &REF_PACKETS[1], ts::PKT_SIZE * (REF_PACKETS_COUNT - 1)));
+    TSUNIT_EQUAL(u"", log_buffer);
+}
+
+void MemoryPluginTest::testMetadata()
+{
+    ts::UString log_buffer;
+    TestReport log(log_buffer);
+
+    std::vector<uint32_t> labels;
+    LabelInput input(REF_PACKETS, REF_PACKETS_COUNT);
+    LabelOutput output(labels);
+
+    ts::TSProcessorArgs opt;
+    opt.input = {u"memory", {}};
+    opt.output = {u"memory", {}};
+
+    ts::TSProcessor tsp(log);
+    tsp.registerEventHandler(&input, ts::PluginType::INPUT);
+    tsp.registerEventHandler(&output, ts::PluginType::OUTPUT);
+
+    TSUNIT_ASSERT(tsp.start(opt));
+    tsp.waitForTermination();
+
+    TSUNIT_EQUAL(REF_PACKETS_COUNT, labels.size());
+    for (size_t i = 0; i < labels.size(); ++i) {
+        TSUNIT_EQUAL(uint32_t(1) << i, labels[i]);
+    }
+    TSUNIT_EQUAL(u"", log_buffer);
+}
@@ -0,0 +1,247 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::Muxer
+//
+//----------------------------------------------------------------------------
+
+#include "tsMuxer.h"
+#include "tsTSFile.h"
+#include "tsTSPacket.h"
+#include "tsFileUtils.h"
+#include "tsCerrReport.h"
+#include "tsNullReport.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class MuxerTest: public tsunit::Test
+{
+public:
+    MuxerTest();
+
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testScheduling();
+
+    TSUNIT_TEST_BEGIN(MuxerTest);
+    TSUNIT_TEST(testScheduling);
+    TSUNIT_TEST_END();
+
+private:
+    ts::UString _input1;
+    ts::UString _input2;
+    ts::UString _output;
+
+    // Statistics on a muxed output file.
+    struct MuxStats
+    {
+        size_t count1;     // Packets from input 1.
+        size_t count2;     // Packets from input 2.
+        size_t stuffing;   // Null packets between the first and last input packets.
+        size_t max_burst;  // Longest run of consecutive packets from input 1, in the second half of the input.
+        bool   in_order;   // All packets from each input are in order.
+    };
+
+    // Create a CBR input file with one PCR every 10 packets.
+    static void CreateInput(const ts::UString& name, ts::PID pid, size_t count, ts::BitRate bitrate);
+
+    // Run the muxer and analyze its output file.
+    void runMuxer(ts::MuxScheduling scheduling, MuxStats& stats);
+};
+
+TSUNIT_REGISTER(MuxerTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+namespace {
+    constexpr ts::PID PID1 = 0x0100;
+    constexpr ts::PID PID2 = 0x0200;
+    constexpr size_t COUNT1 = 4000;
+    constexpr size_t COUNT2 = 6000;
+    const ts::BitRate BITRATE1 = 16000000;
+    const ts::BitRate BITRATE2 = 24000000;
+    const ts::BitRate OUTPUT_BITRATE = 80000000;
+}
+
+// Constructor.
+MuxerTest::MuxerTest() :
+    _input1(),
+    _input2(),
+    _output()
+{
+}
+
+// Test suite initialization method.
+void MuxerTest::beforeTest()
+{
+    if (_input1.empty()) {
+        _input1 = ts::TempFile(u".in1.ts");
+        _input2 = ts::TempFile(u".in2.ts");
+        _output = ts::TempFile(u".out.ts");
+    }
+    ts::DeleteFile(_input1, NULLREP);
+    ts::DeleteFile(_input2, NULLREP);
+    ts::DeleteFile(_output, NULLREP);
+}
+
+// Test suite cleanup method.
+void MuxerTest::afterTest()
+{
+    ts::DeleteFile(_input1, NULLREP);
+    ts::DeleteFile(_input2, NULLREP);
+    ts::DeleteFile(_output, NULLREP);
+}
+
+
+//----------------------------------------------------------------------------
+// Test utilities.
+//----------------------------------------------------------------------------
+
+void MuxerTest::CreateInput(const ts::UString& name, ts::PID pid, size_t count, ts::BitRate bitrate)
+{
+    ts::TSFile file;
+    TSUNIT_ASSERT(file.open(name, ts::TSFile::WRITE, CERR));
+    for (size_t i = 0; i < count; ++i) {
+        ts::TSPacket pkt;
+        pkt.init(pid, uint8_t(i & 0x0F));
+        if (i % 10 == 0) {
+            pkt.setPCR(((ts::BitRate(i * ts::PKT_SIZE_BITS * ts::SYSTEM_CLOCK_FREQ)) / bitrate).toInt(), true);
+        }
+        // Use the start of the payload to number the packets.
+        ts::PutUInt16(pkt.getPayload(), uint16_t(i));
+        TSUNIT_ASSERT(file.writePackets(&pkt, nullptr, 1, CERR));
+    }
+    TSUNIT_ASSERT(file.close(CERR));
+}
+
+void MuxerTest::runMuxer(ts::MuxScheduling scheduling, MuxStats& stats)
+{
+    stats = MuxStats();
+    stats.in_order = true;
+
+    ts::MuxerArgs args;
+    args.appName = u"MuxerTest";
+    args.inputs = {{u"file", {_input1}}, {u"file", {_input2}}};
+    args.output = {u"file", {_output}};
+    args.outputBitRate = OUTPUT_BITRATE;
+    args.inputOnce = args.outputOnce = true;
+    args.nitScope = args.sdtScope = args.eitScope = ts::TableScope::NONE;
+    args.scheduling = scheduling;
+    args.enforceDefaults();
+
+    ts::Muxer mux(CERR);
+    TSUNIT_ASSERT(mux.start(args));
+    mux.waitForTermination();
+
+    // Analyze the output file.
+    ts::TSFile file;
+    TSUNIT_ASSERT(file.open(_output, ts::TSFile::READ, CERR));
+    ts::TSPacket pkt;
+    size_t pending_stuffing = 0;
+    size_t burst = 0;
+    while (file.readPackets(&pkt, nullptr, 1, CERR) == 1) {
+        const ts::PID pid = pkt.getPID();
+        const bool from_input = pid == PID1 || pid == PID2;
+        if (from_input) {
+            const size_t index = ts::GetUInt16(pkt.getPayload());
+            size_t& count(pid == PID1 ? stats.count1 : stats.count2);
+            stats.in_order = stats.in_order && index == count;
+            count++;
+            if (stats.count1 + stats.count2 > 1) {
+                stats.stuffing += pending_stuffing;
+            }
+            pending_stuffing = 0;
+        }
+        else if (pid == ts::PID_NULL) {
+            pending_stuffing++;
+        }
+        if (pid == PID1) {
+            burst++;
+            if (stats.count1 > COUNT1 / 2) {
+                stats.max_burst = std::max(stats.max_burst, burst);
+            }
+        }
+        else if (from_input || pid == ts::PID_NULL) {
+            burst = 0;
+        }
+    }
+    TSUNIT_ASSERT(file.close(CERR));
+
+    debug() << "MuxerTest: " << ts::MuxSchedulingEnum.name(int(scheduling))
+            << ", packets: " << stats.count1 << ", " << stats.count2
+            << ", stuffing: " << stats.stuffing << ", max burst: " << stats.max_burst << std::endl;
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void MuxerTest::testScheduling()
+{
+    // Two CBR inputs using half of the output bandwidth, during about 0.4 second.
+    CreateInput(_input1, PID1, COUNT1, BITRATE1);
+    CreateInput(_input2, PID2, COUNT2, BITRATE2);
+
+    MuxStats rr;
+    MuxStats dl;
+    runMuxer(ts::MuxScheduling::ROUND_ROBIN, rr);
+    runMuxer(ts::MuxScheduling::DEADLINE, dl);
+
+    // With both methods, the input packets are muxed in order. The last packets of
+    // an input may be dropped when all inputs terminate: allow a 2% loss at the end.
+    TSUNIT_ASSERT(rr.in_order);
+    TSUNIT_ASSERT(50 * rr.count1 >= 49 * COUNT1);
+    TSUNIT_ASSERT(50 * rr.count2 >= 49 * COUNT2);
+    TSUNIT_ASSERT(dl.in_order);
+    TSUNIT_ASSERT(50 * dl.count1 >= 49 * COUNT1);
+    TSUNIT_ASSERT(50 * dl.count2 >= 49 * COUNT2);
+
+    // The input streams use half of the output bitrate, the rest is stuffing. The deadline
+    // scheduling spreads the input packets but does not waste bandwidth: the amount of
+    // stuffing while the inputs are muxed is similar to round-robin, within 10%.
+    TSUNIT_ASSERT(dl.stuffing > (COUNT1 + COUNT2) / 2);
+    TSUNIT_ASSERT(rr.stuffing > (COUNT1 + COUNT2) / 2);
+    TSUNIT_ASSERT(10 * dl.stuffing >= 9 * rr.stuffing);
+    TSUNIT_ASSERT(10 * dl.stuffing <= 11 * rr.stuffing);
+
+    // Round-robin sends bursts of input packets after each PCR. Deadline scheduling
+    // paces the packets at the input bitrate, once it is known, within the limits of
+    // the transport buffer model (512 bytes, leaking during each output packet).
+    TSUNIT_ASSERT(dl.max_burst <= 3);
+    TSUNIT_ASSERT(rr.max_burst > dl.max_burst);
+}
@@ -34,6 +34,7 @@
 #include "tsNamesFile.h"
 #include "tsNames.h"
 #include "tsFileUtils.h"
+#include "tsNullReport.h"
 #include "tsDuckContext.h"
 #include "tsMPEG2.h"
 #include "tsAVC.h"
@@ -91,6 +92,7 @@ public:
     void testHiDes();
     void testIP();
     void testExtension();
+    void testIndex();
 
     TSUNIT_TEST_BEGIN(NamesTest);
     TSUNIT_TEST(testConfigFile);
@@ -133,6 +135,7 @@ public:
     TSUNIT_TEST(testHiDes);
     TSUNIT_TEST(testIP);
     TSUNIT_TEST(testExtension);
+    TSUNIT_TEST(testIndex);
     TSUNIT_TEST_END();
 };
 
@@ -479,3 +482,52 @@ void NamesTest::testExtension()
     // Delete temporary file
     ts::DeleteFile(file);
 }
+
+void NamesTest::testIndex()
+{
+    // Create a temporary copy of the DTV names file and its binary index.
+    ts::UStringVector lines;
+    TSUNIT_ASSERT(ts::UString::Load(lines, ts::NamesFile::Instance(ts::NamesFile::Predefined::DTV)->configurationFile()));
+    const ts::UString file(ts::AbsoluteFilePath(ts::TempFile(u".names")));
+    const ts::UString index(file + ts::NamesFile::INDEX_SUFFIX);
+    debug() << "NamesTest::testIndex: names file: " << file << std::endl;
+    TSUNIT_ASSERT(ts::UString::Save(lines, file));
+
+    const ts::NamesFile text(file, false, false);
+    TSUNIT_ASSERT(!text.indexLoaded());
+    TSUNIT_EQUAL(0, text.errorCount());
+    TSUNIT_ASSERT(text.saveIndex(index, NULLREP));
+    TSUNIT_ASSERT(ts::FileExists(index));
+
+    {
+        const ts::NamesFile bin(file);
+        TSUNIT_ASSERT(bin.indexLoaded());
+        TSUNIT_EQUAL(0, bin.errorCount());
+        TSUNIT_ASSERT(!bin.saveIndex(ts::TempFile(), NULLREP));
+
+        // All lookups must return the same names with and without index.
+        const ts::UStringVector sections({u"CASFamily", u"Standards", u"TableId", u"DescriptorId", u"CASystemId", u"StreamType", u"PESStartCode", u"unknown-section"});
+        for (auto it = sections.begin(); it != sections.end(); ++it) {
+            const ts::UString& sec(*it);
+            for (ts::NamesFile::Value value = 0; value < 0x10000; value += 7) {
+                TSUNIT_EQUAL(text.nameExists(sec, value), bin.nameExists(sec, value));
+                TSUNIT_EQUAL(text.nameFromSection(sec, value, ts::NamesFlags::VALUE), bin.nameFromSection(sec, value, ts::NamesFlags::VALUE));
+                TSUNIT_EQUAL(text.nameFromSectionWithFallback(sec, value, value & 0xFF, ts::NamesFlags::HEXA_FIRST), bin.nameFromSectionWithFallback(sec, value, value & 0xFF, ts::NamesFlags::HEXA_FIRST));
+            }
+        }
+        TSUNIT_EQUAL(u"CAT", bin.nameFromSection(u" TABLEID ", 0x00010000 | ts::TID_CAT));
+    }
+
+    // Modify the names file, the index becomes obsolete and the text is used.
+    lines.push_back(u"[TestSection]");
+    lines.push_back(u"0x1234 = test-name");
+    TSUNIT_ASSERT(ts::UString::Save(lines, file));
+    {
+        const ts::NamesFile bin(file);
+        TSUNIT_ASSERT(!bin.indexLoaded());
+        TSUNIT_EQUAL(u"test-name", bin.nameFromSection(u"TestSection", 0x1234));
+    }
+
+    ts::DeleteFile(index);
+    ts::DeleteFile(file);
+}
@@ -40,6 +40,7 @@
 #include "tsTCPConnection.h"
 #include "tsTCPServer.h"
 #include "tsUDPSocket.h"
+#include "tsNullReport.h"
 #include "tsThread.h"
 #include "tsSysUtils.h"
 #include "tsIPUtils.h"
@@ -70,6 +71,8 @@ public:
     void testIPv6SocketAddress();
     void testTCPSocket();
     void testUDPSocket();
+    void testUDPBatch();
+    void testUDPOffload();
     void testIPHeader();
     void testIPProtocol();
     void testTCPPacket();
@@ -86,6 +89,8 @@ public:
     TSUNIT_TEST(testIPv6SocketAddress);
     TSUNIT_TEST(testTCPSocket);
     TSUNIT_TEST(testUDPSocket);
+    TSUNIT_TEST(testUDPBatch);
+    TSUNIT_TEST(testUDPOffload);
     TSUNIT_TEST(testIPHeader);
     TSUNIT_TEST(testIPProtocol);
     TSUNIT_TEST(testTCPPacket);
@@ -721,6 +726,125 @@ void NetworkingTest::testUDPSocket()
     CERR.debug(u"UDPSocketTest: main thread: reply sent");
 }
 
+void NetworkingTest::testUDPBatch()
+{
+    TSUNIT_ASSERT(ts::IPInitialize());
+
+    const ts::IPv4SocketAddress address(ts::IPv4Address::LocalHost, 12346);
+    const size_t count = 10;
+
+    // Create receiver socket.
+    ts::UDPSocket receiver;
+    TSUNIT_ASSERT(receiver.open(CERR));
+    TSUNIT_ASSERT(receiver.reusePort(true, CERR));
+    TSUNIT_ASSERT(receiver.bind(address, CERR));
+
+    // Create sender socket and send all messages at once.
+    ts::UDPSocket sender;
+    TSUNIT_ASSERT(sender.open(CERR));
+    TSUNIT_ASSERT(sender.setDefaultDestination(address, CERR));
+
+    uint8_t out[count][100];
+    const void* out_addresses[count];
+    size_t out_sizes[count];
+    for (size_t i = 0; i < count; ++i) {
+        ::memset(out[i], int(i), sizeof(out[i]));
+        out_addresses[i] = out[i];
+        out_sizes[i] = 10 + i;
+    }
+    TSUNIT_ASSERT(sender.sendBatch(out_addresses, out_sizes, count, CERR));
+
+    // Receive all messages, possibly in several batches.
+    uint8_t in[count][100];
+    ts::UDPSocket::ReceivedMessage msgs[count];
+    size_t received = 0;
+    while (received < count) {
+        for (size_t i = 0; i < count; ++i) {
+            msgs[i].data = in[i];
+            msgs[i].max_size = sizeof(in[i]);
+        }
+        size_t ret_count = 0;
+        TSUNIT_ASSERT(receiver.receiveBatch(msgs, count - received, ret_count, nullptr, CERR));
+        TSUNIT_ASSERT(ret_count > 0);
+        TSUNIT_ASSERT(ret_count <= count - received);
+        debug() << "NetworkingTest::testUDPBatch: received " << ret_count << " messages" << std::endl;
+        for (size_t i = 0; i < ret_count; ++i) {
+            TSUNIT_EQUAL(10 + received, msgs[i].size);
+            TSUNIT_ASSERT(ts::IPv4Address(msgs[i].sender) == ts::IPv4Address::LocalHost);
+            TSUNIT_EQUAL(0, ::memcmp(msgs[i].data, out[received], msgs[i].size));
+            received++;
+        }
+    }
+}
+
+void NetworkingTest::testUDPOffload()
+{
+    TSUNIT_ASSERT(ts::IPInitialize());
+
+    const ts::IPv4SocketAddress address(ts::IPv4Address::LocalHost, 12347);
+    const size_t count = 10;
+
+    // Create receiver socket with receive offload.
+    // Skip the test when the system does not support UDP offload (Linux before 5.0).
+    ts::UDPSocket receiver;
+    TSUNIT_ASSERT(receiver.open(CERR));
+    TSUNIT_ASSERT(receiver.reusePort(true, CERR));
+    if (!receiver.setReceiveCoalescing(true, NULLREP)) {
+        debug() << "NetworkingTest::testUDPOffload: UDP receive offload not supported, test skipped" << std::endl;
+        return;
+    }
+    TSUNIT_ASSERT(receiver.bind(address, CERR));
+
+    // Create sender socket with segmentation offload.
+    ts::UDPSocket sender;
+    TSUNIT_ASSERT(sender.open(CERR));
+    if (!sender.setSendSegmentation(true, NULLREP)) {
+        debug() << "NetworkingTest::testUDPOffload: UDP segmentation offload not supported, test skipped" << std::endl;
+        return;
+    }
+    TSUNIT_ASSERT(sender.setDefaultDestination(address, CERR));
+
+    // Datagrams of identical size, except the last one.
+    uint8_t out[count][100];
+    const void* out_addresses[count];
+    size_t out_sizes[count];
+    for (size_t i = 0; i < count; ++i) {
+        ::memset(out[i], int(i), sizeof(out[i]));
+        out_addresses[i] = out[i];
+        out_sizes[i] = i < count - 1 ? sizeof(out[i]) : 50;
+    }
+    TSUNIT_ASSERT(sender.sendBatch(out_addresses, out_sizes, count, CERR));
+
+    // Receive all datagrams, possibly coalesced.
+    uint8_t in[count][2048];
+    ts::UDPSocket::ReceivedMessage msgs[count];
+    for (size_t i = 0; i < count; ++i) {
+        msgs[i].data = in[i];
+        msgs[i].max_size = sizeof(in[i]);
+    }
+    size_t received = 0;
+    while (received < count) {
+        size_t ret_count = 0;
+        TSUNIT_ASSERT(receiver.receiveBatch(msgs, count, ret_count, nullptr, CERR));
+        TSUNIT_ASSERT(ret_count > 0);
+        for (size_t i = 0; i < ret_count; ++i) {
+            debug() << "NetworkingTest::testUDPOffload: received " << msgs[i].size << " bytes, segment size: " << msgs[i].segment_size << std::endl;
+            // Split coalesced messages into the original datagrams.
+            const uint8_t* data = reinterpret_cast<const uint8_t*>(msgs[i].data);
+            size_t size = msgs[i].size;
+            while (size > 0) {
+                const size_t dg_size = msgs[i].segment_size > 0 ? std::min(size, msgs[i].segment_size) : size;
+                TSUNIT_ASSERT(received < count);
+                TSUNIT_EQUAL(out_sizes[received], dg_size);
+                TSUNIT_EQUAL(0, ::memcmp(data, out[received], dg_size));
+                data += dg_size;
+                size -= dg_size;
+                received++;
+            }
+        }
+    }
+}
+
 void NetworkingTest::testIPHeader()
 {
     static const uint8_t reference_header[] = {
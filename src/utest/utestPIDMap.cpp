@@ -0,0 +1,246 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::PIDMap.
+//
+//----------------------------------------------------------------------------
+
+#include "tsPIDMap.h"
+#include "tsAlgorithm.h"
+#include "tsUString.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class PIDMapTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testEmpty();
+    void testAccess();
+    void testIteration();
+    void testErase();
+    void testCopy();
+
+    TSUNIT_TEST_BEGIN(PIDMapTest);
+    TSUNIT_TEST(testEmpty);
+    TSUNIT_TEST(testAccess);
+    TSUNIT_TEST(testIteration);
+    TSUNIT_TEST(testErase);
+    TSUNIT_TEST(testCopy);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(PIDMapTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void PIDMapTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void PIDMapTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void PIDMapTest::testEmpty()
+{
+    ts::PIDMap<int> map;
+    TSUNIT_ASSERT(map.empty());
+    TSUNIT_EQUAL(0, map.size());
+    TSUNIT_ASSERT(map.begin() == map.end());
+    TSUNIT_ASSERT(map.find(0) == map.end());
+    TSUNIT_ASSERT(map.find(ts::PID_NULL) == map.end());
+    TSUNIT_EQUAL(0, map.count(100));
+    TSUNIT_EQUAL(0, map.erase(100));
+    TSUNIT_ASSERT(!ts::Contains(map, 100));
+}
+
+void PIDMapTest::testAccess()
+{
+    ts::PIDMap<ts::UString> map;
+
+    map[200] = u"foo";
+    TSUNIT_ASSERT(!map.empty());
+    TSUNIT_EQUAL(1, map.size());
+    TSUNIT_EQUAL(1, map.count(200));
+    TSUNIT_EQUAL(0, map.count(201));
+    TSUNIT_ASSERT(ts::Contains(map, 200));
+
+    // Default-constructed element.
+    TSUNIT_ASSERT(map[ts::PID_NULL].empty());
+    TSUNIT_EQUAL(2, map.size());
+
+    auto it = map.find(200);
+    TSUNIT_ASSERT(it != map.end());
+    TSUNIT_EQUAL(200, it->first);
+    TSUNIT_EQUAL(u"foo", it->second);
+    it->second = u"bar";
+    TSUNIT_EQUAL(u"bar", map[200]);
+
+    const auto res1 = map.insert(std::make_pair(ts::PID(300), ts::UString(u"abc")));
+    TSUNIT_ASSERT(res1.second);
+    TSUNIT_EQUAL(300, res1.first->first);
+    TSUNIT_EQUAL(u"abc", map[300]);
+
+    const auto res2 = map.insert(std::make_pair(ts::PID(300), ts::UString(u"def")));
+    TSUNIT_ASSERT(!res2.second);
+    TSUNIT_EQUAL(u"abc", res2.first->second);
+    TSUNIT_EQUAL(3, map.size());
+
+    // References remain valid when other elements are inserted or erased.
+    ts::UString& ref(map[300]);
+    for (ts::PID pid = 0; pid < 100; ++pid) {
+        map[pid] = ts::UString::Decimal(pid);
+    }
+    map.erase(200);
+    TSUNIT_EQUAL(u"abc", ref);
+
+    // Invalid PID value.
+    bool thrown = false;
+    try {
+        map[ts::PID_MAX] = u"invalid";
+    }
+    catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    TSUNIT_ASSERT(thrown);
+}
+
+void PIDMapTest::testIteration()
+{
+    ts::PIDMap<int> map;
+    map[ts::PID_NULL] = 4;
+    map[0] = 1;
+    map[1000] = 3;
+    map[17] = 2;
+
+    // Iteration in increasing order of PID.
+    std::vector<ts::PID> pids;
+    int expected = 1;
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        TSUNIT_EQUAL(expected++, it->second);
+        pids.push_back(it->first);
+    }
+    TSUNIT_EQUAL(4, pids.size());
+    TSUNIT_EQUAL(0, pids[0]);
+    TSUNIT_EQUAL(17, pids[1]);
+    TSUNIT_EQUAL(1000, pids[2]);
+    TSUNIT_EQUAL(ts::PID_NULL, pids[3]);
+
+    // Const iteration, range-based loop.
+    const ts::PIDMap<int>& cmap(map);
+    int sum = 0;
+    for (const auto& it : cmap) {
+        sum += it.second;
+    }
+    TSUNIT_EQUAL(10, sum);
+
+    // Conversion from iterator to const_iterator.
+    ts::PIDMap<int>::const_iterator cit = map.begin();
+    TSUNIT_ASSERT(cit == cmap.begin());
+    TSUNIT_EQUAL(0, cit->first);
+    cit++;
+    TSUNIT_EQUAL(17, cit->first);
+}
+
+void PIDMapTest::testErase()
+{
+    ts::PIDMap<int> map;
+    for (ts::PID pid = 0; pid < ts::PID_MAX; pid += 10) {
+        map[pid] = int(pid);
+    }
+    TSUNIT_EQUAL(820, map.size());
+
+    // Erase all PID's which are multiple of 20 while iterating.
+    for (auto it = map.begin(); it != map.end(); ) {
+        if (it->first % 20 == 0) {
+            it = map.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+    TSUNIT_EQUAL(410, map.size());
+    TSUNIT_EQUAL(10, map.begin()->first);
+    TSUNIT_EQUAL(0, map.count(20));
+    TSUNIT_EQUAL(1, map.count(30));
+
+    TSUNIT_EQUAL(1, map.erase(30));
+    TSUNIT_EQUAL(0, map.erase(30));
+    TSUNIT_EQUAL(409, map.size());
+
+    map.clear();
+    TSUNIT_ASSERT(map.empty());
+    TSUNIT_ASSERT(map.begin() == map.end());
+}
+
+void PIDMapTest::testCopy()
+{
+    ts::PIDMap<ts::UString> map1;
+    map1[10] = u"ten";
+    map1[20] = u"twenty";
+
+    ts::PIDMap<ts::UString> map2(map1);
+    TSUNIT_EQUAL(2, map2.size());
+    map2[10] = u"dix";
+    TSUNIT_EQUAL(u"ten", map1[10]);
+    TSUNIT_EQUAL(u"dix", map2[10]);
+
+    ts::PIDMap<ts::UString> map3;
+    map3[5] = u"five";
+    map3 = map1;
+    TSUNIT_EQUAL(2, map3.size());
+    TSUNIT_EQUAL(0, map3.count(5));
+    TSUNIT_EQUAL(u"twenty", map3[20]);
+
+    ts::PIDMap<ts::UString> map4(std::move(map3));
+    TSUNIT_EQUAL(2, map4.size());
+    TSUNIT_ASSERT(map3.empty());
+    TSUNIT_EQUAL(u"ten", map4[10]);
+
+    map3 = std::move(map4);
+    TSUNIT_EQUAL(2, map3.size());
+    TSUNIT_ASSERT(map4.empty());
+}
@@ -58,9 +58,13 @@ public:
     virtual void afterTest() override;
 
     void testPacketizer();
+    void testPacketCache();
+    void testScheduler();
 
     TSUNIT_TEST_BEGIN(PacketizerTest);
     TSUNIT_TEST(testPacketizer);
+    TSUNIT_TEST(testPacketCache);
+    TSUNIT_TEST(testScheduler);
     TSUNIT_TEST_END();
 
 private:
@@ -177,3 +181,128 @@ void PacketizerTest::testPacketizer()
     TSUNIT_ASSERT(pmt_count == 4);
     TSUNIT_ASSERT(sdt_count >= 12 && sdt_count <= 18);
 }
+
+// A section provider which cycles over a list of sections, without packet cache.
+namespace {
+    class RoundRobinProvider: public ts::SectionProviderInterface
+    {
+        TS_NOBUILD_NOCOPY(RoundRobinProvider);
+    public:
+        RoundRobinProvider(const ts::SectionPtrVector& sections) : _sections(sections), _next(0) {}
+        virtual void provideSection(ts::SectionCounter counter, ts::SectionPtr& section) override;
+        virtual bool doStuffing() override;
+    private:
+        const ts::SectionPtrVector& _sections;
+        size_t _next;
+    };
+
+    void RoundRobinProvider::provideSection(ts::SectionCounter counter, ts::SectionPtr& section)
+    {
+        section = _sections[_next];
+        _next = (_next + 1) % _sections.size();
+    }
+
+    bool RoundRobinProvider::doStuffing()
+    {
+        return false;
+    }
+}
+
+void PacketizerTest::testPacketCache()
+{
+    // Sections of various sizes, from less than one packet to many packets.
+    ts::DuckContext duck;
+    ts::SectionPtrVector sections;
+    for (size_t i = 0; i < 12; ++i) {
+        ts::ByteBlock payload(30 + 337 * i);
+        for (size_t j = 0; j < payload.size(); ++j) {
+            payload[j] = uint8_t(i + j);
+        }
+        sections.push_back(new ts::Section(ts::TID_EIT_S_ACT_MIN, true, uint16_t(i), 0, true, 0, 0, payload.data(), payload.size()));
+    }
+
+    // Packetize the same cycle of sections with and without packet cache.
+    RoundRobinProvider provider(sections);
+    ts::Packetizer ref(duck, 0x0100, &provider);
+    ts::CyclingPacketizer pzer(duck, 0x0100, ts::CyclingPacketizer::StuffingPolicy::NEVER);
+    pzer.addSections(sections);
+
+    for (size_t pi = 0; pi < 2000; ++pi) {
+        if (pi == 1000) {
+            // Modify a section in place, the cached packets are no longer valid.
+            sections[7]->setVersion(1);
+        }
+        ts::TSPacket pkt1, pkt2;
+        ref.getNextPacket(pkt1);
+        pzer.getNextPacket(pkt2);
+        TSUNIT_EQUAL(0, ::memcmp(pkt1.b, pkt2.b, ts::PKT_SIZE));
+    }
+    TSUNIT_EQUAL(ref.sectionCount(), pzer.sectionCount());
+}
+
+void PacketizerTest::testScheduler()
+{
+    // One-packet sections: 20 sections every second, 10 sections every 500 ms, 100 packets per second.
+    ts::DuckContext duck;
+    ts::CyclingPacketizer pzer(duck, 0x0100, ts::CyclingPacketizer::StuffingPolicy::ALWAYS, ts::PKT_SIZE_BITS * 100);
+    const uint8_t payload[20] = {0};
+    for (uint16_t i = 0; i < 20; ++i) {
+        pzer.addSection(new ts::Section(0x50, true, i, 0, true, 0, 0, payload, sizeof(payload)), 1000);
+    }
+    for (uint16_t i = 0; i < 10; ++i) {
+        pzer.addSection(new ts::Section(0x60, true, i, 0, true, 0, 0, payload, sizeof(payload)), 500);
+    }
+    TSUNIT_EQUAL(30, pzer.storedSectionCount());
+    TSUNIT_EQUAL(ts::PKT_SIZE_BITS * 40, pzer.scheduledBitRate().toInt());
+
+    // Count sections per table id and table id extension during 10 seconds.
+    std::map<uint32_t, size_t> counts;
+    for (size_t pi = 0; pi < 1000; ++pi) {
+        ts::TSPacket pkt;
+        if (pzer.getNextPacket(pkt)) {
+            counts[uint32_t(pkt.b[5]) << 16 | ts::GetUInt16(pkt.b + 8)]++;
+        }
+    }
+    TSUNIT_EQUAL(30, counts.size());
+    for (const auto& it : counts) {
+        debug() << "PacketizerTest::testScheduler: TID " << ts::UString::Hexa(uint8_t(it.first >> 16)) << ", TIDext " << (it.first & 0xFFFF) << ": " << it.second << std::endl;
+        if ((it.first >> 16) == 0x50) {
+            TSUNIT_ASSERT(it.second >= 9 && it.second <= 11);
+        }
+        else {
+            TSUNIT_ASSERT(it.second >= 19 && it.second <= 21);
+        }
+    }
+
+    // Remove some scheduled sections, they are no longer sent.
+    pzer.removeSections(0x60);
+    TSUNIT_EQUAL(20, pzer.storedSectionCount());
+    TSUNIT_EQUAL(ts::PKT_SIZE_BITS * 20, pzer.scheduledBitRate().toInt());
+    pzer.removeSections(0x50, 3);
+    TSUNIT_EQUAL(19, pzer.storedSectionCount());
+
+    counts.clear();
+    for (size_t pi = 0; pi < 1000; ++pi) {
+        ts::TSPacket pkt;
+        if (pzer.getNextPacket(pkt)) {
+            TSUNIT_EQUAL(0x50, pkt.b[5]);
+            counts[ts::GetUInt16(pkt.b + 8)]++;
+        }
+    }
+    TSUNIT_EQUAL(19, counts.size());
+    TSUNIT_ASSERT(counts.find(3) == counts.end());
+
+    // Without bitrate, the sections are no longer scheduled and sent one after the other.
+    pzer.setBitRate(0);
+    TSUNIT_EQUAL(0, pzer.scheduledBitRate().toInt());
+    counts.clear();
+    for (size_t pi = 0; pi < 190; ++pi) {
+        ts::TSPacket pkt;
+        TSUNIT_ASSERT(pzer.getNextPacket(pkt));
+        counts[ts::GetUInt16(pkt.b + 8)]++;
+    }
+    TSUNIT_EQUAL(19, counts.size());
+    for (const auto& it : counts) {
+        TSUNIT_EQUAL(10, it.second);
+    }
+}
@@ -121,6 +121,7 @@ public:
     void testGetIntVarLE();
     void testPutIntVarBE();
     void testPutIntVarLE();
+    void testMemXor();
 
     TSUNIT_TEST_BEGIN(PlatformTest);
     TSUNIT_TEST(testIntegerTypes);
@@ -195,6 +196,7 @@ public:
     TSUNIT_TEST(testGetIntVarLE);
     TSUNIT_TEST(testPutIntVarBE);
     TSUNIT_TEST(testPutIntVarLE);
+    TSUNIT_TEST(testMemXor);
     TSUNIT_TEST_END();
 };
 
@@ -886,3 +888,37 @@ void PlatformTest::testPutIntVarLE()
     ts::PutIntVarLE(out, 8, TS_UCONST64(0x908F8E8D8C8B8A89));
     TSUNIT_EQUAL(0, ::memcmp(out, _bytes + 0x89, 8));
 }
+
+void PlatformTest::testMemXor()
+{
+    // Use all combinations of unaligned areas and sizes which are not multiples of 8.
+    uint8_t a[64];
+    uint8_t b[64];
+    uint8_t out[64];
+    for (size_t i = 0; i < sizeof(a); ++i) {
+        a[i] = uint8_t(i);
+        b[i] = uint8_t(0xA5 + 3 * i);
+    }
+    for (size_t off1 = 0; off1 < 8; ++off1) {
+        for (size_t off2 = 0; off2 < 8; ++off2) {
+            for (size_t off3 = 0; off3 < 8; ++off3) {
+                const size_t size = 45 + off1;
+                ::memset(out, 0, sizeof(out));
+                ts::MemXor(out + off3, a + off1, b + off2, size);
+                for (size_t i = 0; i < sizeof(out); ++i) {
+                    const uint8_t expected = i >= off3 && i < off3 + size ? uint8_t(a[off1 + i - off3] ^ b[off2 + i - off3]) : 0;
+                    TSUNIT_EQUAL(expected, out[i]);
+                }
+            }
+        }
+    }
+
+    // In-place operation, as used by the cipher chaining modes.
+    ::memcpy(out, a, sizeof(a));
+    ts::MemXor(out + 1, out + 1, b + 3, 50);
+    for (size_t i = 1; i < 51; ++i) {
+        TSUNIT_EQUAL(uint8_t(a[i] ^ b[i + 2]), out[i]);
+    }
+    TSUNIT_EQUAL(a[0], out[0]);
+    TSUNIT_EQUAL(a[51], out[51]);
+}
@@ -32,6 +32,8 @@
 //----------------------------------------------------------------------------
 
 #include "tsDVBCSA2.h"
+#include "tsTSScrambling.h"
+#include "tsNullReport.h"
 #include "tsTSPacket.h"
 #include "tsNames.h"
 #include "tsunit.h"
@@ -48,9 +50,13 @@ public:
     virtual void afterTest() override;
 
     void testScrambling();
+    void testBatch();
+    void testTSScramblingBatch();
 
     TSUNIT_TEST_BEGIN(ScramblingTest);
     TSUNIT_TEST(testScrambling);
+    TSUNIT_TEST(testBatch);
+    TSUNIT_TEST(testTSScramblingBatch);
     TSUNIT_TEST_END();
 };
 
@@ -210,3 +216,129 @@ void ScramblingTest::testScrambling()
         TSUNIT_ASSERT(::memcmp(pkt.b + header_size, vec->cipher.b + header_size, payload_size) == 0);
     }
 }
+
+void ScramblingTest::testBatch()
+{
+    // Decrypt many copies of each test vector in one batch, more than the number of parallel lanes.
+    const size_t count = 300;
+    std::vector<ts::TSPacket> pkts(count);
+    std::vector<void*> data(count);
+    std::vector<size_t> size(count);
+    ts::DVBCSA2 scrambler;
+
+    const ScramblingTestVector* vec = scrambling_test_vectors;
+    for (size_t ti = 0; ti < sizeof(scrambling_test_vectors) / sizeof(ScramblingTestVector); ++ti, ++vec) {
+        const size_t header_size = vec->plain.getHeaderSize();
+        const size_t payload_size = vec->plain.getPayloadSize();
+        const uint8_t scv = vec->cipher.getScrambling();
+        TSUNIT_ASSERT(scrambler.setKey(scv == ts::SC_EVEN_KEY ? vec->cw_even : vec->cw_odd, sizeof(vec->cw_even)));
+
+        for (size_t i = 0; i < count; ++i) {
+            pkts[i] = vec->cipher;
+            data[i] = pkts[i].b + header_size;
+            size[i] = payload_size;
+        }
+        TSUNIT_ASSERT(scrambler.decryptInPlaceBatch(data.data(), size.data(), count));
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_ASSERT(::memcmp(pkts[i].b + header_size, vec->plain.b + header_size, payload_size) == 0);
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            pkts[i] = vec->plain;
+        }
+        TSUNIT_ASSERT(scrambler.encryptInPlaceBatch(data.data(), size.data(), count));
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_ASSERT(::memcmp(pkts[i].b + header_size, vec->cipher.b + header_size, payload_size) == 0);
+        }
+    }
+
+    // Data areas of all sizes in the same batch, compared with individual processing.
+    std::vector<ts::TSPacket> ref(count);
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t n = 0; n < ts::PKT_SIZE; ++n) {
+            pkts[i].b[n] = uint8_t(i * 13 + n * 7);
+        }
+        ref[i] = pkts[i];
+        data[i] = pkts[i].b + 4;
+        size[i] = i % (ts::PKT_SIZE - 3);
+    }
+    TSUNIT_ASSERT(scrambler.encryptInPlaceBatch(data.data(), size.data(), count));
+    for (size_t i = 0; i < count; ++i) {
+        TSUNIT_ASSERT(scrambler.encryptInPlace(ref[i].b + 4, size[i]));
+        TSUNIT_ASSERT(pkts[i] == ref[i]);
+    }
+    TSUNIT_ASSERT(scrambler.decryptInPlaceBatch(data.data(), size.data(), count));
+    for (size_t i = 0; i < count; ++i) {
+        TSUNIT_ASSERT(scrambler.decryptInPlace(ref[i].b + 4, size[i]));
+        TSUNIT_ASSERT(pkts[i] == ref[i]);
+    }
+}
+
+void ScramblingTest::testTSScramblingBatch()
+{
+    const uint8_t cw_even[ts::DVBCSA2::KEY_SIZE] = {0x01, 0x02, 0x03, 0x06, 0x04, 0x05, 0x06, 0x0F};
+    const uint8_t cw_odd[ts::DVBCSA2::KEY_SIZE]  = {0x11, 0x12, 0x13, 0x36, 0x14, 0x15, 0x16, 0x3F};
+
+    ts::TSScrambling batch(NULLREP);
+    ts::TSScrambling single(NULLREP);
+    TSUNIT_ASSERT(batch.setCW(ts::ByteBlock(cw_even, sizeof(cw_even)), ts::SC_EVEN_KEY));
+    TSUNIT_ASSERT(batch.setCW(ts::ByteBlock(cw_odd, sizeof(cw_odd)), ts::SC_ODD_KEY));
+    TSUNIT_ASSERT(single.setCW(ts::ByteBlock(cw_even, sizeof(cw_even)), ts::SC_EVEN_KEY));
+    TSUNIT_ASSERT(single.setCW(ts::ByteBlock(cw_odd, sizeof(cw_odd)), ts::SC_ODD_KEY));
+
+    // Packets with various adaptation field sizes.
+    const size_t count = 200;
+    std::vector<ts::TSPacket> pkts(count);
+    std::vector<ts::TSPacket> ref(count);
+    for (size_t i = 0; i < count; ++i) {
+        pkts[i].init(100, uint8_t(i & 0x0F), uint8_t(i));
+        TSUNIT_ASSERT(pkts[i].setPayloadSize(ts::PKT_SIZE - 4 - (i % 20)));
+        ref[i] = pkts[i];
+    }
+
+    // Encrypt, half with even key, half with odd key.
+    TSUNIT_ASSERT(batch.setEncryptParity(ts::SC_EVEN_KEY));
+    TSUNIT_ASSERT(single.setEncryptParity(ts::SC_EVEN_KEY));
+    TSUNIT_ASSERT(batch.encrypt(pkts.data(), count / 2));
+    for (size_t i = 0; i < count / 2; ++i) {
+        TSUNIT_ASSERT(single.encrypt(ref[i]));
+    }
+    TSUNIT_ASSERT(batch.setEncryptParity(ts::SC_ODD_KEY));
+    TSUNIT_ASSERT(single.setEncryptParity(ts::SC_ODD_KEY));
+    TSUNIT_ASSERT(batch.encrypt(pkts.data() + count / 2, count - count / 2));
+    for (size_t i = count / 2; i < count; ++i) {
+        TSUNIT_ASSERT(single.encrypt(ref[i]));
+    }
+    for (size_t i = 0; i < count; ++i) {
+        TSUNIT_ASSERT(pkts[i] == ref[i]);
+    }
+
+    // Decrypt all packets in one batch, with a parity change in the middle.
+    TSUNIT_ASSERT(batch.decrypt(pkts.data(), count));
+    for (size_t i = 0; i < count; ++i) {
+        TSUNIT_ASSERT(single.decrypt(ref[i]));
+        TSUNIT_ASSERT(!pkts[i].isScrambled());
+        TSUNIT_ASSERT(pkts[i] == ref[i]);
+    }
+
+    // Encrypt and decrypt non-contiguous packets, given by address: every other packet.
+    std::vector<ts::TSPacket*> addr;
+    for (size_t i = 0; i < count; i += 2) {
+        addr.push_back(&pkts[i]);
+    }
+    TSUNIT_ASSERT(batch.setEncryptParity(ts::SC_EVEN_KEY));
+    TSUNIT_ASSERT(single.setEncryptParity(ts::SC_EVEN_KEY));
+    TSUNIT_ASSERT(batch.encrypt(addr.data(), addr.size()));
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 2 == 0) {
+            TSUNIT_ASSERT(single.encrypt(ref[i]));
+        }
+        TSUNIT_ASSERT(pkts[i] == ref[i]);
+    }
+    TSUNIT_ASSERT(batch.decrypt(addr.data(), addr.size()));
+    for (size_t i = 0; i < count; i += 2) {
+        TSUNIT_ASSERT(single.decrypt(ref[i]));
+        TSUNIT_ASSERT(!pkts[i].isScrambled());
+        TSUNIT_ASSERT(pkts[i] == ref[i]);
+    }
+}
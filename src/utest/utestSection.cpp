@@ -135,12 +135,31 @@ void SectionTest::testReload()
     TSUNIT_EQUAL(ts::PID_TOT, sec.sourcePID());
     TSUNIT_ASSERT(!sec.isLongSection());
 
+    // The data of a shared section must not be modified by a reload.
+    ts::Section shared(sec, ts::ShareMode::SHARE);
     sec.reload(psi_bat_tvnum_sections, sizeof(psi_bat_tvnum_sections), ts::PID_BAT, ts::CRC32::CHECK);
 
     TSUNIT_ASSERT(sec.isValid());
     TSUNIT_EQUAL(ts::TID_BAT, sec.tableId());
     TSUNIT_EQUAL(ts::PID_BAT, sec.sourcePID());
     TSUNIT_ASSERT(sec.isLongSection());
+
+    TSUNIT_ASSERT(shared.isValid());
+    TSUNIT_EQUAL(ts::TID_TOT, shared.tableId());
+    TSUNIT_EQUAL(sizeof(psi_tot_tnt_sections), shared.size());
+    TSUNIT_EQUAL(0, ::memcmp(shared.content(), psi_tot_tnt_sections, shared.size()));
+
+    // Reloading a non-shared section reuses its data.
+    const size_t size = sec.size();
+    sec.reload(psi_tot_tnt_sections, sizeof(psi_tot_tnt_sections), ts::PID_TOT, ts::CRC32::CHECK);
+    TSUNIT_ASSERT(sec.isValid());
+    TSUNIT_EQUAL(ts::TID_TOT, sec.tableId());
+    TSUNIT_EQUAL(ts::PID_TOT, sec.sourcePID());
+    TSUNIT_ASSERT(sec == shared);
+    sec.reload(psi_bat_tvnum_sections, size, ts::PID_BAT, ts::CRC32::CHECK);
+    TSUNIT_ASSERT(sec.isValid());
+    TSUNIT_EQUAL(ts::TID_BAT, sec.tableId());
+    TSUNIT_EQUAL(ts::TID_TOT, shared.tableId());
 }
 
 void SectionTest::testAssign()
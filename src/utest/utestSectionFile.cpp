@@ -36,18 +36,29 @@
 #include "tsPMT.h"
 #include "tsCAT.h"
 #include "tsTDT.h"
+#include "tsEIT.h"
 #include "tsCAIdentifierDescriptor.h"
+#include "tsShortEventDescriptor.h"
 #include "tsFileUtils.h"
 #include "tsBinaryTable.h"
 #include "tsDuckContext.h"
 #include "tsTSPacket.h"
 #include "tsCerrReport.h"
+#include "tsxmlJSONConverter.h"
+#include "tsxmlElement.h"
+#include "tsxmlElementWriter.h"
+#include "tsxmlTextWriter.h"
+#include "tsxmlJSONWriter.h"
+#include "tsjsonValue.h"
 #include "tsunit.h"
 
 #include "tables/psi_pat1_xml.h"
 #include "tables/psi_pat1_sections.h"
 #include "tables/psi_pmt_scte35_xml.h"
 #include "tables/psi_pmt_scte35_sections.h"
+#include "tables/psi_bat_cplus_sections.h"
+#include "tables/psi_sdt_r3_sections.h"
+#include "tables/psi_tot_tnt_sections.h"
 
 
 //----------------------------------------------------------------------------
@@ -73,6 +84,8 @@ public:
     void testMultiSectionsCAT();
     void testMultiSectionsAtProgramLevelPMT();
     void testMultiSectionsAtStreamLevelPMT();
+    void testPrintJSON();
+    void testWriter();
 
     TSUNIT_TEST_BEGIN(SectionFileTest);
     TSUNIT_TEST(testConfigurationFile);
@@ -86,6 +99,8 @@ public:
     TSUNIT_TEST(testMultiSectionsCAT);
     TSUNIT_TEST(testMultiSectionsAtProgramLevelPMT);
     TSUNIT_TEST(testMultiSectionsAtStreamLevelPMT);
+    TSUNIT_TEST(testPrintJSON);
+    TSUNIT_TEST(testWriter);
     TSUNIT_TEST_END();
 
 private:
@@ -769,3 +784,120 @@ void SectionFileTest::testMemory()
     TSUNIT_EQUAL(0, ::memcmp(out2, psi_pat1_sections, sizeof(psi_pat1_sections)));
     TSUNIT_EQUAL(0, ::memcmp(out2 + 32, psi_pmt_scte35_sections, sizeof(psi_pmt_scte35_sections)));
 }
+
+void SectionFileTest::testPrintJSON()
+{
+    // Build an XML document with various tables.
+    ts::DuckContext duck;
+    ts::SectionFile file(duck);
+    ts::ByteBlock bin;
+    bin.append(psi_pat1_sections, sizeof(psi_pat1_sections));
+    bin.append(psi_pmt_scte35_sections, sizeof(psi_pmt_scte35_sections));
+    bin.append(psi_bat_cplus_sections, sizeof(psi_bat_cplus_sections));
+    bin.append(psi_sdt_r3_sections, sizeof(psi_sdt_r3_sections));
+    bin.append(psi_tot_tnt_sections, sizeof(psi_tot_tnt_sections));
+    TSUNIT_ASSERT(file.loadBuffer(bin));
+    TSUNIT_EQUAL(5, file.tablesCount());
+
+    ts::xml::Document doc(report());
+    TSUNIT_ASSERT(doc.parse(file.toXML()));
+    const ts::xml::Element* first = doc.rootElement()->findFirstChild(u"PAT");
+    TSUNIT_ASSERT(first != nullptr);
+
+    ts::xml::JSONConverter conv(report());
+    TSUNIT_ASSERT(ts::SectionFile::LoadModel(conv));
+
+    // The JSON text must be the same with or without intermediate JSON tree.
+    for (int ti = 0; ti < 3; ++ti) {
+        ts::xml::Tweaks tweaks;
+        tweaks.x2jIncludeRoot = ti == 1;
+        tweaks.x2jEnforceInteger = tweaks.x2jEnforceBoolean = ti == 2;
+        tweaks.x2jTrimText = tweaks.x2jCollapseText = ti == 2;
+        conv.setTweaks(tweaks);
+
+        ts::TextFormatter text(report());
+        text.setString();
+        conv.printJSON(text, doc);
+        const ts::UString ref(conv.convertToJSON(doc)->printed());
+        debug() << "SectionFileTest::testPrintJSON: " << ref.size() << " characters" << std::endl;
+        TSUNIT_EQUAL(ref, text.toString());
+
+        text.setString();
+        conv.printJSON(text, first);
+        TSUNIT_EQUAL(conv.convertToJSON(doc, true)->query(u"#nodes[0]").printed(), text.toString());
+    }
+}
+
+void SectionFileTest::testWriter()
+{
+    // Various tables, including EIT, SDT and PMT which directly use the XML writer.
+    ts::DuckContext duck;
+    ts::SectionFile file(duck);
+    ts::ByteBlock bin;
+    bin.append(psi_pat1_sections, sizeof(psi_pat1_sections));
+    bin.append(psi_pmt_scte35_sections, sizeof(psi_pmt_scte35_sections));
+    bin.append(psi_bat_cplus_sections, sizeof(psi_bat_cplus_sections));
+    bin.append(psi_sdt_r3_sections, sizeof(psi_sdt_r3_sections));
+    bin.append(psi_tot_tnt_sections, sizeof(psi_tot_tnt_sections));
+    TSUNIT_ASSERT(file.loadBuffer(bin));
+
+    ts::EIT eit(true, false, 1, 5, true, 0x1234, 0x5678, 0x9ABC);
+    for (uint16_t id = 1; id <= 3; ++id) {
+        ts::EIT::Event& ev(eit.events[id]);
+        ev.event_id = id;
+        ev.start_time = ts::Time(2021, 6, 1, 20, id, 0);
+        ev.duration = 1800 * id;
+        ev.running_status = 4;
+        ev.descs.add(duck, ts::ShortEventDescriptor(u"eng", ts::UString::Format(u"event %d", {id}), u"some <text> & more"));
+    }
+    file.add(ts::AbstractTablePtr(new ts::EIT(eit)));
+    TSUNIT_EQUAL(6, file.tablesCount());
+
+    ts::xml::JSONConverter conv(report());
+    TSUNIT_ASSERT(ts::SectionFile::LoadModel(conv));
+
+    ts::BinaryTable::XMLOptions opt;
+    opt.setPID = true;
+    opt.setPackets = true;
+
+    for (int generic = 0; generic < 2; ++generic) {
+        opt.forceGeneric = generic != 0;
+        for (size_t ti = 0; ti < file.tables().size(); ++ti) {
+            const ts::BinaryTable& table(*file.tables()[ti]);
+
+            // Reference XML tree.
+            ts::xml::Document doc(report());
+            doc.initialize(u"tsduck");
+            const ts::xml::Element* elem = table.toXML(duck, doc.rootElement(), opt);
+            TSUNIT_ASSERT(elem != nullptr);
+            ts::TextFormatter ref(report());
+            ref.setString();
+            elem->print(ref);
+
+            // XML text, without XML tree.
+            ts::TextFormatter text(report());
+            text.setString();
+            ts::xml::TextWriter twriter(text);
+            TSUNIT_ASSERT(table.toXML(duck, twriter, opt));
+            TSUNIT_EQUAL(ref.toString(), text.toString());
+
+            // XML tree, using the writer adapter.
+            ts::xml::Document doc2(report());
+            doc2.initialize(u"tsduck");
+            ts::xml::ElementWriter ewriter(doc2.rootElement());
+            TSUNIT_ASSERT(table.toXML(duck, ewriter, opt));
+            TSUNIT_ASSERT(ewriter.currentElement() == doc2.rootElement());
+            TSUNIT_EQUAL(doc.toString(), doc2.toString());
+
+            // JSON text, without XML or JSON tree.
+            ref.setString();
+            conv.printJSON(ref, elem);
+            text.setString();
+            ts::xml::JSONWriter jwriter(text, conv);
+            TSUNIT_ASSERT(table.toXML(duck, jwriter, opt));
+            TSUNIT_EQUAL(ref.toString(), text.toString());
+
+            debug() << "SectionFileTest::testWriter: " << elem->name() << ", " << text.toString().size() << " JSON characters" << std::endl;
+        }
+    }
+}
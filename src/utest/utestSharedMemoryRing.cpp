@@ -0,0 +1,319 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::SharedMemoryRing
+//
+//----------------------------------------------------------------------------
+
+#include "tsSharedMemoryRing.h"
+#include "tsSysUtils.h"
+#include "tsNullReport.h"
+#include "tsCerrReport.h"
+#include "tsunit.h"
+
+#if !defined(TS_WINDOWS)
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class SharedMemoryRingTest: public tsunit::Test
+{
+public:
+    SharedMemoryRingTest();
+
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testName();
+    void testHandshake();
+    void testLateReader();
+    void testStalledReader();
+    void testAttachTimeout();
+
+    TSUNIT_TEST_BEGIN(SharedMemoryRingTest);
+    TSUNIT_TEST(testName);
+    TSUNIT_TEST(testHandshake);
+    TSUNIT_TEST(testLateReader);
+    TSUNIT_TEST(testStalledReader);
+    TSUNIT_TEST(testAttachTimeout);
+    TSUNIT_TEST_END();
+
+private:
+    ts::UString _name;
+
+    // Build a packet and its metadata with an identifiable index.
+    static void MakePacket(ts::TSPacket& pkt, ts::TSPacketMetadata& mdata, size_t index);
+
+    // Check that a packet and its metadata have the expected index.
+    static bool CheckPacket(const ts::TSPacket& pkt, const ts::TSPacketMetadata& mdata, size_t index);
+};
+
+TSUNIT_REGISTER(SharedMemoryRingTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Constructor.
+SharedMemoryRingTest::SharedMemoryRingTest() :
+    _name()
+{
+}
+
+// Test suite initialization method.
+void SharedMemoryRingTest::beforeTest()
+{
+    // Unique name per process, tests may run in parallel.
+    if (_name.empty()) {
+        _name.format(u"utest-%d", {ts::CurrentProcessId()});
+    }
+}
+
+// Test suite cleanup method.
+void SharedMemoryRingTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Test packets.
+//----------------------------------------------------------------------------
+
+void SharedMemoryRingTest::MakePacket(ts::TSPacket& pkt, ts::TSPacketMetadata& mdata, size_t index)
+{
+    pkt = ts::NullPacket;
+    pkt.setPID(ts::PID(index % 0x1FFF));
+    ts::PutUInt32(pkt.b + 4, uint32_t(index));
+    mdata.reset();
+    mdata.setLabel(index % ts::TSPacketMetadata::LABEL_COUNT);
+}
+
+bool SharedMemoryRingTest::CheckPacket(const ts::TSPacket& pkt, const ts::TSPacketMetadata& mdata, size_t index)
+{
+    return pkt.getPID() == ts::PID(index % 0x1FFF) &&
+        ts::GetUInt32(pkt.b + 4) == uint32_t(index) &&
+        mdata.hasLabel(index % ts::TSPacketMetadata::LABEL_COUNT);
+}
+
+
+//----------------------------------------------------------------------------
+// Test cases
+//----------------------------------------------------------------------------
+
+void SharedMemoryRingTest::testName()
+{
+    TSUNIT_ASSERT(ts::SharedMemoryRing::IsValidName(u"foo"));
+    TSUNIT_ASSERT(!ts::SharedMemoryRing::IsValidName(u""));
+    TSUNIT_ASSERT(!ts::SharedMemoryRing::IsValidName(u"foo/bar"));
+
+    ts::SharedMemoryRing ring(NULLREP);
+    TSUNIT_ASSERT(!ring.create(u"foo/bar"));
+    TSUNIT_ASSERT(!ring.isOpen());
+}
+
+void SharedMemoryRingTest::testHandshake()
+{
+#if defined(TS_WINDOWS)
+    debug() << "SharedMemoryRingTest::testHandshake: not supported on Windows, skipped" << std::endl;
+#else
+    // A small ring, the writer wraps several times.
+    constexpr size_t RING_SIZE = 100;
+    constexpr size_t TOTAL = 1000;
+    constexpr size_t CHUNK = 30;
+
+    ts::SharedMemoryRing writer(CERR);
+    ts::SharedMemoryRing reader(CERR);
+
+    TSUNIT_ASSERT(writer.create(_name, RING_SIZE));
+    TSUNIT_ASSERT(writer.isOpen());
+    TSUNIT_ASSERT(reader.attach(_name, 1000));
+    TSUNIT_ASSERT(reader.isOpen());
+
+    ts::TSPacketVector wpkt(CHUNK);
+    ts::TSPacketMetadataVector wmdata(CHUNK);
+    ts::TSPacketVector rpkt(RING_SIZE);
+    ts::TSPacketMetadataVector rmdata(RING_SIZE);
+
+    size_t written = 0;
+    size_t received = 0;
+    bool in_order = true;
+
+    while (written < TOTAL) {
+        // Fill the ring as much as possible without blocking.
+        while (written < TOTAL && written + CHUNK <= received + RING_SIZE) {
+            const size_t count = std::min(CHUNK, TOTAL - written);
+            for (size_t i = 0; i < count; ++i) {
+                MakePacket(wpkt[i], wmdata[i], written + i);
+            }
+            TSUNIT_ASSERT(writer.write(wpkt.data(), wmdata.data(), count));
+            written += count;
+        }
+        // Read part of the available packets.
+        const size_t count = reader.read(rpkt.data(), rmdata.data(), 45, 1000);
+        TSUNIT_ASSERT(count > 0);
+        for (size_t i = 0; i < count; ++i) {
+            in_order = in_order && CheckPacket(rpkt[i], rmdata[i], received + i);
+        }
+        received += count;
+    }
+
+    // Writer terminates, the reader gets the remaining packets, then the end of stream.
+    writer.close();
+    TSUNIT_ASSERT(!writer.isOpen());
+    while (received < TOTAL) {
+        const size_t count = reader.read(rpkt.data(), rmdata.data(), rpkt.size(), 1000);
+        TSUNIT_ASSERT(count > 0);
+        for (size_t i = 0; i < count; ++i) {
+            in_order = in_order && CheckPacket(rpkt[i], rmdata[i], received + i);
+        }
+        received += count;
+    }
+    TSUNIT_ASSERT(in_order);
+    TSUNIT_EQUAL(TOTAL, received);
+    TSUNIT_EQUAL(0, reader.read(rpkt.data(), rmdata.data(), rpkt.size(), 1000));
+    TSUNIT_EQUAL(0, writer.blockedCount());
+    reader.close();
+#endif
+}
+
+void SharedMemoryRingTest::testLateReader()
+{
+#if defined(TS_WINDOWS)
+    debug() << "SharedMemoryRingTest::testLateReader: not supported on Windows, skipped" << std::endl;
+#else
+    ts::SharedMemoryRing writer(CERR);
+    ts::SharedMemoryRing reader1(CERR);
+    ts::SharedMemoryRing reader2(CERR);
+
+    ts::TSPacketVector pkt(10);
+    ts::TSPacketMetadataVector mdata(10);
+    for (size_t i = 0; i < pkt.size(); ++i) {
+        MakePacket(pkt[i], mdata[i], i);
+    }
+
+    TSUNIT_ASSERT(writer.create(_name, 50));
+    TSUNIT_ASSERT(reader1.attach(_name, 1000));
+    TSUNIT_ASSERT(writer.write(pkt.data(), mdata.data(), 5));
+
+    // The second reader only receives the packets which are written after it joined.
+    TSUNIT_ASSERT(reader2.attach(_name, 1000));
+    TSUNIT_ASSERT(writer.write(pkt.data() + 5, mdata.data() + 5, 5));
+
+    ts::TSPacketVector rpkt(20);
+    ts::TSPacketMetadataVector rmdata(20);
+
+    TSUNIT_EQUAL(10, reader1.read(rpkt.data(), rmdata.data(), rpkt.size(), 1000));
+    TSUNIT_ASSERT(CheckPacket(rpkt[0], rmdata[0], 0));
+    TSUNIT_ASSERT(CheckPacket(rpkt[9], rmdata[9], 9));
+
+    TSUNIT_EQUAL(5, reader2.read(rpkt.data(), rmdata.data(), rpkt.size(), 1000));
+    TSUNIT_ASSERT(CheckPacket(rpkt[0], rmdata[0], 5));
+    TSUNIT_ASSERT(CheckPacket(rpkt[4], rmdata[4], 9));
+
+    // A reader which detaches no longer blocks the writer.
+    reader1.close();
+    writer.close();
+    TSUNIT_EQUAL(0, reader2.read(rpkt.data(), rmdata.data(), rpkt.size(), 1000));
+#endif
+}
+
+void SharedMemoryRingTest::testStalledReader()
+{
+#if defined(TS_WINDOWS)
+    debug() << "SharedMemoryRingTest::testStalledReader: not supported on Windows, skipped" << std::endl;
+#else
+    ts::SharedMemoryRing writer(CERR);
+    TSUNIT_ASSERT(writer.create(_name, 10));
+
+    ts::TSPacketVector pkt(30);
+    ts::TSPacketMetadataVector mdata(30);
+    for (size_t i = 0; i < pkt.size(); ++i) {
+        MakePacket(pkt[i], mdata[i], i);
+    }
+
+    // The child process joins as reader and stops itself. After being resumed,
+    // it must detect that its slot was reclaimed by the writer.
+    const pid_t child = ::fork();
+    TSUNIT_ASSERT(child >= 0);
+    if (child == 0) {
+        ts::SharedMemoryRing reader(NULLREP);
+        if (!reader.attach(_name, 1000)) {
+            ::_exit(2);
+        }
+        ::raise(SIGSTOP);
+        ts::TSPacketVector rpkt(10);
+        ts::TSPacketMetadataVector rmdata(10);
+        const size_t count = reader.read(rpkt.data(), rmdata.data(), rpkt.size(), 1000);
+        reader.close();
+        ::_exit(count == 0 ? 0 : 1);
+    }
+
+    // Wait for the child to stop.
+    int status = 0;
+    TSUNIT_EQUAL(child, ::waitpid(child, &status, WUNTRACED));
+    TSUNIT_ASSERT(WIFSTOPPED(status));
+
+    // The writer blocks on the stalled reader until its lease expires, then reclaims its slot.
+    TSUNIT_ASSERT(writer.write(pkt.data(), mdata.data(), pkt.size()));
+    TSUNIT_ASSERT(writer.blockedCount() > 0);
+
+    // A new reader gets the reclaimed slot.
+    ts::SharedMemoryRing reader(CERR);
+    TSUNIT_ASSERT(reader.attach(_name, 1000));
+
+    // Resume the stalled reader, it must fail without releasing the slot of the new reader.
+    ::kill(child, SIGCONT);
+    TSUNIT_EQUAL(child, ::waitpid(child, &status, 0));
+    TSUNIT_ASSERT(WIFEXITED(status));
+    TSUNIT_EQUAL(0, WEXITSTATUS(status));
+
+    ts::TSPacketVector rpkt(10);
+    ts::TSPacketMetadataVector rmdata(10);
+    TSUNIT_ASSERT(writer.write(pkt.data(), mdata.data(), 5));
+    TSUNIT_EQUAL(5, reader.read(rpkt.data(), rmdata.data(), rpkt.size(), 1000));
+    TSUNIT_ASSERT(CheckPacket(rpkt[0], rmdata[0], 0));
+    TSUNIT_ASSERT(CheckPacket(rpkt[4], rmdata[4], 4));
+    reader.close();
+#endif
+}
+
+void SharedMemoryRingTest::testAttachTimeout()
+{
+    // No writer, the reader gives up after the timeout.
+    ts::SharedMemoryRing reader(NULLREP);
+    TSUNIT_ASSERT(!reader.attach(_name + u"-none", 200));
+    TSUNIT_ASSERT(!reader.isOpen());
+}
@@ -34,6 +34,7 @@
 #include "tsFileUtils.h"
 #include "tsSysUtils.h"
 #include "tsSysInfo.h"
+#include "tsResidentBuffer.h"
 #include "tsRegistry.h"
 #include "tsMonotonic.h"
 #include "tsTime.h"
@@ -75,6 +76,7 @@ public:
     void testSearchWildcard();
     void testHomeDirectory();
     void testProcessMetrics();
+    void testNUMA();
     void testIsTerminal();
     void testSysInfo();
     void testSymLinks();
@@ -103,6 +105,7 @@ public:
     TSUNIT_TEST(testSearchWildcard);
     TSUNIT_TEST(testHomeDirectory);
     TSUNIT_TEST(testProcessMetrics);
+    TSUNIT_TEST(testNUMA);
     TSUNIT_TEST(testIsTerminal);
     TSUNIT_TEST(testSysInfo);
     TSUNIT_TEST(testSymLinks);
@@ -695,6 +698,34 @@ void SysUtilsTest::testProcessMetrics()
     TSUNIT_ASSERT(pm2.vmem_size > 0);
 }
 
+void SysUtilsTest::testNUMA()
+{
+    std::set<size_t> cpus;
+    TSUNIT_ASSERT(!ts::GetNUMANodeCPUs(100000, cpus));
+    TSUNIT_ASSERT(cpus.empty());
+    TSUNIT_ASSERT(ts::SetCurrentThreadAffinity(cpus));
+
+#if defined(TS_LINUX)
+    // Node 0 does not exist on all Linux systems (/sys may be unavailable in containers).
+    if (ts::GetNUMANodeCPUs(0, cpus)) {
+        debug() << "SysUtilsTest::testNUMA: CPU's in node 0: " << ts::UString::Decimal(cpus.size()) << std::endl;
+        TSUNIT_ASSERT(!cpus.empty());
+
+        // Bind a buffer to node 0. The mbind() system call is not allowed in some
+        // containers (EPERM) and does not exist on kernels without NUMA support (ENOSYS).
+        ts::ResidentBuffer<uint8_t> buf(100000, 0);
+        const ts::SysErrorCode err = buf.numaErrorCode();
+        if (err == EPERM || err == ENOSYS) {
+            debug() << "SysUtilsTest::testNUMA: mbind() not available: " << ts::SysErrorCodeMessage(err) << std::endl;
+        }
+        else {
+            TSUNIT_ASSERT(buf.isNUMABound());
+        }
+        ::memset(buf.base(), 0x55, buf.count());
+    }
+#endif
+}
+
 void SysUtilsTest::testIsTerminal()
 {
 #if defined(TS_WINDOWS)
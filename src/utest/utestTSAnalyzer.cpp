@@ -0,0 +1,173 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::TSAnalyzer.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSAnalyzer.h"
+#include "tsCyclingPacketizer.h"
+#include "tsDuckContext.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TSAnalyzerTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testThreads();
+
+    TSUNIT_TEST_BEGIN(TSAnalyzerTest);
+    TSUNIT_TEST(testThreads);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(TSAnalyzerTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void TSAnalyzerTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void TSAnalyzerTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Test cases
+//----------------------------------------------------------------------------
+
+namespace {
+    // An analyzer which exposes the description of its PID's.
+    class Analyzer: public ts::TSAnalyzer
+    {
+        TS_NOBUILD_NOCOPY(Analyzer);
+    public:
+        Analyzer(ts::DuckContext& duck) : ts::TSAnalyzer(duck) {}
+        ts::UString description()
+        {
+            recomputeStatistics();
+            ts::UString desc;
+            for (auto it = _pids.begin(); it != _pids.end(); ++it) {
+                desc.append(ts::UString::Format(u"%d: %d packets, %s\n", {it->first, it->second->ts_pkt_cnt, it->second->fullDescription(true)}));
+            }
+            return desc;
+        }
+    };
+
+    // Build a stream with one service and several audio PID's. The audio
+    // attributes of each PID change in the middle of the stream.
+    void BuildStream(ts::DuckContext& duck, ts::TSPacketVector& packets)
+    {
+        const ts::PID pmt_pid = 100;
+        const size_t audio_count = 5;
+        const size_t cycles = 200;
+
+        ts::PAT pat(0, true, 1);
+        pat.pmts[1] = pmt_pid;
+        ts::PMT pmt(0, true, 1, 101);
+        for (size_t i = 0; i < audio_count; ++i) {
+            pmt.streams[ts::PID(101 + i)].stream_type = ts::ST_MPEG1_AUDIO;
+        }
+        ts::CyclingPacketizer pat_pzer(duck, ts::PID_PAT);
+        ts::CyclingPacketizer pmt_pzer(duck, pmt_pid);
+        pat_pzer.addTable(duck, pat);
+        pmt_pzer.addTable(duck, pmt);
+
+        packets.resize(cycles * (2 + audio_count));
+        ts::TSPacketVector::iterator pkt(packets.begin());
+        for (size_t cycle = 0; cycle < cycles; ++cycle) {
+            pat_pzer.getNextPacket(*pkt++);
+            pmt_pzer.getNextPacket(*pkt++);
+            for (size_t i = 0; i < audio_count; ++i) {
+                // One PES packet per TS packet, starting with an MPEG-1 layer II frame header.
+                pkt->init(ts::PID(101 + i), uint8_t(cycle), 0xFF);
+                pkt->setPUSI();
+                uint8_t* pes = pkt->b + 4;
+                pes[0] = 0x00;
+                pes[1] = 0x00;
+                pes[2] = 0x01;
+                pes[3] = 0xC0;
+                ts::PutUInt16(pes + 4, uint16_t(ts::PKT_SIZE - 4 - 6));
+                pes[6] = 0x80;
+                pes[7] = 0x00;
+                pes[8] = 0x00;
+                pes[9] = 0xFF;
+                pes[10] = 0xFD;
+                pes[11] = uint8_t(((cycle < cycles / 2 ? 8 : 12) + i % 2) << 4 | 0x04);
+                pes[12] = 0x00;
+                ++pkt;
+            }
+        }
+    }
+}
+
+void TSAnalyzerTest::testThreads()
+{
+    ts::DuckContext duck;
+    ts::TSPacketVector packets;
+    BuildStream(duck, packets);
+
+    Analyzer sequential(duck);
+    for (const auto& pkt : packets) {
+        sequential.feedPacket(pkt);
+    }
+    const ts::UString ref(sequential.description());
+    debug() << "TSAnalyzerTest::testThreads: sequential analysis:" << std::endl << ref;
+    TSUNIT_ASSERT(ref.contain(u"layer II"));
+
+    for (size_t threads = 2; threads <= 4; ++threads) {
+        Analyzer parallel(duck);
+        parallel.setAnalysisThreads(threads);
+        for (const auto& pkt : packets) {
+            parallel.feedPacket(pkt);
+        }
+        TSUNIT_EQUAL(ref, parallel.description());
+
+        // Analyze again after a reset.
+        parallel.reset();
+        for (const auto& pkt : packets) {
+            parallel.feedPacket(pkt);
+        }
+        TSUNIT_EQUAL(ref, parallel.description());
+    }
+}
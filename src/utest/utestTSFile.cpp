@@ -32,11 +32,16 @@
 //----------------------------------------------------------------------------
 
 #include "tsTSFile.h"
+#include "tsTSFileIndex.h"
 #include "tsTSPacket.h"
 #include "tsTSPacketMetadata.h"
 #include "tsCerrReport.h"
 #include "tsNullReport.h"
 #include "tsFileUtils.h"
+#include "tsOneShotPacketizer.h"
+#include "tsBinaryTable.h"
+#include "tsDuckContext.h"
+#include "tsPAT.h"
 #include "tsunit.h"
 
 
@@ -57,6 +62,11 @@ public:
     void testDuck();
     void testStuffingRead();
     void testStuffingWrite();
+    void testReadModes();
+    void testWriteBehind();
+    void testWriteBehindAbort();
+    void testWriteBehindError();
+    void testIndex();
 
     TSUNIT_TEST_BEGIN(TSFileTest);
     TSUNIT_TEST(testTS);
@@ -64,6 +74,11 @@ public:
     TSUNIT_TEST(testDuck);
     TSUNIT_TEST(testStuffingRead);
     TSUNIT_TEST(testStuffingWrite);
+    TSUNIT_TEST(testReadModes);
+    TSUNIT_TEST(testWriteBehind);
+    TSUNIT_TEST(testWriteBehindAbort);
+    TSUNIT_TEST(testWriteBehindError);
+    TSUNIT_TEST(testIndex);
     TSUNIT_TEST_END();
 
 private:
@@ -96,6 +111,7 @@ void TSFileTest::beforeTest()
 void TSFileTest::afterTest()
 {
     ts::DeleteFile(_tempFileName, NULLREP);
+    ts::DeleteFile(ts::TSFileIndex::IndexFileName(_tempFileName), NULLREP);
 }
 
 
@@ -395,3 +411,208 @@ void TSFileTest::testStuffingWrite()
     TSUNIT_EQUAL(184, packets[5].getPayloadSize());
     TSUNIT_EQUAL(0xFF, packets[5].getPayload()[0]);
 }
+
+void TSFileTest::testReadModes()
+{
+    // Create a file which is larger than the read buffers.
+    const size_t count = 20000;
+    ts::TSPacketVector packets(count);
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i] = ts::NullPacket;
+        packets[i].setPID(ts::PID(i % 8000));
+    }
+    ts::TSFile file;
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, CERR));
+    TSUNIT_ASSERT(file.writePackets(packets.data(), nullptr, packets.size(), CERR));
+    TSUNIT_ASSERT(file.close(CERR));
+    TSUNIT_EQUAL(count * ts::PKT_SIZE, ts::GetFileSize(_tempFileName));
+
+    static const ts::TSFileReadMode modes[] = {ts::TSFileReadMode::STREAM, ts::TSFileReadMode::MMAP, ts::TSFileReadMode::DIRECT};
+    for (size_t mi = 0; mi < sizeof(modes) / sizeof(modes[0]); ++mi) {
+        debug() << "TSFileTest::testReadModes: mode " << ts::TSFileReadModeEnum.name(modes[mi]) << std::endl;
+
+        // Read the file twice, starting at an unaligned offset, with unaligned read sizes.
+        const size_t start = 7;
+        ts::TSFile in;
+        in.setReadMode(modes[mi]);
+        TSUNIT_ASSERT(in.openRead(_tempFileName, 2, start * ts::PKT_SIZE, CERR));
+#if !defined(TS_WINDOWS)
+        TSUNIT_EQUAL(int(modes[mi]), int(in.readMode()));
+#endif
+        ts::TSPacketVector inpackets(999);
+        size_t index = 0;
+        size_t ret = 0;
+        while ((ret = in.readPackets(inpackets.data(), nullptr, inpackets.size(), CERR)) > 0) {
+            for (size_t i = 0; i < ret; ++i) {
+                TSUNIT_EQUAL(packets[start + (index + i) % (count - start)].getPID(), inpackets[i].getPID());
+            }
+            index += ret;
+        }
+        TSUNIT_EQUAL(2 * (count - start), index);
+        TSUNIT_ASSERT(in.close(CERR));
+
+        // Random access in a rewindable file.
+        TSUNIT_ASSERT(in.openRead(_tempFileName, 0, CERR));
+        TSUNIT_ASSERT(in.seek(15000, CERR));
+        TSUNIT_EQUAL(10, in.readPackets(inpackets.data(), nullptr, 10, CERR));
+        TSUNIT_EQUAL(packets[15000].getPID(), inpackets[0].getPID());
+        TSUNIT_EQUAL(packets[15009].getPID(), inpackets[9].getPID());
+        TSUNIT_ASSERT(in.seek(3, CERR));
+        TSUNIT_EQUAL(1, in.readPackets(inpackets.data(), nullptr, 1, CERR));
+        TSUNIT_EQUAL(packets[3].getPID(), inpackets[0].getPID());
+        TSUNIT_ASSERT(in.seek(count - 1, CERR));
+        TSUNIT_EQUAL(1, in.readPackets(inpackets.data(), nullptr, 10, CERR));
+        TSUNIT_EQUAL(packets[count - 1].getPID(), inpackets[0].getPID());
+        TSUNIT_EQUAL(0, in.readPackets(inpackets.data(), nullptr, 10, CERR));
+        TSUNIT_ASSERT(in.close(CERR));
+    }
+}
+
+void TSFileTest::testWriteBehind()
+{
+    // Small buffers, not multiple of the packet size, to test buffer boundaries.
+    const size_t count = 5000;
+    ts::TSFile file;
+    file.setWriteBehind(3, 4096);
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, CERR, ts::TSPacketFormat::M2TS));
+
+    ts::TSPacketVector packets(count);
+    ts::TSPacketMetadataVector mdata(count);
+    for (size_t i = 0; i < count; ++i) {
+        packets[i] = ts::NullPacket;
+        packets[i].setPID(ts::PID(i % 8000));
+        mdata[i].setInputTimeStamp(i, ts::SYSTEM_CLOCK_FREQ, ts::TimeSource::UNDEFINED);
+    }
+    size_t index = 0;
+    for (size_t chunk = 1; index < count; chunk = chunk % 37 + 1) {
+        const size_t size = std::min(chunk, count - index);
+        TSUNIT_ASSERT(file.writePackets(&packets[index], &mdata[index], size, CERR));
+        index += size;
+    }
+    TSUNIT_EQUAL(count, file.writePacketsCount());
+    TSUNIT_ASSERT(file.close(CERR));
+    TSUNIT_EQUAL(count * (4 + ts::PKT_SIZE), ts::GetFileSize(_tempFileName));
+
+    ts::TSFile::WriteBehindStatus status;
+    file.getWriteBehindStatus(status);
+    debug() << "TSFileTest::testWriteBehind: writes: " << status.write_count << ", blocked: " << status.blocked_count << ", max queued: " << status.max_queued << std::endl;
+    TSUNIT_EQUAL(count * (4 + ts::PKT_SIZE), status.write_bytes);
+    TSUNIT_EQUAL((status.write_bytes + 4095) / 4096, status.write_count);
+    TSUNIT_ASSERT(status.max_queued >= 1);
+    TSUNIT_ASSERT(status.max_queued <= 3);
+
+    // Read back the file.
+    ts::TSPacket pkt;
+    ts::TSPacketMetadata md;
+    TSUNIT_ASSERT(file.openRead(_tempFileName, 0, CERR));
+    for (size_t i = 0; i < count; ++i) {
+        TSUNIT_EQUAL(1, file.readPackets(&pkt, &md, 1, CERR));
+        TSUNIT_EQUAL(packets[i].getPID(), pkt.getPID());
+        TSUNIT_EQUAL(i & 0x3FFFFFFF, md.getInputTimeStamp());
+    }
+    TSUNIT_EQUAL(0, file.readPackets(&pkt, &md, 1, CERR));
+    TSUNIT_ASSERT(file.close(CERR));
+}
+
+void TSFileTest::testWriteBehindAbort()
+{
+    ts::TSFile file;
+    file.setWriteBehind(2, 4096);
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, CERR));
+
+    ts::TSPacketVector packets(100, ts::NullPacket);
+    TSUNIT_ASSERT(file.writePackets(packets.data(), nullptr, packets.size(), CERR));
+
+    // After an abort, all data are dropped and the file can only be closed.
+    file.abort();
+    TSUNIT_ASSERT(!file.writePackets(packets.data(), nullptr, packets.size(), NULLREP));
+    TSUNIT_ASSERT(file.close(CERR));
+    TSUNIT_ASSERT(!file.isOpen());
+    TSUNIT_ASSERT(ts::GetFileSize(_tempFileName) <= int64_t(packets.size() * ts::PKT_SIZE));
+}
+
+void TSFileTest::testWriteBehindError()
+{
+#if defined(TS_LINUX)
+    // All writes to /dev/full fail with ENOSPC. The error is reported when closing the file.
+    ts::TSFile file;
+    file.setWriteBehind(2, 4096);
+    TSUNIT_ASSERT(file.open(u"/dev/full", ts::TSFile::WRITE, CERR));
+    TSUNIT_ASSERT(file.writePackets(&ts::NullPacket, nullptr, 1, CERR));
+    TSUNIT_ASSERT(!file.close(NULLREP));
+    TSUNIT_ASSERT(!file.isOpen());
+#endif
+}
+
+void TSFileTest::testIndex()
+{
+    // Build a file with one PCR every 10 packets, 10 ms apart, and two versions of the PAT.
+    const size_t count = 1000;
+    ts::DuckContext duck;
+    ts::TSPacketVector packets(count);
+    for (size_t i = 0; i < count; ++i) {
+        packets[i] = ts::NullPacket;
+        packets[i].setPID(100);
+        if (i % 10 == 1) {
+            TSUNIT_ASSERT(packets[i].setPCR(1000 + (i / 10) * 270000, true));
+        }
+    }
+    for (size_t i = 0; i < 2; ++i) {
+        ts::PAT pat(uint8_t(i), true, 0x1234);
+        pat.pmts[1] = 200;
+        ts::BinaryTable bin;
+        TSUNIT_ASSERT(pat.serialize(duck, bin));
+        ts::OneShotPacketizer pzer(duck, ts::PID_PAT);
+        ts::TSPacketVector pat_packets;
+        pzer.setNextContinuityCounter(uint8_t(i));
+        pzer.addTable(bin);
+        pzer.getPackets(pat_packets);
+        TSUNIT_EQUAL(1, pat_packets.size());
+        packets[i * 500] = pat_packets[0];
+    }
+
+    ts::TSFile file;
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, CERR));
+    TSUNIT_ASSERT(file.writePackets(packets.data(), nullptr, packets.size(), CERR));
+    TSUNIT_ASSERT(file.close(CERR));
+
+    // Build and save the index.
+    const ts::UString index_name(ts::TSFileIndex::IndexFileName(_tempFileName));
+    ts::TSFileIndex index;
+    TSUNIT_ASSERT(index.build(_tempFileName, CERR));
+    TSUNIT_ASSERT(index.save(index_name, CERR));
+
+    // Reload the index and check lookups.
+    ts::TSFileIndex index2;
+    TSUNIT_ASSERT(index2.load(_tempFileName, CERR));
+    TSUNIT_EQUAL(count, index2.packetCount());
+    TSUNIT_EQUAL(ts::PKT_SIZE, index2.filePacketSize());
+    TSUNIT_EQUAL(100, index2.timePoints().size());
+    TSUNIT_EQUAL(990, index2.duration());
+    TSUNIT_EQUAL(index.events().size(), index2.events().size());
+
+    TSUNIT_EQUAL(1, index2.packetAtTime(0));
+    TSUNIT_EQUAL(61, index2.packetAtTime(55));
+    TSUNIT_EQUAL(61, index2.packetAtTime(60));
+    TSUNIT_EQUAL(count, index2.packetAtTime(2000));
+    TSUNIT_EQUAL(0, index2.timeAtPacket(0));
+    TSUNIT_EQUAL(60, index2.timeAtPacket(65));
+    TSUNIT_EQUAL(990, index2.timeAtPacket(999));
+
+    ts::PacketCounter pkt = 0;
+    TSUNIT_ASSERT(index2.nextEvent(0, ts::TSFileIndex::EventType::TABLE_VERSION, pkt, ts::PID_PAT, ts::TID_PAT));
+    TSUNIT_EQUAL(0, pkt);
+    TSUNIT_ASSERT(index2.nextEvent(1, ts::TSFileIndex::EventType::TABLE_VERSION, pkt));
+    TSUNIT_EQUAL(500, pkt);
+    TSUNIT_ASSERT(!index2.nextEvent(501, ts::TSFileIndex::EventType::TABLE_VERSION, pkt));
+    TSUNIT_ASSERT(!index2.nextEvent(0, ts::TSFileIndex::EventType::INTRA_FRAME, pkt));
+
+    // Seek in the file using the index.
+    ts::TSPacket inpkt;
+    TSUNIT_ASSERT(file.openRead(_tempFileName, 0, CERR));
+    TSUNIT_ASSERT(file.seekTime(index2, 500, false, CERR));
+    TSUNIT_EQUAL(1, file.readPackets(&inpkt, nullptr, 1, CERR));
+    TSUNIT_EQUAL(ts::PID(100), inpkt.getPID());
+    TSUNIT_EQUAL(1000 + 50 * 270000, inpkt.getPCR());
+    TSUNIT_ASSERT(file.close(CERR));
+}
@@ -33,6 +33,7 @@
 
 #include "tsTSProcessor.h"
 #include "tsPluginRepository.h"
+#include "tsPluginEventData.h"
 #include "tsCerrReport.h"
 #include "tsunit.h"
 
@@ -48,10 +49,18 @@ public:
     virtual void afterTest() override;
 
     void testProcessing();
+    void testBranches();
+    void testPacketBatch();
 
     TSUNIT_TEST_BEGIN(TSProcessorTest);
     TSUNIT_TEST(testProcessing);
+    TSUNIT_TEST(testBranches);
+    TSUNIT_TEST(testPacketBatch);
     TSUNIT_TEST_END();
+
+private:
+    // Run a chain with the batch test plugin, return the output packets.
+    static void RunBatchPlugin(bool batch, ts::TSPacketVector& output);
 };
 
 TSUNIT_REGISTER(TSProcessorTest);
@@ -177,6 +186,132 @@ TestPlugin::Status TestPlugin::processPacket(ts::TSPacket& pkt, ts::TSPacketMeta
 }
 
 
+//----------------------------------------------------------------------------
+// Internal packet processing plugin class using the "packet batch" method
+// when --batch is specified, the "packet" method otherwise. Each packet is
+// modified, nullified, dropped or ends the processing, based on its index.
+//----------------------------------------------------------------------------
+
+namespace {
+    class BatchTestPlugin : ts::ProcessorPlugin
+    {
+    public:
+        // Constructor.
+        BatchTestPlugin(ts::TSP*);
+
+        // Implementation of plugin API.
+        virtual bool getOptions() override;
+        virtual Status processPacket(ts::TSPacket&, ts::TSPacketMetadata&) override;
+        virtual bool usePacketBatch() override;
+        virtual void processPacketBatch(ts::TSPacket*, ts::TSPacketMetadata*, Status*, size_t) override;
+
+        // A factory static method which creates an instance of that class.
+        static ts::ProcessorPlugin* CreateInstance(ts::TSP*);
+
+    private:
+        // Command line options:
+        bool _batch;
+        ts::PacketCounter _end;
+
+        // Process one packet, index is the packet number in the plugin stream.
+        Status processOnePacket(ts::TSPacket&, ts::TSPacketMetadata&, ts::PacketCounter);
+    };
+}
+
+// Factory method.
+ts::ProcessorPlugin* BatchTestPlugin::CreateInstance(ts::TSP* t)
+{
+    return new BatchTestPlugin(t);
+}
+
+// Constructor.
+BatchTestPlugin::BatchTestPlugin(ts::TSP* t) :
+    ts::ProcessorPlugin(t, u"Batch test plugin", u"[options]"),
+    _batch(false),
+    _end(0)
+{
+    option(u"batch");
+    help(u"batch", u"Use the packet batch method.");
+
+    option(u"end", 'e', POSITIVE);
+    help(u"end", u"End the processing at this packet index.");
+}
+
+bool BatchTestPlugin::getOptions()
+{
+    _batch = present(u"batch");
+    getIntValue(_end, u"end", ts::PacketCounter(-1));
+    return true;
+}
+
+bool BatchTestPlugin::usePacketBatch()
+{
+    return _batch;
+}
+
+BatchTestPlugin::Status BatchTestPlugin::processPacket(ts::TSPacket& pkt, ts::TSPacketMetadata& metadata)
+{
+    return processOnePacket(pkt, metadata, tsp->pluginPackets());
+}
+
+void BatchTestPlugin::processPacketBatch(ts::TSPacket* pkt, ts::TSPacketMetadata* metadata, Status* status, size_t count)
+{
+    const ts::PacketCounter first = tsp->pluginPackets();
+    for (size_t i = 0; i < count; ++i) {
+        status[i] = processOnePacket(pkt[i], metadata[i], first + i);
+        if (status[i] == TSP_END) {
+            break;
+        }
+    }
+}
+
+BatchTestPlugin::Status BatchTestPlugin::processOnePacket(ts::TSPacket& pkt, ts::TSPacketMetadata& metadata, ts::PacketCounter index)
+{
+    if (index == _end) {
+        return TSP_END;
+    }
+    else if (index % 11 == 5) {
+        return TSP_DROP;
+    }
+    else if (index % 7 == 3) {
+        return TSP_NULL;
+    }
+    else {
+        pkt.setPID(ts::PID(0x100 + index % 16));
+        ts::PutUInt32(pkt.getPayload(), uint32_t(index));
+        return TSP_OK;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// An event handler for memory output plugin: fill a vector of packets.
+//----------------------------------------------------------------------------
+
+namespace {
+    class OutputHandler : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(OutputHandler);
+    public:
+        OutputHandler(ts::TSPacketVector& output) : _output(output) {}
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+    private:
+        ts::TSPacketVector& _output;
+    };
+
+    void OutputHandler::handlePluginEvent(const ts::PluginEventContext& context)
+    {
+        ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+        if (data != nullptr) {
+            const size_t packets_count = data->size() / ts::PKT_SIZE;
+            const size_t index = _output.size();
+            _output.resize(index + packets_count);
+            ts::TSPacket::Copy(&_output[index], data->data(), packets_count);
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // A test plugin event handler.
 // We don't do the TSUNIT assertions in the event handler (called in plugin
@@ -324,3 +459,103 @@ void TSProcessorTest::testProcessing()
     TSUNIT_EQUAL(3,          handler2.logs[0].count);
     TSUNIT_EQUAL(26,         handler2.logs[0].packets);
 }
+
+void TSProcessorTest::testBranches()
+{
+    ts::PluginRepository::Instance()->registerProcessor(u"test1", TestPlugin::CreateInstance);
+
+    // Two parallel branches between two regular plugins, using both synchronization methods.
+    for (int lock_free = 0; lock_free < 2; ++lock_free) {
+
+        ts::TSProcessorArgs opt;
+        opt.app_name = u"TSProcessorTest::testBranches";
+        opt.lock_free = lock_free != 0;
+        opt.input = {u"null", {u"10000"}};
+        opt.plugins = {
+            {u"test1", {u"--count", u"1000"}},
+            {u"test1", {u"--count", u"1000", u"--branch"}},
+            {u"test1", {u"--count", u"1000", u"--branch"}},
+            {u"test1", {u"--count", u"1000"}},
+        };
+        opt.output = {u"drop"};
+
+        ts::TSProcessor tsproc(CERR);
+        TestEventHandler handler;
+        ts::TSProcessor::Criteria crit;
+        crit.event_code = TestPlugin::EVENT_STOP;
+        tsproc.registerEventHandler(&handler, crit);
+
+        TSUNIT_ASSERT(tsproc.start(opt));
+        tsproc.waitForTermination();
+
+        // All plugins have seen all packets. The two branches may stop in any order.
+        TSUNIT_EQUAL(4, handler.logs.size());
+        size_t index_sum = 0;
+        for (size_t i = 0; i < handler.logs.size(); ++i) {
+            TSUNIT_EQUAL(0xBEEF0002, handler.logs[i].code);
+            TSUNIT_EQUAL(6, handler.logs[i].count);
+            TSUNIT_EQUAL(10000, handler.logs[i].packets);
+            index_sum += handler.logs[i].index;
+        }
+        TSUNIT_EQUAL(1 + 2 + 3 + 4, index_sum);
+    }
+}
+
+void TSProcessorTest::RunBatchPlugin(bool batch, ts::TSPacketVector& output)
+{
+    ts::PluginRepository::Instance()->registerProcessor(u"test-batch", BatchTestPlugin::CreateInstance);
+
+    ts::TSProcessorArgs opt;
+    opt.app_name = u"TSProcessorTest::testPacketBatch";
+    opt.input = {u"null", {u"20000"}};
+    opt.plugins = {{u"test-batch", {u"--end", u"15000"}}};
+    if (batch) {
+        opt.plugins[0].args.push_back(u"--batch");
+    }
+    opt.output = {u"memory", {}};
+
+    ts::TSProcessor tsproc(CERR);
+    OutputHandler handler(output);
+    tsproc.registerEventHandler(&handler, ts::PluginType::OUTPUT);
+
+    output.clear();
+    TSUNIT_ASSERT(tsproc.start(opt));
+    tsproc.waitForTermination();
+}
+
+void TSProcessorTest::testPacketBatch()
+{
+    ts::TSPacketVector single;
+    ts::TSPacketVector batch;
+
+    RunBatchPlugin(false, single);
+    RunBatchPlugin(true, batch);
+
+    // Packets from 0 to 14999, without the dropped ones.
+    size_t expected = 0;
+    for (size_t i = 0; i < 15000; ++i) {
+        expected += i % 11 != 5;
+    }
+    debug() << "TSProcessorTest::testPacketBatch: single: " << single.size() << ", batch: " << batch.size() << ", expected: " << expected << std::endl;
+
+    TSUNIT_EQUAL(expected, single.size());
+    TSUNIT_EQUAL(expected, batch.size());
+    TSUNIT_ASSERT(single == batch);
+
+    // Check the indexes in the modified packets.
+    size_t index = 0;
+    bool indexes_ok = true;
+    for (const auto& pkt : batch) {
+        while (index % 11 == 5) {
+            index++;
+        }
+        if (index % 7 == 3) {
+            indexes_ok = indexes_ok && pkt.getPID() == ts::PID_NULL;
+        }
+        else {
+            indexes_ok = indexes_ok && pkt.getPID() == ts::PID(0x100 + index % 16) && ts::GetUInt32(pkt.getPayload()) == uint32_t(index);
+        }
+        index++;
+    }
+    TSUNIT_ASSERT(indexes_ok);
+}
@@ -33,6 +33,9 @@
 
 #include "tsxmlModelDocument.h"
 #include "tsxmlElement.h"
+#include "tsxmlElementWriter.h"
+#include "tsxmlTextWriter.h"
+#include "tsxmlJSONWriter.h"
 #include "tsSectionFile.h"
 #include "tsTextFormatter.h"
 #include "tsCerrReport.h"
@@ -62,6 +65,7 @@ public:
     void testEscape();
     void testTweaks();
     void testChannels();
+    void testWriter();
 
     TSUNIT_TEST_BEGIN(XMLTest);
     TSUNIT_TEST(testDocument);
@@ -73,6 +77,7 @@ public:
     TSUNIT_TEST(testEscape);
     TSUNIT_TEST(testTweaks);
     TSUNIT_TEST(testChannels);
+    TSUNIT_TEST(testWriter);
     TSUNIT_TEST_END();
 
 private:
@@ -488,3 +493,77 @@ void XMLTest::testChannels()
     ts::xml::Document model(report());
     TSUNIT_ASSERT(model.load(ts::SectionFile::XML_TABLES_MODEL));
 }
+
+namespace {
+    // Write the same XML structure in any XML writer.
+    void WriteSample(ts::xml::Writer& writer)
+    {
+        static const uint8_t data[40] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                                         0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,
+                                         0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27};
+
+        ts::xml::Element first(nullptr, u"first");
+        first.setIntAttribute(u"id", 12);
+
+        writer.setNextFirstChild(&first);
+        writer.startElement(u"node1");
+        writer.setAttribute(u"Name", u"a'b\"c&d");
+        writer.setIntAttribute(u"value", 0x1234, true);
+        writer.setBoolAttribute(u"flag", true);
+        writer.startElement(u"empty");
+        writer.endElement();
+        writer.startElement(u"text");
+        writer.setAttribute(u"empty", u"", true);
+        writer.addText(u"some <text> & more");
+        writer.endElement();
+        writer.addHexaTextChild(u"hexa", data, sizeof(data));
+        writer.addHexaTextChild(u"none", data, 0, true);
+
+        ts::xml::Element* dom = writer.startDOM();
+        ts::xml::Element* e = dom->addElement(u"dom");
+        e->setAttribute(u"a", u"b");
+        e->addElement(u"sub")->addText(u"foo");
+        e->addHexaText(data, 5);
+        writer.endDOM();
+
+        writer.startElement(u"node2");
+        writer.endElement();
+        writer.endElement();
+    }
+}
+
+void XMLTest::testWriter()
+{
+    // Reference XML tree.
+    ts::xml::Document doc(report());
+    ts::xml::Element* root = doc.initialize(u"root");
+    TSUNIT_ASSERT(root != nullptr);
+    ts::xml::ElementWriter ewriter(root);
+    WriteSample(ewriter);
+    TSUNIT_ASSERT(ewriter.currentElement() == root);
+    TSUNIT_EQUAL(1, root->childrenCount());
+    const ts::xml::Element* node = root->firstChildElement();
+    TSUNIT_ASSERT(node != nullptr);
+    TSUNIT_EQUAL(u"first", node->firstChildElement()->name());
+
+    // Directly printed XML text.
+    ts::TextFormatter ref(report());
+    ts::TextFormatter text(report());
+    ref.setString();
+    text.setString();
+    node->print(ref);
+    ts::xml::TextWriter twriter(text);
+    WriteSample(twriter);
+    debug() << "XMLTest::testWriter: XML text:" << std::endl << text.toString() << std::endl;
+    TSUNIT_EQUAL(ref.toString(), text.toString());
+
+    // Directly printed JSON text, without model.
+    ts::xml::JSONConverter conv(report());
+    ref.setString();
+    text.setString();
+    conv.printJSON(ref, node);
+    ts::xml::JSONWriter jwriter(text, conv);
+    WriteSample(jwriter);
+    debug() << "XMLTest::testWriter: JSON text:" << std::endl << text.toString() << std::endl;
+    TSUNIT_EQUAL(ref.toString(), text.toString());
+}
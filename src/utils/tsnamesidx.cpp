@@ -0,0 +1,107 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2021, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Compile ".names" files into precompiled binary indexes.
+//  This is a build-time utility. The generated indexes are installed next
+//  to the ".names" files and mapped in memory by ts::NamesFile.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMain.h"
+#include "tsNamesFile.h"
+TS_MAIN(MainCode);
+
+
+//----------------------------------------------------------------------------
+//  Command line options
+//----------------------------------------------------------------------------
+
+namespace {
+    class Options: public ts::Args
+    {
+        TS_NOBUILD_NOCOPY(Options);
+    public:
+        Options(int argc, char *argv[]);
+
+        ts::UStringVector files;   // Input ".names" files.
+        ts::UString       output;  // Output index file, when only one input file.
+    };
+}
+
+Options::Options(int argc, char *argv[]) :
+    Args(u"Compile .names files into binary indexes", u"[options] filename ..."),
+    files(),
+    output()
+{
+    option(u"", 0, STRING, 1, UNLIMITED_COUNT);
+    help(u"", u"Names files to compile.");
+
+    option(u"output", 'o', STRING);
+    help(u"output", u"filename",
+         u"Name of the binary index file to create. This option is allowed with one input file only. "
+         u"By default, the index is created in the same directory as the input file, "
+         u"with the same name and an additional \"" + ts::NamesFile::INDEX_SUFFIX + u"\" suffix.");
+
+    analyze(argc, argv);
+
+    getValues(files);
+    getValue(output, u"output");
+
+    if (!output.empty() && files.size() > 1) {
+        error(u"--output is allowed with one input file only");
+    }
+
+    exitOnError();
+}
+
+
+//----------------------------------------------------------------------------
+//  Program entry point
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    Options opt(argc, argv);
+    bool success = true;
+
+    for (auto it = opt.files.begin(); it != opt.files.end(); ++it) {
+        // Always parse the text file, never use an existing index.
+        const ts::NamesFile names(*it, false, false);
+        if (names.configurationFile().empty() || names.errorCount() > 0) {
+            opt.error(u"errors in %s, index not created", {*it});
+            success = false;
+        }
+        else {
+            const ts::UString index(opt.output.empty() ? *it + ts::NamesFile::INDEX_SUFFIX : opt.output);
+            opt.verbose(u"creating %s", {index});
+            success = names.saveIndex(index, opt) && success;
+        }
+    }
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}